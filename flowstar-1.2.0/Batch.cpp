@@ -0,0 +1,312 @@
+/*---
+  Flow*: A Taylor Model Based Flowpipe analyzer.
+  Authors: Xin Chen, Erika Abraham and Sriram Sankaranarayanan.
+  Email: Xin Chen <xin.chen@cs.rwth-aachen.de> if you have questions or comments.
+
+  The code is released as is under the GNU General Public License (GPL). Please consult the file LICENSE.txt for
+  further information.
+---*/
+
+#include "Batch.h"
+
+// class BatchJob
+
+BatchJob::BatchJob()
+{
+	lineNum = 0;
+	modelID = -1;
+
+	bSucceeded = false;
+	bSafetyChecking = false;
+	result = UNKNOWN;
+	numOfFlowpipes = 0;
+	numOfJumps = 0;
+	wallTime = 0;
+}
+
+BatchJob::BatchJob(const BatchJob & job)
+{
+	modelFile = job.modelFile;
+	overrides = job.overrides;
+	lineNum = job.lineNum;
+	modelID = job.modelID;
+
+	bSucceeded = job.bSucceeded;
+	outputFileName = job.outputFileName;
+	bSafetyChecking = job.bSafetyChecking;
+	result = job.result;
+	numOfFlowpipes = job.numOfFlowpipes;
+	numOfJumps = job.numOfJumps;
+	wallTime = job.wallTime;
+}
+
+BatchJob::~BatchJob()
+{
+}
+
+BatchJob & BatchJob::operator = (const BatchJob & job)
+{
+	if(this == &job)
+		return *this;
+
+	modelFile = job.modelFile;
+	overrides = job.overrides;
+	lineNum = job.lineNum;
+	modelID = job.modelID;
+
+	bSucceeded = job.bSucceeded;
+	outputFileName = job.outputFileName;
+	bSafetyChecking = job.bSafetyChecking;
+	result = job.result;
+	numOfFlowpipes = job.numOfFlowpipes;
+	numOfJumps = job.numOfJumps;
+	wallTime = job.wallTime;
+
+	return *this;
+}
+
+// class Batch
+
+Batch::Batch()
+{
+	numThreads = 1;
+}
+
+Batch::~Batch()
+{
+	for(int i=0; i<models.size(); ++i)
+	{
+		delete models[i];
+	}
+}
+
+bool Batch::load(const char *fileName)
+{
+	FILE *fp = fopen(fileName, "r");
+
+	if(fp == NULL)
+	{
+		printf("Can not open the manifest %s.\n", fileName);
+		return false;
+	}
+
+	string line;
+	int lineNum = 0;
+	int c;
+
+	do
+	{
+		c = getc(fp);
+
+		if(c != '\n' && c != EOF)
+		{
+			line += (char)c;
+			continue;
+		}
+
+		++lineNum;
+
+		// a line is a model file followed by its overrides, the empty lines and the comments are skipped
+		size_t begin = line.find_first_not_of(" \t\r");
+
+		if(begin != string::npos && line[begin] != '#')
+		{
+			size_t end = line.find_first_of(" \t\r", begin);
+
+			BatchJob job;
+			job.modelFile = line.substr(begin, end == string::npos ? string::npos : end - begin);
+			job.overrides = end == string::npos ? string() : line.substr(end);
+			job.lineNum = lineNum;
+
+			jobs.push_back(job);
+		}
+
+		line.clear();
+	}
+	while(c != EOF);
+
+	fclose(fp);
+
+	return true;
+}
+
+int Batch::load_model(const string & modelFile)
+{
+	map<string,int>::const_iterator iter;
+
+	if((iter = modelTab.find(modelFile)) != modelTab.end())
+	{
+		return iter->second;
+	}
+
+	Analysis *model = new Analysis;
+
+	if(!model->parse_file(modelFile.c_str()))
+	{
+		printf("Can not parse the model file %s.\n", modelFile.c_str());
+		delete model;
+		model = NULL;
+	}
+
+	int id = models.size();
+	models.push_back(model);
+	modelTab[modelFile] = id;
+
+	return id;
+}
+
+static void batch_job(void *arg, const int i)
+{
+	Batch *batch = (Batch *)arg;
+	batch->run_job(i);
+}
+
+bool Batch::run()
+{
+	if(!make_output_directories())
+	{
+		return false;
+	}
+
+	// the model files are parsed before the jobs start, each job fills the factorial tables of its own analysis
+	for(int i=0; i<jobs.size(); ++i)
+	{
+		jobs[i].modelID = load_model(jobs[i].modelFile);
+	}
+
+	runParallelTasks(batch_job, this, jobs.size(), numThreads);
+
+	bool bSucceeded = true;
+
+	for(int i=0; i<jobs.size(); ++i)
+	{
+		bSucceeded = bSucceeded && jobs[i].bSucceeded;
+	}
+
+	return bSucceeded;
+}
+
+void Batch::run_job(const int i)
+{
+	BatchJob & job = jobs[i];
+	const Analysis *model = models[job.modelID];
+
+	if(model == NULL)
+	{
+		return;
+	}
+
+	struct timespec begin, end;
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+
+	Analysis analysis;
+	analysis.copy_model(*model);
+
+	bool bHybrid = (analysis.task == TASK_HYBRID || analysis.task == TASK_HYBRID_FLOWPIPES);
+
+	// the output files of the jobs are numbered unless the overrides name them
+	char name[NAME_SIZE];
+	sprintf(name, "%.*s_%d", NAME_SIZE-12, bHybrid ? model->hybridProblem.outputFileName : model->continuousProblem.outputFileName, i+1);
+	strcpy(analysis.continuousProblem.outputFileName, name);
+	strcpy(analysis.hybridProblem.outputFileName, name);
+
+	analysis.continuousProblem.bPrint = false;
+	analysis.hybridProblem.bPrint = false;
+
+	// the parse errors refer to the line of the manifest
+	analysis.lineNum = job.lineNum;
+
+	if(!analysis.parse_string(string("override { ") + job.overrides + str_suffix))
+	{
+		return;
+	}
+
+	job.outputFileName = bHybrid ? analysis.hybridProblem.outputFileName : analysis.continuousProblem.outputFileName;
+
+	char filename[NAME_SIZE+30];
+	sprintf(filename, "%s%s%s", outputDir, job.outputFileName.c_str(), str_batch_log_name_suffix);
+	analysis.fpLog = fopen(filename, "w");
+
+	if(analysis.fpLog == NULL)
+	{
+		printf("Can not create the log file of %s.\n", job.outputFileName.c_str());
+		return;
+	}
+
+	job.bSucceeded = analysis.run();
+	fclose(analysis.fpLog);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	job.wallTime = elapsed_nanoseconds(begin, end) / 1e9;
+
+	job.bSafetyChecking = analysis.bSafetyChecking;
+	job.result = analysis.result;
+
+	if(bHybrid)
+	{
+		job.numOfFlowpipes = analysis.hybridProblem.numOfFlowpipes();
+		job.numOfJumps = analysis.hybridProblem.numOfJumpsExecuted();
+	}
+	else
+	{
+		job.numOfFlowpipes = analysis.continuousProblem.numOfFlowpipes();
+	}
+}
+
+static const char *result_name(const BatchJob & job)
+{
+	if(!job.bSucceeded)
+	{
+		return "ERROR";
+	}
+
+	if(!job.bSafetyChecking)
+	{
+		return "NONE";
+	}
+
+	switch(job.result)
+	{
+	case SAFE:
+		return "SAFE";
+	case UNSAFE:
+		return "UNSAFE";
+	default:
+		return "UNKNOWN";
+	}
+}
+
+void Batch::dump_summary(FILE *fp) const
+{
+	int numOfFailures = 0;
+
+	for(int i=0; i<jobs.size(); ++i)
+	{
+		const BatchJob & job = jobs[i];
+
+		if(job.bSucceeded)
+		{
+			fprintf(fp, "%s (line %d): %s, %lu flowpipes, %lu jumps, %lf s\n", job.outputFileName.c_str(), job.lineNum, result_name(job),
+					job.numOfFlowpipes, job.numOfJumps, job.wallTime);
+		}
+		else
+		{
+			fprintf(fp, "%s (line %d): failed\n", job.modelFile.c_str(), job.lineNum);
+			++numOfFailures;
+		}
+	}
+
+	fprintf(fp, "%lu jobs, %d failed.\n", jobs.size(), numOfFailures);
+}
+
+void Batch::dump_csv(FILE *fp) const
+{
+	fprintf(fp, "line,model,output,wall_time,flowpipes,jumps,result\n");
+
+	for(int i=0; i<jobs.size(); ++i)
+	{
+		const BatchJob & job = jobs[i];
+		fprintf(fp, "%d,%s,%s,%lf,%lu,%lu,%s\n", job.lineNum, job.modelFile.c_str(), job.outputFileName.c_str(), job.wallTime,
+				job.numOfFlowpipes, job.numOfJumps, result_name(job));
+	}
+}
@@ -0,0 +1,71 @@
+/*---
+  Flow*: A Taylor Model Based Flowpipe analyzer.
+  Authors: Xin Chen, Erika Abraham and Sriram Sankaranarayanan.
+  Email: Xin Chen <xin.chen@cs.rwth-aachen.de> if you have questions or comments.
+
+  The code is released as is under the GNU General Public License (GPL). Please consult the file LICENSE.txt for
+  further information.
+---*/
+
+#ifndef BATCH_H_
+#define BATCH_H_
+
+#include "modelParser.h"
+
+/*
+ * A job of a batch is a model file and the settings which override the ones of the model. The overrides are written
+ * in the syntax of the model files, e.g., "time 5 fixed orders 6 init { x in [1,1.1] y in [0,0.1] } output vdp_a".
+ */
+class BatchJob
+{
+public:
+	string modelFile;
+	string overrides;
+	int lineNum;				// in the manifest
+	int modelID;				// the index of the parsed model file in the batch
+
+	bool bSucceeded;
+	string outputFileName;
+	bool bSafetyChecking;
+	int result;
+	unsigned long numOfFlowpipes;
+	unsigned long numOfJumps;
+	double wallTime;			// in seconds
+public:
+	BatchJob();
+	BatchJob(const BatchJob & job);
+	~BatchJob();
+
+	BatchJob & operator = (const BatchJob & job);
+};
+
+/*
+ * A batch runs its jobs concurrently in one process. Every model file is parsed only once, the jobs copy the parsed
+ * problem, so the Horner forms of the ODEs and the cached Taylor expansions of the modes are shared, and so are the
+ * tables of the factorials. The messages of a job are written to its own log file in the output directory.
+ */
+class Batch
+{
+public:
+	vector<BatchJob> jobs;
+	vector<Analysis *> models;		// NULL if the model file could not be parsed
+	map<string,int> modelTab;
+	int numThreads;
+public:
+	Batch();
+	~Batch();
+
+	bool load(const char *fileName);	// read the manifest, one job per line
+	bool run();							// returns whether all of the jobs succeeded
+	void run_job(const int i);
+
+	void dump_summary(FILE *fp) const;
+	void dump_csv(FILE *fp) const;
+private:
+	Batch(const Batch & batch);			// not copyable
+	Batch & operator = (const Batch & batch);
+
+	int load_model(const string & modelFile);
+};
+
+#endif /* BATCH_H_ */
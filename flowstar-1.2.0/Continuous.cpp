@@ -140,6 +140,8 @@ void Flowpipe::dump_normal(FILE *fp, const vector<string> & stateVarNames, const
 
 void Flowpipe::composition(TaylorModelVec & result) const
 {
+	ProfileScope scope(PHASE_COMPOSITION);
+
 	vector<int> orders;
 
 	for(int i=0; i<tmv.tms.size(); ++i)
@@ -164,6 +166,8 @@ void Flowpipe::composition(TaylorModelVec & result) const
 
 void Flowpipe::composition_normal(TaylorModelVec & result, const vector<Interval> & step_exp_table) const
 {
+	ProfileScope scope(PHASE_COMPOSITION);
+
 	int domainDim = domain.size();
 
 	vector<int> orders;
@@ -271,248 +275,309 @@ void Flowpipe::normalize()
 	}
 }
 
-// for low-degree ODEs
-// fixed step sizes and orders
-
-bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+void Flowpipe::split(list<Flowpipe> & results, const int num) const
 {
-	int rangeDim = ode.size();
-	Interval intZero, intOne(1,1), intUnit(-1,1);
-	result.clear();
+	results.clear();
+	results.push_back(*this);
 
-	// evaluate the the initial set x0
-	TaylorModelVec range_of_x0;
-	tmvPre.evaluate_t(range_of_x0, step_end_exp_table);
+	if(num <= 1)
+	{
+		return;
+	}
 
-	// the center point of x0's polynomial part
-	vector<Interval> intVecCenter;
-	range_of_x0.constant(intVecCenter);
+	int domainDim = domain.size();
 
-	// the center point of the remainder
-	for(int i=0; i<rangeDim; ++i)
+	for(; results.size() < num;)
 	{
-		Interval M;
-		range_of_x0.tms[i].remainder.remove_midpoint(M);
-		intVecCenter[i] += M;
-	}
+		list<Flowpipe>::iterator iterMax = results.begin();
+		int dimMax = 0;
+		double widthMax = 0;
 
-	TaylorModelVec c0(intVecCenter, rangeDim+1);
+		list<Flowpipe>::iterator iter = results.begin();
+		for(; iter != results.end(); ++iter)
+		{
+			for(int i=1; i<domainDim; ++i)		// we omit the time dimension
+			{
+				double w = iter->domain[i].width();
+				if(w > widthMax)
+				{
+					widthMax = w;
+					iterMax = iter;
+					dimMax = i;
+				}
+			}
+		}
 
-	// introduce a new variable r0 such that x0 = c0 + A*r0, then r0 is origin-centered
-	range_of_x0.rmConstant();
+		if(dimMax == 0)
+		{
+			break;		// the domain is a point
+		}
 
-	// compute the preconditioning matrix
-	Matrix A(rangeDim,rangeDim), invA(rangeDim,rangeDim);
-	TaylorModelVec range_of_r0;
+		Interval left, right;
+		iterMax->domain[dimMax].split(left, right);
 
-	switch(precondition)
-	{
-	case ID_PRE:
-	{
-		range_of_r0 = range_of_x0;
-		break;
+		Flowpipe fpLeft = *iterMax;
+		fpLeft.domain[dimMax] = left;
+		iterMax->domain[dimMax] = right;
+
+		results.insert(iterMax, fpLeft);
 	}
 
-	case QR_PRE:
+	list<Flowpipe>::iterator iter = results.begin();
+	for(; iter != results.end(); ++iter)
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
-		range_of_x0.linearTrans(range_of_r0, invA);
-		break;
-	}
+		iter->normalize();
 	}
+}
 
-	vector<Interval> tmvPolyRange;
-	tmv.polyRangeNormal(tmvPolyRange, step_end_exp_table);
-	range_of_r0.insert_ctrunc_normal(result.tmv, tmv, tmvPolyRange, step_end_exp_table, domain.size(), order);
+// class LinearFlow
 
-	// we normalized the interval bound of r0
-	vector<Interval> boundOfr0;
-	result.tmv.intEvalNormal(boundOfr0, step_end_exp_table);
+LinearFlow::LinearFlow()
+{
+	order = 0;
+}
 
-	// Compute the scaling matrix S.
-	Matrix S(rangeDim, rangeDim);
-	Matrix invS(rangeDim, rangeDim);
-	for(int i=0; i<rangeDim; ++i)
-	{
-		Interval intSup;
-		boundOfr0[i].mag(intSup);
+LinearFlow::LinearFlow(const LinearFlow & flow):coefficients(flow.coefficients), hull(flow.hull), truncation(flow.truncation), inputs(flow.inputs), order(flow.order)
+{
+}
 
-		if(!intSup.subseteq(intZero))
-		{
-			double dSup = intSup.sup();
-			S.set(dSup, i, i);
-			invS.set(1/dSup, i, i);
-			boundOfr0[i] = intUnit;
-		}
-		else
-		{
-			S.set(0, i, i);
-			invS.set(1, i, i);
-		}
-	}
+LinearFlow::~LinearFlow()
+{
+	coefficients.clear();
+	truncation.clear();
+	hull.clear();
+	inputs.clear();
+}
 
-	// apply the scaling matrix S, i.e., A S S^(-1) A^(-1), then the interval bound of r0 is normalized to [-1,1]^n
+bool LinearFlow::build(const TaylorModelVec & ode, const vector<Interval> & uncertainties, const double step, const int minOrder, const int maxOrder)
+{
+	int rangeDim = ode.tms.size();
+	int dim = rangeDim + 1;
+	Interval intZero, intOne(1);
 
-	switch(precondition)
-	{
-	case ID_PRE:
-	{
-		A = S;
-		invA = invS;
-		break;
-	}
+	coefficients.clear();
+	truncation.clear();
+	hull.clear();
+	inputs.clear();
 
-	case QR_PRE:
+	// the augmented matrix M = [A b; 0 0] such that (x,1)' = M*(x,1)
+	vector<Interval> zeroRow;
+	for(int j=0; j<dim; ++j)
 	{
-		A = A * S;
-		invA = invS * invA;
-		break;
-	}
+		zeroRow.push_back(intZero);
 	}
 
-	result.tmv.linearTrans_assign(invS);
-	result.tmv.cutoff_normal(step_end_exp_table);
+	vector<Interval> constants;
+	ode.constant(constants);
 
-	Matrix matCoefficients_Ar0(rangeDim, rangeDim+1);
+	vector<vector<Interval> > M, absM;
 
 	for(int i=0; i<rangeDim; ++i)
 	{
+		vector<Interval> linear = zeroRow;
+		ode.tms[i].linearCoefficients(linear);
+
+		vector<Interval> row;
 		for(int j=0; j<rangeDim; ++j)
 		{
-			matCoefficients_Ar0.set( A.get(i,j) , i, j+1);
+			row.push_back(linear[j+1]);
 		}
-	}
-
-	TaylorModelVec Ar0(matCoefficients_Ar0);
 
-	TaylorModelVec x0;
-	Ar0.add(x0, c0);
+		row.push_back(constants[i]);
+		M.push_back(row);
+	}
 
-	TaylorModelVec x;
+	M.push_back(zeroRow);
 
-	for(int i=0; i<taylorExpansion.size(); ++i)
+	// an upper bound of the infinity norm of M*h
+	Interval intNorm;
+	for(int i=0; i<dim; ++i)
 	{
-		TaylorModel tmTemp;
-		taylorExpansion[i].insert_no_remainder(tmTemp, x0, rangeDim+1, order);
-		x.tms.push_back(tmTemp);
-	}
+		vector<Interval> row;
+		Interval intRowSum;
 
-	x.cutoff();
+		for(int j=0; j<dim; ++j)
+		{
+			Interval intMag;
+			M[i][j].mag(intMag);
+			row.push_back(intMag);
+			intRowSum += intMag;
+		}
 
-	bool bfound = true;
+		absM.push_back(row);
 
-	vector<Interval> step_uncertainties;
-	for(int i=0; i<rangeDim; ++i)
-	{
-		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
+		if(intRowSum.sup() > intNorm.sup())
+		{
+			intNorm = intRowSum;
+		}
 	}
 
-	for(int i=0; i<rangeDim; ++i)
+	Interval intStep(step), intNormStep = intNorm * intStep;
+
+	// C_k = M^k/k! and D_k = |M|^k/k!, the truncated part of row i of exp(M*t) for order N is bounded by
+	// sum_j D_(N+1)[i][j] * h^(N+1) / (1 - |M|h/(N+2)) in the infinity norm
+	vector<vector<Interval> > identity;
+	for(int i=0; i<dim; ++i)
 	{
-		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
+		identity.push_back(zeroRow);
+		identity[i][i] = intOne;
 	}
 
-	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	coefficients.push_back(identity);
 
-	vector<Interval> xPolyRange;
-	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, order);
+	vector<vector<Interval> > absCoefficients = identity;
+	Interval intStepPower(1);
+	bool bfound = false;
 
-	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
-	vector<Interval> intDifferences;
-	for(int i=0; i<rangeDim; ++i)
+	for(int k=1; k<=maxOrder+1; ++k)
 	{
-		Polynomial polyTemp;
-		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+		vector<vector<Interval> > next, absNext;
 
-		Interval intTemp;
-		polyTemp.intEvalNormal(intTemp, step_exp_table);
+		for(int i=0; i<dim; ++i)
+		{
+			vector<Interval> row = zeroRow, absRow = zeroRow;
 
-		intDifferences.push_back(intTemp);
-	}
+			for(int j=0; j<dim; ++j)
+			{
+				for(int l=0; l<dim; ++l)
+				{
+					if(!M[l][j].subseteq(intZero))
+					{
+						row[j] += coefficients.back()[i][l] * M[l][j];
+						absRow[j] += absCoefficients[i][l] * absM[l][j];
+					}
+				}
 
-	// add the uncertainties and the cutoff intervals onto the result
-	for(int i=0; i<rangeDim; ++i)
-	{
-		tmvTemp.tms[i].remainder += step_uncertainties[i];
-		tmvTemp.tms[i].remainder += intDifferences[i];
-	}
+				row[j] /= Interval(k);
+				absRow[j] /= Interval(k);
+			}
 
-	for(int i=0; i<rangeDim; ++i)
-	{
-		if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+			next.push_back(row);
+			absNext.push_back(absRow);
+		}
+
+		absCoefficients = absNext;
+		intStepPower *= intStep;
+
+		if(k-1 >= minOrder)
+		{
+			Interval intRatio = intNormStep / Interval(k+1);
+
+			if(intRatio.sup() < 1)
+			{
+				Interval intScale = intStepPower / (intOne - intRatio);
+				double dMax = 0;
+
+				truncation.clear();
+				for(int i=0; i<rangeDim; ++i)
+				{
+					Interval intRowSum;
+					for(int j=0; j<dim; ++j)
+					{
+						intRowSum += absCoefficients[i][j];
+					}
+
+					intRowSum *= intScale;
+					truncation.push_back(Interval(-intRowSum.sup(), intRowSum.sup()));
+
+					if(intRowSum.sup() > dMax)
+					{
+						dMax = intRowSum.sup();
+					}
+				}
+
+				order = k-1;
+				bfound = true;
+
+				if(dMax <= THRESHOLD_HIGH)
+				{
+					break;
+				}
+			}
+		}
+
+		if(k > maxOrder)
 		{
-			bfound = false;
 			break;
 		}
+
+		coefficients.push_back(next);
 	}
 
 	if(!bfound)
 	{
 		return false;
 	}
-	else
-	{
-		for(int i=0; i<rangeDim; ++i)
-			x.tms[i].remainder = tmvTemp.tms[i].remainder;
-	}
-
-	bool bfinished = false;
-	for(; !bfinished;)
-	{
-		bfinished = true;
 
-		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+	coefficients.resize(order+1);
 
-		for(int i=0; i<rangeDim; ++i)
-		{
-			newRemainders.push_back(tmvTemp.tms[i].remainder);
-		}
+	// the enclosure of exp(A*t) over [0,h]
+	vector<Interval> step_exp_table, step_end_exp_table;
+	construct_step_exp_table(step_exp_table, step_end_exp_table, step, order);
 
-		// add the uncertainties and the cutoff intervals onto the result
-		for(int i=0; i<rangeDim; ++i)
-		{
-			newRemainders[i] += step_uncertainties[i];
-			newRemainders[i] += intDifferences[i];
-		}
+	for(int i=0; i<rangeDim; ++i)
+	{
+		vector<Interval> row;
 
-		for(int i=0; i<rangeDim; ++i)
+		for(int j=0; j<rangeDim; ++j)
 		{
+			Interval intEntry = truncation[i];
 
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-			}
-			else
+			for(int k=0; k<=order; ++k)
 			{
-				bfinished = true;
-				break;
+				intEntry += coefficients[k][i][j] * step_exp_table[k];
 			}
 
-			x.tms[i].remainder = newRemainders[i];
+			row.push_back(intEntry);
 		}
+
+		hull.push_back(row);
 	}
 
-	result.tmvPre = x;
-	result.domain = domain;
-	result.domain[0] = step_exp_table[1];
+	// the input term int_0^t exp(A*(t-s))*u(s) ds is in [0,h] * hull * U
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Interval intInput;
+
+		for(int j=0; j<rangeDim; ++j)
+		{
+			if(!uncertainties[j].subseteq(intZero))
+			{
+				intInput += hull[i][j] * uncertainties[j];
+			}
+		}
+
+		intInput *= step_exp_table[1];
+		inputs.push_back(intInput);
+	}
 
-	trees.clear();
 	return true;
 }
 
-bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const vector<int> & orders, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+LinearFlow & LinearFlow::operator = (const LinearFlow & flow)
 {
-	int rangeDim = ode.size();
-	Interval intZero, intOne(1,1), intUnit(-1,1);
+	if(this == &flow)
+		return *this;
+
+	coefficients = flow.coefficients;
+	hull = flow.hull;
+	truncation = flow.truncation;
+	inputs = flow.inputs;
+	order = flow.order;
+
+	return *this;
+}
+
+// integration scheme for affine ODEs
+
+bool Flowpipe::advance_linear(Flowpipe & result, const LinearFlow & flow, const int precondition, const vector<Interval> & step_exp_table, const vector<Interval> & step_end_exp_table) const
+{
+	int rangeDim = tmvPre.tms.size();
+	Interval intZero, intUnit(-1,1);
 	result.clear();
 
+	stepLog->begin();
+
 	// evaluate the the initial set x0
 	TaylorModelVec range_of_x0;
 	tmvPre.evaluate_t(range_of_x0, step_end_exp_table);
@@ -520,7 +585,8 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 	// the center point of x0's polynomial part
 	vector<Interval> intVecCenter;
 	range_of_x0.constant(intVecCenter);
-	// the center point of the remainder of x0
+
+	// the center point of the remainder
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Interval M;
@@ -528,8 +594,6 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		intVecCenter[i] += M;
 	}
 
-	TaylorModelVec c0(intVecCenter, rangeDim+1);
-
 	// introduce a new variable r0 such that x0 = c0 + A*r0, then r0 is origin-centered
 	range_of_x0.rmConstant();
 
@@ -547,8 +611,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -556,7 +619,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	vector<Interval> tmvPolyRange;
 	tmv.polyRangeNormal(tmvPolyRange, step_end_exp_table);
-	range_of_r0.insert_ctrunc_normal(result.tmv, tmv, tmvPolyRange, step_end_exp_table, domain.size(), orders);
+	range_of_r0.insert_ctrunc_normal(result.tmv, tmv, tmvPolyRange, step_end_exp_table, domain.size(), flow.order);
 
 	// we normalized the interval bound of r0
 	vector<Interval> boundOfr0;
@@ -606,134 +669,112 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 	result.tmv.linearTrans_assign(invS);
 	result.tmv.cutoff_normal(step_end_exp_table);
 
-	Matrix matCoefficients_Ar0(rangeDim, rangeDim+1);
-
+	// x0 = c0 + A*r0, the truncation error is proportional to the infinity norm of (x0,1)
+	double dMag = 1;
 	for(int i=0; i<rangeDim; ++i)
 	{
+		Interval intRowSum;
+		intVecCenter[i].mag(intRowSum);
+
 		for(int j=0; j<rangeDim; ++j)
 		{
-			matCoefficients_Ar0.set( A.get(i,j) , i, j+1);
+			intRowSum += fabs(A.get(i,j));
 		}
-	}
 
-	TaylorModelVec Ar0(matCoefficients_Ar0);
-
-	TaylorModelVec x0;
-	Ar0.add(x0, c0);
-
-	TaylorModelVec x;
-
-	for(int i=0; i<taylorExpansion.size(); ++i)
-	{
-		TaylorModel tmTemp;
-		taylorExpansion[i].insert_no_remainder(tmTemp, x0, rangeDim+1, orders[i]);
-		x.tms.push_back(tmTemp);
-	}
-
-	x.cutoff();
-
-	vector<Interval> step_uncertainties;
-	for(int i=0; i<rangeDim; ++i)
-	{
-		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
-	}
-
-	bool bfound = true;
-
-	for(int i=0; i<rangeDim; ++i)
-	{
-		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
+		if(intRowSum.sup() > dMag)
+		{
+			dMag = intRowSum.sup();
+		}
 	}
 
-	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	Interval intMag(dMag);
 
-	vector<Interval> xPolyRange;
-	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, orders);
+	// x(t) = sum_k t^k * M^k/k! * (c0 + A*r0, 1) + truncation + inputs
+	TaylorModelVec x;
 
-	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
-	vector<Interval> intDifferences;
-	for(int i=0; i<rangeDim; ++i)
+	vector<int> degrees;
+	for(int i=0; i<rangeDim+1; ++i)
 	{
-		Polynomial polyTemp;
-		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-
-		Interval intTemp;
-		polyTemp.intEvalNormal(intTemp, step_exp_table);
-		intDifferences.push_back(intTemp);
+		degrees.push_back(0);
 	}
 
 	for(int i=0; i<rangeDim; ++i)
 	{
-		tmvTemp.tms[i].remainder += step_uncertainties[i];
-		tmvTemp.tms[i].remainder += intDifferences[i];
-	}
+		vector<Monomial> monomials;
 
-	for(int i=0; i<rangeDim; ++i)
-	{
-		if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+		for(int k=0; k<=flow.order; ++k)
 		{
-			bfound = false;
-			break;
-		}
-	}
+			const vector<Interval> & row = flow.coefficients[k][i];
 
-	if(!bfound)
-	{
-		return false;
-	}
-	else
-	{
-		for(int i=0; i<rangeDim; ++i)
-			x.tms[i].remainder = tmvTemp.tms[i].remainder;
-	}
+			Interval intConstant = row[rangeDim];
+			vector<Interval> linear;
 
-	bool bfinished = false;
-	for(; !bfinished;)
-	{
-		bfinished = true;
+			for(int l=0; l<rangeDim; ++l)
+			{
+				linear.push_back(intZero);
+			}
 
-		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+			for(int j=0; j<rangeDim; ++j)
+			{
+				if(row[j].subseteq(intZero))
+				{
+					continue;
+				}
 
-		for(int i=0; i<rangeDim; ++i)
-		{
-			newRemainders[i] += step_uncertainties[i];
-			newRemainders[i] += intDifferences[i];
-		}
+				intConstant += row[j] * intVecCenter[j];
 
-		for(int i=0; i<rangeDim; ++i)
-		{
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
+				for(int l=0; l<rangeDim; ++l)
 				{
-					bfinished = false;
+					double a = A.get(j,l);
+					if(a != 0)
+					{
+						linear[l] += row[j] * Interval(a);
+					}
 				}
 			}
-			else
+
+			degrees[0] = k;
+
+			if(!intConstant.subseteq(intZero))
 			{
-				bfinished = true;
-				break;
+				monomials.push_back(Monomial(intConstant, degrees));
 			}
 
-			x.tms[i].remainder = newRemainders[i];
+			for(int l=0; l<rangeDim; ++l)
+			{
+				if(!linear[l].subseteq(intZero))
+				{
+					degrees[l+1] = 1;
+					monomials.push_back(Monomial(linear[l], degrees));
+					degrees[l+1] = 0;
+				}
+			}
 		}
+
+		Polynomial polyTemp(monomials);
+		TaylorModel tmTemp(polyTemp, flow.truncation[i] * intMag + flow.inputs[i]);
+		x.tms.push_back(tmTemp);
 	}
 
+	x.cutoff_normal(step_exp_table);
+
+	// the flow is evaluated once per step, which is logged as a single iteration
+	stepLog->accept(step_exp_table[1].sup(), flow.order, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
 	return true;
 }
 
-// adaptive step sizes and fixed orders
+// for low-degree ODEs
+// fixed step sizes and orders
 
-bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
+	stepLog->begin();
+
 	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
@@ -745,7 +786,8 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 	// the center point of x0's polynomial part
 	vector<Interval> intVecCenter;
 	range_of_x0.constant(intVecCenter);
-	// the center point of the remainder of x0
+
+	// the center point of the remainder
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Interval M;
@@ -772,8 +814,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -857,10 +898,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	x.cutoff();
 
-	if(step > THRESHOLD_HIGH)		// step size is changed
-	{
-		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
-	}
+	bool bfound = true;
 
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
@@ -868,34 +906,35 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
-	bool bfound = true;
-
 	for(int i=0; i<rangeDim; ++i)
 	{
-		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
+		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, order);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, order);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
-	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
+
 		intDifferences.push_back(intTemp);
 	}
 
+	// add the uncertainties and the cutoff intervals onto the result
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
@@ -911,51 +950,15 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	for(; !bfound;)
+	if(!bfound)
 	{
-		bfound = true;
-		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
-
-		if(newStep < miniStep)
-		{
-			return false;
-		}
-
-		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*order);
-
-		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
-		{
-			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
-		}
-
-		x.polyRangeNormal(xPolyRange, step_exp_table);
-		x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, order);
-
-		// recompute the interval evaluation of the polynomial differences
-		for(int i=0; i<rangeDim; ++i)
-		{
-			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			tmvTemp.tms[i].remainder += step_uncertainties[i];
-			tmvTemp.tms[i].remainder += intDifferences[i];
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
-			{
-				bfound = false;
-				break;
-			}
-		}
+		stepLog->reject(step_exp_table[1].sup(), order, tmvTemp);
+		return false;
 	}
-
-	for(int i=0; i<rangeDim; ++i)
+	else
 	{
-		x.tms[i].remainder = tmvTemp.tms[i].remainder;
+		for(int i=0; i<rangeDim; ++i)
+			x.tms[i].remainder = tmvTemp.tms[i].remainder;
 	}
 
 	bool bfinished = false;
@@ -964,8 +967,14 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
+		for(int i=0; i<rangeDim; ++i)
+		{
+			newRemainders.push_back(tmvTemp.tms[i].remainder);
+		}
+
+		// add the uncertainties and the cutoff intervals onto the result
 		for(int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += step_uncertainties[i];
@@ -974,6 +983,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 		for(int i=0; i<rangeDim; ++i)
 		{
+
 			if(newRemainders[i].subseteq(x.tms[i].remainder))
 			{
 				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
@@ -991,16 +1001,20 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
+	stepLog->accept(step_exp_table[1].sup(), order, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
-bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const vector<int> & orders, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
+	stepLog->begin();
+
 	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
@@ -1039,8 +1053,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -1124,11 +1137,6 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	x.cutoff();
 
-	if(step > THRESHOLD_HIGH)		// step size is changed
-	{
-		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
-	}
-
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
 	{
@@ -1143,20 +1151,21 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, orders);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, orders);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
-	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
@@ -1178,50 +1187,15 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	for(; !bfound;)
+	if(!bfound)
 	{
-		bfound = true;
-		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
-
-		if(newStep < miniStep)
-		{
-			return false;
-		}
-
-		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*globalMaxOrder);
-
-		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
-		{
-			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
-		}
-
-		x.polyRangeNormal(xPolyRange, step_exp_table);
-		x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, orders);
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			tmvTemp.tms[i].remainder += step_uncertainties[i];
-			tmvTemp.tms[i].remainder += intDifferences[i];
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
-			{
-				bfound = false;
-				break;
-			}
-		}
+		stepLog->reject(step_exp_table[1].sup(), orders, tmvTemp);
+		return false;
 	}
-
-	for(int i=0; i<rangeDim; ++i)
+	else
 	{
-		x.tms[i].remainder = tmvTemp.tms[i].remainder;
+		for(int i=0; i<rangeDim; ++i)
+			x.tms[i].remainder = tmvTemp.tms[i].remainder;
 	}
 
 	bool bfinished = false;
@@ -1230,7 +1204,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
 		for(int i=0; i<rangeDim; ++i)
 		{
@@ -1257,18 +1231,22 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
+	stepLog->accept(step_exp_table[1].sup(), orders, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
-// adaptive orders and fixed step sizes
+// adaptive step sizes and fixed orders
 
-bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, int & order, const int maxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
+	stepLog->begin();
+
 	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
@@ -1307,8 +1285,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -1392,40 +1369,48 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	x.cutoff();
 
-	bool bfound = true;
+	if(step > THRESHOLD_HIGH)		// step size is changed
+	{
+		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
+	}
 
 	vector<Interval> step_uncertainties;
-
 	for(int i=0; i<rangeDim; ++i)
 	{
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
+	bool bfound = true;
+
 	for(int i=0; i<rangeDim; ++i)
 	{
 		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, order);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, order);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
+	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
 		intDifferences.push_back(intTemp);
 	}
 
-	// add the uncertainties onto the reault
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
@@ -1441,48 +1426,40 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	int newOrder = order;
-
 	for(; !bfound;)
 	{
-		++newOrder;
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), order, tmvTemp);
+		bfound = true;
+		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
 
-		if(newOrder > maxOrder)
+		if(newStep < miniStep)
 		{
 			return false;
 		}
 
-		// increase the approximation orders by 1
-		x.Picard_no_remainder_assign(x0, ode, rangeDim+1, newOrder);
+		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*order);
 
-		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
 		{
-			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
 		}
 
-		// compute the Picard operation again
 		x.polyRangeNormal(xPolyRange, step_exp_table);
-		x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, newOrder);
+		x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, order);
 
-		// Update the irreducible part
+		// recompute the interval evaluation of the polynomial differences
 		for(int i=0; i<rangeDim; ++i)
 		{
-			Polynomial polyTemp;
-			polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-
-			Interval intTemp;
-			polyTemp.intEvalNormal(intTemp, step_exp_table);
-			intDifferences[i] = intTemp;
+			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
 		}
 
-		// add the uncertainties onto the result
 		for(int i=0; i<rangeDim; ++i)
 		{
 			tmvTemp.tms[i].remainder += step_uncertainties[i];
 			tmvTemp.tms[i].remainder += intDifferences[i];
 		}
 
-		bfound = true;
 		for(int i=0; i<rangeDim; ++i)
 		{
 			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
@@ -1504,9 +1481,8 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
-		// add the uncertainties
 		for(int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += step_uncertainties[i];
@@ -1532,17 +1508,20 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	order = newOrder;
+	stepLog->accept(step_exp_table[1].sup(), order, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
-bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, vector<int> & orders, const vector<int> & maxOrders, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
+	stepLog->begin();
+
 	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
@@ -1581,8 +1560,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -1666,6 +1644,11 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 
 	x.cutoff();
 
+	if(step > THRESHOLD_HIGH)		// step size is changed
+	{
+		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
+	}
+
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
 	{
@@ -1680,18 +1663,23 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, orders);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, orders);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
+	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
@@ -1704,101 +1692,40 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		tmvTemp.tms[i].remainder += intDifferences[i];
 	}
 
-	vector<bool> bIncrease;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 		{
-			bIncrease.push_back(true);
-			if(bfound)
-				bfound = false;
-		}
-		else
-		{
-			bIncrease.push_back(false);
+			bfound = false;
+			break;
 		}
 	}
 
-	vector<int> newOrders = orders;
-	bool bIncreaseOthers = false;
-	int numIncrease = 0;
-
-	vector<bool> bIncreased;
-	for(int i=0; i<rangeDim; ++i)
-	{
-		bIncreased.push_back(false);
-	}
-
 	for(; !bfound;)
 	{
-		bool bChanged = false;
-
-		if(bIncreaseOthers)
-		{
-			for(int i=0; i<bIncrease.size(); ++i)
-			{
-				if(!bIncrease[i] && newOrders[i] < maxOrders[i])
-				{
-					++newOrders[i];
-					bIncreased[i] = true;
-
-					if(!bChanged)
-						bChanged = true;
-				}
-			}
-
-			bIncreaseOthers = false;
-		}
-		else
-		{
-			numIncrease = 0;
-			for(int i=0; i<bIncrease.size(); ++i)
-			{
-				if(bIncrease[i] && newOrders[i] < maxOrders[i])
-				{
-					++newOrders[i];
-					++numIncrease;
-
-					bIncreased[i] = true;
-
-					if(!bChanged)
-						bChanged = true;
-				}
-			}
-
-			if(numIncrease < newOrders.size())
-				bIncreaseOthers = true;
-		}
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), orders, tmvTemp);
+		bfound = true;
+		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
 
-		if(!bChanged)
+		if(newStep < miniStep)
 		{
 			return false;
 		}
 
-		// increase the approximation orders
-		x.Picard_no_remainder_assign(x0, ode, rangeDim+1, newOrders, bIncreased);
+		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*globalMaxOrder);
 
-		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
 		{
-			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
 		}
 
-		// compute the Picard operation again
 		x.polyRangeNormal(xPolyRange, step_exp_table);
-		x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, newOrders);
+		x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, orders);
 
 		for(int i=0; i<rangeDim; ++i)
 		{
-			// update the irreducible part if necessary
-			if(bIncreased[i])
-			{
-				Polynomial polyTemp;
-				polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-
-				Interval intTemp;
-				polyTemp.intEvalNormal(intTemp, step_exp_table);
-				intDifferences[i] = intTemp;
-			}
+			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
 		}
 
 		for(int i=0; i<rangeDim; ++i)
@@ -1807,37 +1734,14 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 			tmvTemp.tms[i].remainder += intDifferences[i];
 		}
 
-		bfound = true;
-
 		for(int i=0; i<rangeDim; ++i)
 		{
 			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 			{
-				if(!bIncreaseOthers)
-				{
-					bIncrease[i] = true;
-					if(bfound)
-						bfound = false;
-				}
-				else
-				{
-					bfound = false;
-					break;
-				}
-			}
-			else
-			{
-				if(!bIncreaseOthers)
-				{
-					bIncrease[i] = false;
-				}
+				bfound = false;
+				break;
 			}
 		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			bIncreased[i] = false;
-		}
 	}
 
 	for(int i=0; i<rangeDim; ++i)
@@ -1851,7 +1755,7 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
 		for(int i=0; i<rangeDim; ++i)
 		{
@@ -1878,42 +1782,22 @@ bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	orders = newOrders;
+	stepLog->accept(step_exp_table[1].sup(), orders, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
+// adaptive orders and fixed step sizes
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-// for high-degree ODEs
-// fixed step sizes and orders
-
-bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, int & order, const int maxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
+	stepLog->begin();
+
 	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
@@ -1952,8 +1836,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -1984,8 +1867,8 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 		else
 		{
-			S.set(0,i,i);
-			invS.set(1,i,i);
+			S.set(0, i, i);
+			invS.set(1, i, i);
 		}
 	}
 
@@ -2011,18 +1894,6 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	result.tmv.linearTrans_assign(invS);
 	result.tmv.cutoff_normal(step_end_exp_table);
 
-	// compute the Taylor expansion of r(t)
-	// since r(t) = A^{-1} * (x(t) - c(t)), we have that r'(t) = A^{-1} * (x'(t) - c'(t)) = A^{-1} * (f(c(t) + A*r(t), t) - c'(t))
-
-	TaylorModelVec c = c0;
-	for(int i=1; i<=order; ++i)
-	{
-		c.Picard_no_remainder_assign(c0, ode, rangeDim+1, i);	// compute c(t)
-	}
-
-	TaylorModelVec dcdt;
-	c.derivative(dcdt, 0);	// compute dc/dt
-
 	Matrix matCoefficients_Ar0(rangeDim, rangeDim+1);
 
 	for(int i=0; i<rangeDim; ++i)
@@ -2034,56 +1905,44 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	}
 
 	TaylorModelVec Ar0(matCoefficients_Ar0);
-	TaylorModelVec Ar = Ar0;
 
-	TaylorModelVec c_plus_Ar;
-	Ar.add(c_plus_Ar, c);
+	TaylorModelVec x0;
+	Ar0.add(x0, c0);
 
-	// compute the Taylor expansion of the ODE of A*r(t)
-	TaylorModelVec Adrdt;
-	for(int i=0; i<rangeDim; ++i)
+	TaylorModelVec x;
+
+	for(int i=0; i<taylorExpansion.size(); ++i)
 	{
 		TaylorModel tmTemp;
-		ode[i].insert_no_remainder(tmTemp, c_plus_Ar, rangeDim+1, order - 1);
-		Adrdt.tms.push_back(tmTemp);
+		taylorExpansion[i].insert_no_remainder(tmTemp, x0, rangeDim+1, order);
+		x.tms.push_back(tmTemp);
 	}
 
-	Adrdt.sub_assign(dcdt);
-
-	TaylorModelVec drdt;
-	Adrdt.linearTrans(drdt, invA);
-
-	TaylorModelVec taylorExp_Ar;
-	computeTaylorExpansion(taylorExp_Ar, Adrdt, drdt, order);
-	taylorExp_Ar.add_assign(Ar0);
-
-	TaylorModelVec x = c;
-	x.add_assign(taylorExp_Ar);		// the Taylor expansion of x(t)
-
 	x.cutoff();
 
+	bool bfound = true;
+
 	vector<Interval> step_uncertainties;
+
 	for(int i=0; i<rangeDim; ++i)
 	{
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
-	TaylorModelVec x0;
-	Ar0.add(x0, c0);
-
-	bool bfound = true;
-
 	for(int i=0; i<rangeDim; ++i)
 	{
 		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, order);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, order);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
@@ -2094,11 +1953,10 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
-
 		intDifferences.push_back(intTemp);
 	}
 
-	// add the uncertainties and the cutoff intervals onto the result
+	// add the uncertainties onto the reault
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
@@ -2114,36 +1972,84 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	if(!bfound)
-	{
-		return false;
-	}
-	else
-	{
-		for(int i=0; i<rangeDim; ++i)
-			x.tms[i].remainder = tmvTemp.tms[i].remainder;
-	}
+	int newOrder = order;
 
-	bool bfinished = false;
-	for(; !bfinished;)
+	for(; !bfound;)
 	{
-		bfinished = true;
-
-		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), newOrder, tmvTemp);
+		++newOrder;
 
-		// add the uncertainties and the cutoff intervals onto the result
-		for(int i=0; i<rangeDim; ++i)
+		if(newOrder > maxOrder)
 		{
-			newRemainders[i] += step_uncertainties[i];
-			newRemainders[i] += intDifferences[i];
+			return false;
 		}
 
-		for(int i=0; i<rangeDim; ++i)
-		{
+		// increase the approximation orders by 1
+		x.Picard_no_remainder_assign(x0, ode, rangeDim+1, newOrder);
 
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
+		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		{
+			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+		}
+
+		// compute the Picard operation again
+		x.polyRangeNormal(xPolyRange, step_exp_table);
+		x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, newOrder);
+
+		// Update the irreducible part
+		for(int i=0; i<rangeDim; ++i)
+		{
+			Polynomial polyTemp;
+			polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+
+			Interval intTemp;
+			polyTemp.intEvalNormal(intTemp, step_exp_table);
+			intDifferences[i] = intTemp;
+		}
+
+		// add the uncertainties onto the result
+		for(int i=0; i<rangeDim; ++i)
+		{
+			tmvTemp.tms[i].remainder += step_uncertainties[i];
+			tmvTemp.tms[i].remainder += intDifferences[i];
+		}
+
+		bfound = true;
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+			{
+				bfound = false;
+				break;
+			}
+		}
+	}
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		x.tms[i].remainder = tmvTemp.tms[i].remainder;
+	}
+
+	bool bfinished = false;
+	for(; !bfinished;)
+	{
+		bfinished = true;
+
+		vector<Interval> newRemainders;
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
+
+		// add the uncertainties
+		for(int i=0; i<rangeDim; ++i)
+		{
+			newRemainders[i] += step_uncertainties[i];
+			newRemainders[i] += intDifferences[i];
+		}
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if(newRemainders[i].subseteq(x.tms[i].remainder))
+			{
 				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
 				{
 					bfinished = false;
@@ -2159,16 +2065,21 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
+	order = newOrder;
+	stepLog->accept(step_exp_table[1].sup(), order, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
-bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+bool Flowpipe::advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, vector<int> & orders, const vector<int> & maxOrders, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
+	stepLog->begin();
+
 	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
@@ -2207,8 +2118,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -2266,20 +2176,6 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	result.tmv.linearTrans_assign(invS);
 	result.tmv.cutoff_normal(step_end_exp_table);
 
-	// compute the Taylor expansion of r(t)
-	// since r(t) = A^{-1} * (x(t) - c(t)), we have that r'(t) = A^{-1} * (x'(t) - c'(t)) = A^{-1} * (f(c(t) + A*r(t), t) - c'(t))
-
-	TaylorModelVec c = c0;
-	for(int i=1; i<=globalMaxOrder; ++i)
-	{
-		c.Picard_no_remainder_assign(c0, ode, rangeDim+1, i);	// compute c(t)
-	}
-
-	c.nctrunc(orders);
-
-	TaylorModelVec dcdt;
-	c.derivative(dcdt, 0);	// compute dc/dt
-
 	Matrix matCoefficients_Ar0(rangeDim, rangeDim+1);
 
 	for(int i=0; i<rangeDim; ++i)
@@ -2291,30 +2187,18 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	}
 
 	TaylorModelVec Ar0(matCoefficients_Ar0);
-	TaylorModelVec Ar = Ar0;
 
-	TaylorModelVec c_plus_Ar;
-	Ar.add(c_plus_Ar, c);
+	TaylorModelVec x0;
+	Ar0.add(x0, c0);
 
-	// compute the Taylor expansion of the ODE of A*r(t)
-	TaylorModelVec Adrdt;
-	for(int i=0; i<rangeDim; ++i)
+	TaylorModelVec x;
+
+	for(int i=0; i<taylorExpansion.size(); ++i)
 	{
 		TaylorModel tmTemp;
-		ode[i].insert_no_remainder(tmTemp, c_plus_Ar, rangeDim+1, orders[i] - 1);
-		Adrdt.tms.push_back(tmTemp);
+		taylorExpansion[i].insert_no_remainder(tmTemp, x0, rangeDim+1, orders[i]);
+		x.tms.push_back(tmTemp);
 	}
-	Adrdt.sub_assign(dcdt);
-
-	TaylorModelVec drdt;
-	Adrdt.linearTrans(drdt, invA);
-
-	TaylorModelVec taylorExp_Ar;
-	computeTaylorExpansion(taylorExp_Ar, Adrdt, drdt, orders);
-	taylorExp_Ar.add_assign(Ar0);
-
-	TaylorModelVec x = c;
-	x.add_assign(taylorExp_Ar);		// the Taylor expansion of x(t)
 
 	x.cutoff();
 
@@ -2324,9 +2208,6 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
-	TaylorModelVec x0;
-	Ar0.add(x0, c0);
-
 	bool bfound = true;
 
 	for(int i=0; i<rangeDim; ++i)
@@ -2335,11 +2216,14 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, orders);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, orders);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
@@ -2359,23 +2243,147 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		tmvTemp.tms[i].remainder += intDifferences[i];
 	}
 
+	vector<bool> bIncrease;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 		{
-			bfound = false;
-			break;
+			bIncrease.push_back(true);
+			if(bfound)
+				bfound = false;
+		}
+		else
+		{
+			bIncrease.push_back(false);
 		}
 	}
 
-	if(!bfound)
+	vector<int> newOrders = orders;
+	bool bIncreaseOthers = false;
+	int numIncrease = 0;
+
+	vector<bool> bIncreased;
+	for(int i=0; i<rangeDim; ++i)
 	{
-		return false;
+		bIncreased.push_back(false);
 	}
-	else
+
+	for(; !bfound;)
 	{
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), newOrders, tmvTemp);
+		bool bChanged = false;
+
+		if(bIncreaseOthers)
+		{
+			for(int i=0; i<bIncrease.size(); ++i)
+			{
+				if(!bIncrease[i] && newOrders[i] < maxOrders[i])
+				{
+					++newOrders[i];
+					bIncreased[i] = true;
+
+					if(!bChanged)
+						bChanged = true;
+				}
+			}
+
+			bIncreaseOthers = false;
+		}
+		else
+		{
+			numIncrease = 0;
+			for(int i=0; i<bIncrease.size(); ++i)
+			{
+				if(bIncrease[i] && newOrders[i] < maxOrders[i])
+				{
+					++newOrders[i];
+					++numIncrease;
+
+					bIncreased[i] = true;
+
+					if(!bChanged)
+						bChanged = true;
+				}
+			}
+
+			if(numIncrease < newOrders.size())
+				bIncreaseOthers = true;
+		}
+
+		if(!bChanged)
+		{
+			return false;
+		}
+
+		// increase the approximation orders
+		x.Picard_no_remainder_assign(x0, ode, rangeDim+1, newOrders, bIncreased);
+
+		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		{
+			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+		}
+
+		// compute the Picard operation again
+		x.polyRangeNormal(xPolyRange, step_exp_table);
+		x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, newOrders);
+
 		for(int i=0; i<rangeDim; ++i)
-			x.tms[i].remainder = tmvTemp.tms[i].remainder;
+		{
+			// update the irreducible part if necessary
+			if(bIncreased[i])
+			{
+				Polynomial polyTemp;
+				polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+
+				Interval intTemp;
+				polyTemp.intEvalNormal(intTemp, step_exp_table);
+				intDifferences[i] = intTemp;
+			}
+		}
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			tmvTemp.tms[i].remainder += step_uncertainties[i];
+			tmvTemp.tms[i].remainder += intDifferences[i];
+		}
+
+		bfound = true;
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+			{
+				if(!bIncreaseOthers)
+				{
+					bIncrease[i] = true;
+					if(bfound)
+						bfound = false;
+				}
+				else
+				{
+					bfound = false;
+					break;
+				}
+			}
+			else
+			{
+				if(!bIncreaseOthers)
+				{
+					bIncrease[i] = false;
+				}
+			}
+		}
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			bIncreased[i] = false;
+		}
+	}
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		x.tms[i].remainder = tmvTemp.tms[i].remainder;
 	}
 
 	bool bfinished = false;
@@ -2384,7 +2392,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
 		for(int i=0; i<rangeDim; ++i)
 		{
@@ -2411,29 +2419,57 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
+	orders = newOrders;
+	stepLog->accept(step_exp_table[1].sup(), orders, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
-// adaptive step sizes and fixed orders
 
-bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
-{
-	int rangeDim = ode.size();
-	Interval intZero, intOne(1,1), intUnit(-1,1);
-	result.clear();
 
-	// evaluate the the initial set x0
-	TaylorModelVec range_of_x0;
-	tmvPre.evaluate_t(range_of_x0, step_end_exp_table);
 
-	// the center point of x0's polynomial part
-	vector<Interval> intVecCenter;
-	range_of_x0.constant(intVecCenter);
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+// for high-degree ODEs
+// fixed step sizes and orders
+
+bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+{
+	stepLog->begin();
+
+	int rangeDim = ode.size();
+	Interval intZero, intOne(1,1), intUnit(-1,1);
+	result.clear();
+
+	// evaluate the the initial set x0
+	TaylorModelVec range_of_x0;
+	tmvPre.evaluate_t(range_of_x0, step_end_exp_table);
+
+	// the center point of x0's polynomial part
+	vector<Interval> intVecCenter;
+	range_of_x0.constant(intVecCenter);
 	// the center point of the remainder of x0
 	for(int i=0; i<rangeDim; ++i)
 	{
@@ -2461,8 +2497,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -2493,8 +2528,8 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 		else
 		{
-			S.set(0, i, i);
-			invS.set(1, i, i);
+			S.set(0,i,i);
+			invS.set(1,i,i);
 		}
 	}
 
@@ -2571,20 +2606,15 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 	x.cutoff();
 
-	TaylorModelVec x0;
-	Ar0.add(x0, c0);
-
-	if(step > THRESHOLD_HIGH)		// step size is changed
-	{
-		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
-	}
-
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
+	TaylorModelVec x0;
+	Ar0.add(x0, c0);
+
 	bool bfound = true;
 
 	for(int i=0; i<rangeDim; ++i)
@@ -2593,26 +2623,29 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, order);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, order);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
-	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
+
 		intDifferences.push_back(intTemp);
 	}
 
+	// add the uncertainties and the cutoff intervals onto the result
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
@@ -2628,51 +2661,15 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	for(; !bfound;)
+	if(!bfound)
 	{
-		bfound = true;
-		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
-
-		if(newStep < miniStep)
-		{
-			return false;
-		}
-
-		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*order);
-
-		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
-		{
-			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
-		}
-
-		x.polyRangeNormal(xPolyRange, step_exp_table);
-		x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, order);
-
-		// recompute the interval evaluation of the polynomial differences
-		for(int i=0; i<rangeDim; ++i)
-		{
-			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			tmvTemp.tms[i].remainder += step_uncertainties[i];
-			tmvTemp.tms[i].remainder += intDifferences[i];
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
-			{
-				bfound = false;
-				break;
-			}
-		}
+		stepLog->reject(step_exp_table[1].sup(), order, tmvTemp);
+		return false;
 	}
-
-	for(int i=0; i<rangeDim; ++i)
+	else
 	{
-		x.tms[i].remainder = tmvTemp.tms[i].remainder;
+		for(int i=0; i<rangeDim; ++i)
+			x.tms[i].remainder = tmvTemp.tms[i].remainder;
 	}
 
 	bool bfinished = false;
@@ -2681,8 +2678,9 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
+		// add the uncertainties and the cutoff intervals onto the result
 		for(int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += step_uncertainties[i];
@@ -2691,6 +2689,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 		for(int i=0; i<rangeDim; ++i)
 		{
+
 			if(newRemainders[i].subseteq(x.tms[i].remainder))
 			{
 				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
@@ -2708,16 +2707,20 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
+	stepLog->accept(step_exp_table[1].sup(), order, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
-bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
+	stepLog->begin();
+
 	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
@@ -2756,8 +2759,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -2824,6 +2826,8 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		c.Picard_no_remainder_assign(c0, ode, rangeDim+1, i);	// compute c(t)
 	}
 
+	c.nctrunc(orders);
+
 	TaylorModelVec dcdt;
 	c.derivative(dcdt, 0);	// compute dc/dt
 
@@ -2851,7 +2855,6 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		ode[i].insert_no_remainder(tmTemp, c_plus_Ar, rangeDim+1, orders[i] - 1);
 		Adrdt.tms.push_back(tmTemp);
 	}
-
 	Adrdt.sub_assign(dcdt);
 
 	TaylorModelVec drdt;
@@ -2866,20 +2869,15 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 	x.cutoff();
 
-	TaylorModelVec x0;
-	Ar0.add(x0, c0);
-
-	if(step > THRESHOLD_HIGH)		// step size is changed
-	{
-		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
-	}
-
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
+	TaylorModelVec x0;
+	Ar0.add(x0, c0);
+
 	bool bfound = true;
 
 	for(int i=0; i<rangeDim; ++i)
@@ -2888,20 +2886,21 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, orders);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, orders);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
-	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
@@ -2923,50 +2922,15 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	for(; !bfound;)
+	if(!bfound)
 	{
-		bfound = true;
-		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
-
-		if(newStep < miniStep)
-		{
-			return false;
-		}
-
-		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*globalMaxOrder);
-
-		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
-		{
-			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
-		}
-
-		x.polyRangeNormal(xPolyRange, step_exp_table);
-		x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, orders);
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			tmvTemp.tms[i].remainder += step_uncertainties[i];
-			tmvTemp.tms[i].remainder += intDifferences[i];
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
-			{
-				bfound = false;
-				break;
-			}
-		}
+		stepLog->reject(step_exp_table[1].sup(), orders, tmvTemp);
+		return false;
 	}
-
-	for(int i=0; i<rangeDim; ++i)
+	else
 	{
-		x.tms[i].remainder = tmvTemp.tms[i].remainder;
+		for(int i=0; i<rangeDim; ++i)
+			x.tms[i].remainder = tmvTemp.tms[i].remainder;
 	}
 
 	bool bfinished = false;
@@ -2975,7 +2939,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
 		for(int i=0; i<rangeDim; ++i)
 		{
@@ -3002,18 +2966,22 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
+	stepLog->accept(step_exp_table[1].sup(), orders, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
-// adaptive orders and fixed step sizes
+// adaptive step sizes and fixed orders
 
-bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, int & order, const int maxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
+	stepLog->begin();
+
 	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
@@ -3052,8 +3020,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -3165,6 +3132,11 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	TaylorModelVec x0;
 	Ar0.add(x0, c0);
 
+	if(step > THRESHOLD_HIGH)		// step size is changed
+	{
+		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
+	}
+
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
 	{
@@ -3179,25 +3151,29 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, order);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, order);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
+	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
 		intDifferences.push_back(intTemp);
 	}
 
-	// add the uncertainties onto the reault
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
@@ -3213,48 +3189,40 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	int newOrder = order;
-
 	for(; !bfound;)
 	{
-		++newOrder;
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), order, tmvTemp);
+		bfound = true;
+		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
 
-		if(newOrder > maxOrder)
+		if(newStep < miniStep)
 		{
 			return false;
 		}
 
-		// increase the approximation orders by 1
-		x.Picard_no_remainder_assign(x0, ode, rangeDim+1, newOrder);
+		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*order);
 
-		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
 		{
-			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
 		}
 
-		// compute the Picard operation again
 		x.polyRangeNormal(xPolyRange, step_exp_table);
-		x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, newOrder);
+		x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, order);
 
-		// Update the irreducible part
+		// recompute the interval evaluation of the polynomial differences
 		for(int i=0; i<rangeDim; ++i)
 		{
-			Polynomial polyTemp;
-			polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-
-			Interval intTemp;
-			polyTemp.intEvalNormal(intTemp, step_exp_table);
-			intDifferences[i] = intTemp;
+			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
 		}
 
-		// add the uncertainties onto the result
 		for(int i=0; i<rangeDim; ++i)
 		{
 			tmvTemp.tms[i].remainder += step_uncertainties[i];
 			tmvTemp.tms[i].remainder += intDifferences[i];
 		}
 
-		bfound = true;
 		for(int i=0; i<rangeDim; ++i)
 		{
 			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
@@ -3276,9 +3244,8 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
-		// add the uncertainties
 		for(int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += step_uncertainties[i];
@@ -3304,17 +3271,20 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	order = newOrder;
+	stepLog->accept(step_exp_table[1].sup(), order, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
-bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, vector<int> & orders, const int localMaxOrder, const vector<int> & maxOrders, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
+bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
+	stepLog->begin();
+
 	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
@@ -3353,8 +3323,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -3416,13 +3385,11 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	// since r(t) = A^{-1} * (x(t) - c(t)), we have that r'(t) = A^{-1} * (x'(t) - c'(t)) = A^{-1} * (f(c(t) + A*r(t), t) - c'(t))
 
 	TaylorModelVec c = c0;
-	for(int i=1; i<=localMaxOrder; ++i)
+	for(int i=1; i<=globalMaxOrder; ++i)
 	{
 		c.Picard_no_remainder_assign(c0, ode, rangeDim+1, i);	// compute c(t)
 	}
 
-	c.nctrunc(orders);
-
 	TaylorModelVec dcdt;
 	c.derivative(dcdt, 0);	// compute dc/dt
 
@@ -3468,6 +3435,11 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	TaylorModelVec x0;
 	Ar0.add(x0, c0);
 
+	if(step > THRESHOLD_HIGH)		// step size is changed
+	{
+		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
+	}
+
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
 	{
@@ -3482,18 +3454,23 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 	}
 
 	TaylorModelVec tmvTemp;
-	vector<RangeTree *> trees;
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
 
 	vector<Interval> xPolyRange;
 	x.polyRangeNormal(xPolyRange, step_exp_table);
-	x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, orders);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, orders);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
+	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
@@ -3506,101 +3483,40 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		tmvTemp.tms[i].remainder += intDifferences[i];
 	}
 
-	vector<bool> bIncrease;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 		{
-			bIncrease.push_back(true);
-			if(bfound)
-				bfound = false;
-		}
-		else
-		{
-			bIncrease.push_back(false);
+			bfound = false;
+			break;
 		}
 	}
 
-	vector<int> newOrders = orders;
-	bool bIncreaseOthers = false;
-	int numIncrease = 0;
-
-	vector<bool> bIncreased;
-	for(int i=0; i<rangeDim; ++i)
-	{
-		bIncreased.push_back(false);
-	}
-
 	for(; !bfound;)
 	{
-		bool bChanged = false;
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), orders, tmvTemp);
+		bfound = true;
+		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
 
-		if(bIncreaseOthers)
-		{
-			for(int i=0; i<bIncrease.size(); ++i)
-			{
-				if(!bIncrease[i] && newOrders[i] < maxOrders[i])
-				{
-					++newOrders[i];
-					bIncreased[i] = true;
-
-					if(!bChanged)
-						bChanged = true;
-				}
-			}
-
-			bIncreaseOthers = false;
-		}
-		else
-		{
-			numIncrease = 0;
-			for(int i=0; i<bIncrease.size(); ++i)
-			{
-				if(bIncrease[i] && newOrders[i] < maxOrders[i])
-				{
-					++newOrders[i];
-					++numIncrease;
-
-					bIncreased[i] = true;
-
-					if(!bChanged)
-						bChanged = true;
-				}
-			}
-
-			if(numIncrease < newOrders.size())
-				bIncreaseOthers = true;
-		}
-
-		if(!bChanged)
+		if(newStep < miniStep)
 		{
 			return false;
 		}
 
-		// increase the approximation orders
-		x.Picard_no_remainder_assign(x0, ode, rangeDim+1, newOrders, bIncreased);
+		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*globalMaxOrder);
 
-		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
 		{
-			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
 		}
 
-		// compute the Picard operation again
 		x.polyRangeNormal(xPolyRange, step_exp_table);
-		x.Picard_ctrunc_normal(tmvTemp, trees, x0, xPolyRange, ode, step_exp_table, rangeDim+1, newOrders);
+		x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, orders);
 
 		for(int i=0; i<rangeDim; ++i)
 		{
-			// update the irreducible part if necessary
-			if(bIncreased[i])
-			{
-				Polynomial polyTemp;
-				polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-
-				Interval intTemp;
-				polyTemp.intEvalNormal(intTemp, step_exp_table);
-				intDifferences[i] = intTemp;
-			}
+			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
 		}
 
 		for(int i=0; i<rangeDim; ++i)
@@ -3609,37 +3525,14 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 			tmvTemp.tms[i].remainder += intDifferences[i];
 		}
 
-		bfound = true;
-
 		for(int i=0; i<rangeDim; ++i)
 		{
 			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 			{
-				if(!bIncreaseOthers)
-				{
-					bIncrease[i] = true;
-					if(bfound)
-						bfound = false;
-				}
-				else
-				{
-					bfound = false;
-					break;
-				}
-			}
-			else
-			{
-				if(!bIncreaseOthers)
-				{
-					bIncrease[i] = false;
-				}
+				bfound = false;
+				break;
 			}
 		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			bIncreased[i] = false;
-		}
 	}
 
 	for(int i=0; i<rangeDim; ++i)
@@ -3653,7 +3546,7 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_only_remainder(newRemainders, trees, x0, ode, step_exp_table[1]);
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
 		for(int i=0; i<rangeDim; ++i)
 		{
@@ -3680,35 +3573,23 @@ bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> &
 		}
 	}
 
-	orders = newOrders;
+	stepLog->accept(step_exp_table[1].sup(), orders, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
-	trees.clear();
+	ranges.clear();
 	return true;
 }
 
+// adaptive orders and fixed step sizes
 
-
-
-
-
-
-
-
-
-
-
-
-
-
-// integration scheme for non-polynomial ODEs (using Taylor approximations)
-// fixed step sizes and orders
-
-bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
+bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, int & order, const int maxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
-	int rangeDim = strOde.size();
+	stepLog->begin();
+
+	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
 
@@ -3719,7 +3600,6 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	// the center point of x0's polynomial part
 	vector<Interval> intVecCenter;
 	range_of_x0.constant(intVecCenter);
-
 	// the center point of the remainder of x0
 	for(int i=0; i<rangeDim; ++i)
 	{
@@ -3747,8 +3627,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -3812,7 +3691,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec c = c0;
 	for(int i=1; i<=order; ++i)
 	{
-		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, strOde, i, uncertainty_centers);	// compute c(t)
+		c.Picard_no_remainder_assign(c0, ode, rangeDim+1, i);	// compute c(t)
 	}
 
 	TaylorModelVec dcdt;
@@ -3835,22 +3714,11 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	Ar.add(c_plus_Ar, c);
 
 	// compute the Taylor expansion of the ODE of A*r(t)
-
-	parseSetting.clear();
-	parseSetting.order = order - 1;
-	parseSetting.flowpipe = c_plus_Ar;
-
-	string prefix(str_prefix_taylor_polynomial);
-	string suffix(str_suffix);
-
 	TaylorModelVec Adrdt;
 	for(int i=0; i<rangeDim; ++i)
 	{
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-
-		parseODE();		// call the parser
-
-		TaylorModel tmTemp(parseResult.expansion, intZero);
+		TaylorModel tmTemp;
+		ode[i].insert_no_remainder(tmTemp, c_plus_Ar, rangeDim+1, order - 1);
 		Adrdt.tms.push_back(tmTemp);
 	}
 
@@ -3871,21 +3739,28 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec x0;
 	Ar0.add(x0, c0);
 
-	bool bfound = true;
-
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
+	bool bfound = true;
+
 	for(int i=0; i<rangeDim; ++i)
 	{
-		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
+		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
 	}
 
 	TaylorModelVec tmvTemp;
-	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, order, uncertainty_centers);
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
+
+	vector<Interval> xPolyRange;
+	x.polyRangeNormal(xPolyRange, step_exp_table);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, order);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
@@ -3896,11 +3771,10 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
-
 		intDifferences.push_back(intTemp);
 	}
 
-	// add the uncertainties and the rounded intervals onto the result
+	// add the uncertainties onto the reault
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
@@ -3916,14 +3790,63 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
-	if(!bfound)
+	int newOrder = order;
+
+	for(; !bfound;)
 	{
-		return false;
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), newOrder, tmvTemp);
+		++newOrder;
+
+		if(newOrder > maxOrder)
+		{
+			return false;
+		}
+
+		// increase the approximation orders by 1
+		x.Picard_no_remainder_assign(x0, ode, rangeDim+1, newOrder);
+
+		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		{
+			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+		}
+
+		// compute the Picard operation again
+		x.polyRangeNormal(xPolyRange, step_exp_table);
+		x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, newOrder);
+
+		// Update the irreducible part
+		for(int i=0; i<rangeDim; ++i)
+		{
+			Polynomial polyTemp;
+			polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+
+			Interval intTemp;
+			polyTemp.intEvalNormal(intTemp, step_exp_table);
+			intDifferences[i] = intTemp;
+		}
+
+		// add the uncertainties onto the result
+		for(int i=0; i<rangeDim; ++i)
+		{
+			tmvTemp.tms[i].remainder += step_uncertainties[i];
+			tmvTemp.tms[i].remainder += intDifferences[i];
+		}
+
+		bfound = true;
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+			{
+				bfound = false;
+				break;
+			}
+		}
 	}
-	else
+
+	for(int i=0; i<rangeDim; ++i)
 	{
-		for(int i=0; i<rangeDim; ++i)
-			x.tms[i].remainder = tmvTemp.tms[i].remainder;
+		x.tms[i].remainder = tmvTemp.tms[i].remainder;
 	}
 
 	bool bfinished = false;
@@ -3932,14 +3855,9 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, x0, strOde, step_exp_table[1], order);
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			newRemainders.push_back(tmvTemp.tms[i].remainder);
-		}
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
 
-		// add the uncertainties and the rounded intervals onto the result
+		// add the uncertainties
 		for(int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += step_uncertainties[i];
@@ -3965,16 +3883,22 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
+	order = newOrder;
+	stepLog->accept(step_exp_table[1].sup(), order, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
+	ranges.clear();
 	return true;
 }
 
-bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
+bool Flowpipe::advance_high_degree(Flowpipe & result, const vector<HornerForm> & ode, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, vector<int> & orders, const int localMaxOrder, const vector<int> & maxOrders, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const
 {
-	int rangeDim = strOde.size();
+	stepLog->begin();
+
+	int rangeDim = ode.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
 
@@ -3985,7 +3909,6 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	// the center point of x0's polynomial part
 	vector<Interval> intVecCenter;
 	range_of_x0.constant(intVecCenter);
-
 	// the center point of the remainder of x0
 	for(int i=0; i<rangeDim; ++i)
 	{
@@ -4013,8 +3936,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -4076,11 +3998,13 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	// since r(t) = A^{-1} * (x(t) - c(t)), we have that r'(t) = A^{-1} * (x'(t) - c'(t)) = A^{-1} * (f(c(t) + A*r(t), t) - c'(t))
 
 	TaylorModelVec c = c0;
-	for(int i=1; i<=globalMaxOrder; ++i)
+	for(int i=1; i<=localMaxOrder; ++i)
 	{
-		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, strOde, i, uncertainty_centers);	// compute c(t)
+		c.Picard_no_remainder_assign(c0, ode, rangeDim+1, i);	// compute c(t)
 	}
 
+	c.nctrunc(orders);
+
 	TaylorModelVec dcdt;
 	c.derivative(dcdt, 0);	// compute dc/dt
 
@@ -4101,22 +4025,11 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	Ar.add(c_plus_Ar, c);
 
 	// compute the Taylor expansion of the ODE of A*r(t)
-
-	parseSetting.clear();
-	parseSetting.flowpipe = c_plus_Ar;
-
-	string prefix(str_prefix_taylor_polynomial);
-	string suffix(str_suffix);
-
 	TaylorModelVec Adrdt;
 	for(int i=0; i<rangeDim; ++i)
 	{
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-		parseSetting.order = orders[i] - 1;
-
-		parseODE();		// call the parser
-
-		TaylorModel tmTemp(parseResult.expansion, intZero);
+		TaylorModel tmTemp;
+		ode[i].insert_no_remainder(tmTemp, c_plus_Ar, rangeDim+1, orders[i] - 1);
 		Adrdt.tms.push_back(tmTemp);
 	}
 
@@ -4137,21 +4050,28 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec x0;
 	Ar0.add(x0, c0);
 
-	bool bfound = true;
-
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
+	bool bfound = true;
+
 	for(int i=0; i<rangeDim; ++i)
 	{
-		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
+		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
 	}
 
 	TaylorModelVec tmvTemp;
-	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, orders, uncertainty_centers);
+	vector<vector<Interval> > ranges;
+
+	vector<HornerTape> odeTapes;
+	toHornerTapes(odeTapes, ode);
+
+	vector<Interval> xPolyRange;
+	x.polyRangeNormal(xPolyRange, step_exp_table);
+	x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, orders);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
@@ -4162,51 +4082,167 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
-
 		intDifferences.push_back(intTemp);
 	}
 
-	// add the uncertainties and the rounded intervals onto the result
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
 		tmvTemp.tms[i].remainder += intDifferences[i];
 	}
 
+	vector<bool> bIncrease;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 		{
-			bfound = false;
-			break;
+			bIncrease.push_back(true);
+			if(bfound)
+				bfound = false;
+		}
+		else
+		{
+			bIncrease.push_back(false);
 		}
 	}
 
-	if(!bfound)
-	{
-		return false;
-	}
-	else
+	vector<int> newOrders = orders;
+	bool bIncreaseOthers = false;
+	int numIncrease = 0;
+
+	vector<bool> bIncreased;
+	for(int i=0; i<rangeDim; ++i)
 	{
-		for(int i=0; i<rangeDim; ++i)
-			x.tms[i].remainder = tmvTemp.tms[i].remainder;
+		bIncreased.push_back(false);
 	}
 
-	bool bfinished = false;
-	for(; !bfinished;)
+	for(; !bfound;)
 	{
-		bfinished = true;
-
-		vector<Interval> newRemainders;
-		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, x0, strOde, step_exp_table[1], orders);
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), newOrders, tmvTemp);
+		bool bChanged = false;
 
-		for(int i=0; i<rangeDim; ++i)
+		if(bIncreaseOthers)
 		{
-			newRemainders.push_back(tmvTemp.tms[i].remainder);
-		}
-
-		// add the uncertainties and the rounded intervals onto the result
-		for(int i=0; i<rangeDim; ++i)
+			for(int i=0; i<bIncrease.size(); ++i)
+			{
+				if(!bIncrease[i] && newOrders[i] < maxOrders[i])
+				{
+					++newOrders[i];
+					bIncreased[i] = true;
+
+					if(!bChanged)
+						bChanged = true;
+				}
+			}
+
+			bIncreaseOthers = false;
+		}
+		else
+		{
+			numIncrease = 0;
+			for(int i=0; i<bIncrease.size(); ++i)
+			{
+				if(bIncrease[i] && newOrders[i] < maxOrders[i])
+				{
+					++newOrders[i];
+					++numIncrease;
+
+					bIncreased[i] = true;
+
+					if(!bChanged)
+						bChanged = true;
+				}
+			}
+
+			if(numIncrease < newOrders.size())
+				bIncreaseOthers = true;
+		}
+
+		if(!bChanged)
+		{
+			return false;
+		}
+
+		// increase the approximation orders
+		x.Picard_no_remainder_assign(x0, ode, rangeDim+1, newOrders, bIncreased);
+
+		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		{
+			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+		}
+
+		// compute the Picard operation again
+		x.polyRangeNormal(xPolyRange, step_exp_table);
+		x.Picard_ctrunc_normal(tmvTemp, ranges, x0, xPolyRange, odeTapes, step_exp_table, rangeDim+1, newOrders);
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			// update the irreducible part if necessary
+			if(bIncreased[i])
+			{
+				Polynomial polyTemp;
+				polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+
+				Interval intTemp;
+				polyTemp.intEvalNormal(intTemp, step_exp_table);
+				intDifferences[i] = intTemp;
+			}
+		}
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			tmvTemp.tms[i].remainder += step_uncertainties[i];
+			tmvTemp.tms[i].remainder += intDifferences[i];
+		}
+
+		bfound = true;
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+			{
+				if(!bIncreaseOthers)
+				{
+					bIncrease[i] = true;
+					if(bfound)
+						bfound = false;
+				}
+				else
+				{
+					bfound = false;
+					break;
+				}
+			}
+			else
+			{
+				if(!bIncreaseOthers)
+				{
+					bIncrease[i] = false;
+				}
+			}
+		}
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			bIncreased[i] = false;
+		}
+	}
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		x.tms[i].remainder = tmvTemp.tms[i].remainder;
+	}
+
+	bool bfinished = false;
+	for(; !bfinished;)
+	{
+		bfinished = true;
+
+		vector<Interval> newRemainders;
+		x.Picard_only_remainder(newRemainders, ranges, x0, odeTapes, step_exp_table[1]);
+
+		for(int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += step_uncertainties[i];
 			newRemainders[i] += intDifferences[i];
@@ -4231,18 +4267,39 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
+	orders = newOrders;
+	stepLog->accept(step_exp_table[1].sup(), orders, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
 
+	ranges.clear();
 	return true;
 }
 
 
-// adaptive step sizes and fixed orders
-bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
+
+
+
+
+
+
+
+
+
+
+
+
+
+// integration scheme for non-polynomial ODEs (using Taylor approximations)
+// fixed step sizes and orders
+
+bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
 {
-	int rangeDim = strOde.size();
+	stepLog->begin();
+
+	int rangeDim = exprOde.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
 
@@ -4281,8 +4338,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -4346,7 +4402,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec c = c0;
 	for(int i=1; i<=order; ++i)
 	{
-		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, strOde, i, uncertainty_centers);	// compute c(t)
+		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, exprOde, i, uncertainty_centers);	// compute c(t)
 	}
 
 	TaylorModelVec dcdt;
@@ -4370,21 +4426,13 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	// compute the Taylor expansion of the ODE of A*r(t)
 
-	parseSetting.clear();
-	parseSetting.flowpipe = c_plus_Ar;
-	parseSetting.order = order - 1;
-
-	string prefix(str_prefix_taylor_polynomial);
-	string suffix(str_suffix);
-
 	TaylorModelVec Adrdt;
 	for(int i=0; i<rangeDim; ++i)
 	{
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-
-		parseODE();		// call the parser
+		Polynomial polyTemp;
+		exprOde[i].taylor_polynomial(polyTemp, c_plus_Ar, rangeDim+1, order - 1);
 
-		TaylorModel tmTemp(parseResult.expansion, intZero);
+		TaylorModel tmTemp(polyTemp, intZero);
 		Adrdt.tms.push_back(tmTemp);
 	}
 
@@ -4405,10 +4453,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec x0;
 	Ar0.add(x0, c0);
 
-	if(step > THRESHOLD_HIGH)		// step size is changed
-	{
-		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
-	}
+	bool bfound = true;
 
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
@@ -4416,30 +4461,29 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
-	bool bfound = true;
-
 	for(int i=0; i<rangeDim; ++i)
 	{
-		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
+		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
 	}
 
 	TaylorModelVec tmvTemp;
-	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, order, uncertainty_centers);
+	list<Interval> ranges;
+	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, order, uncertainty_centers);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
-	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
+
 		intDifferences.push_back(intTemp);
 	}
 
+	// add the uncertainties and the rounded intervals onto the result
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
@@ -4455,50 +4499,15 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
-	for(; !bfound;)
+	if(!bfound)
 	{
-		bfound = true;
-		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
-
-		if(newStep < miniStep)
-		{
-			return false;
-		}
-
-		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*order);
-
-		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
-		{
-			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
-		}
-
-		x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, order, uncertainty_centers);
-
-		// recompute the interval evaluation of the polynomial differences
-		for(int i=0; i<rangeDim; ++i)
-		{
-			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			tmvTemp.tms[i].remainder += step_uncertainties[i];
-			tmvTemp.tms[i].remainder += intDifferences[i];
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
-			{
-				bfound = false;
-				break;
-			}
-		}
+		stepLog->reject(step_exp_table[1].sup(), order, tmvTemp);
+		return false;
 	}
-
-	for(int i=0; i<rangeDim; ++i)
+	else
 	{
-		x.tms[i].remainder = tmvTemp.tms[i].remainder;
+		for(int i=0; i<rangeDim; ++i)
+			x.tms[i].remainder = tmvTemp.tms[i].remainder;
 	}
 
 	bool bfinished = false;
@@ -4507,8 +4516,14 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, x0, strOde, step_exp_table[1], order);
+		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, ranges, x0, exprOde, step_exp_table[1], order);
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			newRemainders.push_back(tmvTemp.tms[i].remainder);
+		}
 
+		// add the uncertainties and the rounded intervals onto the result
 		for(int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += step_uncertainties[i];
@@ -4534,6 +4549,8 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
+	stepLog->accept(step_exp_table[1].sup(), order, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
@@ -4541,9 +4558,11 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	return true;
 }
 
-bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
+bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
 {
-	int rangeDim = strOde.size();
+	stepLog->begin();
+
+	int rangeDim = exprOde.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
 
@@ -4582,8 +4601,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -4647,7 +4665,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec c = c0;
 	for(int i=1; i<=globalMaxOrder; ++i)
 	{
-		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, strOde, i, uncertainty_centers);	// compute c(t)
+		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, exprOde, i, uncertainty_centers);	// compute c(t)
 	}
 
 	TaylorModelVec dcdt;
@@ -4671,21 +4689,13 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	// compute the Taylor expansion of the ODE of A*r(t)
 
-	parseSetting.clear();
-	parseSetting.flowpipe = c_plus_Ar;
-
-	string prefix(str_prefix_taylor_polynomial);
-	string suffix(str_suffix);
-
 	TaylorModelVec Adrdt;
 	for(int i=0; i<rangeDim; ++i)
 	{
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-		parseSetting.order = orders[i] - 1;
-
-		parseODE();		// call the parser
+		Polynomial polyTemp;
+		exprOde[i].taylor_polynomial(polyTemp, c_plus_Ar, rangeDim+1, orders[i] - 1);
 
-		TaylorModel tmTemp(parseResult.expansion, intZero);
+		TaylorModel tmTemp(polyTemp, intZero);
 		Adrdt.tms.push_back(tmTemp);
 	}
 
@@ -4706,10 +4716,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec x0;
 	Ar0.add(x0, c0);
 
-	if(step > THRESHOLD_HIGH)		// step size is changed
-	{
-		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
-	}
+	bool bfound = true;
 
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
@@ -4717,30 +4724,29 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
-	bool bfound = true;
-
 	for(int i=0; i<rangeDim; ++i)
 	{
-		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
+		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
 	}
 
 	TaylorModelVec tmvTemp;
-	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, orders, uncertainty_centers);
+	list<Interval> ranges;
+	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, orders, uncertainty_centers);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
-	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
+
 		intDifferences.push_back(intTemp);
 	}
 
+	// add the uncertainties and the rounded intervals onto the result
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
@@ -4756,64 +4762,35 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
-	for(; !bfound;)
+	if(!bfound)
 	{
-		bfound = true;
-		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
+		stepLog->reject(step_exp_table[1].sup(), orders, tmvTemp);
+		return false;
+	}
+	else
+	{
+		for(int i=0; i<rangeDim; ++i)
+			x.tms[i].remainder = tmvTemp.tms[i].remainder;
+	}
 
-		if(newStep < miniStep)
-		{
-			return false;
-		}
+	bool bfinished = false;
+	for(; !bfinished;)
+	{
+		bfinished = true;
 
-		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*globalMaxOrder);
+		vector<Interval> newRemainders;
+		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, ranges, x0, exprOde, step_exp_table[1], orders);
 
-		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
+		for(int i=0; i<rangeDim; ++i)
 		{
-			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
+			newRemainders.push_back(tmvTemp.tms[i].remainder);
 		}
 
-		x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, orders, uncertainty_centers);
-
-		// recompute the interval evaluation of the polynomial differences
+		// add the uncertainties and the rounded intervals onto the result
 		for(int i=0; i<rangeDim; ++i)
 		{
-			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			tmvTemp.tms[i].remainder += step_uncertainties[i];
-			tmvTemp.tms[i].remainder += intDifferences[i];
-		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
-			{
-				bfound = false;
-				break;
-			}
-		}
-	}
-
-	for(int i=0; i<rangeDim; ++i)
-	{
-		x.tms[i].remainder = tmvTemp.tms[i].remainder;
-	}
-
-	bool bfinished = false;
-	for(; !bfinished;)
-	{
-		bfinished = true;
-
-		vector<Interval> newRemainders;
-		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, x0, strOde, step_exp_table[1], orders);
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			newRemainders[i] += step_uncertainties[i];
-			newRemainders[i] += intDifferences[i];
+			newRemainders[i] += step_uncertainties[i];
+			newRemainders[i] += intDifferences[i];
 		}
 
 		for(int i=0; i<rangeDim; ++i)
@@ -4835,6 +4812,8 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
+	stepLog->accept(step_exp_table[1].sup(), orders, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
@@ -4843,10 +4822,12 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 }
 
 
-// adaptive orders and fixed step sizes
-bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, int & order, const int maxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
+// adaptive step sizes and fixed orders
+bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
 {
-	int rangeDim = strOde.size();
+	stepLog->begin();
+
+	int rangeDim = exprOde.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
 
@@ -4885,8 +4866,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -4950,7 +4930,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec c = c0;
 	for(int i=1; i<=order; ++i)
 	{
-		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, strOde, i, uncertainty_centers);	// compute c(t)
+		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, exprOde, i, uncertainty_centers);	// compute c(t)
 	}
 
 	TaylorModelVec dcdt;
@@ -4974,21 +4954,13 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	// compute the Taylor expansion of the ODE of A*r(t)
 
-	parseSetting.clear();
-	parseSetting.order = order - 1;
-	parseSetting.flowpipe = c_plus_Ar;
-
-	string prefix(str_prefix_taylor_polynomial);
-	string suffix(str_suffix);
-
 	TaylorModelVec Adrdt;
 	for(int i=0; i<rangeDim; ++i)
 	{
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-
-		parseODE();		// call the parser
+		Polynomial polyTemp;
+		exprOde[i].taylor_polynomial(polyTemp, c_plus_Ar, rangeDim+1, order - 1);
 
-		TaylorModel tmTemp(parseResult.expansion, intZero);
+		TaylorModel tmTemp(polyTemp, intZero);
 		Adrdt.tms.push_back(tmTemp);
 	}
 
@@ -5009,7 +4981,10 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec x0;
 	Ar0.add(x0, c0);
 
-	bool bfound = true;
+	if(step > THRESHOLD_HIGH)		// step size is changed
+	{
+		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
+	}
 
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
@@ -5017,28 +4992,31 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
+	bool bfound = true;
+
 	for(int i=0; i<rangeDim; ++i)
 	{
-		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
+		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
 	}
 
 	TaylorModelVec tmvTemp;
-	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, order, uncertainty_centers);
+	list<Interval> ranges;
+	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, order, uncertainty_centers);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
+	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
-
 		intDifferences.push_back(intTemp);
 	}
 
-	// add the uncertainties and the rounded intervals onto the result
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
@@ -5054,47 +5032,39 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
-	int newOrder = order;
-
 	for(; !bfound;)
 	{
-		++newOrder;
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), order, tmvTemp);
+		bfound = true;
+		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
 
-		if(newOrder > maxOrder)
+		if(newStep < miniStep)
 		{
 			return false;
 		}
 
-		// increase the approximation orders by 1
-		x.Picard_non_polynomial_taylor_no_remainder_assign(x0, strOde, newOrder, uncertainty_centers);
+		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*order);
 
-		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
 		{
-			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
 		}
 
-		// compute the Picard operation again
-		x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, newOrder, uncertainty_centers);
+		x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, order, uncertainty_centers);
 
-		// Update the irreducible part
+		// recompute the interval evaluation of the polynomial differences
 		for(int i=0; i<rangeDim; ++i)
 		{
-			Polynomial polyTemp;
-			polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-
-			Interval intTemp;
-			polyTemp.intEvalNormal(intTemp, step_exp_table);
-			intDifferences[i] = intTemp;
+			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
 		}
 
-		// add the uncertainties onto the result
 		for(int i=0; i<rangeDim; ++i)
 		{
 			tmvTemp.tms[i].remainder += step_uncertainties[i];
 			tmvTemp.tms[i].remainder += intDifferences[i];
 		}
 
-		bfound = true;
 		for(int i=0; i<rangeDim; ++i)
 		{
 			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
@@ -5116,9 +5086,8 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, x0, strOde, step_exp_table[1], newOrder);
+		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, ranges, x0, exprOde, step_exp_table[1], order);
 
-		// add the uncertainties
 		for(int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += step_uncertainties[i];
@@ -5144,7 +5113,8 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
-	order = newOrder;
+	stepLog->accept(step_exp_table[1].sup(), order, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
@@ -5152,9 +5122,11 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	return true;
 }
 
-bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, vector<int> & orders, const int localMaxOrder, const vector<int> & maxOrders, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
+bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
 {
-	int rangeDim = strOde.size();
+	stepLog->begin();
+
+	int rangeDim = exprOde.size();
 	Interval intZero, intOne(1,1), intUnit(-1,1);
 	result.clear();
 
@@ -5193,8 +5165,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	case QR_PRE:
 	{
-		preconditionQR(A, range_of_x0, rangeDim, rangeDim+1);
-		A.transpose(invA);
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
 		range_of_x0.linearTrans(range_of_r0, invA);
 		break;
 	}
@@ -5256,9 +5227,9 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	// since r(t) = A^{-1} * (x(t) - c(t)), we have that r'(t) = A^{-1} * (x'(t) - c'(t)) = A^{-1} * (f(c(t) + A*r(t), t) - c'(t))
 
 	TaylorModelVec c = c0;
-	for(int i=1; i<=localMaxOrder; ++i)
+	for(int i=1; i<=globalMaxOrder; ++i)
 	{
-		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, strOde, i, uncertainty_centers);	// compute c(t)
+		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, exprOde, i, uncertainty_centers);	// compute c(t)
 	}
 
 	TaylorModelVec dcdt;
@@ -5282,21 +5253,13 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 
 	// compute the Taylor expansion of the ODE of A*r(t)
 
-	parseSetting.clear();
-	parseSetting.flowpipe = c_plus_Ar;
-
-	string prefix(str_prefix_taylor_polynomial);
-	string suffix(str_suffix);
-
 	TaylorModelVec Adrdt;
 	for(int i=0; i<rangeDim; ++i)
 	{
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-		parseSetting.order = orders[i] - 1;
-
-		parseODE();		// call the parser
+		Polynomial polyTemp;
+		exprOde[i].taylor_polynomial(polyTemp, c_plus_Ar, rangeDim+1, orders[i] - 1);
 
-		TaylorModel tmTemp(parseResult.expansion, intZero);
+		TaylorModel tmTemp(polyTemp, intZero);
 		Adrdt.tms.push_back(tmTemp);
 	}
 
@@ -5317,7 +5280,10 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	TaylorModelVec x0;
 	Ar0.add(x0, c0);
 
-	bool bfound = true;
+	if(step > THRESHOLD_HIGH)		// step size is changed
+	{
+		construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
+	}
 
 	vector<Interval> step_uncertainties;
 	for(int i=0; i<rangeDim; ++i)
@@ -5325,128 +5291,71 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
 	}
 
+	bool bfound = true;
+
 	for(int i=0; i<rangeDim; ++i)
 	{
-		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
+		x.tms[i].remainder = estimation[i] + step_uncertainties[i];		// apply the remainder estimation
 	}
 
 	TaylorModelVec tmvTemp;
-	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, orders, uncertainty_centers);
+	list<Interval> ranges;
+	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, orders, uncertainty_centers);
 
 	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
 	vector<Interval> intDifferences;
+	vector<Polynomial> polyDifferences;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		Polynomial polyTemp;
 		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+		polyDifferences.push_back(polyTemp);
 
 		Interval intTemp;
 		polyTemp.intEvalNormal(intTemp, step_exp_table);
-
 		intDifferences.push_back(intTemp);
 	}
 
-	// add the uncertainties and the rounded intervals onto the result
 	for(int i=0; i<rangeDim; ++i)
 	{
 		tmvTemp.tms[i].remainder += step_uncertainties[i];
 		tmvTemp.tms[i].remainder += intDifferences[i];
 	}
 
-	vector<bool> bIncrease;
 	for(int i=0; i<rangeDim; ++i)
 	{
 		if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 		{
-			bIncrease.push_back(true);
-			if(bfound)
-				bfound = false;
-		}
-		else
-		{
-			bIncrease.push_back(false);
+			bfound = false;
+			break;
 		}
 	}
 
-	vector<int> newOrders = orders;
-	bool bIncreaseOthers = false;
-	int numIncrease = 0;
-
-	vector<bool> bIncreased;
-	for(int i=0; i<rangeDim; ++i)
-	{
-		bIncreased.push_back(false);
-	}
-
 	for(; !bfound;)
 	{
-		bool bChanged = false;
-
-		if(bIncreaseOthers)
-		{
-			for(int i=0; i<bIncrease.size(); ++i)
-			{
-				if(!bIncrease[i] && newOrders[i] < maxOrders[i])
-				{
-					++newOrders[i];
-					bIncreased[i] = true;
-
-					if(!bChanged)
-						bChanged = true;
-				}
-			}
-
-			bIncreaseOthers = false;
-		}
-		else
-		{
-			numIncrease = 0;
-			for(int i=0; i<bIncrease.size(); ++i)
-			{
-				if(bIncrease[i] && newOrders[i] < maxOrders[i])
-				{
-					++newOrders[i];
-					++numIncrease;
-
-					bIncreased[i] = true;
-
-					if(!bChanged)
-						bChanged = true;
-				}
-			}
-
-			if(numIncrease < newOrders.size())
-				bIncreaseOthers = true;
-		}
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), orders, tmvTemp);
+		bfound = true;
+		double newStep = step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
 
-		if(!bChanged)
+		if(newStep < miniStep)
 		{
 			return false;
 		}
 
-		// increase the approximation orders
-		x.Picard_non_polynomial_taylor_no_remainder_assign(x0, strOde, newOrders, bIncreased, uncertainty_centers);
+		construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*globalMaxOrder);
 
-		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		for(int i=0; i<rangeDim; ++i)	// update the uncertainties in the step
 		{
-			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+			step_uncertainties[i] = step_exp_table[1] * uncertainties[i];
 		}
 
-		// compute the Picard operation again
-		x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, x0, strOde, step_exp_table, newOrders, uncertainty_centers);
+		x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, orders, uncertainty_centers);
 
+		// recompute the interval evaluation of the polynomial differences
 		for(int i=0; i<rangeDim; ++i)
 		{
-			// update the irreducible part if necessary
-			if(bIncreased[i])
-			{
-				Polynomial polyTemp;
-				polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
-
-				Interval intTemp;
-				polyTemp.intEvalNormal(intTemp, step_exp_table);
-				intDifferences[i] = intTemp;
-			}
+			polyDifferences[i].intEvalNormal(intDifferences[i], step_exp_table);
 		}
 
 		for(int i=0; i<rangeDim; ++i)
@@ -5455,37 +5364,14 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 			tmvTemp.tms[i].remainder += intDifferences[i];
 		}
 
-		bfound = true;
-
 		for(int i=0; i<rangeDim; ++i)
 		{
 			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 			{
-				if(!bIncreaseOthers)
-				{
-					bIncrease[i] = true;
-					if(bfound)
-						bfound = false;
-				}
-				else
-				{
-					bfound = false;
-					break;
-				}
-			}
-			else
-			{
-				if(!bIncreaseOthers)
-				{
-					bIncrease[i] = false;
-				}
+				bfound = false;
+				break;
 			}
 		}
-
-		for(int i=0; i<rangeDim; ++i)
-		{
-			bIncreased[i] = false;
-		}
 	}
 
 	for(int i=0; i<rangeDim; ++i)
@@ -5499,7 +5385,7 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		bfinished = true;
 
 		vector<Interval> newRemainders;
-		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, x0, strOde, step_exp_table[1], newOrders);
+		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, ranges, x0, exprOde, step_exp_table[1], orders);
 
 		for(int i=0; i<rangeDim; ++i)
 		{
@@ -5526,7 +5412,8 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 		}
 	}
 
-	orders = newOrders;
+	stepLog->accept(step_exp_table[1].sup(), orders, x);
+
 	result.tmvPre = x;
 	result.domain = domain;
 	result.domain[0] = step_exp_table[1];
@@ -5534,16 +5421,704 @@ bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<str
 	return true;
 }
 
-Flowpipe & Flowpipe::operator = (const Flowpipe & flowpipe)
+
+// adaptive orders and fixed step sizes
+bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, int & order, const int maxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
 {
-	if(this == &flowpipe)
-		return *this;
+	stepLog->begin();
 
-	tmvPre = flowpipe.tmvPre;
-	tmv = flowpipe.tmv;
-	domain = flowpipe.domain;
-	return *this;
-}
+	int rangeDim = exprOde.size();
+	Interval intZero, intOne(1,1), intUnit(-1,1);
+	result.clear();
+
+	// evaluate the the initial set x0
+	TaylorModelVec range_of_x0;
+	tmvPre.evaluate_t(range_of_x0, step_end_exp_table);
+
+	// the center point of x0's polynomial part
+	vector<Interval> intVecCenter;
+	range_of_x0.constant(intVecCenter);
+
+	// the center point of the remainder of x0
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Interval M;
+		range_of_x0.tms[i].remainder.remove_midpoint(M);
+		intVecCenter[i] += M;
+	}
+
+	TaylorModelVec c0(intVecCenter, rangeDim+1);
+
+	// introduce a new variable r0 such that x0 = c0 + A*r0, then r0 is origin-centered
+	range_of_x0.rmConstant();
+
+	// compute the preconditioning matrix
+	Matrix A(rangeDim,rangeDim), invA(rangeDim,rangeDim);
+	TaylorModelVec range_of_r0;
+
+	switch(precondition)
+	{
+	case ID_PRE:
+	{
+		range_of_r0 = range_of_x0;
+		break;
+	}
+
+	case QR_PRE:
+	{
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
+		range_of_x0.linearTrans(range_of_r0, invA);
+		break;
+	}
+	}
+
+	vector<Interval> tmvPolyRange;
+	tmv.polyRangeNormal(tmvPolyRange, step_end_exp_table);
+	range_of_r0.insert_ctrunc_normal(result.tmv, tmv, tmvPolyRange, step_end_exp_table, domain.size(), order);
+
+	// we normalized the interval bound of r0
+	vector<Interval> boundOfr0;
+	result.tmv.intEvalNormal(boundOfr0, step_end_exp_table);
+
+	// Compute the scaling matrix S.
+	Matrix S(rangeDim, rangeDim);
+	Matrix invS(rangeDim, rangeDim);
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Interval intSup;
+		boundOfr0[i].mag(intSup);
+
+		if(!intSup.subseteq(intZero))
+		{
+			double dSup = intSup.sup();
+			S.set(dSup, i, i);
+			invS.set(1/dSup, i, i);
+			boundOfr0[i] = intUnit;
+		}
+		else
+		{
+			S.set(0, i, i);
+			invS.set(1, i, i);
+		}
+	}
+
+	// apply the scaling matrix S, i.e., A S S^(-1) A^(-1), then the interval bound of r0 is normalized to [-1,1]^n
+
+	switch(precondition)
+	{
+	case ID_PRE:
+	{
+		A = S;
+		invA = invS;
+		break;
+	}
+
+	case QR_PRE:
+	{
+		A = A * S;
+		invA = invS * invA;
+		break;
+	}
+	}
+
+	result.tmv.linearTrans_assign(invS);
+	result.tmv.cutoff_normal(step_end_exp_table);
+
+	// compute the Taylor expansion of r(t)
+	// since r(t) = A^{-1} * (x(t) - c(t)), we have that r'(t) = A^{-1} * (x'(t) - c'(t)) = A^{-1} * (f(c(t) + A*r(t), t) - c'(t))
+
+	TaylorModelVec c = c0;
+	for(int i=1; i<=order; ++i)
+	{
+		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, exprOde, i, uncertainty_centers);	// compute c(t)
+	}
+
+	TaylorModelVec dcdt;
+	c.derivative(dcdt, 0);	// compute dc/dt
+
+	Matrix matCoefficients_Ar0(rangeDim, rangeDim+1);
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		for(int j=0; j<rangeDim; ++j)
+		{
+			matCoefficients_Ar0.set( A.get(i,j) , i, j+1);
+		}
+	}
+
+	TaylorModelVec Ar0(matCoefficients_Ar0);
+	TaylorModelVec Ar = Ar0;
+
+	TaylorModelVec c_plus_Ar;
+	Ar.add(c_plus_Ar, c);
+
+	// compute the Taylor expansion of the ODE of A*r(t)
+
+	TaylorModelVec Adrdt;
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Polynomial polyTemp;
+		exprOde[i].taylor_polynomial(polyTemp, c_plus_Ar, rangeDim+1, order - 1);
+
+		TaylorModel tmTemp(polyTemp, intZero);
+		Adrdt.tms.push_back(tmTemp);
+	}
+
+	Adrdt.sub_assign(dcdt);
+
+	TaylorModelVec drdt;
+	Adrdt.linearTrans(drdt, invA);
+
+	TaylorModelVec taylorExp_Ar;
+	computeTaylorExpansion(taylorExp_Ar, Adrdt, drdt, order);
+	taylorExp_Ar.add_assign(Ar0);
+
+	TaylorModelVec x = c;
+	x.add_assign(taylorExp_Ar);		// the Taylor expansion of x(t)
+
+	x.cutoff();
+
+	TaylorModelVec x0;
+	Ar0.add(x0, c0);
+
+	bool bfound = true;
+
+	vector<Interval> step_uncertainties;
+	for(int i=0; i<rangeDim; ++i)
+	{
+		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
+	}
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
+	}
+
+	TaylorModelVec tmvTemp;
+	list<Interval> ranges;
+	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, order, uncertainty_centers);
+
+	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
+	vector<Interval> intDifferences;
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Polynomial polyTemp;
+		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+
+		Interval intTemp;
+		polyTemp.intEvalNormal(intTemp, step_exp_table);
+
+		intDifferences.push_back(intTemp);
+	}
+
+	// add the uncertainties and the rounded intervals onto the result
+	for(int i=0; i<rangeDim; ++i)
+	{
+		tmvTemp.tms[i].remainder += step_uncertainties[i];
+		tmvTemp.tms[i].remainder += intDifferences[i];
+	}
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+		{
+			bfound = false;
+			break;
+		}
+	}
+
+	int newOrder = order;
+
+	for(; !bfound;)
+	{
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), newOrder, tmvTemp);
+		++newOrder;
+
+		if(newOrder > maxOrder)
+		{
+			return false;
+		}
+
+		// increase the approximation orders by 1
+		x.Picard_non_polynomial_taylor_no_remainder_assign(x0, exprOde, newOrder, uncertainty_centers);
+
+		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		{
+			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+		}
+
+		// compute the Picard operation again
+		x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, newOrder, uncertainty_centers);
+
+		// Update the irreducible part
+		for(int i=0; i<rangeDim; ++i)
+		{
+			Polynomial polyTemp;
+			polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+
+			Interval intTemp;
+			polyTemp.intEvalNormal(intTemp, step_exp_table);
+			intDifferences[i] = intTemp;
+		}
+
+		// add the uncertainties onto the result
+		for(int i=0; i<rangeDim; ++i)
+		{
+			tmvTemp.tms[i].remainder += step_uncertainties[i];
+			tmvTemp.tms[i].remainder += intDifferences[i];
+		}
+
+		bfound = true;
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+			{
+				bfound = false;
+				break;
+			}
+		}
+	}
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		x.tms[i].remainder = tmvTemp.tms[i].remainder;
+	}
+
+	bool bfinished = false;
+	for(; !bfinished;)
+	{
+		bfinished = true;
+
+		vector<Interval> newRemainders;
+		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, ranges, x0, exprOde, step_exp_table[1], newOrder);
+
+		// add the uncertainties
+		for(int i=0; i<rangeDim; ++i)
+		{
+			newRemainders[i] += step_uncertainties[i];
+			newRemainders[i] += intDifferences[i];
+		}
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if(newRemainders[i].subseteq(x.tms[i].remainder))
+			{
+				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
+				{
+					bfinished = false;
+				}
+			}
+			else
+			{
+				bfinished = true;
+				break;
+			}
+
+			x.tms[i].remainder = newRemainders[i];
+		}
+	}
+
+	order = newOrder;
+	stepLog->accept(step_exp_table[1].sup(), order, x);
+
+	result.tmvPre = x;
+	result.domain = domain;
+	result.domain[0] = step_exp_table[1];
+
+	return true;
+}
+
+bool Flowpipe::advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, vector<int> & orders, const int localMaxOrder, const vector<int> & maxOrders, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const
+{
+	stepLog->begin();
+
+	int rangeDim = exprOde.size();
+	Interval intZero, intOne(1,1), intUnit(-1,1);
+	result.clear();
+
+	// evaluate the the initial set x0
+	TaylorModelVec range_of_x0;
+	tmvPre.evaluate_t(range_of_x0, step_end_exp_table);
+
+	// the center point of x0's polynomial part
+	vector<Interval> intVecCenter;
+	range_of_x0.constant(intVecCenter);
+
+	// the center point of the remainder of x0
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Interval M;
+		range_of_x0.tms[i].remainder.remove_midpoint(M);
+		intVecCenter[i] += M;
+	}
+
+	TaylorModelVec c0(intVecCenter, rangeDim+1);
+
+	// introduce a new variable r0 such that x0 = c0 + A*r0, then r0 is origin-centered
+	range_of_x0.rmConstant();
+
+	// compute the preconditioning matrix
+	Matrix A(rangeDim,rangeDim), invA(rangeDim,rangeDim);
+	TaylorModelVec range_of_r0;
+
+	switch(precondition)
+	{
+	case ID_PRE:
+	{
+		range_of_r0 = range_of_x0;
+		break;
+	}
+
+	case QR_PRE:
+	{
+		preconditionQR(A, invA, range_of_x0, rangeDim, rangeDim+1);
+		range_of_x0.linearTrans(range_of_r0, invA);
+		break;
+	}
+	}
+
+	vector<Interval> tmvPolyRange;
+	tmv.polyRangeNormal(tmvPolyRange, step_end_exp_table);
+	range_of_r0.insert_ctrunc_normal(result.tmv, tmv, tmvPolyRange, step_end_exp_table, domain.size(), orders);
+
+	// we normalized the interval bound of r0
+	vector<Interval> boundOfr0;
+	result.tmv.intEvalNormal(boundOfr0, step_end_exp_table);
+
+	// Compute the scaling matrix S.
+	Matrix S(rangeDim, rangeDim);
+	Matrix invS(rangeDim, rangeDim);
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Interval intSup;
+		boundOfr0[i].mag(intSup);
+
+		if(!intSup.subseteq(intZero))
+		{
+			double dSup = intSup.sup();
+			S.set(dSup, i, i);
+			invS.set(1/dSup, i, i);
+			boundOfr0[i] = intUnit;
+		}
+		else
+		{
+			S.set(0, i, i);
+			invS.set(1, i, i);
+		}
+	}
+
+	// apply the scaling matrix S, i.e., A S S^(-1) A^(-1), then the interval bound of r0 is normalized to [-1,1]^n
+
+	switch(precondition)
+	{
+	case ID_PRE:
+	{
+		A = S;
+		invA = invS;
+		break;
+	}
+
+	case QR_PRE:
+	{
+		A = A * S;
+		invA = invS * invA;
+		break;
+	}
+	}
+
+	result.tmv.linearTrans_assign(invS);
+	result.tmv.cutoff_normal(step_end_exp_table);
+
+	// compute the Taylor expansion of r(t)
+	// since r(t) = A^{-1} * (x(t) - c(t)), we have that r'(t) = A^{-1} * (x'(t) - c'(t)) = A^{-1} * (f(c(t) + A*r(t), t) - c'(t))
+
+	TaylorModelVec c = c0;
+	for(int i=1; i<=localMaxOrder; ++i)
+	{
+		c.Picard_non_polynomial_taylor_no_remainder_assign(c0, exprOde, i, uncertainty_centers);	// compute c(t)
+	}
+
+	TaylorModelVec dcdt;
+	c.derivative(dcdt, 0);	// compute dc/dt
+
+	Matrix matCoefficients_Ar0(rangeDim, rangeDim+1);
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		for(int j=0; j<rangeDim; ++j)
+		{
+			matCoefficients_Ar0.set( A.get(i,j) , i, j+1);
+		}
+	}
+
+	TaylorModelVec Ar0(matCoefficients_Ar0);
+	TaylorModelVec Ar = Ar0;
+
+	TaylorModelVec c_plus_Ar;
+	Ar.add(c_plus_Ar, c);
+
+	// compute the Taylor expansion of the ODE of A*r(t)
+
+	TaylorModelVec Adrdt;
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Polynomial polyTemp;
+		exprOde[i].taylor_polynomial(polyTemp, c_plus_Ar, rangeDim+1, orders[i] - 1);
+
+		TaylorModel tmTemp(polyTemp, intZero);
+		Adrdt.tms.push_back(tmTemp);
+	}
+
+	Adrdt.sub_assign(dcdt);
+
+	TaylorModelVec drdt;
+	Adrdt.linearTrans(drdt, invA);
+
+	TaylorModelVec taylorExp_Ar;
+	computeTaylorExpansion(taylorExp_Ar, Adrdt, drdt, orders);
+	taylorExp_Ar.add_assign(Ar0);
+
+	TaylorModelVec x = c;
+	x.add_assign(taylorExp_Ar);		// the Taylor expansion of x(t)
+
+	x.cutoff();
+
+	TaylorModelVec x0;
+	Ar0.add(x0, c0);
+
+	bool bfound = true;
+
+	vector<Interval> step_uncertainties;
+	for(int i=0; i<rangeDim; ++i)
+	{
+		step_uncertainties.push_back(step_exp_table[1] * uncertainties[i]);
+	}
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		x.tms[i].remainder = estimation[i] + step_uncertainties[i];	// apply the remainder estimation
+	}
+
+	TaylorModelVec tmvTemp;
+	list<Interval> ranges;
+	x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, orders, uncertainty_centers);
+
+	// compute the interval evaluation of the polynomial difference, this part is not able to be reduced by Picard iteration
+	vector<Interval> intDifferences;
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Polynomial polyTemp;
+		polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+
+		Interval intTemp;
+		polyTemp.intEvalNormal(intTemp, step_exp_table);
+
+		intDifferences.push_back(intTemp);
+	}
+
+	// add the uncertainties and the rounded intervals onto the result
+	for(int i=0; i<rangeDim; ++i)
+	{
+		tmvTemp.tms[i].remainder += step_uncertainties[i];
+		tmvTemp.tms[i].remainder += intDifferences[i];
+	}
+
+	vector<bool> bIncrease;
+	for(int i=0; i<rangeDim; ++i)
+	{
+		if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+		{
+			bIncrease.push_back(true);
+			if(bfound)
+				bfound = false;
+		}
+		else
+		{
+			bIncrease.push_back(false);
+		}
+	}
+
+	vector<int> newOrders = orders;
+	bool bIncreaseOthers = false;
+	int numIncrease = 0;
+
+	vector<bool> bIncreased;
+	for(int i=0; i<rangeDim; ++i)
+	{
+		bIncreased.push_back(false);
+	}
+
+	for(; !bfound;)
+	{
+		profiler->retry(PHASE_PICARD);
+		stepLog->reject(step_exp_table[1].sup(), newOrders, tmvTemp);
+		bool bChanged = false;
+
+		if(bIncreaseOthers)
+		{
+			for(int i=0; i<bIncrease.size(); ++i)
+			{
+				if(!bIncrease[i] && newOrders[i] < maxOrders[i])
+				{
+					++newOrders[i];
+					bIncreased[i] = true;
+
+					if(!bChanged)
+						bChanged = true;
+				}
+			}
+
+			bIncreaseOthers = false;
+		}
+		else
+		{
+			numIncrease = 0;
+			for(int i=0; i<bIncrease.size(); ++i)
+			{
+				if(bIncrease[i] && newOrders[i] < maxOrders[i])
+				{
+					++newOrders[i];
+					++numIncrease;
+
+					bIncreased[i] = true;
+
+					if(!bChanged)
+						bChanged = true;
+				}
+			}
+
+			if(numIncrease < newOrders.size())
+				bIncreaseOthers = true;
+		}
+
+		if(!bChanged)
+		{
+			return false;
+		}
+
+		// increase the approximation orders
+		x.Picard_non_polynomial_taylor_no_remainder_assign(x0, exprOde, newOrders, bIncreased, uncertainty_centers);
+
+		for(int i=0; i<rangeDim; ++i)	// apply the estimation again
+		{
+			x.tms[i].remainder = estimation[i] + step_uncertainties[i];
+		}
+
+		// compute the Picard operation again
+		x.Picard_non_polynomial_taylor_ctrunc_normal(tmvTemp, ranges, x0, exprOde, step_exp_table, newOrders, uncertainty_centers);
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			// update the irreducible part if necessary
+			if(bIncreased[i])
+			{
+				Polynomial polyTemp;
+				polyTemp = tmvTemp.tms[i].expansion - x.tms[i].expansion;
+
+				Interval intTemp;
+				polyTemp.intEvalNormal(intTemp, step_exp_table);
+				intDifferences[i] = intTemp;
+			}
+		}
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			tmvTemp.tms[i].remainder += step_uncertainties[i];
+			tmvTemp.tms[i].remainder += intDifferences[i];
+		}
+
+		bfound = true;
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if( ! tmvTemp.tms[i].remainder.subseteq(x.tms[i].remainder) )
+			{
+				if(!bIncreaseOthers)
+				{
+					bIncrease[i] = true;
+					if(bfound)
+						bfound = false;
+				}
+				else
+				{
+					bfound = false;
+					break;
+				}
+			}
+			else
+			{
+				if(!bIncreaseOthers)
+				{
+					bIncrease[i] = false;
+				}
+			}
+		}
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			bIncreased[i] = false;
+		}
+	}
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		x.tms[i].remainder = tmvTemp.tms[i].remainder;
+	}
+
+	bool bfinished = false;
+	for(; !bfinished;)
+	{
+		bfinished = true;
+
+		vector<Interval> newRemainders;
+		x.Picard_non_polynomial_taylor_only_remainder(newRemainders, ranges, x0, exprOde, step_exp_table[1], newOrders);
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			newRemainders[i] += step_uncertainties[i];
+			newRemainders[i] += intDifferences[i];
+		}
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if(newRemainders[i].subseteq(x.tms[i].remainder))
+			{
+				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
+				{
+					bfinished = false;
+				}
+			}
+			else
+			{
+				bfinished = true;
+				break;
+			}
+
+			x.tms[i].remainder = newRemainders[i];
+		}
+	}
+
+	orders = newOrders;
+	stepLog->accept(step_exp_table[1].sup(), orders, x);
+
+	result.tmvPre = x;
+	result.domain = domain;
+	result.domain[0] = step_exp_table[1];
+
+	return true;
+}
+
+Flowpipe & Flowpipe::operator = (const Flowpipe & flowpipe)
+{
+	if(this == &flowpipe)
+		return *this;
+
+	tmvPre = flowpipe.tmvPre;
+	tmv = flowpipe.tmv;
+	domain = flowpipe.domain;
+	return *this;
+}
 
 
 
@@ -5588,6 +6163,8 @@ Flowpipe & Flowpipe::operator = (const Flowpipe & flowpipe)
 
 ContinuousSystem::ContinuousSystem()
 {
+	consumer = NULL;
+	bStreaming = false;
 }
 
 ContinuousSystem::ContinuousSystem(const TaylorModelVec & ode_input, const vector<Interval> & uncertainties_input, const Flowpipe & initialSet_input)
@@ -5597,6 +6174,8 @@ ContinuousSystem::ContinuousSystem(const TaylorModelVec & ode_input, const vecto
 
 	initialSet = initialSet_input;
 	tmvOde = ode_input;
+	consumer = NULL;
+	bStreaming = false;
 	uncertainties = uncertainties_input;
 
 	for(int i=0; i<rangeDim; ++i)
@@ -5616,7 +6195,7 @@ ContinuousSystem::ContinuousSystem(const TaylorModelVec & ode_input, const vecto
 	}
 }
 
-ContinuousSystem::ContinuousSystem(const vector<string> & strOde_input, const vector<Interval> & uncertainties_input, const Flowpipe & initialSet_input)
+ContinuousSystem::ContinuousSystem(const vector<Expression> & exprOde_input, const vector<Interval> & uncertainties_input, const Flowpipe & initialSet_input)
 {
 	uncertainties = uncertainties_input;
 
@@ -5627,8 +6206,10 @@ ContinuousSystem::ContinuousSystem(const vector<string> & strOde_input, const ve
 		uncertainty_centers.push_back(M);
 	}
 
-	strOde = strOde_input;
+	exprOde = exprOde_input;
 	initialSet = initialSet_input;
+	consumer = NULL;
+	bStreaming = false;
 }
 
 ContinuousSystem::ContinuousSystem(const ContinuousSystem & system)
@@ -5638,7 +6219,9 @@ ContinuousSystem::ContinuousSystem(const ContinuousSystem & system)
 	initialSet			=	system.initialSet;
 	uncertainties		=	system.uncertainties;
 	uncertainty_centers	=	system.uncertainty_centers;
-	strOde				=	system.strOde;
+	exprOde				=	system.exprOde;
+	consumer			=	system.consumer;
+	bStreaming			=	system.bStreaming;
 }
 
 ContinuousSystem::~ContinuousSystem()
@@ -5646,7 +6229,7 @@ ContinuousSystem::~ContinuousSystem()
 	hfOde.clear();
 	uncertainties.clear();
 	uncertainty_centers.clear();
-	strOde.clear();
+	exprOde.clear();
 }
 
 // fixed step sizes and orders
@@ -5658,7 +6241,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	vector<Polynomial> polyODE;
@@ -5676,7 +6268,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -5703,7 +6304,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	vector<Polynomial> polyODE;
@@ -5721,7 +6331,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -5758,7 +6377,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 	double newStep = 0;
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	vector<Polynomial> polyODE;
@@ -5776,7 +6404,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step_exp_table[1].sup();
@@ -5819,7 +6456,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 	double newStep = 0;
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	vector<Polynomial> polyODE;
@@ -5837,7 +6483,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step_exp_table[1].sup();
@@ -5878,7 +6533,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*maxOrder);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	int newOrder = order;
@@ -5905,7 +6569,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -5953,7 +6626,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	vector<int> newOrders = orders;
@@ -5985,7 +6667,16 @@ void ContinuousSystem::reach_low_degree(list<Flowpipe> & results, const double s
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -6057,7 +6748,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
@@ -6066,7 +6766,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -6093,7 +6802,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
@@ -6102,7 +6820,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -6139,7 +6866,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 	double newStep = 0;
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
@@ -6148,7 +6884,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step_exp_table[1].sup();
@@ -6183,7 +6928,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 	double newStep = 0;
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
@@ -6192,7 +6946,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step_exp_table[1].sup();
@@ -6233,7 +6996,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*maxOrder);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	int newOrder = order;
@@ -6244,7 +7016,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -6278,7 +7059,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 	vector<int> newOrders = orders;
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
@@ -6294,7 +7084,16 @@ void ContinuousSystem::reach_high_degree(list<Flowpipe> & results, const double
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -6348,16 +7147,34 @@ void ContinuousSystem::reach_non_polynomial_taylor(list<Flowpipe> & results, con
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOde, precondition, step_exp_table, step_end_exp_table, order, estimation, uncertainties, uncertainty_centers);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOde, precondition, step_exp_table, step_end_exp_table, order, estimation, uncertainties, uncertainty_centers);
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -6384,16 +7201,34 @@ void ContinuousSystem::reach_non_polynomial_taylor(list<Flowpipe> & results, con
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOde, precondition, step_exp_table, step_end_exp_table, orders, globalMaxOrder, estimation, uncertainties, uncertainty_centers);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOde, precondition, step_exp_table, step_end_exp_table, orders, globalMaxOrder, estimation, uncertainties, uncertainty_centers);
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -6429,16 +7264,34 @@ void ContinuousSystem::reach_non_polynomial_taylor(list<Flowpipe> & results, con
 	double newStep = 0;
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOde, precondition, step_exp_table, step_end_exp_table, newStep, miniStep, order, estimation, uncertainties, uncertainty_centers);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOde, precondition, step_exp_table, step_end_exp_table, newStep, miniStep, order, estimation, uncertainties, uncertainty_centers);
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step_exp_table[1].sup();
@@ -6473,16 +7326,34 @@ void ContinuousSystem::reach_non_polynomial_taylor(list<Flowpipe> & results, con
 	double newStep = 0;
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOde, precondition, step_exp_table, step_end_exp_table, newStep, miniStep, orders, globalMaxOrder, estimation, uncertainties, uncertainty_centers);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOde, precondition, step_exp_table, step_end_exp_table, newStep, miniStep, orders, globalMaxOrder, estimation, uncertainties, uncertainty_centers);
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step_exp_table[1].sup();
@@ -6523,18 +7394,36 @@ void ContinuousSystem::reach_non_polynomial_taylor(list<Flowpipe> & results, con
 	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*maxOrder);
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	int newOrder = order;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOde, precondition, step_exp_table, step_end_exp_table, newOrder, maxOrder, estimation, uncertainties, uncertainty_centers);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOde, precondition, step_exp_table, step_end_exp_table, newOrder, maxOrder, estimation, uncertainties, uncertainty_centers);
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -6568,7 +7457,16 @@ void ContinuousSystem::reach_non_polynomial_taylor(list<Flowpipe> & results, con
 	vector<int> newOrders = orders;
 
 	results.clear();
-	results.push_back(initialSet);
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
 	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
 
 	for(double t=THRESHOLD_HIGH; t < time;)
@@ -6580,11 +7478,20 @@ void ContinuousSystem::reach_non_polynomial_taylor(list<Flowpipe> & results, con
 				localMaxOrder = newOrders[i];
 		}
 
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOde, precondition, step_exp_table, step_end_exp_table, newOrders, localMaxOrder, maxOrders, estimation, uncertainties, uncertainty_centers);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOde, precondition, step_exp_table, step_end_exp_table, newOrders, localMaxOrder, maxOrders, estimation, uncertainties, uncertainty_centers);
 
 		if(bvalid)
 		{
-			results.push_back(newFlowpipe);
+			if(!bStreaming)
+			{
+				results.push_back(newFlowpipe);
+			}
+
+			if(consumer != NULL && !consumer->receive(newFlowpipe))
+			{
+				break;
+			}
+
 			currentFlowpipe = newFlowpipe;
 
 			t += step;
@@ -6608,11 +7515,75 @@ void ContinuousSystem::reach_non_polynomial_taylor(list<Flowpipe> & results, con
 					--newOrders[i];
 			}
 		}
-		else
+		else
+		{
+			fprintf(stdout, "Terminated -- The remainder estimation is not large enough.\n");
+			break;
+		}
+	}
+}
+
+// for affine ODEs
+
+void ContinuousSystem::reach_linear(list<Flowpipe> & results, const double step, const double miniStep, const double time, const int minOrder, const int maxOrder, const int precondition, const bool bPrint, const vector<string> & stateVarNames) const
+{
+	results.clear();
+
+	// the step size is only reduced in adaptive mode, when the Taylor series of the flow can not be bounded for it
+	double newStep = step;
+	LinearFlow flow;
+
+	while(!flow.build(tmvOde, uncertainties, newStep, minOrder, maxOrder))
+	{
+		newStep *= LAMBDA_DOWN;
+
+		if(newStep < miniStep)
+		{
+			fprintf(stdout, "Terminated -- The step size is too large for the linear flow.\n");
+			return;
+		}
+	}
+
+	vector<Interval> step_exp_table, step_end_exp_table;
+
+	construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*flow.order);
+
+	if(!bStreaming)
+	{
+		results.push_back(initialSet);
+	}
+
+	if(consumer != NULL && !consumer->receive(initialSet))
+	{
+		return;
+	}
+
+	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
+
+	for(double t=THRESHOLD_HIGH; t < time;)
+	{
+		currentFlowpipe.advance_linear(newFlowpipe, flow, precondition, step_exp_table, step_end_exp_table);
+
+		if(!bStreaming)
+		{
+			results.push_back(newFlowpipe);
+		}
+
+		if(consumer != NULL && !consumer->receive(newFlowpipe))
 		{
-			fprintf(stdout, "Terminated -- The remainder estimation is not large enough.\n");
 			break;
 		}
+
+		currentFlowpipe = newFlowpipe;
+
+		t += newStep;
+
+		if(bPrint)
+		{
+			printf("time = %f,\t", t);
+			printf("step = %f,\t", newStep);
+			printf("order = %d\n", flow.order);
+		}
 	}
 }
 
@@ -6626,7 +7597,9 @@ ContinuousSystem & ContinuousSystem::operator = (const ContinuousSystem & system
 	initialSet			=	system.initialSet;
 	uncertainties		=	system.uncertainties;
 	uncertainty_centers	=	system.uncertainty_centers;
-	strOde				=	system.strOde;
+	exprOde				=	system.exprOde;
+	consumer			=	system.consumer;
+	bStreaming			=	system.bStreaming;
 
 	return *this;
 }
@@ -6670,6 +7643,13 @@ ContinuousSystem & ContinuousSystem::operator = (const ContinuousSystem & system
 
 ContinuousReachability::ContinuousReachability()
 {
+	numSplits = 1;
+	numThreads = 1;
+	bOnlineChecking = false;
+	checkingResult = UNKNOWN;
+	bStreaming = false;
+	numOfStreamedFlowpipes = 0;
+	bBinaryDumping = false;
 }
 
 ContinuousReachability::~ContinuousReachability()
@@ -6687,7 +7667,108 @@ ContinuousReachability::~ContinuousReachability()
 	tmVarNames.clear();
 }
 
-void ContinuousReachability::dump(FILE *fp) const
+bool ContinuousReachability::dump(FILE *fp) const
+{
+	dump_header(fp);
+
+	if(bBinaryDumping)
+	{
+		// only a reference to the binary file is kept in the text
+		fprintf(fp, "binary\n");
+
+		FILE *fpBinary = open_binary_dumping_file();
+
+		if(fpBinary == NULL)
+		{
+			return false;
+		}
+
+		dump_binary(fpBinary);
+		fclose(fpBinary);
+	}
+	else
+	{
+		list<TaylorModelVec>::const_iterator fpIter = flowpipesCompo.begin();
+		list<vector<Interval> >::const_iterator doIter = domains.begin();
+
+		for(; fpIter != flowpipesCompo.end(); ++fpIter, ++doIter)
+		{
+			dump_flowpipe(fp, *fpIter, *doIter);
+		}
+	}
+
+	dump_footer(fp);
+
+	return true;
+}
+
+void ContinuousReachability::dump_binary(FILE *fp) const
+{
+	list<TaylorModelVec>::const_iterator fpIter = flowpipesCompo.begin();
+	list<vector<Interval> >::const_iterator doIter = domains.begin();
+
+	for(; fpIter != flowpipesCompo.end(); ++fpIter, ++doIter)
+	{
+		write_flowpipe_record(fp, *fpIter, *doIter);
+	}
+
+	write_flowpipe_file_end(fp);
+}
+
+// the header of the file is written, returns NULL if the file can not be created
+FILE *ContinuousReachability::open_binary_dumping_file() const
+{
+	char filename[NAME_SIZE+30];
+	sprintf(filename, "%s%s%s", outputDir, outputFileName, str_binary_dumping_name_suffix);
+	FILE *fpBinary = fopen(filename, "wb");
+
+	if(fpBinary != NULL)
+	{
+		write_flowpipe_file_header(fpBinary, FLOWPIPE_FILE_CONTINUOUS);
+	}
+
+	return fpBinary;
+}
+
+bool ContinuousReachability::load_binary()
+{
+	char filename[NAME_SIZE+30];
+	sprintf(filename, "%s%s%s", outputDir, outputFileName, str_binary_dumping_name_suffix);
+
+	FlowpipeFileReader reader;
+	if(!reader.open(filename, FLOWPIPE_FILE_CONTINUOUS))
+	{
+		return false;
+	}
+
+	flowpipesCompo.clear();
+	domains.clear();
+
+	for(;;)
+	{
+		int modeID;
+		TaylorModelVec tmv;
+		vector<Interval> domain;
+
+		int type = reader.next(modeID, tmv, domain);
+
+		if(type == FLOWPIPE_RECORD_END)
+		{
+			break;
+		}
+		else if(type != FLOWPIPE_RECORD_FLOWPIPE)
+		{
+			return false;
+		}
+
+		flowpipesCompo.push_back(tmv);
+		domains.push_back(domain);
+	}
+
+	return true;
+}
+
+void ContinuousReachability::dump_header(FILE *fp) const
 {
 	fprintf(fp,"state var ");
 	for(int i=0; i<stateVarNames.size()-1; ++i)
@@ -6752,35 +7833,33 @@ void ContinuousReachability::dump(FILE *fp) const
 	}
 	fprintf(fp, "%s\n\n", tmVarNames[tmVarNames.size()-1].c_str());
 
-	list<TaylorModelVec>::const_iterator fpIter = flowpipesCompo.begin();
-	list<vector<Interval> >::const_iterator doIter = domains.begin();
+}
 
+void ContinuousReachability::dump_flowpipe(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain) const
+{
 	// every Taylor model flowpipe is enclosed by braces
+	fprintf(fp, "{\n");
+	tmv.dump_interval(fp, stateVarNames, tmVarNames);
 
-	for(; fpIter != flowpipesCompo.end(); ++fpIter, ++doIter)
+	//dump the domain
+	for(int i=0; i<domain.size(); ++i)
 	{
-		fprintf(fp, "{\n");
-		fpIter->dump_interval(fp, stateVarNames, tmVarNames);
-
-		//dump the domain
-		for(int i=0; i<doIter->size(); ++i)
-		{
-			fprintf(fp, "%s in ", tmVarNames[i].c_str());
-			(*doIter)[i].dump(fp);
-			fprintf(fp, "\n");
-		}
-
-		fprintf(fp, "}\n\n");
+		fprintf(fp, "%s in ", tmVarNames[i].c_str());
+		domain[i].dump(fp);
+		fprintf(fp, "\n");
 	}
 
+	fprintf(fp, "}\n\n");
+}
+
+void ContinuousReachability::dump_footer(FILE *fp) const
+{
 	fprintf(fp, "}\n");
 }
 
-void ContinuousReachability::run()
+void ContinuousReachability::reach(list<Flowpipe> & results, const ContinuousSystem & sys) const
 {
-	compute_factorial_rec(globalMaxOrder+1);
-	compute_power_4(globalMaxOrder+1);
-	compute_double_factorial(2*globalMaxOrder);
+	stepLog->enter(NULL, 0);
 
 	switch(integrationScheme)
 	{
@@ -6791,29 +7870,29 @@ void ContinuousReachability::run()
 		case UNIFORM:
 			if(bAdaptiveSteps)
 			{
-				system.reach_low_degree(flowpipes, step, miniStep, time, orders[0], precondition, estimation, bPrint, stateVarNames);
+				sys.reach_low_degree(results, step, miniStep, time, orders[0], precondition, estimation, bPrint, stateVarNames);
 			}
 			else if(bAdaptiveOrders)
 			{
-				system.reach_low_degree(flowpipes, step, time, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames);
+				sys.reach_low_degree(results, step, time, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames);
 			}
 			else
 			{
-				system.reach_low_degree(flowpipes, step, time, orders[0], precondition, estimation, bPrint, stateVarNames);
+				sys.reach_low_degree(results, step, time, orders[0], precondition, estimation, bPrint, stateVarNames);
 			}
 			break;
 		case MULTI:
 			if(bAdaptiveSteps)
 			{
-				system.reach_low_degree(flowpipes, step, miniStep, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
+				sys.reach_low_degree(results, step, miniStep, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
 			}
 			else if(bAdaptiveOrders)
 			{
-				system.reach_low_degree(flowpipes, step, time, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
+				sys.reach_low_degree(results, step, time, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
 			}
 			else
 			{
-				system.reach_low_degree(flowpipes, step, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
+				sys.reach_low_degree(results, step, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
 			}
 			break;
 		}
@@ -6827,29 +7906,29 @@ void ContinuousReachability::run()
 		case UNIFORM:
 			if(bAdaptiveSteps)
 			{
-				system.reach_high_degree(flowpipes, step, miniStep, time, orders[0], precondition, estimation, bPrint, stateVarNames);
+				sys.reach_high_degree(results, step, miniStep, time, orders[0], precondition, estimation, bPrint, stateVarNames);
 			}
 			else if(bAdaptiveOrders)
 			{
-				system.reach_high_degree(flowpipes, step, time, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames);
+				sys.reach_high_degree(results, step, time, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames);
 			}
 			else
 			{
-				system.reach_high_degree(flowpipes, step, time, orders[0], precondition, estimation, bPrint, stateVarNames);
+				sys.reach_high_degree(results, step, time, orders[0], precondition, estimation, bPrint, stateVarNames);
 			}
 			break;
 		case MULTI:
 			if(bAdaptiveSteps)
 			{
-				system.reach_high_degree(flowpipes, step, miniStep, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
+				sys.reach_high_degree(results, step, miniStep, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
 			}
 			else if(bAdaptiveOrders)
 			{
-				system.reach_high_degree(flowpipes, step, time, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
+				sys.reach_high_degree(results, step, time, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
 			}
 			else
 			{
-				system.reach_high_degree(flowpipes, step, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
+				sys.reach_high_degree(results, step, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
 			}
 			break;
 		}
@@ -6863,35 +7942,376 @@ void ContinuousReachability::run()
 		case UNIFORM:
 			if(bAdaptiveSteps)
 			{
-				system.reach_non_polynomial_taylor(flowpipes, step, miniStep, time, orders[0], precondition, estimation, bPrint, stateVarNames);
+				sys.reach_non_polynomial_taylor(results, step, miniStep, time, orders[0], precondition, estimation, bPrint, stateVarNames);
 			}
 			else if(bAdaptiveOrders)
 			{
-				system.reach_non_polynomial_taylor(flowpipes, step, time, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames);
+				sys.reach_non_polynomial_taylor(results, step, time, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames);
 			}
 			else
 			{
-				system.reach_non_polynomial_taylor(flowpipes, step, time, orders[0], precondition, estimation, bPrint, stateVarNames);
+				sys.reach_non_polynomial_taylor(results, step, time, orders[0], precondition, estimation, bPrint, stateVarNames);
 			}
 			break;
 		case MULTI:
 			if(bAdaptiveSteps)
 			{
-				system.reach_non_polynomial_taylor(flowpipes, step, miniStep, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
+				sys.reach_non_polynomial_taylor(results, step, miniStep, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
 			}
 			else if(bAdaptiveOrders)
 			{
-				system.reach_non_polynomial_taylor(flowpipes, step, time, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
+				sys.reach_non_polynomial_taylor(results, step, time, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
 			}
 			else
 			{
-				system.reach_non_polynomial_taylor(flowpipes, step, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
+				sys.reach_non_polynomial_taylor(results, step, time, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames);
 			}
 			break;
 		}
-		break;
+		break;
+	}
+
+	case LINEAR_ODE:
+	{
+		// the largest step size is used unless the flow can not be built for it
+		int minOrder, maxOrder;
+		linear_flow_orders(minOrder, maxOrder, orderType, bAdaptiveOrders, orders, maxOrders);
+		sys.reach_linear(results, step, bAdaptiveSteps ? miniStep : step, time, minOrder, maxOrder, precondition, bPrint, stateVarNames);
+		break;
+	}
+	}
+}
+
+class ContinuousSafetyMonitor : public FlowpipeConsumer		// composes the flowpipes, checks them against the unsafe set and keeps or streams them out
+{
+public:
+	const ContinuousReachability *problem;
+	bool bChecking;				// whether the flowpipes are checked against the unsafe set
+
+	list<TaylorModelVec> flowpipesCompo;
+	list<vector<Interval> > domains;
+
+	int result;
+	Interval globalTime;
+	Interval violationTime;
+
+	// the flowpipes which may intersect the unsafe set
+	list<TaylorModelVec> unsafe_flowpipes;
+	list<vector<Interval> > unsafe_flowpipe_domains;
+	list<Interval> globalTimes;
+
+	// if the files are given, the composed flowpipes are written to them and then freed
+	FILE *fpPlotting;
+	FILE *fpDumping;
+	FILE *fpCounterexamples;
+	Polyhedron polyTemplate;
+	unsigned long numOfFlowpipes;
+
+	volatile int *stop;			// shared by the monitors of all sub-boxes, set once the unsafe set is definitely reached
+
+	vector<Interval> step_exp_table;
+	Interval intStep;
+	vector<Interval> check_exp_table;
+	int maxOrder;
+
+	ContinuousSafetyMonitor()
+	{
+		problem = NULL;
+		bChecking = false;
+		result = SAFE;
+		fpPlotting = NULL;
+		fpDumping = NULL;
+		fpCounterexamples = NULL;
+		numOfFlowpipes = 0;
+		stop = NULL;
+		maxOrder = 0;
+	}
+
+	bool receive(const Flowpipe & flowpipe);
+};
+
+bool ContinuousSafetyMonitor::receive(const Flowpipe & flowpipe)
+{
+	if(stop != NULL && *stop)
+	{
+		return false;		// another sub-box has already reached the unsafe set
+	}
+
+	if(step_exp_table.size() == 0 || intStep != flowpipe.domain[0])
+	{
+		construct_step_exp_table(step_exp_table, flowpipe.domain[0], problem->globalMaxOrder);
+		intStep = flowpipe.domain[0];
+	}
+
+	TaylorModelVec tmvTemp;
+	flowpipe.composition_normal(tmvTemp, step_exp_table);
+
+	++numOfFlowpipes;
+
+	int tmp = maxOrder;
+	for(int i=0; i<tmvTemp.tms.size(); ++i)
+	{
+		int order = tmvTemp.tms[i].degree();
+		if(maxOrder < order)
+		{
+			maxOrder = order;
+		}
+	}
+
+	if(check_exp_table.size() == 0 || check_exp_table[1] != flowpipe.domain[0] || maxOrder > tmp)
+	{
+		construct_step_exp_table(check_exp_table, flowpipe.domain[0], 2*maxOrder);
+	}
+
+	if(fpPlotting != NULL)
+	{
+		problem->plot_2D_flowpipe(fpPlotting, tmvTemp, flowpipe.domain, check_exp_table, polyTemplate);
+
+		if(problem->bBinaryDumping)
+		{
+			write_flowpipe_record(fpDumping, tmvTemp, flowpipe.domain);
+		}
+		else
+		{
+			problem->dump_flowpipe(fpDumping, tmvTemp, flowpipe.domain);
+		}
+	}
+	else
+	{
+		flowpipesCompo.push_back(tmvTemp);
+		domains.push_back(flowpipe.domain);
+	}
+
+	if(bChecking)
+	{
+		int type = problem->check_flowpipe(tmvTemp, flowpipe.domain.size(), check_exp_table);
+
+		if(type == UNSAFE && problem->bOnlineChecking)
+		{
+			Interval intStart(globalTime.sup());
+			violationTime = intStart + flowpipe.domain[0];
+			result = UNSAFE;
+
+			if(stop != NULL)
+			{
+				__sync_lock_test_and_set(stop, 1);
+			}
+
+			return false;
+		}
+		else if(type != SAFE)
+		{
+			if(fpCounterexamples != NULL)
+			{
+				problem->dump_potential_counterexample(fpCounterexamples, tmvTemp, flowpipe.domain, globalTime);
+			}
+			else
+			{
+				unsafe_flowpipes.push_back(tmvTemp);
+				unsafe_flowpipe_domains.push_back(flowpipe.domain);
+				globalTimes.push_back(globalTime);
+			}
+
+			result = UNKNOWN;
+		}
+	}
+
+	globalTime += flowpipe.domain[0];
+
+	return true;
+}
+
+class ContinuousSplitTasks		// the reachability computations for the sub-boxes of the initial set
+{
+public:
+	const ContinuousReachability *problem;
+	vector<ContinuousSystem> systems;
+	vector<list<Flowpipe> > results;
+	vector<ContinuousSafetyMonitor> monitors;
+	volatile int stop;		// the computations of all sub-boxes are aborted once it is set
+};
+
+static void continuous_split_task(void *arg, const int i)
+{
+	ContinuousSplitTasks *tasks = (ContinuousSplitTasks *)arg;
+	tasks->problem->reach(tasks->results[i], tasks->systems[i]);
+}
+
+bool ContinuousReachability::run()
+{
+	compute_factorial_rec(globalMaxOrder+1);
+	compute_power_4(globalMaxOrder+1);
+	compute_double_factorial(2*globalMaxOrder);
+
+	numOfPieceFlowpipes.clear();
+
+	if(numSplits <= 1 && !bOnlineChecking && !bStreaming)
+	{
+		reach(flowpipes, system);
+		return true;
+	}
+
+	list<Flowpipe> initialSets;
+	system.initialSet.split(initialSets, numSplits);
+	numSplits = initialSets.size();		// a degenerate domain may have fewer pieces
+
+	bool bChecking = bOnlineChecking || (bStreaming && bSafetyChecking);
+
+	ContinuousSafetyMonitor stage;
+	stage.problem = this;
+	stage.bChecking = bChecking;
+
+	if(bStreaming)
+	{
+		// the output files are filled while the flowpipes are computed
+		stage.fpPlotting = open_plotting_file();
+
+		if(stage.fpPlotting == NULL)
+		{
+			return false;
+		}
+
+		plot_2D_header(stage.fpPlotting);
+
+		if(plotSetting == PLOT_OCTAGON)
+		{
+			plot_2D_octagon_template(stage.polyTemplate);
+		}
+
+		stage.fpDumping = open_dumping_file();
+
+		if(stage.fpDumping != NULL && bBinaryDumping)
+		{
+			dump_header(stage.fpDumping);
+			fprintf(stage.fpDumping, "binary\n");
+			dump_footer(stage.fpDumping);
+			fclose(stage.fpDumping);
+
+			stage.fpDumping = open_binary_dumping_file();
+		}
+		else if(stage.fpDumping != NULL)
+		{
+			dump_header(stage.fpDumping);
+		}
+
+		if(stage.fpDumping == NULL)
+		{
+			fclose(stage.fpPlotting);
+			return false;
+		}
+
+		if(bChecking)
+		{
+			stage.fpCounterexamples = open_counterexample_file();
+		}
+	}
+
+	ContinuousSplitTasks tasks;
+	tasks.problem = this;
+	tasks.stop = 0;
+	tasks.monitors.resize(initialSets.size(), stage);
+
+	list<Flowpipe>::const_iterator iter = initialSets.begin();
+	for(int i=0; iter != initialSets.end(); ++iter, ++i)
+	{
+		ContinuousSystem sys = system;
+		sys.initialSet = *iter;
+
+		if(bChecking || bStreaming)
+		{
+			tasks.monitors[i].stop = &tasks.stop;
+			sys.consumer = &tasks.monitors[i];
+			sys.bStreaming = bStreaming;
+		}
+
+		tasks.systems.push_back(sys);
+	}
+
+	tasks.results.resize(tasks.systems.size());
+
+	// the sub-boxes share the output files when streaming, so they are handled one after another
+	runParallelTasks(continuous_split_task, &tasks, tasks.systems.size(), bStreaming ? 1 : numThreads, &tasks.stop);
+
+	// the flowpipes are merged in the order of the sub-boxes, the time of each sub-box starts from 0
+	flowpipes.clear();
+	for(int i=0; i<tasks.results.size(); ++i)
+	{
+		numOfPieceFlowpipes.push_back(tasks.results[i].size());
+		flowpipes.splice(flowpipes.end(), tasks.results[i]);
+	}
+
+	flowpipesCompo.clear();
+	domains.clear();
+	numOfStreamedFlowpipes = 0;
+
+	list<TaylorModelVec> unsafe_flowpipes;
+	list<vector<Interval> > unsafe_flowpipe_domains;
+	list<Interval> globalTimes;
+
+	if(bChecking)
+	{
+		checkingResult = SAFE;
+	}
+
+	for(int i=0; i<tasks.monitors.size(); ++i)
+	{
+		ContinuousSafetyMonitor & monitor = tasks.monitors[i];
+
+		flowpipesCompo.splice(flowpipesCompo.end(), monitor.flowpipesCompo);
+		domains.splice(domains.end(), monitor.domains);
+		numOfStreamedFlowpipes += monitor.numOfFlowpipes;
+
+		unsafe_flowpipes.splice(unsafe_flowpipes.end(), monitor.unsafe_flowpipes);
+		unsafe_flowpipe_domains.splice(unsafe_flowpipe_domains.end(), monitor.unsafe_flowpipe_domains);
+		globalTimes.splice(globalTimes.end(), monitor.globalTimes);
+
+		if(!bChecking)
+		{
+			continue;
+		}
+
+		if(monitor.result == UNSAFE)
+		{
+			if(checkingResult != UNSAFE)
+			{
+				violationTime = monitor.violationTime;
+			}
+
+			checkingResult = UNSAFE;
+		}
+		else if(monitor.result == UNKNOWN && checkingResult == SAFE)
+		{
+			checkingResult = UNKNOWN;
+		}
+	}
+
+	if(bStreaming)
+	{
+		plot_2D_footer(stage.fpPlotting);
+		fclose(stage.fpPlotting);
+
+		if(bBinaryDumping)
+		{
+			write_flowpipe_file_end(stage.fpDumping);
+		}
+		else
+		{
+			dump_footer(stage.fpDumping);
+		}
+
+		fclose(stage.fpDumping);
+
+		if(stage.fpCounterexamples != NULL)
+		{
+			fclose(stage.fpCounterexamples);
+		}
 	}
+	else if(bChecking && checkingResult != UNSAFE)
+	{
+		dump_potential_counterexamples(unsafe_flowpipes, unsafe_flowpipe_domains, globalTimes);
 	}
+
+	return true;
 }
 
 void ContinuousReachability::composition()
@@ -6928,30 +8348,11 @@ int ContinuousReachability::safetyChecking() const
 		return UNSAFE;	// since the whole state space is unsafe, the system is not safe
 	}
 
-	bool bDumpCounterexamples = true;
-
-	int mkres = mkdir(counterexampleDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
-	{
-		printf("Can not create the directory for counterexamples.\n");
-		bDumpCounterexamples = false;
-	}
-
-	char filename_counterexamples[NAME_SIZE+10];
-	FILE *fpDumpCounterexamples;
-
-	if(bDumpCounterexamples)
-	{
-		sprintf(filename_counterexamples, "%s%s%s", counterexampleDir, outputFileName, str_counterexample_dumping_name_suffix);
-		fpDumpCounterexamples = fopen(filename_counterexamples, "w");
-	}
-
 	list<TaylorModelVec>::const_iterator tmvIter = flowpipesCompo.begin();
 	list<vector<Interval> >::const_iterator doIter = domains.begin();
 
 	vector<Interval> step_exp_table;
 
-	int rangeDim = tmvIter->tms.size();
 	int domainDim = doIter->size();
 
 	int result = SAFE;
@@ -6961,10 +8362,21 @@ int ContinuousReachability::safetyChecking() const
 	list<Interval> globalTimes;
 
 	int maxOrder = 0;
-	Interval globalTime;
+	Interval globalTime, intZero;
+
+	// the flowpipes loaded from a file are regarded as one piece
+	int piece = 0;
+	unsigned long numLeft = numOfPieceFlowpipes.size() > 0 ? numOfPieceFlowpipes[0] : flowpipesCompo.size();
 
 	for(; tmvIter!=flowpipesCompo.end(); ++tmvIter, ++doIter)
 	{
+		while(numLeft == 0 && piece + 1 < numOfPieceFlowpipes.size())
+		{
+			++piece;
+			numLeft = numOfPieceFlowpipes[piece];
+			globalTime = intZero;		// the initial set of the next sub-box starts from time 0
+		}
+
 		int tmp = maxOrder;
 		for(int i=0; i<tmvIter->tms.size(); ++i)
 		{
@@ -6980,34 +8392,7 @@ int ContinuousReachability::safetyChecking() const
 			construct_step_exp_table(step_exp_table, (*doIter)[0], 2*maxOrder);
 		}
 
-		bool bsafe = false;
-
-		vector<Interval> tmvPolyRange;
-		tmvIter->polyRangeNormal(tmvPolyRange, step_exp_table);
-
-		for(int i=0; i<unsafeSet.size(); ++i)
-		{
-			TaylorModel tmTemp;
-
-			// interval evaluation on the constraint
-			unsafeSet[i].hf.insert_normal(tmTemp, *tmvIter, tmvPolyRange, step_exp_table, domainDim);
-
-			Interval intTemp;
-			tmTemp.intEvalNormal(intTemp, step_exp_table);
-
-			if(intTemp > unsafeSet[i].B)
-			{
-				// no intersection with the unsafe set
-				bsafe = true;
-				break;
-			}
-			else
-			{
-				continue;
-			}
-		}
-
-		if(!bsafe)
+		if(check_flowpipe(*tmvIter, domainDim, step_exp_table) != SAFE)
 		{
 			unsafe_flowpipes.push_back(*tmvIter);
 			unsafe_flowpipe_domains.push_back(*doIter);
@@ -7017,264 +8402,172 @@ int ContinuousReachability::safetyChecking() const
 		}
 
 		globalTime += (*doIter)[0];
+		--numLeft;
 	}
 
-	if(bDumpCounterexamples && unsafe_flowpipes.size() > 0)
-	{
-		dump_potential_counterexample(fpDumpCounterexamples, unsafe_flowpipes, unsafe_flowpipe_domains, globalTimes);
-	}
-
-	if(bDumpCounterexamples)
-	{
-		fclose(fpDumpCounterexamples);
-	}
+	dump_potential_counterexamples(unsafe_flowpipes, unsafe_flowpipe_domains, globalTimes);
 
 	return result;
 }
 
-unsigned long ContinuousReachability::numOfFlowpipes() const
+// returns SAFE if the flowpipe does not intersect the unsafe set, UNSAFE if it is entirely contained in the unsafe set
+int ContinuousReachability::check_flowpipe(const TaylorModelVec & tmv, const int domainDim, const vector<Interval> & step_exp_table) const
 {
-	return (unsigned long)(flowpipes.size()) - 1;
-}
+	vector<Interval> tmvPolyRange;
+	tmv.polyRangeNormal(tmvPolyRange, step_exp_table);
 
-void ContinuousReachability::dump_potential_counterexample(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, const list<Interval> & globalTimes) const
-{
-	list<TaylorModelVec>::const_iterator fpIter = flowpipes.begin();
-	list<vector<Interval> >::const_iterator doIter = domains.begin();
-	list<Interval>::const_iterator timeIter = globalTimes.begin();
+	bool bInside = true;
 
-	for(; fpIter!=flowpipes.end(); ++fpIter, ++doIter, ++timeIter)
+	for(int i=0; i<unsafeSet.size(); ++i)
 	{
-		fprintf(fp, "starting time %lf\n{\n", timeIter->sup());
+		TaylorModel tmTemp;
 
-		fpIter->dump_interval(fp, stateVarNames, tmVarNames);
+		// interval evaluation on the constraint
+		unsafeSet[i].hf.insert_normal(tmTemp, tmv, tmvPolyRange, step_exp_table, domainDim);
 
-		for(int i=0; i<doIter->size(); ++i)
+		Interval intTemp;
+		tmTemp.intEvalNormal(intTemp, step_exp_table);
+
+		if(intTemp > unsafeSet[i].B)
+		{
+			// no intersection with the unsafe set
+			return SAFE;
+		}
+		else if(intTemp.sup() > unsafeSet[i].B.inf())
 		{
-			fprintf(fp, "%s in ", tmVarNames[i].c_str());
-			(*doIter)[i].dump(fp);
-			fprintf(fp, "\n");
+			bInside = false;
 		}
+	}
 
-		fprintf(fp, "}\n\n\n");
+	if(bInside)
+	{
+		return UNSAFE;
+	}
+	else
+	{
+		return UNKNOWN;
 	}
 }
 
-void ContinuousReachability::plot_2D() const
+void ContinuousReachability::dump_potential_counterexamples(const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, const list<Interval> & globalTimes) const
 {
-	char filename[NAME_SIZE+10];
+	FILE *fpDumpCounterexamples = open_counterexample_file();
 
-	switch(plotFormat)
+	if(fpDumpCounterexamples == NULL)
 	{
-	case PLOT_GNUPLOT:
-		sprintf(filename, "%s%s.plt", outputDir, outputFileName);
-		break;
-	case PLOT_MATLAB:
-		sprintf(filename, "%s%s.m", outputDir, outputFileName);
-		break;
+		return;
 	}
 
-	FILE *fpPlotting = fopen(filename, "w");
+	dump_potential_counterexample(fpDumpCounterexamples, flowpipes, domains, globalTimes);
 
-	if(fpPlotting == NULL)
+	fclose(fpDumpCounterexamples);
+}
+
+FILE *ContinuousReachability::open_counterexample_file() const
+{
+	int mkres = mkdir(counterexampleDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+	if(mkres < 0 && errno != EEXIST)
 	{
-		printf("Can not create the plotting file.\n");
-		exit(1);
+		printf("Can not create the directory for counterexamples.\n");
+		return NULL;
 	}
 
-	printf("Generating the plotting file...\n");
-	switch(plotFormat)
+	char filename_counterexamples[NAME_SIZE+40];
+	sprintf(filename_counterexamples, "%s%s%s", counterexampleDir, outputFileName, str_counterexample_dumping_name_suffix);
+	FILE *fpDumpCounterexamples = fopen(filename_counterexamples, "w");
+
+	if(fpDumpCounterexamples == NULL)
 	{
-	case PLOT_GNUPLOT:
-		plot_2D_GNUPLOT(fpPlotting);
-		break;
-	case PLOT_MATLAB:
-		plot_2D_MATLAB(fpPlotting);
-		break;
+		printf("Can not create the file for counterexamples.\n");
 	}
-	printf("Done.\n");
 
-	fclose(fpPlotting);
+	return fpDumpCounterexamples;
 }
 
-void ContinuousReachability::plot_2D_GNUPLOT(FILE *fp) const
+unsigned long ContinuousReachability::numOfFlowpipes() const
 {
-	switch(plotSetting)
+	unsigned long numOfInitialSets = numSplits > 1 ? numSplits : 1;
+
+	if(bStreaming)
 	{
-	case PLOT_INTERVAL:
-		plot_2D_interval_GNUPLOT(fp);
-		break;
-	case PLOT_OCTAGON:
-		plot_2D_octagon_GNUPLOT(fp);
-		break;
-	case PLOT_GRID:
-		plot_2D_grid_GNUPLOT(fp);
-		break;
+		return numOfStreamedFlowpipes - numOfInitialSets;
+	}
+	else
+	{
+		return (unsigned long)(flowpipes.size()) - numOfInitialSets;
 	}
 }
 
-void ContinuousReachability::plot_2D_interval_GNUPLOT(FILE *fp) const
+void ContinuousReachability::dump_potential_counterexample(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, const list<Interval> & globalTimes) const
 {
-	fprintf(fp, "set terminal postscript\n");
-
-	char filename[NAME_SIZE+10];
-	sprintf(filename, "%s%s.eps", imageDir, outputFileName);
-	fprintf(fp, "set output '%s'\n", filename);
-
-	fprintf(fp, "set style line 1 linecolor rgb \"blue\"\n");
-	fprintf(fp, "set autoscale\n");
-	fprintf(fp, "unset label\n");
-	fprintf(fp, "set xtic auto\n");
-	fprintf(fp, "set ytic auto\n");
-	fprintf(fp, "set xlabel \"%s\"\n", stateVarNames[outputAxes[0]].c_str());
-	fprintf(fp, "set ylabel \"%s\"\n", stateVarNames[outputAxes[1]].c_str());
-	fprintf(fp, "plot '-' notitle with lines ls 1\n");
-
-	vector<Interval> step_exp_table, step_end_exp_table;
-	Interval intStep;
-
-	list<TaylorModelVec>::const_iterator tmvIter = flowpipesCompo.begin();
+	list<TaylorModelVec>::const_iterator fpIter = flowpipes.begin();
 	list<vector<Interval> >::const_iterator doIter = domains.begin();
+	list<Interval>::const_iterator timeIter = globalTimes.begin();
 
-	int maxOrder = 0;
-
-	for(; tmvIter != flowpipesCompo.end() && doIter != domains.end(); ++tmvIter, ++doIter)
+	for(; fpIter!=flowpipes.end(); ++fpIter, ++doIter, ++timeIter)
 	{
-		int tmp = maxOrder;
-		for(int i=0; i<tmvIter->tms.size(); ++i)
-		{
-			int order = tmvIter->tms[i].expansion.degree();
-			if(maxOrder < order)
-			{
-				maxOrder = order;
-			}
-		}
-
-		if(step_exp_table.size() == 0 || intStep != (*doIter)[0] || maxOrder > tmp)
-		{
-			construct_step_exp_table(step_exp_table, step_end_exp_table, (*doIter)[0].sup(), maxOrder);
-			intStep = (*doIter)[0];
-		}
-
-		vector<Interval> box;
-		tmvIter->intEvalNormal(box, step_exp_table);
-
-		Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
-
-		// output the vertices
-		fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
-		fprintf(fp, "%lf %lf\n", X.sup(), Y.inf());
-		fprintf(fp, "%lf %lf\n", X.sup(), Y.sup());
-		fprintf(fp, "%lf %lf\n", X.inf(), Y.sup());
-		fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
-		fprintf(fp, "\n\n");
+		dump_potential_counterexample(fp, *fpIter, *doIter, *timeIter);
 	}
-
-	fprintf(fp, "e\n");
 }
 
-void ContinuousReachability::plot_2D_octagon_GNUPLOT(FILE *fp) const
+void ContinuousReachability::dump_potential_counterexample(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain, const Interval & globalTime) const
 {
-	int x = outputAxes[0];
-	int y = outputAxes[1];
-
-	int rangeDim = stateVarNames.size();
-	Matrix output_poly_temp(8, rangeDim);
-
-	output_poly_temp.set(1, 0, x);
-	output_poly_temp.set(1, 1, y);
-	output_poly_temp.set(-1, 2, x);
-	output_poly_temp.set(-1, 3, y);
-	output_poly_temp.set(1/sqrt(2), 4, x);
-	output_poly_temp.set(1/sqrt(2), 4, y);
-	output_poly_temp.set(1/sqrt(2), 5, x);
-	output_poly_temp.set(-1/sqrt(2), 5, y);
-	output_poly_temp.set(-1/sqrt(2), 6, x);
-	output_poly_temp.set(1/sqrt(2), 6, y);
-	output_poly_temp.set(-1/sqrt(2), 7, x);
-	output_poly_temp.set(-1/sqrt(2), 7, y);
-
-	// Construct the 2D template matrix.
-	int rows = 8;
-	int cols = rangeDim;
-
-	Matrix sortedTemplate(rows, cols);
-	RowVector rowVec(cols);
-	list<RowVector> sortedRows;
-	list<RowVector>::iterator iterp, iterq;
-
-	output_poly_temp.row(rowVec, 0);
-	sortedRows.push_back(rowVec);
+	fprintf(fp, "starting time %lf\n{\n", globalTime.sup());
 
-	bool bInserted;
+	tmv.dump_interval(fp, stateVarNames, tmVarNames);
 
-	// Sort the row vectors in the template by anti-clockwise order (only in the x-y space).
-	for(int i=1; i<rows; ++i)
+	for(int i=0; i<domain.size(); ++i)
 	{
-		iterp = sortedRows.begin();
-		iterq = iterp;
-		++iterq;
-		bInserted = false;
+		fprintf(fp, "%s in ", tmVarNames[i].c_str());
+		domain[i].dump(fp);
+		fprintf(fp, "\n");
+	}
 
-		for(; iterq != sortedRows.end();)
-		{
-			double tmp1 = output_poly_temp.get(i,x) * iterp->get(y) - output_poly_temp.get(i,y) * iterp->get(x);
-			double tmp2 = output_poly_temp.get(i,x) * iterq->get(y) - output_poly_temp.get(i,y) * iterq->get(x);
+	fprintf(fp, "}\n\n\n");
+}
 
-			if(tmp1 < 0 && tmp2 > 0)
-			{
-				output_poly_temp.row(rowVec, i);
-				sortedRows.insert(iterq, rowVec);
-				bInserted = true;
-				break;
-			}
-			else
-			{
-				++iterp;
-				++iterq;
-			}
-		}
+FILE *ContinuousReachability::open_dumping_file() const
+{
+	char filename[NAME_SIZE+30];
+	sprintf(filename, "%s%s.flow", outputDir, outputFileName);
+	return fopen(filename, "w");
+}
 
-		if(!bInserted)
-		{
-			output_poly_temp.row(rowVec, i);
-			sortedRows.push_back(rowVec);
-		}
-	}
+FILE *ContinuousReachability::open_plotting_file() const
+{
+	char filename[NAME_SIZE+30];
 
-	iterp = sortedRows.begin();
-	for(int i=0; i<rows; ++i, ++iterp)
+	switch(plotFormat)
 	{
-		for(int j=0; j<cols; ++j)
-		{
-			sortedTemplate.set(iterp->get(j), i, j);
-		}
+	case PLOT_GNUPLOT:
+		sprintf(filename, "%s%s.plt", outputDir, outputFileName);
+		break;
+	case PLOT_MATLAB:
+		sprintf(filename, "%s%s.m", outputDir, outputFileName);
+		break;
 	}
 
-	ColVector b(rows);
-	Polyhedron polyTemplate(sortedTemplate, b);
-
-	fprintf(fp, "set terminal postscript\n");
+	return fopen(filename, "w");
+}
 
-	char filename[NAME_SIZE+10];
-	sprintf(filename, "%s%s.eps", imageDir, outputFileName);
-	fprintf(fp, "set output '%s'\n", filename);
+bool ContinuousReachability::plot_2D() const
+{
+	FILE *fpPlotting = open_plotting_file();
 
-	fprintf(fp, "set style line 1 linecolor rgb \"blue\"\n");
-	fprintf(fp, "set autoscale\n");
-	fprintf(fp, "unset label\n");
-	fprintf(fp, "set xtic auto\n");
-	fprintf(fp, "set ytic auto\n");
-	fprintf(fp, "set xlabel \"%s\"\n", stateVarNames[outputAxes[0]].c_str());
-	fprintf(fp, "set ylabel \"%s\"\n", stateVarNames[outputAxes[1]].c_str());
-	fprintf(fp, "plot '-' notitle with lines ls 1\n");
+	if(fpPlotting == NULL)
+	{
+		return false;
+	}
 
-	// Compute the intersections of two facets.
-	// The vertices are ordered clockwisely.
+	printf("Generating the plotting file...\n");
 
-	gsl_matrix *C = gsl_matrix_alloc(2,2);
-	gsl_vector *d = gsl_vector_alloc(2);
-	gsl_vector *vertex = gsl_vector_alloc(2);
+	plot_2D_header(fpPlotting);
+
+	Polyhedron polyTemplate;
+	if(plotSetting == PLOT_OCTAGON)
+	{
+		plot_2D_octagon_template(polyTemplate);
+	}
 
 	vector<Interval> step_exp_table, step_end_exp_table;
 	Interval intStep;
@@ -7302,73 +8595,28 @@ void ContinuousReachability::plot_2D_octagon_GNUPLOT(FILE *fp) const
 			intStep = (*doIter)[0];
 		}
 
+		plot_2D_flowpipe(fpPlotting, *tmvIter, *doIter, step_exp_table, polyTemplate);
+	}
 
-		templatePolyhedronNormal(polyTemplate, *tmvIter, step_exp_table);
-
-		double f1, f2;
-
-		list<LinearConstraint>::iterator iterp, iterq;
-		iterp = iterq = polyTemplate.constraints.begin();
-		++iterq;
-
-		for(; iterq != polyTemplate.constraints.end(); ++iterp, ++iterq)
-		{
-			gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
-			gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
-			gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
-			gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
-
-			gsl_vector_set(d, 0, iterp->B.midpoint());
-			gsl_vector_set(d, 1, iterq->B.midpoint());
-
-			gsl_linalg_HH_solve(C, d, vertex);
-
-			double v1 = gsl_vector_get(vertex, 0);
-			double v2 = gsl_vector_get(vertex, 1);
-
-			if(iterp == polyTemplate.constraints.begin())
-			{
-				f1 = v1;
-				f2 = v2;
-			}
-
-			fprintf(fp, "%lf %lf\n", v1, v2);
-		}
-
-		iterp = polyTemplate.constraints.begin();
-		--iterq;
-
-		gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
-		gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
-		gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
-		gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
-
-		gsl_vector_set(d, 0, iterp->B.midpoint());
-		gsl_vector_set(d, 1, iterq->B.midpoint());
-
-		gsl_linalg_HH_solve(C, d, vertex);
-
-		double v1 = gsl_vector_get(vertex, 0);
-		double v2 = gsl_vector_get(vertex, 1);
-
-		fprintf(fp, "%lf %lf\n", v1, v2);
+	plot_2D_footer(fpPlotting);
 
-		fprintf(fp, "%lf %lf\n", f1, f2);
-		fprintf(fp, "\n\n");
-	}
+	printf("Done.\n");
 
-	fprintf(fp, "e\n");
+	fclose(fpPlotting);
 
-	gsl_matrix_free(C);
-	gsl_vector_free(d);
-	gsl_vector_free(vertex);
+	return true;
 }
 
-void ContinuousReachability::plot_2D_grid_GNUPLOT(FILE *fp) const
+void ContinuousReachability::plot_2D_header(FILE *fp) const
 {
+	if(plotFormat != PLOT_GNUPLOT)
+	{
+		return;
+	}
+
 	fprintf(fp, "set terminal postscript\n");
 
-	char filename[NAME_SIZE+10];
+	char filename[NAME_SIZE+30];
 	sprintf(filename, "%s%s.eps", imageDir, outputFileName);
 	fprintf(fp, "set output '%s'\n", filename);
 
@@ -7380,108 +8628,53 @@ void ContinuousReachability::plot_2D_grid_GNUPLOT(FILE *fp) const
 	fprintf(fp, "set xlabel \"%s\"\n", stateVarNames[outputAxes[0]].c_str());
 	fprintf(fp, "set ylabel \"%s\"\n", stateVarNames[outputAxes[1]].c_str());
 	fprintf(fp, "plot '-' notitle with lines ls 1\n");
-
-	list<TaylorModelVec>::const_iterator tmvIter = flowpipesCompo.begin();
-	list<vector<Interval> >::const_iterator doIter = domains.begin();
-	int domainDim = doIter->size();
-
-	for(; tmvIter != flowpipesCompo.end() && doIter != domains.end(); ++tmvIter, ++doIter)
-	{
-		// decompose the domain
-		list<vector<Interval> > grids;
-
-		gridBox(grids, *doIter, numSections);
-
-		// we only consider the output dimensions
-		HornerForm hfOutputX;
-		Interval remainderX;
-		tmvIter->tms[outputAxes[0]].toHornerForm(hfOutputX, remainderX);
-
-		HornerForm hfOutputY;
-		Interval remainderY;
-		tmvIter->tms[outputAxes[1]].toHornerForm(hfOutputY, remainderY);
-
-		// evaluate the images from all of the grids
-		list<vector<Interval> >::const_iterator gIter = grids.begin();
-		for(; gIter!=grids.end(); ++gIter)
-		{
-			Interval X;
-			hfOutputX.intEval(X, *gIter);
-			X += remainderX;
-
-			Interval Y;
-			hfOutputY.intEval(Y, *gIter);
-			Y += remainderY;
-
-			// output the vertices
-			fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
-			fprintf(fp, "%lf %lf\n", X.sup(), Y.inf());
-			fprintf(fp, "%lf %lf\n", X.sup(), Y.sup());
-			fprintf(fp, "%lf %lf\n", X.inf(), Y.sup());
-			fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
-			fprintf(fp, "\n\n");
-		}
-	}
-
-	fprintf(fp, "e\n");
 }
 
-void ContinuousReachability::plot_2D_MATLAB(FILE *fp) const
+void ContinuousReachability::plot_2D_footer(FILE *fp) const
 {
-	switch(plotSetting)
+	if(plotFormat == PLOT_GNUPLOT)
 	{
-	case PLOT_INTERVAL:
-		plot_2D_interval_MATLAB(fp);
-		break;
-	case PLOT_OCTAGON:
-		plot_2D_octagon_MATLAB(fp);
-		break;
-	case PLOT_GRID:
-		plot_2D_grid_MATLAB(fp);
-		break;
+		fprintf(fp, "e\n");
 	}
 }
 
-void ContinuousReachability::plot_2D_interval_MATLAB(FILE *fp) const
+// the step_exp_table should be of an order no less than the degree of tmv
+void ContinuousReachability::plot_2D_flowpipe(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain, vector<Interval> & step_exp_table, Polyhedron & polyTemplate) const
 {
-	vector<Interval> step_exp_table, step_end_exp_table;
-	Interval intStep;
-
-	list<TaylorModelVec>::const_iterator tmvIter = flowpipesCompo.begin();
-	list<vector<Interval> >::const_iterator doIter = domains.begin();
-
-	int maxOrder = 0;
-
-	for(; tmvIter != flowpipesCompo.end() && doIter != domains.end(); ++tmvIter, ++doIter)
+	switch(plotFormat)
 	{
-		int tmp = maxOrder;
-		for(int i=0; i<tmvIter->tms.size(); ++i)
+	case PLOT_GNUPLOT:
+		switch(plotSetting)
 		{
-			int order = tmvIter->tms[i].expansion.degree();
-			if(maxOrder < order)
-			{
-				maxOrder = order;
-			}
+		case PLOT_INTERVAL:
+			plot_2D_interval_GNUPLOT(fp, tmv, step_exp_table);
+			break;
+		case PLOT_OCTAGON:
+			plot_2D_octagon_GNUPLOT(fp, tmv, step_exp_table, polyTemplate);
+			break;
+		case PLOT_GRID:
+			plot_2D_grid_GNUPLOT(fp, tmv, domain);
+			break;
 		}
-
-		if(step_exp_table.size() == 0 || intStep != (*doIter)[0] || maxOrder > tmp)
+		break;
+	case PLOT_MATLAB:
+		switch(plotSetting)
 		{
-			construct_step_exp_table(step_exp_table, step_end_exp_table, (*doIter)[0].sup(), maxOrder);
-			intStep = (*doIter)[0];
+		case PLOT_INTERVAL:
+			plot_2D_interval_MATLAB(fp, tmv, step_exp_table);
+			break;
+		case PLOT_OCTAGON:
+			plot_2D_octagon_MATLAB(fp, tmv, step_exp_table, polyTemplate);
+			break;
+		case PLOT_GRID:
+			plot_2D_grid_MATLAB(fp, tmv, domain);
+			break;
 		}
-
-		vector<Interval> box;
-		tmvIter->intEvalNormal(box, step_exp_table);
-
-		Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
-
-		// output all the vertices
-		fprintf(fp,"plot( [%lf,%lf,%lf,%lf,%lf] , [%lf,%lf,%lf,%lf,%lf] , 'b');\nhold on;\nclear;\n",
-				X.inf(), X.sup(), X.sup(), X.inf(), X.inf(), Y.inf(), Y.inf(), Y.sup(), Y.sup(), Y.inf());
+		break;
 	}
 }
 
-void ContinuousReachability::plot_2D_octagon_MATLAB(FILE *fp) const
+void ContinuousReachability::plot_2D_octagon_template(Polyhedron & polyTemplate) const
 {
 	int x = outputAxes[0];
 	int y = outputAxes[1];
@@ -7560,7 +8753,17 @@ void ContinuousReachability::plot_2D_octagon_MATLAB(FILE *fp) const
 	}
 
 	ColVector b(rows);
-	Polyhedron polyTemplate(sortedTemplate, b);
+	Polyhedron result(sortedTemplate, b);
+	polyTemplate = result;
+}
+
+// compute the vertices of the octagon which encloses the flowpipe, the last vertex is the first one
+void ContinuousReachability::plot_2D_octagon_vertices(vector<double> & vertices_x, vector<double> & vertices_y, const TaylorModelVec & tmv, vector<Interval> & step_exp_table, Polyhedron & polyTemplate) const
+{
+	int x = outputAxes[0];
+	int y = outputAxes[1];
+
+	templatePolyhedronNormal(polyTemplate, tmv, step_exp_table);
 
 	// Compute the intersections of two facets.
 	// The vertices are ordered clockwisely.
@@ -7569,151 +8772,197 @@ void ContinuousReachability::plot_2D_octagon_MATLAB(FILE *fp) const
 	gsl_vector *d = gsl_vector_alloc(2);
 	gsl_vector *vertex = gsl_vector_alloc(2);
 
-	vector<Interval> step_exp_table, step_end_exp_table;
-	Interval intStep;
-
-	list<TaylorModelVec>::const_iterator tmvIter = flowpipesCompo.begin();
-	list<vector<Interval> >::const_iterator doIter = domains.begin();
+	double f1, f2;
 
-	int maxOrder = 0;
+	list<LinearConstraint>::iterator iterp, iterq;
+	iterp = iterq = polyTemplate.constraints.begin();
+	++iterq;
 
-	for(; tmvIter != flowpipesCompo.end() && doIter != domains.end(); ++tmvIter, ++doIter)
+	for(; iterq != polyTemplate.constraints.end(); ++iterp, ++iterq)
 	{
-		int tmp = maxOrder;
-		for(int i=0; i<tmvIter->tms.size(); ++i)
-		{
-			int order = tmvIter->tms[i].expansion.degree();
-			if(maxOrder < order)
-			{
-				maxOrder = order;
-			}
-		}
+		gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
+		gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
+		gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
+		gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
 
-		if(step_exp_table.size() == 0 || intStep != (*doIter)[0] || maxOrder > tmp)
+		gsl_vector_set(d, 0, iterp->B.midpoint());
+		gsl_vector_set(d, 1, iterq->B.midpoint());
+
+		gsl_linalg_HH_solve(C, d, vertex);
+
+		double v1 = gsl_vector_get(vertex, 0);
+		double v2 = gsl_vector_get(vertex, 1);
+
+		if(iterp == polyTemplate.constraints.begin())
 		{
-			construct_step_exp_table(step_exp_table, step_end_exp_table, (*doIter)[0].sup(), maxOrder);
-			intStep = (*doIter)[0];
+			f1 = v1;
+			f2 = v2;
 		}
 
+		vertices_x.push_back(v1);
+		vertices_y.push_back(v2);
+	}
 
-		templatePolyhedronNormal(polyTemplate, *tmvIter, step_exp_table);
+	iterp = polyTemplate.constraints.begin();
+	--iterq;
 
-		double f1, f2;
+	gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
+	gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
+	gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
+	gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
 
-		list<LinearConstraint>::iterator iterp, iterq;
-		iterp = iterq = polyTemplate.constraints.begin();
-		++iterq;
+	gsl_vector_set(d, 0, iterp->B.midpoint());
+	gsl_vector_set(d, 1, iterq->B.midpoint());
 
-		vector<double> vertices_x, vertices_y;
+	gsl_linalg_HH_solve(C, d, vertex);
 
-		for(; iterq != polyTemplate.constraints.end(); ++iterp, ++iterq)
-		{
-			gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
-			gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
-			gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
-			gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
+	double v1 = gsl_vector_get(vertex, 0);
+	double v2 = gsl_vector_get(vertex, 1);
 
-			gsl_vector_set(d, 0, iterp->B.midpoint());
-			gsl_vector_set(d, 1, iterq->B.midpoint());
+	vertices_x.push_back(v1);
+	vertices_y.push_back(v2);
+	vertices_x.push_back(f1);
+	vertices_y.push_back(f2);
 
-			gsl_linalg_HH_solve(C, d, vertex);
+	gsl_matrix_free(C);
+	gsl_vector_free(d);
+	gsl_vector_free(vertex);
+}
 
-			double v1 = gsl_vector_get(vertex, 0);
-			double v2 = gsl_vector_get(vertex, 1);
+void ContinuousReachability::plot_2D_interval_GNUPLOT(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & step_exp_table) const
+{
+	vector<Interval> box;
+	tmv.intEvalNormal(box, step_exp_table);
+
+	Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
+
+	// output the vertices
+	fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
+	fprintf(fp, "%lf %lf\n", X.sup(), Y.inf());
+	fprintf(fp, "%lf %lf\n", X.sup(), Y.sup());
+	fprintf(fp, "%lf %lf\n", X.inf(), Y.sup());
+	fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
+	fprintf(fp, "\n\n");
+}
 
-			if(iterp == polyTemplate.constraints.begin())
-			{
-				f1 = v1;
-				f2 = v2;
-			}
+void ContinuousReachability::plot_2D_octagon_GNUPLOT(FILE *fp, const TaylorModelVec & tmv, vector<Interval> & step_exp_table, Polyhedron & polyTemplate) const
+{
+	vector<double> vertices_x, vertices_y;
+	plot_2D_octagon_vertices(vertices_x, vertices_y, tmv, step_exp_table, polyTemplate);
 
-			vertices_x.push_back(v1);
-			vertices_y.push_back(v2);
-		}
+	for(int i=0; i<vertices_x.size(); ++i)
+	{
+		fprintf(fp, "%lf %lf\n", vertices_x[i], vertices_y[i]);
+	}
 
-		iterp = polyTemplate.constraints.begin();
-		--iterq;
+	fprintf(fp, "\n\n");
+}
 
-		gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
-		gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
-		gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
-		gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
+void ContinuousReachability::plot_2D_grid_GNUPLOT(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain) const
+{
+	// decompose the domain
+	list<vector<Interval> > grids;
 
-		gsl_vector_set(d, 0, iterp->B.midpoint());
-		gsl_vector_set(d, 1, iterq->B.midpoint());
+	gridBox(grids, domain, numSections);
 
-		gsl_linalg_HH_solve(C, d, vertex);
+	// we only consider the output dimensions
+	HornerForm hfOutputX;
+	Interval remainderX;
+	tmv.tms[outputAxes[0]].toHornerForm(hfOutputX, remainderX);
 
-		double v1 = gsl_vector_get(vertex, 0);
-		double v2 = gsl_vector_get(vertex, 1);
+	HornerForm hfOutputY;
+	Interval remainderY;
+	tmv.tms[outputAxes[1]].toHornerForm(hfOutputY, remainderY);
 
-		vertices_x.push_back(v1);
-		vertices_y.push_back(v2);
-		vertices_x.push_back(f1);
-		vertices_y.push_back(f2);
+	// evaluate the images from all of the grids
+	list<vector<Interval> >::const_iterator gIter = grids.begin();
+	for(; gIter!=grids.end(); ++gIter)
+	{
+		Interval X;
+		hfOutputX.intEval(X, *gIter);
+		X += remainderX;
 
-		fprintf(fp, "plot( ");
+		Interval Y;
+		hfOutputY.intEval(Y, *gIter);
+		Y += remainderY;
 
-		fprintf(fp, "[ ");
-		for(int i=0; i<vertices_x.size()-1; ++i)
-		{
-			fprintf(fp, "%lf , ", vertices_x[i]);
-		}
-		fprintf(fp, "%lf ] , ", vertices_x.back());
+		// output the vertices
+		fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
+		fprintf(fp, "%lf %lf\n", X.sup(), Y.inf());
+		fprintf(fp, "%lf %lf\n", X.sup(), Y.sup());
+		fprintf(fp, "%lf %lf\n", X.inf(), Y.sup());
+		fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
+		fprintf(fp, "\n\n");
+	}
+}
 
-		fprintf(fp, "[ ");
-		for(int i=0; i<vertices_y.size()-1; ++i)
-		{
-			fprintf(fp, "%lf , ", vertices_y[i]);
-		}
-		fprintf(fp, "%lf ] , ", vertices_y.back());
+void ContinuousReachability::plot_2D_interval_MATLAB(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & step_exp_table) const
+{
+	vector<Interval> box;
+	tmv.intEvalNormal(box, step_exp_table);
 
-		fprintf(fp, "'b');\nhold on;\nclear;\n");
-	}
+	Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
 
-	gsl_matrix_free(C);
-	gsl_vector_free(d);
-	gsl_vector_free(vertex);
+	// output all the vertices
+	fprintf(fp,"plot( [%lf,%lf,%lf,%lf,%lf] , [%lf,%lf,%lf,%lf,%lf] , 'b');\nhold on;\nclear;\n",
+			X.inf(), X.sup(), X.sup(), X.inf(), X.inf(), Y.inf(), Y.inf(), Y.sup(), Y.sup(), Y.inf());
 }
 
-void ContinuousReachability::plot_2D_grid_MATLAB(FILE *fp) const
+void ContinuousReachability::plot_2D_octagon_MATLAB(FILE *fp, const TaylorModelVec & tmv, vector<Interval> & step_exp_table, Polyhedron & polyTemplate) const
 {
-	list<TaylorModelVec>::const_iterator tmvIter = flowpipesCompo.begin();
-	list<vector<Interval> >::const_iterator doIter = domains.begin();
-	int domainDim = doIter->size();
+	vector<double> vertices_x, vertices_y;
+	plot_2D_octagon_vertices(vertices_x, vertices_y, tmv, step_exp_table, polyTemplate);
 
-	for(; tmvIter != flowpipesCompo.end() && doIter != domains.end(); ++tmvIter, ++doIter)
+	fprintf(fp, "plot( ");
+
+	fprintf(fp, "[ ");
+	for(int i=0; i<vertices_x.size()-1; ++i)
 	{
-		// decompose the domain
-		list<vector<Interval> > grids;
+		fprintf(fp, "%lf , ", vertices_x[i]);
+	}
+	fprintf(fp, "%lf ] , ", vertices_x.back());
+
+	fprintf(fp, "[ ");
+	for(int i=0; i<vertices_y.size()-1; ++i)
+	{
+		fprintf(fp, "%lf , ", vertices_y[i]);
+	}
+	fprintf(fp, "%lf ] , ", vertices_y.back());
 
-		gridBox(grids, *doIter, numSections);
+	fprintf(fp, "'b');\nhold on;\nclear;\n");
+}
 
-		// we only consider the output dimensions
-		HornerForm hfOutputX;
-		Interval remainderX;
-		tmvIter->tms[outputAxes[0]].toHornerForm(hfOutputX, remainderX);
+void ContinuousReachability::plot_2D_grid_MATLAB(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain) const
+{
+	// decompose the domain
+	list<vector<Interval> > grids;
 
-		HornerForm hfOutputY;
-		Interval remainderY;
-		tmvIter->tms[outputAxes[1]].toHornerForm(hfOutputY, remainderY);
+	gridBox(grids, domain, numSections);
 
-		// evaluate the images from all of the grids
-		list<vector<Interval> >::const_iterator gIter = grids.begin();
-		for(; gIter!=grids.end(); ++gIter)
-		{
-			Interval X;
-			hfOutputX.intEval(X, *gIter);
-			X += remainderX;
+	// we only consider the output dimensions
+	HornerForm hfOutputX;
+	Interval remainderX;
+	tmv.tms[outputAxes[0]].toHornerForm(hfOutputX, remainderX);
 
-			Interval Y;
-			hfOutputY.intEval(Y, *gIter);
-			Y += remainderY;
+	HornerForm hfOutputY;
+	Interval remainderY;
+	tmv.tms[outputAxes[1]].toHornerForm(hfOutputY, remainderY);
 
-			// output the vertices
-			fprintf(fp,"plot( [%lf,%lf,%lf,%lf,%lf] , [%lf,%lf,%lf,%lf,%lf] , 'b');\nhold on;\nclear;\n",
-					X.inf(), X.sup(), X.sup(), X.inf(), X.inf(), Y.inf(), Y.inf(), Y.sup(), Y.sup(), Y.inf());
-		}
+	// evaluate the images from all of the grids
+	list<vector<Interval> >::const_iterator gIter = grids.begin();
+	for(; gIter!=grids.end(); ++gIter)
+	{
+		Interval X;
+		hfOutputX.intEval(X, *gIter);
+		X += remainderX;
+
+		Interval Y;
+		hfOutputY.intEval(Y, *gIter);
+		Y += remainderY;
+
+		// output the vertices
+		fprintf(fp,"plot( [%lf,%lf,%lf,%lf,%lf] , [%lf,%lf,%lf,%lf,%lf] , 'b');\nhold on;\nclear;\n",
+				X.inf(), X.sup(), X.sup(), X.inf(), X.inf(), Y.inf(), Y.inf(), Y.sup(), Y.sup(), Y.inf());
 	}
 }
 
@@ -7797,6 +9046,11 @@ bool ContinuousReachability::getTMVarName(string & vName, int id) const
 	}
 }
 
+void ContinuousReachability::initialConfig(const Flowpipe & initialSet)
+{
+	system.initialSet = initialSet;
+}
+
 void computeTaylorExpansion(TaylorModelVec & result, const TaylorModelVec & first_order_deriv, const TaylorModelVec & ode, const int order)
 {
 	vector<Interval> intVecZero;
@@ -7820,7 +9074,7 @@ void computeTaylorExpansion(TaylorModelVec & result, const TaylorModelVec & firs
 
 		TaylorModelVec tmvTemp2;
 		tmvTemp.evaluate_t(tmvTemp2, intVecZero);
-		tmvTemp2.mul_assign(factorial_rec[i]);
+		tmvTemp2.mul_assign(factorialTables->factorial_rec[i]);
 		tmvTemp2.mul_assign(0,i);			// multiplied by t^i
 //		tmvTemp2.nctrunc(order);
 
@@ -7868,7 +9122,7 @@ void computeTaylorExpansion(TaylorModelVec & result, const TaylorModelVec & firs
 
 			TaylorModel tmTemp2;
 			tmTemp.evaluate_t(tmTemp2, intVecZero);
-			tmTemp2.mul_assign(factorial_rec[j]);
+			tmTemp2.mul_assign(factorialTables->factorial_rec[j]);
 			tmTemp2.mul_assign(0,j);
 //			tmTemp2.nctrunc(orders[i]);
 
@@ -7883,7 +9137,62 @@ void computeTaylorExpansion(TaylorModelVec & result, const TaylorModelVec & firs
 		taylorExpansion.tms[i].cutoff();
 	}
 
-	result = taylorExpansion;
+	result = taylorExpansion;
+}
+
+bool isAffineODE(const TaylorModelVec & ode)
+{
+	int numVars = ode.tms.size() + 1;
+
+	for(int i=0; i<ode.tms.size(); ++i)
+	{
+		int d = ode.tms[i].degree();
+
+		if(d > 1)
+		{
+			return false;
+		}
+
+		if(d == 1)
+		{
+			vector<Interval> linear;
+			Interval intZero;
+
+			for(int j=0; j<numVars; ++j)
+			{
+				linear.push_back(intZero);
+			}
+
+			ode.tms[i].linearCoefficients(linear);
+
+			if(!linear[0].subseteq(intZero))
+			{
+				return false;		// depends on t
+			}
+		}
+	}
+
+	return true;
+}
+
+void linear_flow_orders(int & minOrder, int & maxOrder, const int orderType, const bool bAdaptiveOrders, const vector<int> & orders, const vector<int> & maxOrders)
+{
+	switch(orderType)
+	{
+	case UNIFORM:
+		minOrder = orders[0];
+		maxOrder = bAdaptiveOrders ? maxOrders[0] : orders[0];
+		break;
+	case MULTI:
+		minOrder = *max_element(orders.begin(), orders.end());
+		maxOrder = bAdaptiveOrders ? *max_element(maxOrders.begin(), maxOrders.end()) : minOrder;
+		break;
+	}
+
+	if(maxOrder < minOrder)
+	{
+		maxOrder = minOrder;
+	}
 }
 
 void construct_step_exp_table(vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const int order)
@@ -7918,8 +9227,10 @@ void construct_step_exp_table(vector<Interval> & step_exp_table, const Interval
 	}
 }
 
-void preconditionQR(Matrix & result, const TaylorModelVec & x0, const int rangeDim, const int domainDim)
+void preconditionQR(Matrix & result, Matrix & inverse, const TaylorModelVec & x0, const int rangeDim, const int domainDim)
 {
+	ProfileScope scope(PHASE_PRECONDITION);
+
 	Interval intZero;
 	vector<vector<Interval> > intCoefficients;
 
@@ -7944,8 +9255,127 @@ void preconditionQR(Matrix & result, const TaylorModelVec & x0, const int rangeD
 		}
 	}
 
-	matCoefficients.sortColumns();
-	matCoefficients.QRfactor(result);
+	// the components which only depend on a single variable, such as the constant parameters and the clocks, are
+	// not mixed with the others, so that they remain univariate and keep the polynomials in the Picard iteration sparse
+	vector<int> decoupled(rangeDim, -1);	// the variable of a decoupled component
+	vector<bool> bClaimed(rangeDim, false);
+	int numDecoupled = 0;
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		int var = -1;
+		int numNonzeros = 0;
+
+		for(int j=0; j<rangeDim; ++j)
+		{
+			if(matCoefficients.get(i,j) != 0)
+			{
+				var = j;
+				++numNonzeros;
+			}
+		}
+
+		if(numNonzeros == 1 && !bClaimed[var])
+		{
+			decoupled[i] = var;
+			bClaimed[var] = true;
+			++numDecoupled;
+		}
+	}
+
+	if(numDecoupled == 0)
+	{
+		matCoefficients.sortColumns();
+		matCoefficients.QRfactor(result);
+		result.transpose(inverse);
+		return;
+	}
+
+	/*
+	 * Up to a permutation, the result is A = [Q B; 0 I] where Q is the orthogonal factor of the coupled components over
+	 * the unclaimed variables, and B keeps their linear dependency on the decoupled components, in the new variables
+	 * of the decoupled components. The inverse is [Q^T -Q^T*B; 0 I].
+	 */
+	vector<int> rows, cols, decoupledRows;
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		if(decoupled[i] >= 0)
+		{
+			decoupledRows.push_back(i);
+		}
+		else
+		{
+			rows.push_back(i);
+		}
+
+		if(!bClaimed[i])
+		{
+			cols.push_back(i);
+		}
+	}
+
+	int numCoupled = rows.size();
+
+	result = Matrix(rangeDim, rangeDim);
+	inverse = Matrix(rangeDim, rangeDim);
+
+	for(int k=0; k<numDecoupled; ++k)
+	{
+		result.set(1, decoupledRows[k], decoupled[decoupledRows[k]]);
+		inverse.set(1, decoupled[decoupledRows[k]], decoupledRows[k]);
+	}
+
+	if(numCoupled > 0)
+	{
+		Matrix matCoupled(numCoupled, numCoupled), Q(numCoupled, numCoupled), B(numCoupled, numDecoupled);
+
+		for(int i=0; i<numCoupled; ++i)
+		{
+			for(int j=0; j<numCoupled; ++j)
+			{
+				matCoupled.set(matCoefficients.get(rows[i], cols[j]), i, j);
+			}
+
+			for(int k=0; k<numDecoupled; ++k)
+			{
+				int var = decoupled[decoupledRows[k]];
+				B.set(matCoefficients.get(rows[i], var) / matCoefficients.get(decoupledRows[k], var), i, k);
+			}
+		}
+
+		matCoupled.sortColumns();
+		matCoupled.QRfactor(Q);
+
+		for(int i=0; i<numCoupled; ++i)
+		{
+			for(int j=0; j<numCoupled; ++j)
+			{
+				result.set(Q.get(i,j), rows[i], cols[j]);
+				inverse.set(Q.get(i,j), cols[j], rows[i]);
+			}
+
+			for(int k=0; k<numDecoupled; ++k)
+			{
+				result.set(B.get(i,k), rows[i], decoupled[decoupledRows[k]]);
+			}
+		}
+
+		for(int j=0; j<numCoupled; ++j)
+		{
+			for(int k=0; k<numDecoupled; ++k)
+			{
+				double sum = 0;
+
+				for(int i=0; i<numCoupled; ++i)
+				{
+					sum -= Q.get(i,j) * B.get(i,k);
+				}
+
+				inverse.set(sum, cols[j], decoupledRows[k]);
+			}
+		}
+	}
 }
 
 Interval rho(const TaylorModelVec & tmv, const vector<Interval> & l, const vector<Interval> & domain)
@@ -8043,69 +9473,393 @@ void templatePolyhedron(Polyhedron & result, const TaylorModelVec & tmv, const v
 	}
 }
 
-void templatePolyhedronNormal(Polyhedron & result, const TaylorModelVec & tmv, vector<Interval> & step_exp_table)
+void templatePolyhedronNormal(Polyhedron & result, const TaylorModelVec & tmv, vector<Interval> & step_exp_table)
+{
+	list<LinearConstraint>::iterator iter;
+	for(iter=result.constraints.begin(); iter!=result.constraints.end(); ++iter)
+	{
+		iter->B = rhoNormal(tmv, iter->A, step_exp_table);
+	}
+}
+
+int intersection_check_interval_arithmetic(const vector<PolynomialConstraint> & pcs, const vector<HornerTape> & objFuncs, const vector<Interval> & remainders, const vector<Interval> & domain, vector<bool> & bNeeded)
+{
+	int counter = 0;
+	bNeeded.clear();
+	vector<Interval> registers;
+
+	for(int i=0; i<pcs.size(); ++i)
+	{
+		Interval intTemp;
+		objFuncs[i].intEval(intTemp, domain, registers);
+		intTemp += remainders[i];
+
+		if(intTemp > pcs[i].B)
+		{
+			// no intersection
+			return -1;
+		}
+		else if(intTemp.smallereq(pcs[i].B))
+		{
+			// the flowpipe is entirely contained in the guard, domain contraction is not needed
+			bNeeded.push_back(false);
+			++counter;
+		}
+		else
+		{
+			bNeeded.push_back(true);
+		}
+	}
+
+	return counter;
+}
+
+bool boundary_intersected_collection(const vector<PolynomialConstraint> & pcs, const vector<HornerTape> & objFuncs, const vector<Interval> & remainders, const vector<Interval> & domain, vector<bool> & boundary_intersected)
+{
+	boundary_intersected.clear();
+	vector<Interval> registers;
+
+	for(int i=0; i<pcs.size(); ++i)
+	{
+		Interval intTemp;
+		objFuncs[i].intEval(intTemp, domain, registers);
+		intTemp += remainders[i];
+
+		if(intTemp > pcs[i].B)
+		{
+			// no intersection
+			return false;
+		}
+		else if(intTemp < pcs[i].B)
+		{
+			// do not intersect the boundary
+			boundary_intersected.push_back(false);
+		}
+		else
+		{
+			boundary_intersected.push_back(true);
+		}
+	}
+
+	return true;
+}
+
+void flowpipe_hull(vector<Interval> & hull, const TaylorModelVec & flowpipe, const vector<Interval> & flowpipePolyRange, const vector<Interval> & domain)
+{
+	hull.clear();
+	hull.push_back(domain[0]);
+
+	for(int i=0; i<flowpipe.tms.size(); ++i)
+	{
+		hull.push_back(flowpipePolyRange[i] + flowpipe.tms[i].getRemainder());
+	}
+}
+
+void flowpipe_hull(vector<Interval> & hull, const TaylorModelVec & flowpipe, const vector<Interval> & domain)
+{
+	vector<Interval> flowpipePolyRange;
+	flowpipe.polyRange(flowpipePolyRange, domain);
+
+	flowpipe_hull(hull, flowpipe, flowpipePolyRange, domain);
+}
+
+int intersection_check_hull(const vector<PolynomialConstraint> & pcs, const vector<Interval> & hull)
+{
+	int counter = 0;
+
+	for(int i=0; i<pcs.size(); ++i)
+	{
+		Interval intTemp;
+		pcs[i].hf.intEval(intTemp, hull);
+
+		if(intTemp > pcs[i].B)
+		{
+			// no intersection
+			return -1;
+		}
+		else if(intTemp.smallereq(pcs[i].B))
+		{
+			++counter;
+		}
+	}
+
+	return counter;
+}
+
+// the objective functions p(T(x)) of the constraints p <= B over the domain of the flowpipe T
+static void contraction_objectives(vector<TaylorModel> & objectives, vector<HornerForm> & objForms, vector<HornerTape> & objHF, vector<Interval> & remainders,
+		const TaylorModelVec & flowpipe, const vector<Interval> & flowpipePolyRange, const vector<Interval> & domain, const vector<PolynomialConstraint> & pcs)
+{
+	objectives.clear();
+	objForms.clear();
+	objHF.clear();
+	remainders.clear();
+
+	for(int i=0; i<pcs.size(); ++i)
+	{
+		TaylorModel tmTemp;
+		pcs[i].hf.insert(tmTemp, flowpipe, flowpipePolyRange, domain);
+
+		HornerForm hf;
+		Interval remainder;
+		tmTemp.toHornerForm(hf, remainder);
+
+		objectives.push_back(tmTemp);
+		objForms.push_back(hf);
+		objHF.push_back(HornerTape(hf));
+		remainders.push_back(remainder);
+	}
+}
+
+// the partial derivative of the j-th objective function with respect to the i-th variable, computed on the first use
+static const HornerTape & objective_derivative(vector<vector<HornerTape> > & objDerivatives, vector<vector<bool> > & bDerivatives,
+		const vector<TaylorModel> & objectives, const int j, const int i)
+{
+	if(!bDerivatives[j][i])
+	{
+		TaylorModel tmDerivative;
+		objectives[j].derivative(tmDerivative, i);
+
+		HornerForm hf;
+		Interval intZero;
+		tmDerivative.toHornerForm(hf, intZero);
+
+		objDerivatives[j][i] = HornerTape(hf);
+		bDerivatives[j][i] = true;
+	}
+
+	return objDerivatives[j][i];
+}
+
+// an interval Newton step for p(x) <= bound in the i-th variable, p(x) is in p(x|xi=m) + dp/dxi(X)*(xi-m) by the mean
+// value theorem, the values of xi at which the lower bound of this form exceeds the bound are removed
+static bool newton_contract(vector<Interval> & domain, const int i, const HornerTape & objHF, const HornerTape & derivative, const Interval & bound,
+		vector<Interval> & slice, vector<Interval> & registers)
+{
+	Interval intZero;
+	Interval M(domain[i].midpoint());
+
+	if(!M.subseteq(domain[i]))
+	{
+		return true;
+	}
+
+	Interval D;
+	derivative.intEval(D, domain, registers);
+
+	slice = domain;
+	slice[i] = M;
+
+	Interval Q;
+	objHF.intEval(Q, slice, registers);
+
+	// a = bound - inf(p(x|xi=m)), rounded upward
+	Interval Qinf, a;
+	Q.inf(Qinf);
+	(bound - Qinf).sup(a);
+
+	Interval Dinf, Dsup;
+	D.inf(Dinf);
+	D.sup(Dsup);
+
+	bool bNegative = a < intZero;
+
+	// the feasible t = xi - m are the t >= 0 with inf(D)*t <= a and the t <= 0 with sup(D)*t <= a
+	bool bPos = true, bNeg = true;
+	bool bPosInf = false, bPosSup = false, bNegInf = false, bNegSup = false;
+	Interval posInf, posSup, negInf, negSup;
+
+	if(Dinf > intZero)
+	{
+		if(bNegative)
+		{
+			bPos = false;
+		}
+		else
+		{
+			posSup = a / Dinf;
+			bPosSup = true;
+		}
+	}
+	else if(Dinf < intZero)
+	{
+		if(bNegative)
+		{
+			posInf = a / Dinf;
+			bPosInf = true;
+		}
+	}
+	else if(bNegative)
+	{
+		bPos = false;
+	}
+
+	if(Dsup < intZero)
+	{
+		if(bNegative)
+		{
+			bNeg = false;
+		}
+		else
+		{
+			negInf = a / Dsup;
+			bNegInf = true;
+		}
+	}
+	else if(Dsup > intZero)
+	{
+		if(bNegative)
+		{
+			negSup = a / Dsup;
+			bNegSup = true;
+		}
+	}
+	else if(bNegative)
+	{
+		bNeg = false;
+	}
+
+	if(!bPos && !bNeg)
+	{
+		return false;
+	}
+
+	// the hull of the feasible values of xi
+	Interval X(-DBL_MAX, DBL_MAX);
+	Interval B;
+
+	if(!bNeg || bNegInf)
+	{
+		Interval T = bNeg ? negInf : (bPosInf ? posInf : intZero);
+		(M + T).inf(B);
+		X.setInf(B);
+	}
+
+	if(!bPos || bPosSup)
+	{
+		Interval T = bPos ? posSup : (bNegSup ? negSup : intZero);
+		(M + T).sup(B);
+		X.setSup(B);
+	}
+
+	return domain[i].intersect_assign(X);
+}
+
+// whether all of the constraints which may be violated may be satisfied when the i-th variable is at the bound, the
+// bisection does not move a bound at which this holds since every half which contains it passes the test as well
+static bool bound_may_satisfy(const vector<Interval> & domain, const int i, const Interval & bound, const vector<PolynomialConstraint> & pcs,
+		const vector<HornerTape> & objHF, const vector<Interval> & remainders, const vector<bool> & bNeeded, vector<Interval> & newDomain, vector<Interval> & registers)
+{
+	newDomain = domain;
+	newDomain[i] = bound;
+
+	for(int j=0; j<pcs.size(); ++j)
+	{
+		if(bNeeded[j])
+		{
+			Interval intTemp;
+			objHF[j].intEval(intTemp, newDomain, registers);
+			intTemp += remainders[j];
+
+			if(intTemp > pcs[j].B)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+// narrows the domain by the constraints which may be violated: the forward-backward propagation is applied to all of the
+// variables, then the interval Newton steps to the variables whose bounds still violate the constraints, returns false
+// if the domain becomes empty
+static bool contract_hc4_newton(vector<Interval> & domain, const vector<PolynomialConstraint> & pcs, const vector<TaylorModel> & objectives,
+		const vector<HornerForm> & objForms, const vector<HornerTape> & objHF, const vector<Interval> & remainders, const vector<bool> & bNeeded)
 {
-	list<LinearConstraint>::iterator iter;
-	for(iter=result.constraints.begin(); iter!=result.constraints.end(); ++iter)
+	int domainDim = domain.size();
+
+	// p(T(x)) <= sup(B - remainder)
+	vector<Interval> bounds(pcs.size());
+
+	for(int j=0; j<pcs.size(); ++j)
 	{
-		iter->B = rhoNormal(tmv, iter->A, step_exp_table);
+		(pcs[j].B - remainders[j]).sup(bounds[j]);
 	}
-}
-
-int intersection_check_interval_arithmetic(const vector<PolynomialConstraint> & pcs, const vector<HornerForm> & objFuncs, const vector<Interval> & remainders, const vector<Interval> & domain, vector<bool> & bNeeded)
-{
-	int counter = 0;
-	bNeeded.clear();
 
-	for(int i=0; i<pcs.size(); ++i)
+	for(int k=0; k<DC_CONTRACTOR_ROUNDS; ++k)
 	{
-		Interval intTemp;
-		objFuncs[i].intEval(intTemp, domain);
-		intTemp += remainders[i];
+		vector<Interval> oldDomain = domain;
 
-		if(intTemp > pcs[i].B)
+		for(int j=0; j<pcs.size(); ++j)
 		{
-			// no intersection
-			return -1;
+			if(bNeeded[j])
+			{
+				Interval range(-DBL_MAX, DBL_MAX);
+				range.setSup(bounds[j]);
+
+				if(!objForms[j].contract(domain, range))
+				{
+					return false;
+				}
+			}
 		}
-		else if(intTemp.smallereq(pcs[i].B))
+
+		bool bImproved = false;
+		for(int i=0; i<domainDim; ++i)
 		{
-			// the flowpipe is entirely contained in the guard, domain contraction is not needed
-			bNeeded.push_back(false);
-			++counter;
+			if(oldDomain[i].widthRatio(domain[i]) <= DC_THRESHOLD_IMPROV)
+			{
+				bImproved = true;
+				break;
+			}
 		}
-		else
+
+		if(!bImproved)
 		{
-			bNeeded.push_back(true);
+			break;
 		}
 	}
 
-	return counter;
-}
+	vector<vector<HornerTape> > objDerivatives(pcs.size(), vector<HornerTape>(domainDim));
+	vector<vector<bool> > bDerivatives(pcs.size(), vector<bool>(domainDim, false));
 
-bool boundary_intersected_collection(const vector<PolynomialConstraint> & pcs, const vector<HornerForm> & objFuncs, const vector<Interval> & remainders, const vector<Interval> & domain, vector<bool> & boundary_intersected)
-{
-	boundary_intersected.clear();
+	vector<Interval> slice;
+	vector<Interval> registers;
 
-	for(int i=0; i<pcs.size(); ++i)
+	for(int i=0; i<domainDim; ++i)
 	{
-		Interval intTemp;
-		objFuncs[i].intEval(intTemp, domain);
-		intTemp += remainders[i];
-
-		if(intTemp > pcs[i].B)
-		{
-			// no intersection
-			return false;
-		}
-		else if(intTemp < pcs[i].B)
-		{
-			// do not intersect the boundary
-			boundary_intersected.push_back(false);
-		}
-		else
+		for(int k=0; k<DC_CONTRACTOR_ROUNDS; ++k)
 		{
-			boundary_intersected.push_back(true);
+			Interval Inf, Sup;
+			domain[i].inf(Inf);
+			domain[i].sup(Sup);
+
+			if(bound_may_satisfy(domain, i, Inf, pcs, objHF, remainders, bNeeded, slice, registers)
+					&& bound_may_satisfy(domain, i, Sup, pcs, objHF, remainders, bNeeded, slice, registers))
+			{
+				break;
+			}
+
+			Interval oldInt = domain[i];
+
+			for(int j=0; j<pcs.size(); ++j)
+			{
+				if(bNeeded[j])
+				{
+					const HornerTape & derivative = objective_derivative(objDerivatives, bDerivatives, objectives, j, i);
+
+					if(!newton_contract(domain, i, objHF[j], derivative, bounds[j], slice, registers))
+					{
+						return false;
+					}
+				}
+			}
+
+			if(oldInt.widthRatio(domain[i]) > DC_THRESHOLD_IMPROV)
+			{
+				break;
+			}
 		}
 	}
 
@@ -8114,32 +9868,40 @@ bool boundary_intersected_collection(const vector<PolynomialConstraint> & pcs, c
 
 int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & domain, const vector<PolynomialConstraint> & pcs, vector<bool> & boundary_intersected)
 {
-	int rangeDim = flowpipe.tms.size();
+	ProfileScope scope(PHASE_CONTRACTION);
+
 	int domainDim = domain.size();
 
-	// the Horner forms of p(T(x))
-	vector<HornerForm> objHF;
+	// the objective functions p(T(x)), they are evaluated by the contractors and the bisection below
+	vector<TaylorModel> objectives;
+	vector<HornerForm> objForms;
+	vector<HornerTape> objHF;
 	vector<Interval> remainders;
 
+	// the hull of the flowpipe already decides the flowpipes which are far from the boundary of the constraints
 	vector<Interval> flowpipePolyRange;
 	flowpipe.polyRange(flowpipePolyRange, domain);
 
-	for(int i=0; i<pcs.size(); ++i)
-	{
-		TaylorModel tmTemp;
-		pcs[i].hf.insert(tmTemp, flowpipe, flowpipePolyRange, domain);
+	vector<Interval> hull;
+	flowpipe_hull(hull, flowpipe, flowpipePolyRange, domain);
 
-		HornerForm hf;
-		Interval remainder;
-		tmTemp.toHornerForm(hf, remainder);
-		objHF.push_back(hf);
-		remainders.push_back(remainder);
+	int counter = intersection_check_hull(pcs, hull);
+
+	if(counter == -1)
+	{
+		return -1;	// no intersection is detected
+	}
+	else if(counter == pcs.size())
+	{
+		return 0;	// domain is not contracted
 	}
 
+	contraction_objectives(objectives, objForms, objHF, remainders, flowpipe, flowpipePolyRange, domain, pcs);
+
 	// check the type of the intersections
 	vector<bool> bNeeded;
 
-	int counter = intersection_check_interval_arithmetic(pcs, objHF, remainders, domain, bNeeded);
+	counter = intersection_check_interval_arithmetic(pcs, objHF, remainders, domain, bNeeded);
 
 	if(counter == -1)
 	{
@@ -8156,11 +9918,24 @@ int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & d
 	bool bcontinue = true;
 
 	Interval W;
+	Interval intZero;
+
+	// the workspace of the bisection
+	vector<Interval> newDomain;
+	vector<Interval> registers;
 
 	for(; bcontinue; )
 	{
 		vector<Interval> oldDomain = domain;
 
+		// the contractors remove most of the infeasible part, the bisection then only refines the bounds which they
+		// leave at infeasible points
+		if(!contract_hc4_newton(domain, pcs, objectives, objForms, objHF, remainders, bNeeded))
+		{
+			bvalid = false;
+			break;
+		}
+
 		// contract the domain
 		for(int i=0; i<domainDim; ++i)
 		{
@@ -8168,7 +9943,18 @@ int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & d
 			vector<bool> localNeeded = bNeeded;
 			int localCounter = counter;
 
-			newInt.width(W);
+			Interval Inf;
+			newInt.inf(Inf);
+
+			// the bisection does not move a bound at which the constraints may be satisfied
+			if(bound_may_satisfy(domain, i, Inf, pcs, objHF, remainders, bNeeded, newDomain, registers))
+			{
+				W = intZero;
+			}
+			else
+			{
+				newInt.width(W);
+			}
 
 			// search an approximation for the lower bound
 			for(; W >= DC_THRESHOLD_SEARCH;)
@@ -8181,11 +9967,11 @@ int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & d
 				{
 					if(localNeeded[j])
 					{
-						vector<Interval> newDomain = domain;
+						newDomain = domain;
 						newDomain[i] = intLeft;
 
 						Interval intTemp;
-						objHF[j].intEval(intTemp, newDomain);
+						objHF[j].intEval(intTemp, newDomain, registers);
 						intTemp += remainders[j];
 
 						if(intTemp > pcs[j].B)
@@ -8221,7 +10007,6 @@ int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & d
 			}
 
 			// set the lower bound
-			Interval Inf;
 			newInt.inf(Inf);
 			domain[i].setInf(Inf);
 
@@ -8230,7 +10015,17 @@ int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & d
 			localNeeded = bNeeded;
 			localCounter = counter;
 
-			newInt.width(W);
+			Interval Sup;
+			newInt.sup(Sup);
+
+			if(bound_may_satisfy(domain, i, Sup, pcs, objHF, remainders, bNeeded, newDomain, registers))
+			{
+				W = intZero;
+			}
+			else
+			{
+				newInt.width(W);
+			}
 
 			// search an approximation for the upper bound
 			for(; W >= DC_THRESHOLD_SEARCH;)
@@ -8243,11 +10038,11 @@ int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & d
 				{
 					if(localNeeded[j])
 					{
-						vector<Interval> newDomain = domain;
+						newDomain = domain;
 						newDomain[i] = intRight;
 
 						Interval intTemp;
-						objHF[j].intEval(intTemp, newDomain);
+						objHF[j].intEval(intTemp, newDomain, registers);
 						intTemp += remainders[j];
 
 						if(intTemp > pcs[j].B)
@@ -8281,7 +10076,6 @@ int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & d
 				}
 			}
 
-			Interval Sup;
 			newInt.sup(Sup);
 			domain[i].setSup(Sup);	// set the upper bound
 
@@ -8309,23 +10103,8 @@ int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & d
 
 		if(bcontinue)
 		{
-			objHF.clear();
-			remainders.clear();
-
 			flowpipe.polyRange(flowpipePolyRange, domain);
-
-			for(int i=0; i<pcs.size(); ++i)
-			{
-				TaylorModel tmTemp;
-
-				pcs[i].hf.insert(tmTemp, flowpipe, flowpipePolyRange, domain);
-
-				HornerForm hf;
-				Interval remainder;
-				tmTemp.toHornerForm(hf, remainder);
-				objHF.push_back(hf);
-				remainders.push_back(remainder);
-			}
+			contraction_objectives(objectives, objForms, objHF, remainders, flowpipe, flowpipePolyRange, domain, pcs);
 		}
 	}
 
@@ -8352,6 +10131,275 @@ int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & d
 	}
 }
 
+class ParallelTasks
+{
+public:
+	void (*task)(void *, const int);
+	void *arg;
+	int numTasks;
+	int next;						// the next task to be taken
+	pthread_mutex_t mutex;
+	volatile int *stop;				// no more tasks are taken once it is set, may be NULL
+
+	mpfr_prec_t precision;			// the numerical settings of the calling thread
+	double cutoff;
+
+	Profiler *profiler;				// the profiler, the step log and the factorial tables of the calling thread
+	StepLog *stepLog;
+	FactorialTables *factorialTables;
+};
+
+static void *parallel_worker(void *arg)
+{
+	ParallelTasks *tasks = (ParallelTasks *)arg;
+
+	intervalNumPrecision = tasks->precision;
+	cutoff_threshold = tasks->cutoff;
+	profiler = tasks->profiler;
+	stepLog = tasks->stepLog;
+	factorialTables = tasks->factorialTables;
+
+	for(;;)
+	{
+		pthread_mutex_lock(&tasks->mutex);
+		int i = tasks->next++;
+		pthread_mutex_unlock(&tasks->mutex);
+
+		if(i >= tasks->numTasks || (tasks->stop != NULL && *tasks->stop))
+		{
+			break;
+		}
+
+		tasks->task(tasks->arg, i);
+	}
+
+	return NULL;
+}
+
+void runParallelTasks(void (*task)(void *, const int), void *arg, const int numTasks, const int numThreads, volatile int *stop)
+{
+	ParallelTasks tasks;
+	tasks.task = task;
+	tasks.arg = arg;
+	tasks.numTasks = numTasks;
+	tasks.next = 0;
+	tasks.stop = stop;
+	pthread_mutex_init(&tasks.mutex, NULL);
+	tasks.precision = intervalNumPrecision;
+	tasks.cutoff = cutoff_threshold;
+	tasks.profiler = profiler;
+	tasks.stepLog = stepLog;
+	tasks.factorialTables = factorialTables;
+
+	int num = numThreads < numTasks ? numThreads : numTasks;
+	vector<pthread_t> threads;
+
+	for(int i=1; i<num; ++i)
+	{
+		pthread_t thread;
+		if(pthread_create(&thread, NULL, parallel_worker, &tasks) == 0)
+		{
+			threads.push_back(thread);
+		}
+	}
+
+	parallel_worker(&tasks);		// the calling thread also works
+
+	for(int i=0; i<threads.size(); ++i)
+	{
+		pthread_join(threads[i], NULL);
+	}
+
+	pthread_mutex_destroy(&tasks.mutex);
+}
+
+void write_flowpipe_file_header(FILE *fp, const int type)
+{
+	fwrite(str_flowpipe_file_magic, sizeof(char), 8, fp);
+
+	unsigned int header[4] = {FLOWPIPE_FILE_VERSION, FLOWPIPE_FILE_BOM, (unsigned int)type, 0};
+	fwrite(header, sizeof(unsigned int), 4, fp);
+}
+
+void write_flowpipe_file_end(FILE *fp)
+{
+	unsigned int tag = FLOWPIPE_RECORD_END;
+	fwrite(&tag, sizeof(unsigned int), 1, fp);
+}
+
+void write_flowpipe_record(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain)
+{
+	unsigned int header[3] = {FLOWPIPE_RECORD_FLOWPIPE, (unsigned int)tmv.tms.size(), (unsigned int)domain.size()};
+	fwrite(header, sizeof(unsigned int), 3, fp);
+
+	// the lower bounds of the domain followed by the upper bounds
+	vector<double> bounds(2*domain.size());
+	for(int i=0; i<domain.size(); ++i)
+	{
+		bounds[i] = domain[i].inf();
+		bounds[domain.size() + i] = domain[i].sup();
+	}
+
+	if(bounds.size() > 0)
+	{
+		fwrite(&bounds[0], sizeof(double), bounds.size(), fp);
+	}
+
+	tmv.dump_binary(fp, domain.size());
+}
+
+void write_mode_record(FILE *fp, const int modeID)
+{
+	unsigned int record[2] = {FLOWPIPE_RECORD_MODE, (unsigned int)modeID};
+	fwrite(record, sizeof(unsigned int), 2, fp);
+}
+
+// class FlowpipeFileReader
+
+FlowpipeFileReader::FlowpipeFileReader()
+{
+	fd = -1;
+	data = NULL;
+	size = 0;
+	p = NULL;
+}
+
+FlowpipeFileReader::~FlowpipeFileReader()
+{
+	close();
+}
+
+bool FlowpipeFileReader::open(const char *filename, const int type)
+{
+	close();
+
+	fd = ::open(filename, O_RDONLY);
+	if(fd < 0)
+	{
+		return false;
+	}
+
+	struct stat st;
+	if(fstat(fd, &st) < 0 || st.st_size == 0)
+	{
+		close();
+		return false;
+	}
+
+	size = st.st_size;
+
+	void *addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if(addr == MAP_FAILED)
+	{
+		close();
+		return false;
+	}
+
+	data = (char *)addr;
+	madvise(data, size, MADV_SEQUENTIAL);		// the records are read only once from the beginning to the end
+
+	p = data;
+	const char *end = data + size;
+
+	char magic[8];
+	unsigned int header[4];
+
+	if(!read_binary(magic, 8, p, end) || memcmp(magic, str_flowpipe_file_magic, 8) != 0 || !read_binary(header, sizeof(header), p, end))
+	{
+		close();
+		return false;
+	}
+
+	if(header[0] != FLOWPIPE_FILE_VERSION || header[1] != FLOWPIPE_FILE_BOM || header[2] != type)
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+int FlowpipeFileReader::next(int & modeID, TaylorModelVec & tmv, vector<Interval> & domain)
+{
+	const char *end = data + size;
+
+	unsigned int tag;
+	if(!read_binary(&tag, sizeof(unsigned int), p, end))
+	{
+		return -1;		// the file is truncated
+	}
+
+	switch(tag)
+	{
+	case FLOWPIPE_RECORD_END:
+		return FLOWPIPE_RECORD_END;
+
+	case FLOWPIPE_RECORD_MODE:
+	{
+		unsigned int id;
+		if(!read_binary(&id, sizeof(unsigned int), p, end))
+		{
+			return -1;
+		}
+
+		modeID = id;
+		return FLOWPIPE_RECORD_MODE;
+	}
+
+	case FLOWPIPE_RECORD_FLOWPIPE:
+	{
+		unsigned int dims[2];
+		if(!read_binary(dims, sizeof(dims), p, end) || dims[0] > (end - p) / (2*sizeof(unsigned int) + 2*sizeof(double))
+				|| dims[1] > (end - p) / (2*sizeof(double)))
+		{
+			return -1;
+		}
+
+		int rangeDim = dims[0];
+		int domainDim = dims[1];
+
+		vector<double> bounds(2*domainDim);
+		if(domainDim > 0 && !read_binary(&bounds[0], bounds.size()*sizeof(double), p, end))
+		{
+			return -1;
+		}
+
+		domain.resize(domainDim);
+		for(int i=0; i<domainDim; ++i)
+		{
+			domain[i].set(bounds[i], bounds[domainDim + i]);
+		}
+
+		if(!tmv.load_binary(p, end, rangeDim, domainDim))
+		{
+			return -1;
+		}
+
+		return FLOWPIPE_RECORD_FLOWPIPE;
+	}
+	}
+
+	return -1;
+}
+
+void FlowpipeFileReader::close()
+{
+	if(data != NULL)
+	{
+		munmap(data, size);
+		data = NULL;
+	}
+
+	if(fd >= 0)
+	{
+		::close(fd);
+		fd = -1;
+	}
+
+	size = 0;
+	p = NULL;
+}
+
 void gridBox(list<vector<Interval> > & grids, const vector<Interval> & box, const int num)
 {
 	grids.clear();
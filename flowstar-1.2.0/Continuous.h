@@ -13,6 +13,39 @@
 #include "TaylorModel.h"
 #include "Geometry.h"
 
+class Flowpipe;
+
+class FlowpipeConsumer			// receives the flowpipes once they are computed, the integration stops if receive returns false
+{
+public:
+	virtual ~FlowpipeConsumer() {}
+	virtual bool receive(const Flowpipe & flowpipe) = 0;
+};
+
+class LinearFlow				// the flow of an affine ODE x' = A*x + b + u over a time step [0,h], u is bounded by the uncertainties
+{
+private:
+	vector<vector<vector<Interval> > > coefficients;	// the Taylor coefficients M^k/k! of exp(M*t) where M = [A b; 0 0]
+	vector<vector<Interval> > hull;						// an interval enclosure of exp(A*t) over [0,h]
+	vector<Interval> truncation;						// row i of the truncated part of exp(M*t) is bounded by truncation[i] in the infinity norm
+	vector<Interval> inputs;							// an enclosure of the input term over [0,h]
+	int order;
+public:
+	LinearFlow();
+	LinearFlow(const LinearFlow & flow);
+	~LinearFlow();
+
+	// use the smallest order in [minOrder, maxOrder] whose truncation error is negligible,
+	// returns false if the Taylor series can not be bounded for the step size
+	bool build(const TaylorModelVec & ode, const vector<Interval> & uncertainties, const double step, const int minOrder, const int maxOrder);
+
+	LinearFlow & operator = (const LinearFlow & flow);
+
+	friend class Flowpipe;
+	friend class ContinuousSystem;
+	friend class HybridSystem;
+};
+
 class Flowpipe					// A flowpipe is represented by a composition of two Taylor models. The left Taylor model is the preconditioning part.
 {
 private:
@@ -39,6 +72,12 @@ public:
 
 	void normalize();
 
+	// split the domain into num pieces by bisecting the widest dimension of the widest piece, the pieces are normalized
+	void split(list<Flowpipe> & results, const int num) const;
+
+	// integration scheme for affine ODEs, the Picard iteration is replaced by the linear flow
+	bool advance_linear(Flowpipe & result, const LinearFlow & flow, const int precondition, const vector<Interval> & step_exp_table, const vector<Interval> & step_end_exp_table) const;
+
 	// fast integration scheme for low-degree ODEs
 	// fixed step sizes and orders
 	bool advance_low_degree(Flowpipe & result, const vector<HornerForm> & ode, const vector<HornerForm> & taylorExpansion, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties) const;
@@ -69,21 +108,22 @@ public:
 
 	// integration scheme for non-polynomial ODEs (using Taylor approximations)
 	// fixed step sizes and orders
-	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
-	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
+	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
+	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
 
 	// adaptive step sizes and fixed orders
-	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
-	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
+	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const int order, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
+	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const double miniStep, const vector<int> & orders, const int globalMaxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
 
 	// adaptive orders and fixed step sizes
-	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, int & order, const int maxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
-	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<string> & strOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, vector<int> & orders, const int localMaxOrder, const vector<int> & maxOrders, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
+	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, int & order, const int maxOrder, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
+	bool advance_non_polynomial_taylor(Flowpipe & result, const vector<Expression> & exprOde, const int precondition, vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, vector<int> & orders, const int localMaxOrder, const vector<int> & maxOrders, const vector<Interval> & estimation, const vector<Interval> & uncertainties, const vector<Interval> & uncertainty_centers) const;
 
 	Flowpipe & operator = (const Flowpipe & flowpipe);
 
 	friend class ContinuousSystem;
 	friend class ContinuousReachability;
+	friend class ContinuousSafetyMonitor;
 	friend class HybridSystem;
 	friend class HybridReachability;
 };
@@ -96,11 +136,13 @@ private:
 	Flowpipe initialSet;			// the initial set
 	vector<Interval> uncertainties;
 	vector<Interval> uncertainty_centers;
-	vector<string> strOde;
+	vector<Expression> exprOde;
+	FlowpipeConsumer *consumer;		// the stage which receives the computed flowpipes, may be NULL
+	bool bStreaming;				// the flowpipes are only handed to the consumer and not kept in the results
 public:
 	ContinuousSystem();
 	ContinuousSystem(const TaylorModelVec & ode_input, const vector<Interval> & uncertainties_input, const Flowpipe & initialSet_input);
-	ContinuousSystem(const vector<string> & strOde_input, const vector<Interval> & uncertainties_input, const Flowpipe & initialSet_input);
+	ContinuousSystem(const vector<Expression> & exprOde_input, const vector<Interval> & uncertainties_input, const Flowpipe & initialSet_input);
 	ContinuousSystem(const ContinuousSystem & system);
 	~ContinuousSystem();
 
@@ -143,7 +185,12 @@ public:
 	void reach_non_polynomial_taylor(list<Flowpipe> & results, const double step, const double time, const int order, const int maxOrder, const int precondition, const vector<Interval> & estimation, const bool bPrint, const vector<string> & stateVarNames) const;
 	void reach_non_polynomial_taylor(list<Flowpipe> & results, const double step, const double time, const vector<int> & orders, const vector<int> & maxOrders, const int globalMaxOrder, const int precondition, const vector<Interval> & estimation, const bool bPrint, const vector<string> & stateVarNames) const;
 
+	// for affine ODEs, the step size is only reduced down to miniStep if the flow can not be built for it
+	void reach_linear(list<Flowpipe> & results, const double step, const double miniStep, const double time, const int minOrder, const int maxOrder, const int precondition, const bool bPrint, const vector<string> & stateVarNames) const;
+
 	ContinuousSystem & operator = (const ContinuousSystem & system);
+
+	friend class ContinuousReachability;
 };
 
 class ContinuousReachability		// The reachability analysis of continuous systems
@@ -170,12 +217,22 @@ public:
 
 	bool bPrint;
 	bool bSafetyChecking;
+	bool bOnlineChecking;			// compose and check the flowpipes once they are computed
+	int checkingResult;				// the result of the online checking
+	Interval violationTime;			// the time interval in which the unsafe set is definitely reached
+	bool bStreaming;				// plot, dump and check the flowpipes once they are computed and then free them
+	unsigned long numOfStreamedFlowpipes;
+	bool bBinaryDumping;			// the flowpipes are dumped to a binary file next to the text dump
 
 	int integrationScheme;
 
+	int numSplits;					// the number of the sub-boxes of the initial set
+	int numThreads;					// the number of the worker threads
+
 	list<Flowpipe> flowpipes;
 	list<TaylorModelVec> flowpipesCompo;
 	list<vector<Interval> > domains;
+	vector<unsigned long> numOfPieceFlowpipes;		// the number of the flowpipes of each sub-box, empty if the initial set is not split
 
 	vector<PolynomialConstraint> unsafeSet;
 
@@ -190,26 +247,46 @@ public:
 	ContinuousReachability();
 	~ContinuousReachability();
 
-	void dump(FILE *fp) const;
+	bool dump(FILE *fp) const;		// returns false if the binary file can not be created
+	void dump_header(FILE *fp) const;
+	void dump_flowpipe(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain) const;
+	void dump_footer(FILE *fp) const;
+	FILE *open_dumping_file() const;		// the file openers return NULL if the file can not be created
+
+	FILE *open_binary_dumping_file() const;
+	void dump_binary(FILE *fp) const;
+	bool load_binary();
 
-	void run();
+	void reach(list<Flowpipe> & results, const ContinuousSystem & sys) const;
+	bool run();		// returns false if the output files for streaming can not be created
 	void composition();
 	int safetyChecking() const;
+	int check_flowpipe(const TaylorModelVec & tmv, const int domainDim, const vector<Interval> & step_exp_table) const;
 	unsigned long numOfFlowpipes() const;
 
 	void dump_potential_counterexample(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, const list<Interval> & globalTimes) const;
+	void dump_potential_counterexample(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain, const Interval & globalTime) const;
+	void dump_potential_counterexamples(const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, const list<Interval> & globalTimes) const;
+	FILE *open_counterexample_file() const;
+
+	bool plot_2D() const;		// returns false if the plotting file can not be created
+	FILE *open_plotting_file() const;
 
-	void plot_2D() const;
+	// the plotting file is written one flowpipe at a time
+	void plot_2D_header(FILE *fp) const;
+	void plot_2D_flowpipe(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain, vector<Interval> & step_exp_table, Polyhedron & polyTemplate) const;
+	void plot_2D_footer(FILE *fp) const;
 
-	void plot_2D_GNUPLOT(FILE *fp) const;
-	void plot_2D_interval_GNUPLOT(FILE *fp) const;
-	void plot_2D_octagon_GNUPLOT(FILE *fp) const;
-	void plot_2D_grid_GNUPLOT(FILE *fp) const;
+	void plot_2D_octagon_template(Polyhedron & polyTemplate) const;
+	void plot_2D_octagon_vertices(vector<double> & vertices_x, vector<double> & vertices_y, const TaylorModelVec & tmv, vector<Interval> & step_exp_table, Polyhedron & polyTemplate) const;
 
-	void plot_2D_MATLAB(FILE *fp) const;
-	void plot_2D_interval_MATLAB(FILE *fp) const;
-	void plot_2D_octagon_MATLAB(FILE *fp) const;
-	void plot_2D_grid_MATLAB(FILE *fp) const;
+	void plot_2D_interval_GNUPLOT(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & step_exp_table) const;
+	void plot_2D_octagon_GNUPLOT(FILE *fp, const TaylorModelVec & tmv, vector<Interval> & step_exp_table, Polyhedron & polyTemplate) const;
+	void plot_2D_grid_GNUPLOT(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain) const;
+
+	void plot_2D_interval_MATLAB(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & step_exp_table) const;
+	void plot_2D_octagon_MATLAB(FILE *fp, const TaylorModelVec & tmv, vector<Interval> & step_exp_table, Polyhedron & polyTemplate) const;
+	void plot_2D_grid_MATLAB(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain) const;
 
 	bool declareStateVar(const string & vName);
 	int getIDForStateVar(const string & vName) const;
@@ -218,15 +295,22 @@ public:
 	bool declareTMVar(const string & vName);
 	int getIDForTMVar(const string & vName) const;
 	bool getTMVarName(string & vName, const int id) const;
+
+	void initialConfig(const Flowpipe & initialSet);
 };
 
 void computeTaylorExpansion(TaylorModelVec & result, const TaylorModelVec & first_order_deriv, const TaylorModelVec & ode, const int order);
 void computeTaylorExpansion(TaylorModelVec & result, const TaylorModelVec & first_order_deriv, const TaylorModelVec & ode, const vector<int> & orders);
 
+bool isAffineODE(const TaylorModelVec & ode);		// the right-hand side is affine in the state variables and does not depend on t
+
+// the range of the orders of the linear flow for the order settings
+void linear_flow_orders(int & minOrder, int & maxOrder, const int orderType, const bool bAdaptiveOrders, const vector<int> & orders, const vector<int> & maxOrders);
+
 void construct_step_exp_table(vector<Interval> & step_exp_table, vector<Interval> & step_end_exp_table, const double step, const int order);
 void construct_step_exp_table(vector<Interval> & step_exp_table, const Interval & step, const int order);
 
-void preconditionQR(Matrix & result, const TaylorModelVec & tmv, const int rangeDim, const int domainDim);
+void preconditionQR(Matrix & result, Matrix & inverse, const TaylorModelVec & tmv, const int rangeDim, const int domainDim);		// the inverse is also returned
 
 Interval rho(const TaylorModelVec & tmv, const vector<Interval> & l, const vector<Interval> & domain);
 Interval rhoNormal(const TaylorModelVec & tmv, const vector<Interval> & l, const vector<Interval> & step_end_exp_table);
@@ -238,11 +322,49 @@ void templatePolyhedron(Polyhedron & result, const TaylorModelVec & tmv, const v
 void templatePolyhedronNormal(Polyhedron & result, const TaylorModelVec & tmv, vector<Interval> & step_end_exp_table);
 
 int intersection_check_interval_arithmetic(const list<PolynomialConstraint> & pcs, const list<HornerForm> & objFuncs, const list<Interval> & remainders, const vector<Interval> & domain, list<bool> & bNeeded);
-bool boundary_intersected_collection(const vector<PolynomialConstraint> & pcs, const vector<HornerForm> & objFuncs, const vector<Interval> & remainders, const vector<Interval> & domain, vector<bool> & boundary_intersected);
+bool boundary_intersected_collection(const vector<PolynomialConstraint> & pcs, const vector<HornerTape> & objFuncs, const vector<Interval> & remainders, const vector<Interval> & domain, vector<bool> & boundary_intersected);
+
+// the interval hull of a flowpipe, its first component is the time interval of the domain
+void flowpipe_hull(vector<Interval> & hull, const TaylorModelVec & flowpipe, const vector<Interval> & flowpipePolyRange, const vector<Interval> & domain);
+void flowpipe_hull(vector<Interval> & hull, const TaylorModelVec & flowpipe, const vector<Interval> & domain);
+
+// the rejection test of the constraints over the hull, returns -1 if the hull is disjoint from them, otherwise the number of the constraints which are satisfied by the entire hull
+int intersection_check_hull(const vector<PolynomialConstraint> & pcs, const vector<Interval> & hull);
 
 // domain contraction by using interval arithmetic
 int contract_interval_arithmetic(TaylorModelVec & flowpipe, vector<Interval> & domain, const vector<PolynomialConstraint> & pcs, vector<bool> & boundary_intersected);
 
 void gridBox(list<vector<Interval> > & grids, const vector<Interval> & box, const int num);
 
+// the binary flowpipe file
+void write_flowpipe_file_header(FILE *fp, const int type);
+void write_flowpipe_file_end(FILE *fp);
+void write_flowpipe_record(FILE *fp, const TaylorModelVec & tmv, const vector<Interval> & domain);
+void write_mode_record(FILE *fp, const int modeID);
+
+class FlowpipeFileReader		// reads a binary flowpipe file through a memory mapping
+{
+private:
+	int fd;
+	char *data;
+	size_t size;
+	const char *p;
+
+	FlowpipeFileReader(const FlowpipeFileReader & reader);
+	FlowpipeFileReader & operator = (const FlowpipeFileReader & reader);
+public:
+	FlowpipeFileReader();
+	~FlowpipeFileReader();
+
+	bool open(const char *filename, const int type);	// map the file and check its header
+
+	// read the next record, returns its type or -1 if the file is corrupted
+	int next(int & modeID, TaylorModelVec & tmv, vector<Interval> & domain);
+
+	void close();
+};
+
+// run the tasks 0, ..., numTasks-1 on a pool of worker threads, no more tasks are started once *stop is set
+void runParallelTasks(void (*task)(void *, const int), void *arg, const int numTasks, const int numThreads, volatile int *stop = NULL);
+
 #endif /* CONTINUOUS_H_ */
@@ -0,0 +1,597 @@
+/*---
+  Flow*: A Taylor Model Based Flowpipe analyzer.
+  Authors: Xin Chen, Erika Abraham and Sriram Sankaranarayanan.
+  Email: Xin Chen <xin.chen@cs.rwth-aachen.de> if you have questions or comments.
+
+  The code is released as is under the GNU General Public License (GPL). Please consult the file LICENSE.txt for
+  further information.
+---*/
+
+#include "Expression.h"
+#include "TaylorModel.h"
+
+// class ExpressionNode
+
+ExpressionNode::ExpressionNode()
+{
+	type = EXPR_CONSTANT;
+	left = -1;
+	right = -1;
+	n = 0;
+}
+
+ExpressionNode::ExpressionNode(const int type_input, const int left_input, const int right_input, const int n_input)
+{
+	type = type_input;
+	left = left_input;
+	right = right_input;
+	n = n_input;
+}
+
+ExpressionNode::ExpressionNode(const Interval & I)
+{
+	type = EXPR_CONSTANT;
+	left = -1;
+	right = -1;
+	n = 0;
+	value = I;
+}
+
+ExpressionNode::ExpressionNode(const ExpressionNode & node)
+{
+	type = node.type;
+	left = node.left;
+	right = node.right;
+	n = node.n;
+	value = node.value;
+}
+
+ExpressionNode::~ExpressionNode()
+{
+}
+
+bool ExpressionNode::isConstant() const
+{
+	return type == EXPR_CONSTANT;
+}
+
+bool ExpressionNode::operator == (const ExpressionNode & node) const
+{
+	if(type != node.type || left != node.left || right != node.right || n != node.n)
+		return false;
+
+	if(type == EXPR_CONSTANT)
+		return value == node.value;
+
+	return true;
+}
+
+ExpressionNode & ExpressionNode::operator = (const ExpressionNode & node)
+{
+	if(this == &node)
+		return *this;
+
+	type = node.type;
+	left = node.left;
+	right = node.right;
+	n = node.n;
+	value = node.value;
+
+	return *this;
+}
+
+
+// class Expression
+
+Expression::Expression()
+{
+	root = -1;
+}
+
+Expression::Expression(const Expression & expr)
+{
+	nodes = expr.nodes;
+	root = expr.root;
+}
+
+Expression::~Expression()
+{
+	nodes.clear();
+}
+
+void Expression::clear()
+{
+	nodes.clear();
+	root = -1;
+}
+
+bool Expression::isEmpty() const
+{
+	return root < 0;
+}
+
+int Expression::size() const
+{
+	return nodes.size();
+}
+
+bool Expression::isConstant(Interval & value) const
+{
+	if(root < 0 || !nodes[root].isConstant())
+	{
+		return false;
+	}
+
+	value = nodes[root].value;
+	return true;
+}
+
+int Expression::append(const ExpressionNode & node)
+{
+	// share the node if it is already in the DAG
+	for(int i=0; i<nodes.size(); ++i)
+	{
+		if(nodes[i] == node)
+		{
+			return i;
+		}
+	}
+
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+int Expression::constant(const Interval & I)
+{
+	ExpressionNode node(I);
+	return append(node);
+}
+
+int Expression::variable(const int varIndex)
+{
+	ExpressionNode node(EXPR_VARIABLE, -1, -1, varIndex);
+	return append(node);
+}
+
+int Expression::unary(const int type, const int operand)
+{
+	if(nodes[operand].isConstant())
+	{
+		const Interval & I = nodes[operand].value;
+		Interval intZero;
+
+		switch(type)
+		{
+		case EXPR_NEG:
+		{
+			Interval result;
+			I.inv(result);
+			return constant(result);
+		}
+		case EXPR_EXP:
+			return constant(I.exp());
+		case EXPR_SIN:
+			return constant(I.sin());
+		case EXPR_COS:
+			return constant(I.cos());
+		case EXPR_LOG:
+			if(I.inf() > 0)
+			{
+				return constant(I.log());
+			}
+			break;
+		case EXPR_SQRT:
+			if(I.inf() >= 0)
+			{
+				Interval result;
+				I.sqrt(result);
+				return constant(result);
+			}
+			break;
+		}
+	}
+
+	ExpressionNode node(type, operand, -1, 0);
+	return append(node);
+}
+
+int Expression::binary(const int type, const int left, const int right)
+{
+	if(nodes[left].isConstant() && nodes[right].isConstant())
+	{
+		const Interval & I = nodes[left].value;
+		const Interval & J = nodes[right].value;
+
+		switch(type)
+		{
+		case EXPR_ADD:
+			return constant(I + J);
+		case EXPR_SUB:
+			return constant(I - J);
+		case EXPR_MUL:
+			return constant(I * J);
+		case EXPR_DIV:
+			if(J.inf() > 0 || J.sup() < 0)
+			{
+				return constant(I / J);
+			}
+			break;
+		}
+	}
+
+	ExpressionNode node(type, left, right, 0);
+	return append(node);
+}
+
+int Expression::power(const int operand, const int exponent)
+{
+	if(exponent == 0)
+	{
+		Interval intOne(1);
+		return constant(intOne);
+	}
+	else if(exponent == 1)
+	{
+		return operand;
+	}
+
+	if(nodes[operand].isConstant())
+	{
+		return constant(nodes[operand].value.pow(exponent));
+	}
+
+	ExpressionNode node(EXPR_POW, operand, -1, exponent);
+	return append(node);
+}
+
+void Expression::setRoot(const int index)
+{
+	root = index;
+}
+
+void Expression::taylor_picard(TaylorModel & result, list<Interval> & ranges, const TaylorModelVec & vars, const vector<Interval> & step_exp_table, const int numVars, const int order) const
+{
+	vector<TaylorModel> values(nodes.size());
+
+	for(int i=0; i<nodes.size(); ++i)
+	{
+		const ExpressionNode & node = nodes[i];
+
+		switch(node.type)
+		{
+		case EXPR_CONSTANT:
+		{
+			TaylorModel tmConstant(node.value, numVars);
+			values[i] = tmConstant;
+			break;
+		}
+		case EXPR_VARIABLE:
+			values[i] = vars.tms[node.n];
+			break;
+		case EXPR_ADD:
+			values[node.left].add(values[i], values[node.right]);
+			break;
+		case EXPR_SUB:
+			values[node.left].sub(values[i], values[node.right]);
+			break;
+		case EXPR_MUL:
+		{
+			Interval intPoly1, intPoly2, intTrunc;
+
+			values[node.right].polyRangeNormal(intPoly2, step_exp_table);
+			values[node.left].mul_insert_ctrunc_normal(values[i], intPoly1, intTrunc, values[node.right], intPoly2, step_exp_table, order);
+
+			ranges.push_back(intPoly1);
+			ranges.push_back(intPoly2);
+			ranges.push_back(intTrunc);
+			break;
+		}
+		case EXPR_DIV:
+		{
+			TaylorModel tmRec;
+			values[node.right].rec_taylor(tmRec, ranges, step_exp_table, numVars, order);
+
+			Interval intPoly1, intPoly2, intTrunc;
+
+			tmRec.polyRangeNormal(intPoly2, step_exp_table);
+			values[node.left].mul_insert_ctrunc_normal(values[i], intPoly1, intTrunc, tmRec, intPoly2, step_exp_table, order);
+
+			ranges.push_back(intPoly1);
+			ranges.push_back(intPoly2);
+			ranges.push_back(intTrunc);
+			break;
+		}
+		case EXPR_NEG:
+			values[node.left].inv(values[i]);
+			break;
+		case EXPR_POW:
+		{
+			const TaylorModel & tmBase = values[node.left];
+			values[i] = tmBase;
+
+			Interval intPoly1, intPoly2, intTrunc;
+			tmBase.polyRangeNormal(intPoly2, step_exp_table);
+
+			for(int k=2; k<=node.n; ++k)
+			{
+				values[i].mul_insert_ctrunc_normal_assign(intPoly1, intTrunc, tmBase, intPoly2, step_exp_table, order);
+
+				ranges.push_back(intPoly1);
+				ranges.push_back(intPoly2);
+				ranges.push_back(intTrunc);
+			}
+			break;
+		}
+		case EXPR_EXP:
+			values[node.left].exp_taylor(values[i], ranges, step_exp_table, numVars, order);
+			break;
+		case EXPR_SIN:
+			values[node.left].sin_taylor(values[i], ranges, step_exp_table, numVars, order);
+			break;
+		case EXPR_COS:
+			values[node.left].cos_taylor(values[i], ranges, step_exp_table, numVars, order);
+			break;
+		case EXPR_LOG:
+			values[node.left].log_taylor(values[i], ranges, step_exp_table, numVars, order);
+			break;
+		case EXPR_SQRT:
+			values[node.left].sqrt_taylor(values[i], ranges, step_exp_table, numVars, order);
+			break;
+		}
+	}
+
+	result = values[root];
+}
+
+void Expression::taylor_remainder(Interval & result, list<Interval>::iterator & iterRange, const TaylorModelVec & vars, const int order) const
+{
+	vector<Interval> values(nodes.size());
+
+	for(int i=0; i<nodes.size(); ++i)
+	{
+		const ExpressionNode & node = nodes[i];
+
+		switch(node.type)
+		{
+		case EXPR_CONSTANT:
+			break;
+		case EXPR_VARIABLE:
+			values[i] = vars.tms[node.n].remainder;
+			break;
+		case EXPR_ADD:
+			values[i] = values[node.left] + values[node.right];
+			break;
+		case EXPR_SUB:
+			values[i] = values[node.left] - values[node.right];
+			break;
+		case EXPR_MUL:
+		{
+			const Interval & rem1 = values[node.left];
+			const Interval & rem2 = values[node.right];
+
+			values[i] = (*iterRange) * rem2;
+			++iterRange;
+			values[i] += (*iterRange) * rem1;
+			values[i] += rem1 * rem2;
+			++iterRange;
+			values[i] += (*iterRange);
+			++iterRange;
+			break;
+		}
+		case EXPR_DIV:
+		{
+			Interval rem2;
+			rec_taylor_only_remainder(rem2, values[node.right], iterRange, order);
+
+			const Interval & rem1 = values[node.left];
+
+			values[i] = (*iterRange) * rem2;
+			++iterRange;
+			values[i] += (*iterRange) * rem1;
+			values[i] += rem1 * rem2;
+			++iterRange;
+			values[i] += (*iterRange);
+			++iterRange;
+			break;
+		}
+		case EXPR_NEG:
+			values[node.left].inv(values[i]);
+			break;
+		case EXPR_POW:
+		{
+			const Interval & remBase = values[node.left];
+			values[i] = remBase;
+
+			for(int k=2; k<=node.n; ++k)
+			{
+				Interval intTemp;
+				intTemp = (*iterRange) * remBase;
+				++iterRange;
+				intTemp += (*iterRange) * values[i];
+				intTemp += remBase * values[i];
+				++iterRange;
+				intTemp += (*iterRange);
+				++iterRange;
+
+				values[i] = intTemp;
+			}
+			break;
+		}
+		case EXPR_EXP:
+			exp_taylor_only_remainder(values[i], values[node.left], iterRange, order);
+			break;
+		case EXPR_SIN:
+			sin_taylor_only_remainder(values[i], values[node.left], iterRange, order);
+			break;
+		case EXPR_COS:
+			cos_taylor_only_remainder(values[i], values[node.left], iterRange, order);
+			break;
+		case EXPR_LOG:
+			log_taylor_only_remainder(values[i], values[node.left], iterRange, order);
+			break;
+		case EXPR_SQRT:
+			sqrt_taylor_only_remainder(values[i], values[node.left], iterRange, order);
+			break;
+		}
+	}
+
+	result = values[root];
+}
+
+void Expression::taylor_polynomial(Polynomial & result, const TaylorModelVec & vars, const int numVars, const int order) const
+{
+	vector<Polynomial> values(nodes.size());
+
+	for(int i=0; i<nodes.size(); ++i)
+	{
+		const ExpressionNode & node = nodes[i];
+
+		switch(node.type)
+		{
+		case EXPR_CONSTANT:
+		{
+			Polynomial polyConstant(node.value, numVars);
+			values[i] = polyConstant;
+			break;
+		}
+		case EXPR_VARIABLE:
+			values[i] = vars.tms[node.n].expansion;
+			break;
+		case EXPR_ADD:
+			values[i] = values[node.left] + values[node.right];
+			break;
+		case EXPR_SUB:
+			values[i] = values[node.left] - values[node.right];
+			break;
+		case EXPR_MUL:
+			values[node.left].mul_nctrunc(values[i], values[node.right], order);
+			values[i].cutoff();
+			break;
+		case EXPR_DIV:
+		{
+			Polynomial polyRec;
+			values[node.right].rec_taylor(polyRec, numVars, order);
+
+			values[node.left].mul_nctrunc(values[i], polyRec, order);
+			values[i].cutoff();
+			break;
+		}
+		case EXPR_NEG:
+			values[node.left].inv(values[i]);
+			break;
+		case EXPR_POW:
+		{
+			Interval intOne(1);
+			Polynomial polyTemp(intOne, numVars);
+
+			for(int k=0; k<node.n; ++k)
+			{
+				polyTemp.mul_nctrunc_assign(values[node.left], order);
+			}
+
+			values[i] = polyTemp;
+			values[i].cutoff();
+			break;
+		}
+		case EXPR_EXP:
+			values[node.left].exp_taylor(values[i], numVars, order);
+			break;
+		case EXPR_SIN:
+			values[node.left].sin_taylor(values[i], numVars, order);
+			break;
+		case EXPR_COS:
+			values[node.left].cos_taylor(values[i], numVars, order);
+			break;
+		case EXPR_LOG:
+			values[node.left].log_taylor(values[i], numVars, order);
+			break;
+		case EXPR_SQRT:
+			values[node.left].sqrt_taylor(values[i], numVars, order);
+			break;
+		}
+	}
+
+	result = values[root];
+}
+
+void Expression::toString(string & result, const vector<string> & varNames) const
+{
+	result.clear();
+
+	if(root >= 0)
+	{
+		toString(result, root, varNames);
+	}
+}
+
+void Expression::toString(string & result, const int index, const vector<string> & varNames) const
+{
+	const ExpressionNode & node = nodes[index];
+
+	switch(node.type)
+	{
+	case EXPR_CONSTANT:
+	{
+		string strValue;
+		node.value.toString(strValue);
+		result += strValue;
+		break;
+	}
+	case EXPR_VARIABLE:
+		result += varNames[node.n];
+		break;
+	case EXPR_ADD:
+	case EXPR_SUB:
+	case EXPR_MUL:
+	case EXPR_DIV:
+	{
+		const char op[] = {'+', '-', '*', '/'};
+
+		result += '(';
+		toString(result, node.left, varNames);
+		result += ' ';
+		result += op[node.type - EXPR_ADD];
+		result += ' ';
+		toString(result, node.right, varNames);
+		result += ')';
+		break;
+	}
+	case EXPR_NEG:
+		result += "-(";
+		toString(result, node.left, varNames);
+		result += ')';
+		break;
+	case EXPR_POW:
+	{
+		char strNum[NUM_LENGTH];
+		sprintf(strNum, "%d", node.n);
+
+		result += '(';
+		toString(result, node.left, varNames);
+		result += ")^";
+		result += strNum;
+		break;
+	}
+	default:
+	{
+		const char *fun[] = {"exp", "sin", "cos", "log", "sqrt"};
+
+		result += fun[node.type - EXPR_EXP];
+		result += '(';
+		toString(result, node.left, varNames);
+		result += ')';
+		break;
+	}
+	}
+}
+
+Expression & Expression::operator = (const Expression & expr)
+{
+	if(this == &expr)
+		return *this;
+
+	nodes = expr.nodes;
+	root = expr.root;
+
+	return *this;
+}
@@ -0,0 +1,94 @@
+/*---
+  Flow*: A Taylor Model Based Flowpipe analyzer.
+  Authors: Xin Chen, Erika Abraham and Sriram Sankaranarayanan.
+  Email: Xin Chen <xin.chen@cs.rwth-aachen.de> if you have questions or comments.
+
+  The code is released as is under the GNU General Public License (GPL). Please consult the file LICENSE.txt for
+  further information.
+---*/
+
+#ifndef EXPRESSION_H_
+#define EXPRESSION_H_
+
+#include "Polynomial.h"
+
+#define EXPR_CONSTANT	0
+#define EXPR_VARIABLE	1
+#define EXPR_ADD		2
+#define EXPR_SUB		3
+#define EXPR_MUL		4
+#define EXPR_DIV		5
+#define EXPR_NEG		6
+#define EXPR_POW		7
+#define EXPR_EXP		8
+#define EXPR_SIN		9
+#define EXPR_COS		10
+#define EXPR_LOG		11
+#define EXPR_SQRT		12
+
+class ExpressionNode
+{
+public:
+	int type;			// the operation of the node
+	int left;			// index of the first operand
+	int right;			// index of the second operand
+	int n;				// the index of a variable or the exponent of a power
+	Interval value;		// the value of a constant
+public:
+	ExpressionNode();
+	ExpressionNode(const int type_input, const int left_input, const int right_input, const int n_input);
+	ExpressionNode(const Interval & I);
+	ExpressionNode(const ExpressionNode & node);
+	~ExpressionNode();
+
+	bool isConstant() const;
+
+	bool operator == (const ExpressionNode & node) const;
+	ExpressionNode & operator = (const ExpressionNode & node);
+};
+
+// A right-hand side of a non-polynomial ODE compiled into a DAG. The nodes are kept in a topological order such that
+// the operands of a node always precede it. Identical subexpressions are shared and constant subexpressions are folded.
+
+class Expression
+{
+private:
+	vector<ExpressionNode> nodes;
+	int root;
+public:
+	Expression();
+	Expression(const Expression & expr);
+	~Expression();
+
+	void clear();
+	bool isEmpty() const;
+	int size() const;
+	bool isConstant(Interval & value) const;								// true if the expression is folded to a constant
+
+	int constant(const Interval & I);										// the following functions return the index of the new node
+	int variable(const int varIndex);
+	int unary(const int type, const int operand);
+	int binary(const int type, const int left, const int right);
+	int power(const int operand, const int exponent);
+
+	void setRoot(const int index);
+
+	// Taylor model evaluation with conservative truncation, the intermediate ranges are appended to the list
+	void taylor_picard(TaylorModel & result, list<Interval> & ranges, const TaylorModelVec & vars, const vector<Interval> & step_exp_table, const int numVars, const int order) const;
+
+	// only recompute the remainder by using the ranges collected by taylor_picard
+	void taylor_remainder(Interval & result, list<Interval>::iterator & iterRange, const TaylorModelVec & vars, const int order) const;
+
+	// polynomial evaluation with non-conservative truncation
+	void taylor_polynomial(Polynomial & result, const TaylorModelVec & vars, const int numVars, const int order) const;
+
+	void toString(string & result, const vector<string> & varNames) const;
+
+	Expression & operator = (const Expression & expr);
+
+private:
+	int append(const ExpressionNode & node);
+	void toString(string & result, const int index, const vector<string> & varNames) const;
+};
+
+#endif /* EXPRESSION_H_ */
@@ -31,6 +31,8 @@ ResetMap::~ResetMap()
 
 void ResetMap::reset(TaylorModelVec & result, const TaylorModelVec & tmv, const vector<Interval> & domain, const int order) const
 {
+	ProfileScope scope(PHASE_RESET);
+
 	vector<Interval> tmvPolyRange;
 	tmv.polyRange(tmvPolyRange, domain);
 	tmvReset.insert_ctrunc(result, tmv, tmvPolyRange, domain, order);
@@ -244,304 +246,646 @@ TreeNode & TreeNode::operator = (const TreeNode & node)
 
 
 
-// class HybridSystem
+// class ModeExpansion
 
-HybridSystem::HybridSystem()
+ModeExpansion::ModeExpansion()
 {
 }
 
-HybridSystem::HybridSystem(const vector<int> & modes_input, const vector<TaylorModelVec> & odes_input, const vector<vector<HornerForm> > & hfOdes_input,
-		const vector<vector<string> > & strOdes_input, const vector<vector<PolynomialConstraint> > & invariants_input, const vector<vector<DiscTrans> > & transitions_input,
-		const int initMode,	const vector<vector<Interval> > & uncertainties_input, const vector<vector<Interval> > & uncertainty_centers_input, const Flowpipe & initSet)
+ModeExpansion::ModeExpansion(const ModeExpansion & expansion)
 {
-	modes				=	modes_input;
-	odes				=	odes_input;
-	hfOdes				=	hfOdes_input;
-	strOdes				=	strOdes_input;
-	invariants			=	invariants_input;
-	transitions			=	transitions_input;
-	initialMode			=	initMode;
-	initialSet			=	initSet;
-	uncertainties		=	uncertainties_input;
-	uncertainty_centers	=	uncertainty_centers_input;
+	hf = expansion.hf;
+	mf = expansion.mf;
+	highest = expansion.highest;
 }
 
-HybridSystem::HybridSystem(const HybridSystem & hybsys)
+ModeExpansion::~ModeExpansion()
 {
-	modes				=	hybsys.modes;
-	odes				=	hybsys.odes;
-	hfOdes				=	hybsys.hfOdes;
-	strOdes				=	hybsys.strOdes;
-	invariants			=	hybsys.invariants;
-	transitions			=	hybsys.transitions;
-	initialMode			=	hybsys.initialMode;
-	initialSet			=	hybsys.initialSet;
-	uncertainties		=	hybsys.uncertainties;
-	uncertainty_centers	=	hybsys.uncertainty_centers;
 }
 
-HybridSystem::~HybridSystem()
+ModeExpansion & ModeExpansion::operator = (const ModeExpansion & expansion)
 {
-	modes.clear();
-	odes.clear();
-	hfOdes.clear();
-	strOdes.clear();
-	invariants.clear();
-	transitions.clear();
-	uncertainties.clear();
-	uncertainty_centers.clear();
+	if(this == &expansion)
+		return *this;
+
+	hf = expansion.hf;
+	mf = expansion.mf;
+	highest = expansion.highest;
+	return *this;
 }
 
-HybridSystem & HybridSystem::operator = (const HybridSystem & hybsys)
+
+
+
+
+
+
+
+
+
+
+// class ExpansionCache
+
+ExpansionCache::ExpansionCache()
 {
-	if(this == &hybsys)
-		return *this;
+	numRefs = 1;
+	pthread_mutex_init(&mutex, NULL);
+}
 
-	modes				=	hybsys.modes;
-	odes				=	hybsys.odes;
-	hfOdes				=	hybsys.hfOdes;
-	strOdes				=	hybsys.strOdes;
-	invariants			=	hybsys.invariants;
-	transitions			=	hybsys.transitions;
-	initialMode			=	hybsys.initialMode;
-	initialSet			=	hybsys.initialSet;
-	uncertainties		=	hybsys.uncertainties;
-	uncertainty_centers	=	hybsys.uncertainty_centers;
+ExpansionCache::~ExpansionCache()
+{
+	entries.clear();
+	pthread_mutex_destroy(&mutex);
+}
 
-	return *this;
+void ExpansionCache::retain()
+{
+	pthread_mutex_lock(&mutex);
+	++numRefs;
+	pthread_mutex_unlock(&mutex);
 }
 
-// for low-degree ODEs
-// fixed step sizes and orders
+void ExpansionCache::release()
+{
+	pthread_mutex_lock(&mutex);
+	bool bLast = (--numRefs == 0);
+	pthread_mutex_unlock(&mutex);
 
-bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCompo, list<vector<Interval> > & domains, const int mode, const Flowpipe & initFp, const double step,
-		const double time, const int order, const int precondition, const vector<Interval> & estimation, const bool bPrint, const vector<string> & stateVarNames,
-		vector<bool> & invariant_boundary_intersected, const vector<string> & modeNames) const
+	if(bLast)
+	{
+		delete this;
+	}
+}
+
+const ModeExpansion *ExpansionCache::find(const int mode, const int component, const int order)
 {
-	vector<Interval> step_exp_table, step_end_exp_table;
-	Interval intZero;
+	vector<int> key(3);
+	key[0] = mode;
+	key[1] = component;
+	key[2] = order;
 
-	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
+	const ModeExpansion *result = NULL;
 
-	resultsCompo.clear();
+	pthread_mutex_lock(&mutex);
+	map<vector<int>, ModeExpansion>::const_iterator iter = entries.find(key);
+	if(iter != entries.end())
+	{
+		result = &iter->second;
+	}
+	pthread_mutex_unlock(&mutex);
 
-	TaylorModelVec tmvTemp;
-	initFp.composition_normal(tmvTemp, step_exp_table);
-	resultsCompo.push_back(tmvTemp);
-	domains.push_back(initFp.domain);
+	return result;
+}
 
-	Flowpipe newFlowpipe, currentFlowpipe = initFp;
+const ModeExpansion *ExpansionCache::insert(const int mode, const int component, const int order, const ModeExpansion & expansion)
+{
+	vector<int> key(3);
+	key[0] = mode;
+	key[1] = component;
+	key[2] = order;
 
-	vector<Polynomial> polyODE;
-	for(int i=0; i<odes[mode].tms.size(); ++i)
+	// another thread may have inserted the same entry in the meantime, then its entry is kept
+	pthread_mutex_lock(&mutex);
+	const ModeExpansion *result = &entries.insert(make_pair(key, expansion)).first->second;
+	pthread_mutex_unlock(&mutex);
+
+	return result;
+}
+
+const ModeExpansion *ExpansionCache::lookup(const int mode, const int component, const vector<Polynomial> & ode, const int order)
+{
+	const ModeExpansion *result = find(mode, component, order);
+
+	if(result != NULL)
 	{
-		polyODE.push_back(odes[mode].tms[i].expansion);
+		return result;
 	}
 
-	vector<HornerForm> taylorExpansion;
-	computeTaylorExpansion(taylorExpansion, polyODE, order);
+	ModeExpansion expansion;
+	const ModeExpansion *lower = order > 0 ? find(mode, component, order-1) : NULL;
 
-	for(double t=THRESHOLD_HIGH; t < time;)
+	if(lower != NULL)
 	{
-		bool bvalid = currentFlowpipe.advance_low_degree(newFlowpipe, hfOdes[mode], taylorExpansion, precondition, step_exp_table, step_end_exp_table, order, estimation, uncertainties[mode]);
+		// one more Lie derivative of the cached highest-order term
+		expansion.highest = lower->highest;
+		increaseExpansionOrder(expansion.hf, expansion.mf, expansion.highest, lower->mf, ode, order-1);
+	}
+	else
+	{
+		vector<int> orders(ode.size(), 0);
+		orders[component] = order;
 
-		if(bvalid)
-		{
-			// over-approximate the flowpipe/invariant intersection
-			TaylorModelVec tmvCompo;
-			newFlowpipe.composition_normal(tmvCompo, step_exp_table);
+		vector<HornerForm> resultHF;
+		vector<Polynomial> resultMF;
+		vector<Polynomial> highest;
+		computeTaylorExpansion(resultHF, resultMF, highest, ode, orders);
 
-			vector<Interval> contracted_domain = newFlowpipe.domain;
-			vector<bool> local_boundary_intersected;
-			int type = contract_interval_arithmetic(tmvCompo, contracted_domain, invariants[mode], local_boundary_intersected);
+		expansion.hf = resultHF[component];
+		expansion.mf = resultMF[component];
+		expansion.highest = highest[component];
+	}
 
-			if(type >= 0)
+	return insert(mode, component, order, expansion);
+}
+
+void ExpansionCache::expansion(vector<HornerForm> & resultHF, const int mode, const vector<Polynomial> & ode, const int order)
+{
+	vector<int> orders(ode.size(), order);
+	expansion(resultHF, mode, ode, orders);
+}
+
+void ExpansionCache::expansion(vector<HornerForm> & resultHF, const int mode, const vector<Polynomial> & ode, const vector<int> & orders)
+{
+	int rangeDim = ode.size();
+	vector<const ModeExpansion *> cached(rangeDim, NULL);
+	vector<int> missingOrders(rangeDim, 0);
+	bool bMissing = false;
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		cached[i] = find(mode, i, orders[i]);
+
+		if(cached[i] == NULL)
+		{
+			if(orders[i] > 0 && find(mode, i, orders[i]-1) != NULL)
 			{
-				// collect the intersected invariant boundary
-				if(invariant_boundary_intersected.size() != local_boundary_intersected.size())
-				{
-					invariant_boundary_intersected = local_boundary_intersected;
-				}
-				else
-				{
-					for(int i=0; i<local_boundary_intersected.size(); ++i)
-					{
-						if(local_boundary_intersected[i])
-						{
-							invariant_boundary_intersected[i] = true;
-						}
-					}
-				}
+				cached[i] = lookup(mode, i, ode, orders[i]);
 			}
-
-			switch(type)
+			else
 			{
-			case -1:	// invariant violated
-				return true;
-			case 0:		// domain is not contracted
-				currentFlowpipe = newFlowpipe;
-				resultsCompo.push_back(tmvCompo);
-				domains.push_back(contracted_domain);
-				break;
-			case 1: 	// time interval is not contracted
-				newFlowpipe.normalize();
-				currentFlowpipe = newFlowpipe;
-				resultsCompo.push_back(tmvCompo);
-				domains.push_back(contracted_domain);
-				break;
-			case 2: 	// time interval is contracted
-				if(contracted_domain[0] > intZero)
-				{
-					return true;
-				}
-				else
-				{
-					resultsCompo.push_back(tmvCompo);
-					domains.push_back(contracted_domain);
-					return true;
-				}
+				missingOrders[i] = orders[i];
+				bMissing = true;
 			}
+		}
+	}
 
-			t += step;
+	if(bMissing)
+	{
+		// the missing components are expanded together since the Taylor coefficients depend on each other
+		vector<HornerForm> missingHF;
+		vector<Polynomial> missingMF;
+		vector<Polynomial> missingHighest;
+		computeTaylorExpansion(missingHF, missingMF, missingHighest, ode, missingOrders);
 
-			if(bPrint)
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if(cached[i] == NULL)
 			{
-				printf("mode: %s,\t", modeNames[mode].c_str());
-				printf("time = %f,\t", t);
-				printf("step = %f,\t", step);
-				printf("order = %d\n", order);
+				ModeExpansion expansion;
+				expansion.hf = missingHF[i];
+				expansion.mf = missingMF[i];
+				expansion.highest = missingHighest[i];
+				cached[i] = insert(mode, i, orders[i], expansion);
 			}
 		}
-		else
-		{
-			fprintf(stdout, "Terminated -- The remainder estimation is not large enough.\n");
-			return false;
-		}
 	}
 
-	return true;
+	resultHF.clear();
+	for(int i=0; i<rangeDim; ++i)
+	{
+		resultHF.push_back(cached[i]->hf);
+	}
 }
 
-bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCompo, list<vector<Interval> > & domains, const int mode, const Flowpipe & initFp,
-		const double step, const double time, const vector<int> & orders, const int globalMaxOrder, const int precondition,
-		const vector<Interval> & estimation, const bool bPrint, const vector<string> & stateVarNames,
-		vector<bool> & invariant_boundary_intersected, const vector<string> & modeNames) const
+void ExpansionCache::expansion(HornerForm & resultHF, const int mode, const int component, const vector<Polynomial> & ode, const int order)
 {
-	vector<Interval> step_exp_table, step_end_exp_table;
-	Interval intZero;
+	resultHF = lookup(mode, component, ode, order)->hf;
+}
 
-	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
 
-	resultsCompo.clear();
 
-	TaylorModelVec tmvTemp;
-	initFp.composition_normal(tmvTemp, step_exp_table);
-	resultsCompo.push_back(tmvTemp);
-	domains.push_back(initFp.domain);
 
-	Flowpipe newFlowpipe, currentFlowpipe = initFp;
 
-	vector<Polynomial> polyODE;
-	for(int i=0; i<odes[mode].tms.size(); ++i)
+
+
+
+
+
+
+// Gauss-Jordan elimination with partial pivoting, returns false if the matrix is numerically singular
+static bool invert_matrix(Matrix & result, const Matrix & A)
+{
+	int n = A.rows();
+	vector<vector<double> > M(n, vector<double>(2*n, 0));
+	double scale = 0;
+
+	for(int i=0; i<n; ++i)
 	{
-		polyODE.push_back(odes[mode].tms[i].expansion);
-	}
+		for(int j=0; j<n; ++j)
+		{
+			M[i][j] = A.get(i,j);
 
-	vector<HornerForm> taylorExpansion;
-	computeTaylorExpansion(taylorExpansion, polyODE, orders);
+			if(fabs(M[i][j]) > scale)
+			{
+				scale = fabs(M[i][j]);
+			}
+		}
 
-	for(double t=THRESHOLD_HIGH; t < time;)
+		M[i][n+i] = 1;
+	}
+
+	for(int k=0; k<n; ++k)
 	{
-		bool bvalid = currentFlowpipe.advance_low_degree(newFlowpipe, hfOdes[mode], taylorExpansion, precondition, step_exp_table, step_end_exp_table, orders, estimation, uncertainties[mode]);
+		int pivot = k;
+		for(int i=k+1; i<n; ++i)
+		{
+			if(fabs(M[i][k]) > fabs(M[pivot][k]))
+			{
+				pivot = i;
+			}
+		}
 
-		if(bvalid)
+		if(fabs(M[pivot][k]) <= THRESHOLD_HIGH * scale)
 		{
-			// over-approximate the flowpipe/invariant intersection
-			TaylorModelVec tmvCompo;
-			newFlowpipe.composition_normal(tmvCompo, step_exp_table);
+			return false;
+		}
 
-			vector<Interval> contracted_domain = newFlowpipe.domain;
-			vector<bool> local_boundary_intersected;
-			int type = contract_interval_arithmetic(tmvCompo, contracted_domain, invariants[mode], local_boundary_intersected);
+		M[k].swap(M[pivot]);
 
-			if(type >= 0)
+		double p = M[k][k];
+		for(int j=0; j<2*n; ++j)
+		{
+			M[k][j] /= p;
+		}
+
+		for(int i=0; i<n; ++i)
+		{
+			double f = M[i][k];
+
+			if(i != k && f != 0)
 			{
-				// collect the intersected invariant boundary
-				if(invariant_boundary_intersected.size() != local_boundary_intersected.size())
-				{
-					invariant_boundary_intersected = local_boundary_intersected;
-				}
-				else
+				for(int j=0; j<2*n; ++j)
 				{
-					for(int i=0; i<local_boundary_intersected.size(); ++i)
-					{
-						if(local_boundary_intersected[i])
-						{
-							invariant_boundary_intersected[i] = true;
-						}
-					}
+					M[i][j] -= f * M[k][j];
 				}
 			}
+		}
+	}
 
-			switch(type)
-			{
-			case -1:	// invariant violated
-				return true;
-			case 0:		// domain is not contracted
-				currentFlowpipe = newFlowpipe;
-				resultsCompo.push_back(tmvCompo);
-				domains.push_back(contracted_domain);
-				break;
-			case 1: 	// time interval is not contracted
-				newFlowpipe.normalize();
-				currentFlowpipe = newFlowpipe;
-				resultsCompo.push_back(tmvCompo);
-				domains.push_back(contracted_domain);
-				break;
-			case 2: 	// time interval is contracted
-				if(contracted_domain[0] > intZero)
-				{
-					return true;
-				}
-				else
-				{
-					resultsCompo.push_back(tmvCompo);
-					domains.push_back(contracted_domain);
-					return true;
-				}
+	result = Matrix(n);
+
+	for(int i=0; i<n; ++i)
+	{
+		for(int j=0; j<n; ++j)
+		{
+			result.set(M[i][n+j], i, j);
+		}
+	}
+
+	return true;
+}
+
+// class InitialSetEnclosure
+
+InitialSetEnclosure::InitialSetEnclosure()
+{
+	bInterval = true;
+	timePassed = 0;
+	jumpsExecuted = 0;
+}
+
+InitialSetEnclosure::InitialSetEnclosure(const TaylorModelVec & tmv, const vector<Interval> & domain, const bool bParallelotope, const double widening,
+		const double time, const int jumps)
+{
+	int rangeDim = tmv.tms.size();
+	bInterval = true;
+
+	if(bParallelotope)
+	{
+		// the directions are given by the inverse of the linear part
+		vector<vector<Interval> > linear(rangeDim, vector<Interval>(rangeDim+1));
+		tmv.linearCoefficients(linear);
+
+		Matrix L(rangeDim);
+		for(int i=0; i<rangeDim; ++i)
+		{
+			for(int j=0; j<rangeDim; ++j)
+			{
+				L.set(linear[i][j+1].midpoint(), i, j);
 			}
+		}
 
-			t += step;
+		if(invert_matrix(directions, L))
+		{
+			generators = L;
+			bInterval = false;
+		}
+	}
 
-			if(bPrint)
+	tmv.intEval(box, domain);
+
+	if(bInterval)
+	{
+		directions = Matrix(rangeDim);
+		for(int i=0; i<rangeDim; ++i)
+		{
+			directions.set(1, i, i);
+		}
+
+		generators = directions;
+		bounds = box;
+	}
+	else
+	{
+		TaylorModelVec tmvTemp;
+		tmv.linearTrans(tmvTemp, directions);
+		tmvTemp.intEval(bounds, domain);
+	}
+
+	if(widening > 0)
+	{
+		for(int i=0; i<rangeDim; ++i)
+		{
+			bounds[i].bloat(widening * bounds[i].width());
+			box[i].bloat(widening * box[i].width());
+		}
+	}
+
+	timePassed = time;
+	jumpsExecuted = jumps;
+}
+
+InitialSetEnclosure::InitialSetEnclosure(const InitialSetEnclosure & enclosure)
+{
+	directions = enclosure.directions;
+	generators = enclosure.generators;
+	bounds = enclosure.bounds;
+	box = enclosure.box;
+	bInterval = enclosure.bInterval;
+	timePassed = enclosure.timePassed;
+	jumpsExecuted = enclosure.jumpsExecuted;
+}
+
+InitialSetEnclosure::~InitialSetEnclosure()
+{
+	bounds.clear();
+	box.clear();
+}
+
+bool InitialSetEnclosure::contains(const TaylorModelVec & tmv, const vector<Interval> & domain, const vector<Interval> & range) const
+{
+	for(int i=0; i<box.size(); ++i)
+	{
+		if(!range[i].subseteq(box[i]))
+		{
+			return false;
+		}
+	}
+
+	if(bInterval)
+	{
+		return true;
+	}
+
+	TaylorModelVec tmvTemp;
+	tmv.linearTrans(tmvTemp, directions);
+
+	vector<Interval> ranges;
+	tmvTemp.intEval(ranges, domain);
+
+	for(int i=0; i<bounds.size(); ++i)
+	{
+		if(!ranges[i].subseteq(bounds[i]))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void InitialSetEnclosure::toTaylorModel(TaylorModelVec & result) const
+{
+	int rangeDim = bounds.size();
+	int domainDim = rangeDim + 1;
+
+	// a point x in the enclosure is G*(c + r*z) + (I - G*A)*x for some z in [-1,1]^n,
+	// where G is the matrix of the generators and A*x is in the box c + r*[-1,1]^n
+	vector<Interval> centers;
+	vector<Interval> radii;
+
+	for(int j=0; j<rangeDim; ++j)
+	{
+		double midpoint = bounds[j].midpoint();
+		Interval intTemp = bounds[j], intRadius;
+		intTemp.sub_assign(midpoint);
+
+		// the rounded midpoint may be off the center, so the radius has to cover both ends of the box
+		intTemp.mag(intRadius);
+
+		centers.push_back(Interval(midpoint));
+		radii.push_back(Interval(intRadius.sup()));
+	}
+
+	result.clear();
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		Interval constant, remainder;
+		vector<Interval> coefficients(domainDim);
+
+		for(int j=0; j<rangeDim; ++j)
+		{
+			Interval intG(generators.get(i,j));
+			constant += intG * centers[j];
+			coefficients[j+1] = intG * radii[j];
+		}
+
+		if(!bInterval)
+		{
+			for(int k=0; k<rangeDim; ++k)
 			{
-				printf("mode: %s,\t", modeNames[mode].c_str());
-				printf("time = %f,\t", t);
-				printf("step = %f,\t", step);
-				printf("orders:\t");
-				int num = orders.size()-1;
-				for(int i=0; i<num; ++i)
+				Interval intTemp(i == k ? 1.0 : 0.0);
+
+				for(int j=0; j<rangeDim; ++j)
 				{
-					printf("%s : %d, ", stateVarNames[i].c_str(), orders[i]);
+					intTemp -= Interval(generators.get(i,j)) * Interval(directions.get(j,k));
 				}
-				printf("%s : %d\n", stateVarNames[num].c_str(), orders[num]);
+
+				remainder += intTemp * box[k];
 			}
 		}
-		else
+
+		Polynomial polyTemp(coefficients);
+		polyTemp += Polynomial(constant, domainDim);
+
+		TaylorModel tmTemp(polyTemp, remainder);
+		result.tms.push_back(tmTemp);
+	}
+}
+
+InitialSetEnclosure & InitialSetEnclosure::operator = (const InitialSetEnclosure & enclosure)
+{
+	if(this == &enclosure)
+		return *this;
+
+	directions = enclosure.directions;
+	generators = enclosure.generators;
+	bounds = enclosure.bounds;
+	box = enclosure.box;
+	bInterval = enclosure.bInterval;
+	timePassed = enclosure.timePassed;
+	jumpsExecuted = enclosure.jumpsExecuted;
+	return *this;
+}
+
+
+
+
+
+
+
+
+
+
+
+// class InitialSetStore
+
+InitialSetStore::InitialSetStore(const int numModes, const double widening_input)
+{
+	enclosures.resize(numModes);
+	widening = widening_input;
+	pthread_mutex_init(&mutex, NULL);
+}
+
+InitialSetStore::~InitialSetStore()
+{
+	enclosures.clear();
+	pthread_mutex_destroy(&mutex);
+}
+
+bool InitialSetStore::admit(TaylorModelVec & tmv, vector<Interval> & domain, const int mode, const bool bParallelotope, const double timePassed, const int jumpsExecuted)
+{
+	vector<Interval> range;
+	tmv.intEval(range, domain);
+
+	pthread_mutex_lock(&mutex);
+
+	list<InitialSetEnclosure>::const_iterator iter = enclosures[mode].begin();
+	for(; iter != enclosures[mode].end(); ++iter)
+	{
+		if(iter->timePassed <= timePassed && iter->jumpsExecuted <= jumpsExecuted && iter->contains(tmv, domain, range))
 		{
-			fprintf(stdout, "Terminated -- The remainder estimation is not large enough.\n");
+			pthread_mutex_unlock(&mutex);
 			return false;
 		}
 	}
 
+	InitialSetEnclosure enclosure(tmv, domain, bParallelotope, widening, timePassed, jumpsExecuted);
+	enclosures[mode].push_back(enclosure);
+
+	pthread_mutex_unlock(&mutex);
+
+	enclosure.toTaylorModel(tmv);
+
+	Interval intUnit(-1,1);
+	for(int i=1; i<domain.size(); ++i)
+	{
+		domain[i] = intUnit;
+	}
+
 	return true;
 }
 
-// adaptive step sizes and fixed orders
 
-bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCompo, list<vector<Interval> > & domains, const int mode, const Flowpipe & initFp,
-		const double step, const double miniStep, const double time, const int order, const int precondition,
-		const vector<Interval> & estimation, const bool bPrint, const vector<string> & stateVarNames,
+
+
+
+
+
+
+
+
+
+// class HybridSystem
+
+HybridSystem::HybridSystem()
+{
+	expansionCache = new ExpansionCache;
+	consumer = NULL;
+}
+
+HybridSystem::HybridSystem(const vector<int> & modes_input, const vector<TaylorModelVec> & odes_input, const vector<vector<HornerForm> > & hfOdes_input,
+		const vector<vector<Expression> > & exprOdes_input, const vector<vector<PolynomialConstraint> > & invariants_input, const vector<vector<DiscTrans> > & transitions_input,
+		const int initMode,	const vector<vector<Interval> > & uncertainties_input, const vector<vector<Interval> > & uncertainty_centers_input, const Flowpipe & initSet)
+{
+	modes				=	modes_input;
+	odes				=	odes_input;
+	hfOdes				=	hfOdes_input;
+	exprOdes			=	exprOdes_input;
+	invariants			=	invariants_input;
+	transitions			=	transitions_input;
+	initialMode			=	initMode;
+	initialSet			=	initSet;
+	uncertainties		=	uncertainties_input;
+	uncertainty_centers	=	uncertainty_centers_input;
+	expansionCache		=	new ExpansionCache;
+	consumer			=	NULL;
+}
+
+HybridSystem::HybridSystem(const HybridSystem & hybsys)
+{
+	modes				=	hybsys.modes;
+	odes				=	hybsys.odes;
+	hfOdes				=	hybsys.hfOdes;
+	exprOdes			=	hybsys.exprOdes;
+	invariants			=	hybsys.invariants;
+	transitions			=	hybsys.transitions;
+	initialMode			=	hybsys.initialMode;
+	initialSet			=	hybsys.initialSet;
+	uncertainties		=	hybsys.uncertainties;
+	uncertainty_centers	=	hybsys.uncertainty_centers;
+
+	consumer			=	hybsys.consumer;
+
+	expansionCache		=	hybsys.expansionCache;
+	expansionCache->retain();
+}
+
+HybridSystem::~HybridSystem()
+{
+	modes.clear();
+	odes.clear();
+	hfOdes.clear();
+	exprOdes.clear();
+	invariants.clear();
+	transitions.clear();
+	uncertainties.clear();
+	uncertainty_centers.clear();
+
+	expansionCache->release();
+}
+
+HybridSystem & HybridSystem::operator = (const HybridSystem & hybsys)
+{
+	if(this == &hybsys)
+		return *this;
+
+	modes				=	hybsys.modes;
+	odes				=	hybsys.odes;
+	hfOdes				=	hybsys.hfOdes;
+	exprOdes			=	hybsys.exprOdes;
+	invariants			=	hybsys.invariants;
+	transitions			=	hybsys.transitions;
+	initialMode			=	hybsys.initialMode;
+	initialSet			=	hybsys.initialSet;
+	uncertainties		=	hybsys.uncertainties;
+	uncertainty_centers	=	hybsys.uncertainty_centers;
+	consumer			=	hybsys.consumer;
+
+	// the cached expansions are only valid for the ODEs they were computed from
+	hybsys.expansionCache->retain();
+	expansionCache->release();
+	expansionCache		=	hybsys.expansionCache;
+
+	return *this;
+}
+
+// for low-degree ODEs
+// fixed step sizes and orders
+
+bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCompo, list<vector<Interval> > & domains, const int mode, const Flowpipe & initFp, const double step,
+		const double time, const int order, const int precondition, const vector<Interval> & estimation, const bool bPrint, const vector<string> & stateVarNames,
 		vector<bool> & invariant_boundary_intersected, const vector<string> & modeNames) const
 {
 	vector<Interval> step_exp_table, step_end_exp_table;
@@ -558,8 +902,6 @@ bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCom
 
 	Flowpipe newFlowpipe, currentFlowpipe = initFp;
 
-	double newStep = 0;
-
 	vector<Polynomial> polyODE;
 	for(int i=0; i<odes[mode].tms.size(); ++i)
 	{
@@ -567,11 +909,11 @@ bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCom
 	}
 
 	vector<HornerForm> taylorExpansion;
-	computeTaylorExpansion(taylorExpansion, polyODE, order);
+	expansionCache->expansion(taylorExpansion, mode, polyODE, order);
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_low_degree(newFlowpipe, hfOdes[mode], taylorExpansion, precondition, step_exp_table, step_end_exp_table, newStep, miniStep, order, estimation, uncertainties[mode]);
+		bool bvalid = currentFlowpipe.advance_low_degree(newFlowpipe, hfOdes[mode], taylorExpansion, precondition, step_exp_table, step_end_exp_table, order, estimation, uncertainties[mode]);
 
 		if(bvalid)
 		{
@@ -630,7 +972,235 @@ bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCom
 				}
 			}
 
-			t += step_exp_table[1].sup();
+			t += step;
+
+			if(bPrint)
+			{
+				printf("mode: %s,\t", modeNames[mode].c_str());
+				printf("time = %f,\t", t);
+				printf("step = %f,\t", step);
+				printf("order = %d\n", order);
+			}
+		}
+		else
+		{
+			fprintf(stdout, "Terminated -- The remainder estimation is not large enough.\n");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCompo, list<vector<Interval> > & domains, const int mode, const Flowpipe & initFp,
+		const double step, const double time, const vector<int> & orders, const int globalMaxOrder, const int precondition,
+		const vector<Interval> & estimation, const bool bPrint, const vector<string> & stateVarNames,
+		vector<bool> & invariant_boundary_intersected, const vector<string> & modeNames) const
+{
+	vector<Interval> step_exp_table, step_end_exp_table;
+	Interval intZero;
+
+	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*globalMaxOrder);
+
+	resultsCompo.clear();
+
+	TaylorModelVec tmvTemp;
+	initFp.composition_normal(tmvTemp, step_exp_table);
+	resultsCompo.push_back(tmvTemp);
+	domains.push_back(initFp.domain);
+
+	Flowpipe newFlowpipe, currentFlowpipe = initFp;
+
+	vector<Polynomial> polyODE;
+	for(int i=0; i<odes[mode].tms.size(); ++i)
+	{
+		polyODE.push_back(odes[mode].tms[i].expansion);
+	}
+
+	vector<HornerForm> taylorExpansion;
+	expansionCache->expansion(taylorExpansion, mode, polyODE, orders);
+
+	for(double t=THRESHOLD_HIGH; t < time;)
+	{
+		bool bvalid = currentFlowpipe.advance_low_degree(newFlowpipe, hfOdes[mode], taylorExpansion, precondition, step_exp_table, step_end_exp_table, orders, estimation, uncertainties[mode]);
+
+		if(bvalid)
+		{
+			// over-approximate the flowpipe/invariant intersection
+			TaylorModelVec tmvCompo;
+			newFlowpipe.composition_normal(tmvCompo, step_exp_table);
+
+			vector<Interval> contracted_domain = newFlowpipe.domain;
+			vector<bool> local_boundary_intersected;
+			int type = contract_interval_arithmetic(tmvCompo, contracted_domain, invariants[mode], local_boundary_intersected);
+
+			if(type >= 0)
+			{
+				// collect the intersected invariant boundary
+				if(invariant_boundary_intersected.size() != local_boundary_intersected.size())
+				{
+					invariant_boundary_intersected = local_boundary_intersected;
+				}
+				else
+				{
+					for(int i=0; i<local_boundary_intersected.size(); ++i)
+					{
+						if(local_boundary_intersected[i])
+						{
+							invariant_boundary_intersected[i] = true;
+						}
+					}
+				}
+			}
+
+			switch(type)
+			{
+			case -1:	// invariant violated
+				return true;
+			case 0:		// domain is not contracted
+				currentFlowpipe = newFlowpipe;
+				resultsCompo.push_back(tmvCompo);
+				domains.push_back(contracted_domain);
+				break;
+			case 1: 	// time interval is not contracted
+				newFlowpipe.normalize();
+				currentFlowpipe = newFlowpipe;
+				resultsCompo.push_back(tmvCompo);
+				domains.push_back(contracted_domain);
+				break;
+			case 2: 	// time interval is contracted
+				if(contracted_domain[0] > intZero)
+				{
+					return true;
+				}
+				else
+				{
+					resultsCompo.push_back(tmvCompo);
+					domains.push_back(contracted_domain);
+					return true;
+				}
+			}
+
+			t += step;
+
+			if(bPrint)
+			{
+				printf("mode: %s,\t", modeNames[mode].c_str());
+				printf("time = %f,\t", t);
+				printf("step = %f,\t", step);
+				printf("orders:\t");
+				int num = orders.size()-1;
+				for(int i=0; i<num; ++i)
+				{
+					printf("%s : %d, ", stateVarNames[i].c_str(), orders[i]);
+				}
+				printf("%s : %d\n", stateVarNames[num].c_str(), orders[num]);
+			}
+		}
+		else
+		{
+			fprintf(stdout, "Terminated -- The remainder estimation is not large enough.\n");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// adaptive step sizes and fixed orders
+
+bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCompo, list<vector<Interval> > & domains, const int mode, const Flowpipe & initFp,
+		const double step, const double miniStep, const double time, const int order, const int precondition,
+		const vector<Interval> & estimation, const bool bPrint, const vector<string> & stateVarNames,
+		vector<bool> & invariant_boundary_intersected, const vector<string> & modeNames) const
+{
+	vector<Interval> step_exp_table, step_end_exp_table;
+	Interval intZero;
+
+	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
+
+	resultsCompo.clear();
+
+	TaylorModelVec tmvTemp;
+	initFp.composition_normal(tmvTemp, step_exp_table);
+	resultsCompo.push_back(tmvTemp);
+	domains.push_back(initFp.domain);
+
+	Flowpipe newFlowpipe, currentFlowpipe = initFp;
+
+	double newStep = 0;
+
+	vector<Polynomial> polyODE;
+	for(int i=0; i<odes[mode].tms.size(); ++i)
+	{
+		polyODE.push_back(odes[mode].tms[i].expansion);
+	}
+
+	vector<HornerForm> taylorExpansion;
+	expansionCache->expansion(taylorExpansion, mode, polyODE, order);
+
+	for(double t=THRESHOLD_HIGH; t < time;)
+	{
+		bool bvalid = currentFlowpipe.advance_low_degree(newFlowpipe, hfOdes[mode], taylorExpansion, precondition, step_exp_table, step_end_exp_table, newStep, miniStep, order, estimation, uncertainties[mode]);
+
+		if(bvalid)
+		{
+			// over-approximate the flowpipe/invariant intersection
+			TaylorModelVec tmvCompo;
+			newFlowpipe.composition_normal(tmvCompo, step_exp_table);
+
+			vector<Interval> contracted_domain = newFlowpipe.domain;
+			vector<bool> local_boundary_intersected;
+			int type = contract_interval_arithmetic(tmvCompo, contracted_domain, invariants[mode], local_boundary_intersected);
+
+			if(type >= 0)
+			{
+				// collect the intersected invariant boundary
+				if(invariant_boundary_intersected.size() != local_boundary_intersected.size())
+				{
+					invariant_boundary_intersected = local_boundary_intersected;
+				}
+				else
+				{
+					for(int i=0; i<local_boundary_intersected.size(); ++i)
+					{
+						if(local_boundary_intersected[i])
+						{
+							invariant_boundary_intersected[i] = true;
+						}
+					}
+				}
+			}
+
+			switch(type)
+			{
+			case -1:	// invariant violated
+				return true;
+			case 0:		// domain is not contracted
+				currentFlowpipe = newFlowpipe;
+				resultsCompo.push_back(tmvCompo);
+				domains.push_back(contracted_domain);
+				break;
+			case 1: 	// time interval is not contracted
+				newFlowpipe.normalize();
+				currentFlowpipe = newFlowpipe;
+				resultsCompo.push_back(tmvCompo);
+				domains.push_back(contracted_domain);
+				break;
+			case 2: 	// time interval is contracted
+				if(contracted_domain[0] > intZero)
+				{
+					return true;
+				}
+				else
+				{
+					resultsCompo.push_back(tmvCompo);
+					domains.push_back(contracted_domain);
+					return true;
+				}
+			}
+
+			t += step_exp_table[1].sup();
 
 			if(bPrint)
 			{
@@ -684,7 +1254,7 @@ bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCom
 	}
 
 	vector<HornerForm> taylorExpansion;
-	computeTaylorExpansion(taylorExpansion, polyODE, orders);
+	expansionCache->expansion(taylorExpansion, mode, polyODE, orders);
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
@@ -809,7 +1379,7 @@ bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCom
 	}
 
 	vector<HornerForm> taylorExpansion;
-	computeTaylorExpansion(taylorExpansion, polyODE, order);
+	expansionCache->expansion(taylorExpansion, mode, polyODE, order);
 
 	vector<vector<HornerForm> > expansions;
 	expansions.push_back(taylorExpansion);
@@ -892,7 +1462,7 @@ bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCom
 					for(int i=localMaxOrder+1; i<=newOrder; ++i)
 					{
 						vector<HornerForm> newTaylorExpansion;
-						computeTaylorExpansion(newTaylorExpansion, polyODE, i);
+						expansionCache->expansion(newTaylorExpansion, mode, polyODE, i);
 						expansions.push_back(newTaylorExpansion);
 					}
 
@@ -941,10 +1511,7 @@ bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCom
 	}
 
 	vector<HornerForm> taylorExpansionHF;
-	vector<Polynomial> taylorExpansionMF;
-	vector<Polynomial> highestTerms;
-
-	computeTaylorExpansion(taylorExpansionHF, taylorExpansionMF, highestTerms, polyODE, orders);
+	expansionCache->expansion(taylorExpansionHF, mode, polyODE, orders);
 
 	vector<vector<HornerForm> > expansions;
 	vector<HornerForm> emptySet;
@@ -1051,12 +1618,8 @@ bool HybridSystem::reach_continuous_low_degree(list<TaylorModelVec> & resultsCom
 						for(int j=localMaxOrders[i]; j<newOrders[i]; ++j)
 						{
 							HornerForm newTaylorExpansionHF;
-							Polynomial newTaylorExpansionMF;
-
-							increaseExpansionOrder(newTaylorExpansionHF, newTaylorExpansionMF, highestTerms[i], taylorExpansionMF[i], polyODE, j);
-
+							expansionCache->expansion(newTaylorExpansionHF, mode, i, polyODE, j+1);
 							expansions[i].push_back(newTaylorExpansionHF);
-							taylorExpansionMF[i] = newTaylorExpansionMF;
 						}
 					}
 
@@ -1760,7 +2323,7 @@ bool HybridSystem::reach_continuous_non_polynomial_taylor(list<TaylorModelVec> &
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOdes[mode], precondition, step_exp_table, step_end_exp_table, order, estimation, uncertainties[mode], uncertainty_centers[mode]);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOdes[mode], precondition, step_exp_table, step_end_exp_table, order, estimation, uncertainties[mode], uncertainty_centers[mode]);
 
 		if(bvalid)
 		{
@@ -1860,7 +2423,7 @@ bool HybridSystem::reach_continuous_non_polynomial_taylor(list<TaylorModelVec> &
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOdes[mode], precondition, step_exp_table, step_end_exp_table, orders, globalMaxOrder, estimation, uncertainties[mode], uncertainty_centers[mode]);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOdes[mode], precondition, step_exp_table, step_end_exp_table, orders, globalMaxOrder, estimation, uncertainties[mode], uncertainty_centers[mode]);
 
 		if(bvalid)
 		{
@@ -1970,7 +2533,7 @@ bool HybridSystem::reach_continuous_non_polynomial_taylor(list<TaylorModelVec> &
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOdes[mode], precondition, step_exp_table, step_end_exp_table, newStep, miniStep, order, estimation, uncertainties[mode], uncertainty_centers[mode]);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOdes[mode], precondition, step_exp_table, step_end_exp_table, newStep, miniStep, order, estimation, uncertainties[mode], uncertainty_centers[mode]);
 
 		if(bvalid)
 		{
@@ -2078,7 +2641,7 @@ bool HybridSystem::reach_continuous_non_polynomial_taylor(list<TaylorModelVec> &
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOdes[mode], precondition, step_exp_table, step_end_exp_table, newStep, miniStep, orders, globalMaxOrder, estimation, uncertainties[mode], uncertainty_centers[mode]);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOdes[mode], precondition, step_exp_table, step_end_exp_table, newStep, miniStep, orders, globalMaxOrder, estimation, uncertainties[mode], uncertainty_centers[mode]);
 
 		if(bvalid)
 		{
@@ -2194,7 +2757,7 @@ bool HybridSystem::reach_continuous_non_polynomial_taylor(list<TaylorModelVec> &
 
 	for(double t=THRESHOLD_HIGH; t < time;)
 	{
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOdes[mode], precondition, step_exp_table, step_end_exp_table, newOrder, maxOrder, estimation, uncertainties[mode], uncertainty_centers[mode]);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOdes[mode], precondition, step_exp_table, step_end_exp_table, newOrder, maxOrder, estimation, uncertainties[mode], uncertainty_centers[mode]);
 
 		if(bvalid)
 		{
@@ -2308,7 +2871,7 @@ bool HybridSystem::reach_continuous_non_polynomial_taylor(list<TaylorModelVec> &
 				localMaxOrder = newOrders[i];
 		}
 
-		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, strOdes[mode], precondition, step_exp_table, step_end_exp_table, newOrders, localMaxOrder, maxOrders, estimation, uncertainties[mode], uncertainty_centers[mode]);
+		bool bvalid = currentFlowpipe.advance_non_polynomial_taylor(newFlowpipe, exprOdes[mode], precondition, step_exp_table, step_end_exp_table, newOrders, localMaxOrder, maxOrders, estimation, uncertainties[mode], uncertainty_centers[mode]);
 
 		if(bvalid)
 		{
@@ -2399,594 +2962,1520 @@ bool HybridSystem::reach_continuous_non_polynomial_taylor(list<TaylorModelVec> &
 	return true;
 }
 
+// for affine ODEs
 
-// hybrid reachability
-
-void HybridSystem::reach_hybrid(list<list<TaylorModelVec> > & resultsCompo, list<list<vector<Interval> > > & domains, list<int> & modeIDs, list<TreeNode *> & traceNodes,
-		TreeNode * & traceTree, const vector<int> & integrationSchemes, const double step, const double miniStep,
-		const double time, const int orderType, const vector<int> & orders, const vector<int> & maxOrders, const int globalMaxOrder,
-		const bool bAdaptiveSteps, const bool bAdaptiveOrders, const int maxJmps, const int precondition, const vector<Interval> & estimation,
-		const vector<vector<int> > & aggregType, const vector<vector<vector<RowVector> > > aggregationTemplate_candidates, const vector<RowVector> default_aggregation_template,
-		const vector<vector<Matrix> > & weightTab, const vector<vector<vector<bool> > > & linear_auto, const vector<vector<vector<RowVector> > > & template_auto,
-		const bool bPrint, const vector<string> & stateVarNames, const vector<string> & modeNames, const vector<string> & tmVarNames) const
+bool HybridSystem::reach_continuous_linear(list<TaylorModelVec> & resultsCompo, list<vector<Interval> > & domains, const int mode, const Flowpipe & initFp,
+		const double step, const double miniStep, const double time, const int minOrder, const int maxOrder, const int precondition, const bool bPrint,
+		const vector<string> & stateVarNames, vector<bool> & invariant_boundary_intersected, const vector<string> & modeNames) const
 {
-	list<int> modeQueue;
-	list<Flowpipe> flowpipeQueue;
-	list<double> timePassedQueue;
-	list<int> jumpsExecutedQueue;
-
 	Interval intZero;
-	int rangeDim = initialSet.tmv.tms.size();
 
-	modeQueue.push_back(initialMode);
-	flowpipeQueue.push_back(initialSet);
-	timePassedQueue.push_back(0);
-	jumpsExecutedQueue.push_back(0);
+	resultsCompo.clear();
 
-	// mode trace
-	list<TreeNode *> nodeQueue;
-	traceTree = new TreeNode(0, initialMode, intZero);
-	nodeQueue.push_back(traceTree);
+	// the step size is only reduced in adaptive mode, when the Taylor series of the flow can not be bounded for it
+	double newStep = step;
+	LinearFlow flow;
 
-	for(; modeQueue.size() != 0;)
+	while(!flow.build(odes[mode], uncertainties[mode], newStep, minOrder, maxOrder))
 	{
-		int initMode = modeQueue.front();
-		Flowpipe initFp = flowpipeQueue.front();
-		double timePassed = timePassedQueue.front();
-		int jumpsExecuted = jumpsExecutedQueue.front();
-		TreeNode *node = nodeQueue.front();
+		newStep *= LAMBDA_DOWN;
 
-		modeQueue.pop_front();
-		flowpipeQueue.pop_front();
-		timePassedQueue.pop_front();
-		jumpsExecutedQueue.pop_front();
-		nodeQueue.pop_front();
+		if(newStep < miniStep)
+		{
+			fprintf(stdout, "Terminated -- The step size is too large for the linear flow.\n");
+			return false;
+		}
+	}
 
-		list<TaylorModelVec> mode_flowpipes;
-		list<vector<Interval> > mode_domains;
+	vector<Interval> step_exp_table, step_end_exp_table;
 
-		bool bvalid;
-		vector<bool> invariant_boundary_intersected;
+	construct_step_exp_table(step_exp_table, step_end_exp_table, newStep, 2*flow.order);
 
-		switch(integrationSchemes[initMode])
-		{
-		case LOW_DEGREE:
+	TaylorModelVec tmvTemp;
+	initFp.composition_normal(tmvTemp, step_exp_table);
+	resultsCompo.push_back(tmvTemp);
+	domains.push_back(initFp.domain);
+
+	Flowpipe newFlowpipe, currentFlowpipe = initFp;
+
+	for(double t=THRESHOLD_HIGH; t < time;)
+	{
+		currentFlowpipe.advance_linear(newFlowpipe, flow, precondition, step_exp_table, step_end_exp_table);
+
+		// over-approximate the flowpipe/invariant intersection
+		TaylorModelVec tmvCompo;
+		newFlowpipe.composition_normal(tmvCompo, step_exp_table);
+
+		vector<Interval> contracted_domain = newFlowpipe.domain;
+		vector<bool> local_boundary_intersected;
+		int type = contract_interval_arithmetic(tmvCompo, contracted_domain, invariants[mode], local_boundary_intersected);
+
+		if(type >= 0)
 		{
-			switch(orderType)
+			// collect the intersected invariant boundary
+			if(invariant_boundary_intersected.size() != local_boundary_intersected.size())
 			{
-			case UNIFORM:
-				if(bAdaptiveSteps)
-				{
-					bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else if(bAdaptiveOrders)
-				{
-					bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else
-				{
-					bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				break;
-			case MULTI:
-				if(bAdaptiveSteps)
-				{
-					bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else if(bAdaptiveOrders)
-				{
-					bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else
+				invariant_boundary_intersected = local_boundary_intersected;
+			}
+			else
+			{
+				for(int i=0; i<local_boundary_intersected.size(); ++i)
 				{
-					bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+					if(local_boundary_intersected[i])
+					{
+						invariant_boundary_intersected[i] = true;
+					}
 				}
-				break;
 			}
+		}
+
+		switch(type)
+		{
+		case -1:	// invariant violated
+			return true;
+		case 0:		// domain is not contracted
+			currentFlowpipe = newFlowpipe;
+			resultsCompo.push_back(tmvCompo);
+			domains.push_back(contracted_domain);
 			break;
+		case 1: 	// time interval is not contracted
+			newFlowpipe.normalize();
+			currentFlowpipe = newFlowpipe;
+			resultsCompo.push_back(tmvCompo);
+			domains.push_back(contracted_domain);
+			break;
+		case 2: 	// time interval is contracted
+			if(contracted_domain[0] > intZero)
+			{
+				return true;
+			}
+			else
+			{
+				resultsCompo.push_back(tmvCompo);
+				domains.push_back(contracted_domain);
+				return true;
+			}
+		}
+
+		t += newStep;
+
+		if(bPrint)
+		{
+			printf("mode: %s,\t", modeNames[mode].c_str());
+			printf("time = %f,\t", t);
+			printf("step = %f,\t", newStep);
+			printf("order = %d\n", flow.order);
 		}
+	}
+
+	return true;
+}
+
+
+// hybrid reachability
+
+void HybridSystem::clock_rates(vector<bool> & bClocks, vector<Interval> & rates, const int mode) const
+{
+	int rangeDim = initialSet.tmv.tms.size();
 
-		case HIGH_DEGREE:
+	bClocks.assign(rangeDim, false);
+	rates.assign(rangeDim, Interval());
+
+	// the right-hand side of a non-polynomial ODE is a constant if the parser folded it to one
+	if(mode < exprOdes.size() && exprOdes[mode].size() == rangeDim)
+	{
+		for(int i=0; i<rangeDim; ++i)
 		{
-			switch(orderType)
+			if(exprOdes[mode][i].isConstant(rates[i]))
 			{
-			case UNIFORM:
-				if(bAdaptiveSteps)
-				{
-					bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else if(bAdaptiveOrders)
-				{
-					bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else
-				{
-					bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				break;
-			case MULTI:
-				if(bAdaptiveSteps)
+				bClocks[i] = true;
+
+				// the uncertainties of a non-polynomial ODE are split into the centers and the centered parts
+				if(mode < uncertainty_centers.size() && i < uncertainty_centers[mode].size())
 				{
-					bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+					rates[i] += uncertainty_centers[mode][i];
 				}
-				else if(bAdaptiveOrders)
+
+				if(i < uncertainties[mode].size())
 				{
-					bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+					rates[i] += uncertainties[mode][i];
 				}
-				else
+			}
+		}
+
+		return;
+	}
+
+	if(mode >= odes.size() || odes[mode].tms.size() != rangeDim)
+	{
+		return;
+	}
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		const TaylorModel & tm = odes[mode].tms[i];
+
+		if(tm.expansion.degree() == 0)
+		{
+			bClocks[i] = true;
+			tm.expansion.constant(rates[i]);
+			rates[i] += tm.remainder;
+
+			if(i < uncertainties[mode].size())
+			{
+				rates[i] += uncertainties[mode][i];
+			}
+		}
+	}
+}
+
+/*
+ * A clock x with x' in C and x(0) in X0 has the value in X0 + C*t at the time t after the mode is entered. An affine
+ * constraint a*x + k <= B of a guard can then only be satisfied when inf(a*X0) + inf(a*C)*t <= sup(B-k). The window
+ * [windowLo, windowHi] of the time t is the intersection of these conditions, the other constraints are ignored. The
+ * window is empty if windowLo > windowHi.
+ */
+static void guard_time_window(double & windowLo, double & windowHi, const vector<PolynomialConstraint> & guard,
+		const vector<bool> & bClocks, const vector<Interval> & rates, const vector<Interval> & initHull)
+{
+	int rangeDim = bClocks.size();
+	Interval intZero;
+
+	windowLo = 0;
+	windowHi = DBL_MAX;
+
+	for(int j=0; j<guard.size(); ++j)
+	{
+		if(guard[j].p.degree() > 1)
+		{
+			continue;
+		}
+
+		vector<Interval> coefficients(rangeDim+1);
+		guard[j].p.linearCoefficients(coefficients);
+
+		// the constraint should only be on a single clock
+		int clock = -1;
+		bool bAffine = coefficients[0].subseteq(intZero);
+
+		for(int i=0; i<rangeDim && bAffine; ++i)
+		{
+			if(!coefficients[i+1].subseteq(intZero))
+			{
+				if(clock >= 0 || !bClocks[i])
 				{
-					bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+					bAffine = false;
 				}
-				break;
+
+				clock = i;
+			}
+		}
+
+		if(!bAffine || clock < 0)
+		{
+			continue;
+		}
+
+		Interval k;
+		guard[j].p.constant(k);
+
+		Interval U(guard[j].B.sup());
+		U -= k;
+		U = Interval(U.sup());
+
+		Interval L0 = coefficients[clock+1] * initHull[clock+1];
+		Interval L1 = coefficients[clock+1] * rates[clock];
+
+		if(L1.inf() > 0)
+		{
+			Interval bound = (U - Interval(L0.inf())) / Interval(L1.inf());
+
+			if(bound.sup() < windowHi)
+			{
+				windowHi = bound.sup();
+			}
+		}
+		else if(L1.inf() < 0)
+		{
+			Interval bound = (Interval(L0.inf()) - U) / Interval(-L1.inf());
+
+			if(bound.inf() > windowLo)
+			{
+				windowLo = bound.inf();
+			}
+		}
+		else if(L0.inf() > U.sup())
+		{
+			windowHi = -1;
+			return;
+		}
+	}
+}
+
+bool HybridSystem::reach_mode(list<TaylorModelVec> & mode_flowpipes, list<vector<Interval> > & mode_domains, list<int> & succModes, list<Flowpipe> & succFlowpipes,
+		list<double> & succTimes, list<TreeNode *> & succNodes, const int initMode, const Flowpipe & initFp, double timePassed, const int jumpsExecuted, TreeNode *node,
+		const vector<int> & integrationSchemes, const double step, const double miniStep,
+		const double time, const int orderType, const vector<int> & orders, const vector<int> & maxOrders, const int globalMaxOrder,
+		const bool bAdaptiveSteps, const bool bAdaptiveOrders, const int maxJmps, const int precondition, const vector<Interval> & estimation,
+		const vector<vector<int> > & aggregType, const vector<vector<vector<RowVector> > > & aggregationTemplate_candidates, const vector<RowVector> & default_aggregation_template,
+		const vector<vector<Matrix> > & weightTab, const vector<vector<vector<bool> > > & linear_auto, const vector<vector<vector<RowVector> > > & template_auto,
+		const bool bPrint, const vector<string> & stateVarNames, const vector<string> & modeNames, const vector<string> & tmVarNames,
+		InitialSetStore *initialSets) const
+{
+	Interval intZero;
+	int rangeDim = initialSet.tmv.tms.size();
+
+	stepLog->enter(modeNames[initMode].c_str(), timePassed);
+
+	bool bvalid;
+	vector<bool> invariant_boundary_intersected;
+
+	switch(integrationSchemes[initMode])
+	{
+	case LOW_DEGREE:
+	{
+		switch(orderType)
+		{
+		case UNIFORM:
+			if(bAdaptiveSteps)
+			{
+				bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else if(bAdaptiveOrders)
+			{
+				bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else
+			{
+				bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			break;
+		case MULTI:
+			if(bAdaptiveSteps)
+			{
+				bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else if(bAdaptiveOrders)
+			{
+				bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else
+			{
+				bvalid = reach_continuous_low_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
 			}
 			break;
 		}
+		break;
+	}
 
-		case NONPOLY_TAYLOR:
+	case HIGH_DEGREE:
+	{
+		switch(orderType)
 		{
-			switch(orderType)
+		case UNIFORM:
+			if(bAdaptiveSteps)
 			{
-			case UNIFORM:
-				if(bAdaptiveSteps)
-				{
-					bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else if(bAdaptiveOrders)
-				{
-					bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else
-				{
-					bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				break;
-			case MULTI:
-				if(bAdaptiveSteps)
-				{
-					bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else if(bAdaptiveOrders)
-				{
-					bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				else
-				{
-					bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
-				}
-				break;
+				bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else if(bAdaptiveOrders)
+			{
+				bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else
+			{
+				bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			break;
+		case MULTI:
+			if(bAdaptiveSteps)
+			{
+				bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else if(bAdaptiveOrders)
+			{
+				bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else
+			{
+				bvalid = reach_continuous_high_degree(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			break;
+		}
+		break;
+	}
+
+	case NONPOLY_TAYLOR:
+	{
+		switch(orderType)
+		{
+		case UNIFORM:
+			if(bAdaptiveSteps)
+			{
+				bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else if(bAdaptiveOrders)
+			{
+				bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], maxOrders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else
+			{
+				bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders[0], precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			break;
+		case MULTI:
+			if(bAdaptiveSteps)
+			{
+				bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, miniStep, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else if(bAdaptiveOrders)
+			{
+				bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, maxOrders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+			}
+			else
+			{
+				bvalid = reach_continuous_non_polynomial_taylor(mode_flowpipes, mode_domains, initMode, initFp, step, time-timePassed, orders, globalMaxOrder, precondition, estimation, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
 			}
 			break;
 		}
+		break;
+	}
+
+	case LINEAR_ODE:
+	{
+		int minOrder, maxOrder;
+		linear_flow_orders(minOrder, maxOrder, orderType, bAdaptiveOrders, orders, maxOrders);
+		bvalid = reach_continuous_linear(mode_flowpipes, mode_domains, initMode, initFp, step, bAdaptiveSteps ? miniStep : step, time-timePassed, minOrder, maxOrder, precondition, bPrint, stateVarNames, invariant_boundary_intersected, modeNames);
+		break;
+	}
+	}
+
+	list<TaylorModelVec>::iterator tmvIter = mode_flowpipes.begin();
+	list<vector<Interval> >::iterator doIter = mode_domains.begin();
+
+	if(!bvalid)
+	{
+		return false;
+	}
+
+	if(jumpsExecuted == maxJmps)
+	{
+		if(bPrint)
+		{
+			printf("Maximum jump depth is reached.\n");
+		}
+		return true;
+	}
+
+	vector<vector<Interval> > step_exp_tables;
+	vector<Interval> step_exp_table;
+
+	// the hulls of the flowpipes are shared by the guards of all the jumps
+	vector<vector<Interval> > hulls;
+
+	for(; tmvIter!=mode_flowpipes.end(); ++tmvIter, ++doIter)
+	{
+		if(step_exp_table.size() == 0 || step_exp_table[1] != (*doIter)[0])
+		{
+			construct_step_exp_table(step_exp_table, (*doIter)[0], globalMaxOrder);
 		}
 
-		list<TaylorModelVec>::iterator tmvIter = mode_flowpipes.begin();
-		list<vector<Interval> >::iterator doIter = mode_domains.begin();
+		step_exp_tables.push_back(step_exp_table);
+
+		vector<Interval> hull;
+		flowpipe_hull(hull, *tmvIter, *doIter);
+		hulls.push_back(hull);
+	}
+
+	vector<bool> bClocks;
+	vector<Interval> rates;
+	clock_rates(bClocks, rates, initMode);
+
+	// over-approximate the intersection for each jump
+	for(int i=0; i<transitions[initMode].size(); ++i)
+	{
+		vector<TaylorModelVec> intersection_flowpipes;
+		vector<vector<Interval> > intersection_domains;
+
+		list<TaylorModelVec>::iterator tmvIter = mode_flowpipes.begin();
+		list<vector<Interval> >::iterator doIter = mode_domains.begin();
+		double newTimePassed = 0;
+		bool brecorded = false;
+
+		if(bPrint)
+		{
+			printf("Dealing with the jump from %s to %s ...\n", modeNames[initMode].c_str(), modeNames[transitions[initMode][i].targetID].c_str());
+		}
+
+		// the time window in which the guard may be satisfied, the initial clock values are given by the first flowpipe
+		double windowLo, windowHi;
+		guard_time_window(windowLo, windowHi, transitions[initMode][i].guard, bClocks, rates, hulls[0]);
+
+		// collect the intersected flowpipes
+
+		vector<bool> guard_boundary_intersected;
+
+		step_exp_table = step_exp_tables[0];
+
+		Interval triggeredTime;
+		Interval localTime;		// the time since the mode is entered, the first flowpipe is the initial set
+
+		for(int k=0, m=0; tmvIter!=mode_flowpipes.end(); ++tmvIter, ++doIter, ++m)
+		{
+			if(step_exp_table[1] != (*doIter)[0])
+			{
+				step_exp_table = step_exp_tables[++k];
+			}
+
+			Interval flowpipeTime = localTime + (*doIter)[0];
+
+			if(m > 0)
+			{
+				localTime += Interval((*doIter)[0].sup());
+			}
+
+			if(flowpipeTime.inf() > windowHi)
+			{
+				// the guard is not satisfied by the remaining flowpipes
+				break;
+			}
+
+			// most of the flowpipes are far from the guard
+			if(flowpipeTime.sup() < windowLo || intersection_check_hull(transitions[initMode][i].guard, hulls[m]) == -1)
+			{
+				if(!brecorded)
+				{
+					newTimePassed += (*doIter)[0].sup();
+				}
+
+				continue;
+			}
+
+			TaylorModelVec tmvIntersection = *tmvIter;
+			vector<Interval> doIntersection = *doIter;
+
+			vector<bool> local_boundary_intersected;
+			int type = contract_interval_arithmetic(tmvIntersection, doIntersection, transitions[initMode][i].guard, local_boundary_intersected);
+
+			if(type >= 0 && aggregType[initMode][transitions[initMode][i].targetID] == PARA_AGGREG)
+			{
+				// collect the intersected guard boundary
+				if(guard_boundary_intersected.size() != local_boundary_intersected.size())
+				{
+					guard_boundary_intersected = local_boundary_intersected;
+				}
+				else
+				{
+					for(int j=0; j<local_boundary_intersected.size(); ++j)
+					{
+						if(local_boundary_intersected[j])
+						{
+							guard_boundary_intersected[j] = true;
+						}
+					}
+				}
+			}
+
+			if(type != -1)
+			{
+				if(!brecorded)
+				{
+					brecorded = true;
+
+					triggeredTime = doIntersection[0];
+					triggeredTime.add_assign(newTimePassed);
+					newTimePassed += doIntersection[0].inf();
+				}
+				else
+				{
+					// compute the time interval when the jump is triggered
+					triggeredTime.setSup(triggeredTime.sup() + doIntersection[0].sup());
+				}
+
+				intersection_flowpipes.push_back(tmvIntersection);
+				intersection_domains.push_back(doIntersection);
+			}
+			else
+			{
+				if(!brecorded)
+				{
+					newTimePassed += doIntersection[0].sup();
+				}
+			}
+		}
+
+		vector<bool> boundary_intersected = invariant_boundary_intersected;
+		for(int j=0; j<guard_boundary_intersected.size(); ++j)
+		{
+			boundary_intersected.push_back(guard_boundary_intersected[j]);
+		}
+
+		// aggregate the intersections
+		if(intersection_flowpipes.size() > 0)
+		{
+			Flowpipe fpAggregation;
+			TaylorModelVec tmvAggregation;
+			vector<Interval> doAggregation;
+
+			switch(aggregType[initMode][transitions[initMode][i].targetID])
+			{
+			case INTERVAL_AGGREG:
+			{
+				aggregate_flowpipes_by_interval(tmvAggregation, doAggregation, intersection_flowpipes, intersection_domains);
+
+				break;
+			}
+			case PARA_AGGREG:
+			{
+				aggregate_flowpipes_by_Parallelotope(tmvAggregation, doAggregation, intersection_flowpipes, intersection_domains,
+						invariants[initMode], transitions[initMode][i], boundary_intersected,
+						aggregationTemplate_candidates[initMode][transitions[initMode][i].targetID], default_aggregation_template,
+						weightTab, linear_auto, template_auto, globalMaxOrder, rangeDim);
+
+				break;
+			}
+			}
+
+			// contract the aggregation regarding to the guard and invariant
+			vector<PolynomialConstraint> constraints = transitions[initMode][i].guard;
+			for(int j=0; j<invariants[initMode].size(); ++j)
+			{
+				constraints.push_back(invariants[initMode][j]);
+			}
+
+			vector<bool> bVecDummy;
+			contract_interval_arithmetic(tmvAggregation, doAggregation, constraints, bVecDummy);
+
+			//reset map
+			TaylorModelVec tmvImage;
+			transitions[initMode][i].resetMap.reset(tmvImage, tmvAggregation, doAggregation, globalMaxOrder);
+
+			int type = contract_interval_arithmetic(tmvImage, doAggregation, invariants[transitions[initMode][i].targetID], bVecDummy);
+
+			if(type == -1)
+			{
+				if(bPrint)
+				{
+					printf("No intersection detected.\n");
+				}
+
+				continue;
+			}
+			else
+			{
+				int rangeDim = tmvImage.tms.size();
+				Matrix coefficients(rangeDim, rangeDim+1);
+				for(int i=0; i<rangeDim; ++i)
+				{
+					coefficients.set(1, i, i+1);
+				}
+				TaylorModelVec tmvTemp(coefficients);
+
+				fpAggregation.tmv = tmvTemp;
+				fpAggregation.tmvPre = tmvImage;
+				fpAggregation.domain = doAggregation;
+			}
+
+			timePassed += newTimePassed;
+			if(timePassed < time - THRESHOLD_HIGH)
+			{
+				int targetID = transitions[initMode][i].targetID;
+
+				if(initialSets != NULL && !initialSets->admit(fpAggregation.tmvPre, fpAggregation.domain, targetID,
+						aggregType[initMode][targetID] == PARA_AGGREG, timePassed, jumpsExecuted+1))
+				{
+					if(bPrint)
+					{
+						printf("Subsumed by an explored initial set of %s.\n", modeNames[targetID].c_str());
+					}
+				}
+				else
+				{
+					succModes.push_back(targetID);
+					succFlowpipes.push_back(fpAggregation);
+					succTimes.push_back(timePassed);
+
+					TreeNode *child = new TreeNode(transitions[initMode][i].jumpID, targetID, triggeredTime);
+					child->parent = node;
+					succNodes.push_back(child);
+				}
+			}
+		}
+
+		if(bPrint)
+		{
+			printf("Done.\n");
+		}
+	}
+
+	return true;
+}
+
+void HybridSystem::reach_hybrid(list<list<TaylorModelVec> > & resultsCompo, list<list<vector<Interval> > > & domains, list<int> & modeIDs, list<TreeNode *> & traceNodes,
+		TreeNode * & traceTree, const vector<int> & integrationSchemes, const double step, const double miniStep,
+		const double time, const int orderType, const vector<int> & orders, const vector<int> & maxOrders, const int globalMaxOrder,
+		const bool bAdaptiveSteps, const bool bAdaptiveOrders, const int maxJmps, const int precondition, const vector<Interval> & estimation,
+		const vector<vector<int> > & aggregType, const vector<vector<vector<RowVector> > > aggregationTemplate_candidates, const vector<RowVector> default_aggregation_template,
+		const vector<vector<Matrix> > & weightTab, const vector<vector<vector<bool> > > & linear_auto, const vector<vector<vector<RowVector> > > & template_auto,
+		const bool bPrint, const vector<string> & stateVarNames, const vector<string> & modeNames, const vector<string> & tmVarNames,
+		InitialSetStore *initialSets) const
+{
+	list<int> modeQueue;
+	list<Flowpipe> flowpipeQueue;
+	list<double> timePassedQueue;
+	list<int> jumpsExecutedQueue;
+
+	Interval intZero;
+
+	modeQueue.push_back(initialMode);
+	flowpipeQueue.push_back(initialSet);
+	timePassedQueue.push_back(0);
+	jumpsExecutedQueue.push_back(0);
+
+	// mode trace
+	list<TreeNode *> nodeQueue;
+	traceTree = new TreeNode(0, initialMode, intZero);
+	nodeQueue.push_back(traceTree);
+
+	for(; modeQueue.size() != 0;)
+	{
+		int initMode = modeQueue.front();
+		Flowpipe initFp = flowpipeQueue.front();
+		double timePassed = timePassedQueue.front();
+		int jumpsExecuted = jumpsExecutedQueue.front();
+		TreeNode *node = nodeQueue.front();
+
+		modeQueue.pop_front();
+		flowpipeQueue.pop_front();
+		timePassedQueue.pop_front();
+		jumpsExecutedQueue.pop_front();
+		nodeQueue.pop_front();
+
+		list<TaylorModelVec> mode_flowpipes;
+		list<vector<Interval> > mode_domains;
+		list<int> succModes;
+		list<Flowpipe> succFlowpipes;
+		list<double> succTimes;
+		list<TreeNode *> succNodes;
+
+		bool bvalid = reach_mode(mode_flowpipes, mode_domains, succModes, succFlowpipes, succTimes, succNodes, initMode, initFp, timePassed, jumpsExecuted, node,
+				integrationSchemes, step, miniStep, time, orderType, orders, maxOrders, globalMaxOrder, bAdaptiveSteps, bAdaptiveOrders, maxJmps, precondition, estimation,
+				aggregType, aggregationTemplate_candidates, default_aggregation_template, weightTab, linear_auto, template_auto, bPrint, stateVarNames, modeNames, tmVarNames,
+				initialSets);
+
+		if(consumer != NULL)
+		{
+			consumer->receive(mode_flowpipes, mode_domains, initMode, node);		// the flowpipes are freed after this iteration
+		}
+		else
+		{
+			resultsCompo.push_back(mode_flowpipes);
+			domains.push_back(mode_domains);
+			modeIDs.push_back(initMode);
+			traceNodes.push_back(node);
+		}
+
+		if(!bvalid)
+		{
+			return;
+		}
+
+		list<TreeNode *>::iterator iterNode = succNodes.begin();
+		for(; iterNode != succNodes.end(); ++iterNode)
+		{
+			node->children.push_back(*iterNode);
+			jumpsExecutedQueue.push_back(jumpsExecuted+1);
+		}
+
+		modeQueue.splice(modeQueue.end(), succModes);
+		flowpipeQueue.splice(flowpipeQueue.end(), succFlowpipes);
+		timePassedQueue.splice(timePassedQueue.end(), succTimes);
+		nodeQueue.splice(nodeQueue.end(), succNodes);
+	}
+}
+
+// class HybridReachability
+
+HybridReachability::HybridReachability()
+{
+	traceTree = NULL;
+	numOfJumps = 0;
+	numSplits = 1;
+	numThreads = 1;
+	bBinaryDumping = false;
+	bStreaming = false;
+	checkingResult = UNKNOWN;
+	numOfStreamedFlowpipes = 0;
+	numOfStreamedModes = 0;
+	bPruning = false;
+	widening = 0;
+}
+
+HybridReachability::~HybridReachability()
+{
+	outputAxes.clear();
+	orders.clear();
+	maxOrders.clear();
+	aggregationType.clear();
+	default_aggregation_template.clear();
+	aggregationTemplate_candidates.clear();
+	aggregationTemplate_TaylorModel.clear();
+	weightTab.clear();
+	flowpipesCompo.clear();
+	domains.clear();
+	modeIDs.clear();
+	stateVarTab.clear();
+	stateVarNames.clear();
+	tmVarTab.clear();
+	tmVarNames.clear();
+	modeTab.clear();
+	modeNames.clear();
+	unsafeSet.clear();
+	traceNodes.clear();
+	integrationSchemes.clear();
+
+	delete traceTree;
+}
+
+bool HybridReachability::dump(FILE *fp) const
+{
+	dump_header(fp);
+
+	if(bBinaryDumping)
+	{
+		// only a reference to the binary file is kept in the text
+		fprintf(fp, "binary\n");
+
+		FILE *fpBinary = open_binary_dumping_file();
+
+		if(fpBinary == NULL)
+		{
+			return false;
+		}
+
+		dump_binary(fpBinary);
+		fclose(fpBinary);
+	}
+	else
+	{
+		list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
+		list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
+		list<int>::const_iterator modeIter = modeIDs.begin();
+
+		for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
+		{
+			dump_mode(fp, *fpIter, *fpdoIter, *modeIter);
+		}
+	}
+
+	dump_footer(fp);
+
+	return true;
+}
+
+FILE *HybridReachability::open_dumping_file() const
+{
+	char filename[NAME_SIZE+30];
+	sprintf(filename, "%s%s.flow", outputDir, outputFileName);
+	return fopen(filename, "w");
+}
+
+void HybridReachability::dump_header(FILE *fp) const
+{
+	fprintf(fp,"state var ");
+	for(int i=0; i<stateVarNames.size()-1; ++i)
+	{
+		fprintf(fp, "%s,", stateVarNames[i].c_str());
+	}
+	fprintf(fp, "%s\n\n", stateVarNames[stateVarNames.size()-1].c_str());
+
+	// dump the constraints for the state space
+	for(int i=0; i<system.invariants.size(); ++i)
+	{
+		fprintf(fp, "%s\n{\n", modeNames[i].c_str());
+
+		for(int j=0; j<system.invariants[i].size(); ++j)
+		{
+			system.invariants[i][j].dump(fp, stateVarNames);
+		}
+
+		fprintf(fp, "}\n\n");
+	}
+
+	switch(plotFormat)
+	{
+	case PLOT_GNUPLOT:
+		switch(plotSetting)
+		{
+		case PLOT_INTERVAL:
+			fprintf(fp, "gnuplot interval %s , %s\n\n", stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
+			break;
+		case PLOT_OCTAGON:
+			fprintf(fp, "gnuplot octagon %s , %s\n\n", stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
+			break;
+		case PLOT_GRID:
+			fprintf(fp, "gnuplot grid %d %s , %s\n\n", numSections, stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
+			break;
+		}
+		break;
+	case PLOT_MATLAB:
+		switch(plotSetting)
+		{
+		case PLOT_INTERVAL:
+			fprintf(fp, "matlab interval %s , %s\n\n", stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
+			break;
+		case PLOT_OCTAGON:
+			fprintf(fp, "matlab octagon %s , %s\n\n", stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
+			break;
+		case PLOT_GRID:
+			fprintf(fp, "matlab grid %d %s , %s\n\n", numSections, stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
+			break;
+		}
+		break;
+	}
+
+	fprintf(fp, "output %s\n\n", outputFileName);
+
+	if(bSafetyChecking)
+	{
+		// dump the unsafe set
+		fprintf(fp, "unsafe set\n{\n");
+
+		for(int i=0; i<bVecUnderCheck.size(); ++i)
+		{
+			if(bVecUnderCheck[i])
+			{
+				fprintf(fp, "%s\n{\n", modeNames[i].c_str());
+
+				for(int j=0; j<unsafeSet[i].size(); ++j)
+				{
+					unsafeSet[i][j].dump(fp, stateVarNames);
+				}
+
+				fprintf(fp, "}\n\n");
+			}
+		}
+
+		fprintf(fp, "}\n\n");
+	}
+
+	fprintf(fp, "hybrid flowpipes\n{\n");
+}
+
+void HybridReachability::dump_mode(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
+{
+	list<TaylorModelVec>::const_iterator tmvIter = flowpipes.begin();
+	list<vector<Interval> >::const_iterator doIter = fpDomains.begin();
+	vector<string> newNames;
+
+	if(doIter->size() != tmVarNames.size())
+	{
+		string tVar("local_t");
+		newNames.push_back(tVar);
+
+		// rename the variables
+		for(int i=1; i<doIter->size(); ++i)
+		{
+			char name[NAME_SIZE];
+			sprintf(name, "%s%d", local_var_name, i);
+			string strName(name);
+			newNames.push_back(strName);
+		}
+	}
+	else
+	{
+		// do not change the name
+		newNames = tmVarNames;
+	}
+
+	fprintf(fp, "%s\n{\n", modeNames[mode].c_str());
+
+	fprintf(fp, "tm var ");
+	for(int i=1; i<newNames.size()-1; ++i)
+	{
+		fprintf(fp, "%s,", newNames[i].c_str());
+	}
+	fprintf(fp, "%s\n\n", newNames[newNames.size()-1].c_str());
+
+	for(; tmvIter!=flowpipes.end(); ++tmvIter, ++doIter)
+	{
+		fprintf(fp, "{\n");
+		tmvIter->dump_interval(fp, stateVarNames, newNames);
+
+		for(int i=0; i<doIter->size(); ++i)
+		{
+			fprintf(fp, "%s in ", newNames[i].c_str());
+			(*doIter)[i].dump(fp);
+			fprintf(fp, "\n");
+		}
+
+		fprintf(fp, "}\n\n");
+	}
+
+	fprintf(fp, "}\n\n");
+}
+
+void HybridReachability::dump_footer(FILE *fp) const
+{
+	fprintf(fp, "}\n\n");
+
+	// the computation tree is only complete after all of the flowpipes are computed
+	fprintf(fp, "computation paths\n{\n\n");
+
+	string strEmpty;
+	traceTree->dump(fp, strEmpty, modeNames);
+
+	fprintf(fp, "}\n");
+}
+
+void HybridReachability::dump_binary(FILE *fp) const
+{
+	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
+	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
+	list<int>::const_iterator modeIter = modeIDs.begin();
+
+	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
+	{
+		dump_binary_mode(fp, *fpIter, *fpdoIter, *modeIter);
+	}
+
+	write_flowpipe_file_end(fp);
+}
+
+void HybridReachability::dump_binary_mode(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
+{
+	write_mode_record(fp, mode);
+
+	list<TaylorModelVec>::const_iterator tmvIter = flowpipes.begin();
+	list<vector<Interval> >::const_iterator doIter = fpDomains.begin();
+
+	for(; tmvIter!=flowpipes.end(); ++tmvIter, ++doIter)
+	{
+		write_flowpipe_record(fp, *tmvIter, *doIter);
+	}
+}
+
+// the header of the file is written, returns NULL if the file can not be created
+FILE *HybridReachability::open_binary_dumping_file() const
+{
+	char filename[NAME_SIZE+30];
+	sprintf(filename, "%s%s%s", outputDir, outputFileName, str_binary_dumping_name_suffix);
+	FILE *fpBinary = fopen(filename, "wb");
+
+	if(fpBinary != NULL)
+	{
+		write_flowpipe_file_header(fpBinary, FLOWPIPE_FILE_HYBRID);
+	}
+
+	return fpBinary;
+}
+
+bool HybridReachability::load_binary()
+{
+	char filename[NAME_SIZE+30];
+	sprintf(filename, "%s%s%s", outputDir, outputFileName, str_binary_dumping_name_suffix);
+
+	FlowpipeFileReader reader;
+	if(!reader.open(filename, FLOWPIPE_FILE_HYBRID))
+	{
+		return false;
+	}
+
+	flowpipesCompo.clear();
+	domains.clear();
+	modeIDs.clear();
+
+	for(;;)
+	{
+		int modeID;
+		TaylorModelVec tmv;
+		vector<Interval> domain;
+
+		int type = reader.next(modeID, tmv, domain);
+
+		if(type == FLOWPIPE_RECORD_END)
+		{
+			break;
+		}
+		else if(type == FLOWPIPE_RECORD_MODE)
+		{
+			if(modeID < 0 || modeID >= modeNames.size())
+			{
+				return false;
+			}
+
+			list<TaylorModelVec> tmvList;
+			list<vector<Interval> > domainList;
+
+			flowpipesCompo.push_back(tmvList);
+			domains.push_back(domainList);
+			modeIDs.push_back(modeID);
+		}
+		else if(type == FLOWPIPE_RECORD_FLOWPIPE && modeIDs.size() > 0)
+		{
+			flowpipesCompo.back().push_back(tmv);
+			domains.back().push_back(domain);
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void HybridReachability::reach(list<list<TaylorModelVec> > & flowpipes, list<list<vector<Interval> > > & fpDomains, list<int> & fpModeIDs, list<TreeNode *> & nodes, TreeNode * & tree, const HybridSystem & sys) const
+{
+	// the streamed mode visits are handed over in the breadth-first order, so they are computed one after another
+	if(numThreads > 1 && numSplits <= 1 && sys.consumer == NULL)
+	{
+		reach_parallel(flowpipes, fpDomains, fpModeIDs, nodes, tree, sys);
+		return;
+	}
+
+	InitialSetStore *initialSets = bPruning ? new InitialSetStore(sys.odes.size(), widening) : NULL;
+
+	sys.reach_hybrid(flowpipes, fpDomains, fpModeIDs, nodes, tree, integrationSchemes, step, miniStep, time, orderType, orders, maxOrders, globalMaxOrder, bAdaptiveSteps, bAdaptiveOrders,
+			maxJumps, precondition, estimation, aggregationType, aggregationTemplate_candidates, default_aggregation_template, weightTab,
+			linear_auto, template_auto, bPrint, stateVarNames, modeNames, tmVarNames, initialSets);
+
+	delete initialSets;
+}
+
+class HybridTask				// a pending pair of a mode and an initial set
+{
+public:
+	vector<int> key;			// the child indices along the computation path
+	int mode;
+	Flowpipe initSet;
+	double timePassed;
+	int jumpsExecuted;
+	TreeNode *node;
+};
+
+class HybridTaskResult
+{
+public:
+	vector<int> key;
+	int mode;
+	TreeNode *node;
+	list<TaylorModelVec> flowpipes;
+	list<vector<Interval> > domains;
+	list<TreeNode *> children;	// not yet added to the children of node
+};
+
+// the breadth-first order of the sequential exploration
+inline static bool keyBefore(const vector<int> & a, const vector<int> & b)
+{
+	if(a.size() != b.size())
+	{
+		return a.size() < b.size();
+	}
+	else
+	{
+		return lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+	}
+}
+
+inline static bool resultBefore(const HybridTaskResult & a, const HybridTaskResult & b)
+{
+	return keyBefore(a.key, b.key);
+}
+
+class HybridWorkers
+{
+public:
+	const HybridReachability *problem;
+	const HybridSystem *system;
+	InitialSetStore *initialSets;			// shared by the workers, NULL if the subsumed successors are kept
+
+	vector<list<HybridTask> > deques;		// the owner works at the back, the others steal from the front
+	vector<pthread_mutex_t> dequeMutexes;
+	vector<list<HybridTaskResult> > results;
+
+	int numPending;							// the number of the tasks which are queued or being processed
+	unsigned long version;					// increased whenever numPending is changed
+	bool bStopped;
+	vector<int> stopKey;					// the first invalid task in the breadth-first order
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+};
+
+static bool take_hybrid_task(HybridTask & task, HybridWorkers *workers, const int id)
+{
+	int numWorkers = workers->deques.size();
 
-		resultsCompo.push_back(mode_flowpipes);
-		domains.push_back(mode_domains);
-		modeIDs.push_back(initMode);
-		traceNodes.push_back(node);
+	for(int k=0; k<numWorkers; ++k)
+	{
+		int victim = (id + k) % numWorkers;
+		bool bFound = false;
 
-		if(!bvalid)
-		{
-			return;
-		}
+		pthread_mutex_lock(&workers->dequeMutexes[victim]);
+		list<HybridTask> & deque = workers->deques[victim];
 
-		if(jumpsExecuted == maxJmps)
+		if(deque.size() > 0)
 		{
-			if(bPrint)
+			if(k == 0)
 			{
-				printf("Maximum jump depth is reached.\n");
+				task = deque.back();
+				deque.pop_back();
 			}
-			continue;
-		}
-
-		vector<vector<Interval> > step_exp_tables;
-		vector<Interval> step_exp_table;
-
-		for(; tmvIter!=mode_flowpipes.end(); ++tmvIter, ++doIter)
-		{
-			if(step_exp_table.size() == 0 || step_exp_table[1] != (*doIter)[0])
+			else
 			{
-				construct_step_exp_table(step_exp_table, (*doIter)[0], globalMaxOrder);
+				task = deque.front();
+				deque.pop_front();
 			}
 
-			step_exp_tables.push_back(step_exp_table);
+			bFound = true;
 		}
+		pthread_mutex_unlock(&workers->dequeMutexes[victim]);
 
-		// over-approximate the intersection for each jump
-		for(int i=0; i<transitions[initMode].size(); ++i)
+		if(bFound)
 		{
-			vector<TaylorModelVec> intersection_flowpipes;
-			vector<vector<Interval> > intersection_domains;
-
-			list<TaylorModelVec>::iterator tmvIter = mode_flowpipes.begin();
-			list<vector<Interval> >::iterator doIter = mode_domains.begin();
-			double newTimePassed = 0;
-			bool brecorded = false;
+			return true;
+		}
+	}
 
-			if(bPrint)
-			{
-				printf("Dealing with the jump from %s to %s ...\n", modeNames[initMode].c_str(), modeNames[transitions[initMode][i].targetID].c_str());
-			}
+	return false;
+}
 
-			// collect the intersected flowpipes
+static void hybrid_worker(void *arg, const int id)
+{
+	HybridWorkers *workers = (HybridWorkers *)arg;
+	const HybridReachability *problem = workers->problem;
 
-			vector<bool> guard_boundary_intersected;
+	for(;;)
+	{
+		pthread_mutex_lock(&workers->mutex);
+		unsigned long version = workers->version;
+		pthread_mutex_unlock(&workers->mutex);
 
-			step_exp_table = step_exp_tables[0];
+		HybridTask task;
 
-			Interval triggeredTime;
+		if(!take_hybrid_task(task, workers, id))
+		{
+			pthread_mutex_lock(&workers->mutex);
 
-			for(int k=0; tmvIter!=mode_flowpipes.end(); ++tmvIter, ++doIter)
+			if(workers->numPending == 0)
 			{
-				TaylorModelVec tmvIntersection = *tmvIter;
-				vector<Interval> doIntersection = *doIter;
-
-				if(step_exp_table[1] != (*doIter)[0])
-				{
-					step_exp_table = step_exp_tables[++k];
-				}
-
-				vector<bool> local_boundary_intersected;
-				int type = contract_interval_arithmetic(tmvIntersection, doIntersection, transitions[initMode][i].guard, local_boundary_intersected);
-
-				if(type >= 0 && aggregType[initMode][transitions[initMode][i].targetID] == PARA_AGGREG)
-				{
-					// collect the intersected guard boundary
-					if(guard_boundary_intersected.size() != local_boundary_intersected.size())
-					{
-						guard_boundary_intersected = local_boundary_intersected;
-					}
-					else
-					{
-						for(int j=0; j<local_boundary_intersected.size(); ++j)
-						{
-							if(local_boundary_intersected[j])
-							{
-								guard_boundary_intersected[j] = true;
-							}
-						}
-					}
-				}
-
-				if(type != -1)
-				{
-					if(!brecorded)
-					{
-						brecorded = true;
-
-						triggeredTime = doIntersection[0];
-						triggeredTime.add_assign(newTimePassed);
-						newTimePassed += doIntersection[0].inf();
-					}
-					else
-					{
-						// compute the time interval when the jump is triggered
-						triggeredTime.setSup(triggeredTime.sup() + doIntersection[0].sup());
-					}
-
-					intersection_flowpipes.push_back(tmvIntersection);
-					intersection_domains.push_back(doIntersection);
-				}
-				else
-				{
-					if(!brecorded)
-					{
-						newTimePassed += doIntersection[0].sup();
-					}
-				}
+				pthread_mutex_unlock(&workers->mutex);
+				break;
 			}
 
-			vector<bool> boundary_intersected = invariant_boundary_intersected;
-			for(int j=0; j<guard_boundary_intersected.size(); ++j)
+			if(workers->version == version)
 			{
-				boundary_intersected.push_back(guard_boundary_intersected[j]);
+				pthread_cond_wait(&workers->cond, &workers->mutex);
 			}
 
-			// aggregate the intersections
-			if(intersection_flowpipes.size() > 0)
-			{
-				Flowpipe fpAggregation;
-				TaylorModelVec tmvAggregation;
-				vector<Interval> doAggregation;
-
-				switch(aggregType[initMode][transitions[initMode][i].targetID])
-				{
-				case INTERVAL_AGGREG:
-				{
-					aggregate_flowpipes_by_interval(tmvAggregation, doAggregation, intersection_flowpipes, intersection_domains);
-
-					break;
-				}
-				case PARA_AGGREG:
-				{
-					aggregate_flowpipes_by_Parallelotope(tmvAggregation, doAggregation, intersection_flowpipes, intersection_domains,
-							invariants[initMode], transitions[initMode][i], boundary_intersected,
-							aggregationTemplate_candidates[initMode][transitions[initMode][i].targetID], default_aggregation_template,
-							weightTab, linear_auto, template_auto, globalMaxOrder, rangeDim);
-
-					break;
-				}
-				}
+			pthread_mutex_unlock(&workers->mutex);
+			continue;
+		}
 
-				// contract the aggregation regarding to the guard and invariant
-				vector<PolynomialConstraint> constraints = transitions[initMode][i].guard;
-				for(int j=0; j<invariants[initMode].size(); ++j)
-				{
-					constraints.push_back(invariants[initMode][j]);
-				}
+		// a task after the first invalid one is not needed
+		pthread_mutex_lock(&workers->mutex);
+		bool bSkipped = workers->bStopped && keyBefore(workers->stopKey, task.key);
+		pthread_mutex_unlock(&workers->mutex);
 
-				vector<bool> bVecDummy;
-				contract_interval_arithmetic(tmvAggregation, doAggregation, constraints, bVecDummy);
+		int numSucc = 0;
 
-				//reset map
-				TaylorModelVec tmvImage;
-				transitions[initMode][i].resetMap.reset(tmvImage, tmvAggregation, doAggregation, globalMaxOrder);
+		if(!bSkipped)
+		{
+			HybridTaskResult result;
+			result.key = task.key;
+			result.mode = task.mode;
+			result.node = task.node;
 
-				int type = contract_interval_arithmetic(tmvImage, doAggregation, invariants[transitions[initMode][i].targetID], bVecDummy);
+			list<int> succModes;
+			list<Flowpipe> succFlowpipes;
+			list<double> succTimes;
 
-				if(type == -1)
-				{
-					if(bPrint)
-					{
-						printf("No intersection detected.\n");
-					}
+			bool bvalid = workers->system->reach_mode(result.flowpipes, result.domains, succModes, succFlowpipes, succTimes, result.children,
+					task.mode, task.initSet, task.timePassed, task.jumpsExecuted, task.node,
+					problem->integrationSchemes, problem->step, problem->miniStep, problem->time, problem->orderType, problem->orders, problem->maxOrders,
+					problem->globalMaxOrder, problem->bAdaptiveSteps, problem->bAdaptiveOrders, problem->maxJumps, problem->precondition, problem->estimation,
+					problem->aggregationType, problem->aggregationTemplate_candidates, problem->default_aggregation_template, problem->weightTab,
+					problem->linear_auto, problem->template_auto, problem->bPrint, problem->stateVarNames, problem->modeNames, problem->tmVarNames,
+					workers->initialSets);
 
-					continue;
-				}
-				else
+			if(!bvalid)
+			{
+				pthread_mutex_lock(&workers->mutex);
+				if(!workers->bStopped || keyBefore(task.key, workers->stopKey))
 				{
-					int rangeDim = tmvImage.tms.size();
-					Matrix coefficients(rangeDim, rangeDim+1);
-					for(int i=0; i<rangeDim; ++i)
-					{
-						coefficients.set(1, i, i+1);
-					}
-					TaylorModelVec tmvTemp(coefficients);
-
-					fpAggregation.tmv = tmvTemp;
-					fpAggregation.tmvPre = tmvImage;
-					fpAggregation.domain = doAggregation;
+					workers->bStopped = true;
+					workers->stopKey = task.key;
 				}
+				pthread_mutex_unlock(&workers->mutex);
+			}
 
-				timePassed += newTimePassed;
-				if(timePassed < time - THRESHOLD_HIGH)
-				{
-					modeQueue.push_back(transitions[initMode][i].targetID);
-					flowpipeQueue.push_back(fpAggregation);
-					timePassedQueue.push_back(timePassed);
-					jumpsExecutedQueue.push_back(jumpsExecuted+1);
+			list<int>::iterator iterMode = succModes.begin();
+			list<Flowpipe>::iterator iterFp = succFlowpipes.begin();
+			list<double>::iterator iterTime = succTimes.begin();
+			list<TreeNode *>::iterator iterNode = result.children.begin();
 
-					TreeNode *child = new TreeNode(transitions[initMode][i].jumpID, transitions[initMode][i].targetID, triggeredTime);
-					child->parent = node;
-					node->children.push_back(child);
+			pthread_mutex_lock(&workers->dequeMutexes[id]);
+			for(; iterMode != succModes.end(); ++iterMode, ++iterFp, ++iterTime, ++iterNode, ++numSucc)
+			{
+				HybridTask succ;
+				succ.key = task.key;
+				succ.key.push_back(numSucc);
+				succ.mode = *iterMode;
+				succ.initSet = *iterFp;
+				succ.timePassed = *iterTime;
+				succ.jumpsExecuted = task.jumpsExecuted + 1;
+				succ.node = *iterNode;
 
-					nodeQueue.push_back(child);
-				}
+				workers->deques[id].push_back(succ);
 			}
+			pthread_mutex_unlock(&workers->dequeMutexes[id]);
 
-			if(bPrint)
-			{
-				printf("Done.\n");
-			}
+			workers->results[id].push_back(result);
 		}
 
-		step_exp_tables.clear();
+		pthread_mutex_lock(&workers->mutex);
+		workers->numPending += numSucc - 1;
+		++workers->version;
+		pthread_cond_broadcast(&workers->cond);
+		pthread_mutex_unlock(&workers->mutex);
 	}
 }
 
+/*
+ * The pending jump successors are explored by the worker threads in parallel. Every worker keeps its successors in
+ * its own deque and the idle workers steal from the others. Each task is labeled by its position in the breadth-first
+ * order of the sequential exploration, so the results and the trace tree are merged in that order and an invalid
+ * flowpipe stops the exploration at the same point as in HybridSystem::reach_hybrid. When the subsumed successors are
+ * pruned, the set which is kept out of two nested ones may depend on the schedule, the result is sound in either case.
+ */
+void HybridReachability::reach_parallel(list<list<TaylorModelVec> > & flowpipes, list<list<vector<Interval> > > & fpDomains, list<int> & fpModeIDs, list<TreeNode *> & nodes, TreeNode * & tree, const HybridSystem & sys) const
+{
+	Interval intZero;
 
+	HybridWorkers workers;
+	workers.problem = this;
+	workers.system = &sys;
+	workers.initialSets = bPruning ? new InitialSetStore(sys.odes.size(), widening) : NULL;
+	workers.deques.resize(numThreads);
+	workers.dequeMutexes.resize(numThreads);
+	workers.results.resize(numThreads);
+	workers.numPending = 1;
+	workers.version = 0;
+	workers.bStopped = false;
+
+	for(int i=0; i<numThreads; ++i)
+	{
+		pthread_mutex_init(&workers.dequeMutexes[i], NULL);
+	}
 
+	pthread_mutex_init(&workers.mutex, NULL);
+	pthread_cond_init(&workers.cond, NULL);
 
+	tree = new TreeNode(0, sys.initialMode, intZero);
 
+	HybridTask task;
+	task.mode = sys.initialMode;
+	task.initSet = sys.initialSet;
+	task.timePassed = 0;
+	task.jumpsExecuted = 0;
+	task.node = tree;
+	workers.deques[0].push_back(task);
 
+	runParallelTasks(hybrid_worker, &workers, numThreads, numThreads);
 
+	for(int i=0; i<numThreads; ++i)
+	{
+		pthread_mutex_destroy(&workers.dequeMutexes[i]);
+	}
 
+	pthread_mutex_destroy(&workers.mutex);
+	pthread_cond_destroy(&workers.cond);
 
+	delete workers.initialSets;
 
+	list<HybridTaskResult> results;
+	for(int i=0; i<numThreads; ++i)
+	{
+		results.splice(results.end(), workers.results[i]);
+	}
 
+	results.sort(resultBefore);
 
+	flowpipes.clear();
+	fpDomains.clear();
+	fpModeIDs.clear();
+	nodes.clear();
 
+	list<HybridTaskResult>::iterator iter = results.begin();
+	for(; iter != results.end(); ++iter)
+	{
+		if(workers.bStopped && keyBefore(workers.stopKey, iter->key))
+		{
+			// computed after the exploration should have stopped
+			list<TreeNode *>::iterator iterChild = iter->children.begin();
+			for(; iterChild != iter->children.end(); ++iterChild)
+			{
+				delete *iterChild;
+			}
 
+			continue;
+		}
 
+		flowpipes.push_back(list<TaylorModelVec>());
+		flowpipes.back().swap(iter->flowpipes);
+		fpDomains.push_back(list<vector<Interval> >());
+		fpDomains.back().swap(iter->domains);
+		fpModeIDs.push_back(iter->mode);
+		nodes.push_back(iter->node);
 
+		iter->node->children.splice(iter->node->children.end(), iter->children);
+	}
+}
 
+class HybridStreamingStage : public ModeFlowpipeConsumer		// plots, dumps and checks the flowpipes of each mode visit, they are freed afterwards
+{
+public:
+	const HybridReachability *problem;
+	bool bChecking;
 
+	FILE *fpPlotting;
+	FILE *fpDumping;
+	FILE *fpBinary;				// NULL unless the flowpipes are dumped in binary
+	FILE *fpCounterexamples;	// may be NULL
 
+	int result;
+	unsigned long numOfFlowpipes;
+	unsigned long numOfModes;
 
+	HybridStreamingStage()
+	{
+		problem = NULL;
+		bChecking = false;
+		fpPlotting = NULL;
+		fpDumping = NULL;
+		fpBinary = NULL;
+		fpCounterexamples = NULL;
+		result = SAFE;
+		numOfFlowpipes = 0;
+		numOfModes = 0;
+	}
 
+	bool open();		// returns false if the output files can not be created
+	void close();		// the computation tree is written at the end of the dumping file
+	void receive(const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, const int mode, TreeNode *node);
+};
 
-
-// class HybridReachability
-
-HybridReachability::HybridReachability()
+bool HybridStreamingStage::open()
 {
-	traceTree = NULL;
-	numOfJumps = 0;
-}
+	fpPlotting = problem->open_plotting_file();
 
-HybridReachability::~HybridReachability()
-{
-	outputAxes.clear();
-	orders.clear();
-	maxOrders.clear();
-	aggregationType.clear();
-	default_aggregation_template.clear();
-	aggregationTemplate_candidates.clear();
-	aggregationTemplate_TaylorModel.clear();
-	weightTab.clear();
-	flowpipesCompo.clear();
-	domains.clear();
-	modeIDs.clear();
-	stateVarTab.clear();
-	stateVarNames.clear();
-	tmVarTab.clear();
-	tmVarNames.clear();
-	modeTab.clear();
-	modeNames.clear();
-	unsafeSet.clear();
-	traceNodes.clear();
-	integrationSchemes.clear();
+	if(fpPlotting == NULL)
+	{
+		return false;
+	}
 
-	delete traceTree;
-}
+	fpDumping = problem->open_dumping_file();
 
-void HybridReachability::dump(FILE *fp) const
-{
-	fprintf(fp,"state var ");
-	for(int i=0; i<stateVarNames.size()-1; ++i)
+	if(fpDumping == NULL)
 	{
-		fprintf(fp, "%s,", stateVarNames[i].c_str());
+		fclose(fpPlotting);
+		return false;
 	}
-	fprintf(fp, "%s\n\n", stateVarNames[stateVarNames.size()-1].c_str());
 
-	// dump the constraints for the state space
-	for(int i=0; i<system.invariants.size(); ++i)
+	if(problem->bBinaryDumping)
 	{
-		fprintf(fp, "%s\n{\n", modeNames[i].c_str());
+		fpBinary = problem->open_binary_dumping_file();
 
-		for(int j=0; j<system.invariants[i].size(); ++j)
+		if(fpBinary == NULL)
 		{
-			system.invariants[i][j].dump(fp, stateVarNames);
+			fclose(fpPlotting);
+			fclose(fpDumping);
+			return false;
 		}
-
-		fprintf(fp, "}\n\n");
 	}
 
-	// dump the computation tree
-	fprintf(fp, "computation paths\n{\n\n");
-
-	string strEmpty;
-	traceTree->dump(fp, strEmpty, modeNames);
-
-	fprintf(fp, "}\n\n");
+	problem->plot_2D_header(fpPlotting);
+	problem->dump_header(fpDumping);
 
-	switch(plotFormat)
+	if(fpBinary != NULL)
 	{
-	case PLOT_GNUPLOT:
-		switch(plotSetting)
-		{
-		case PLOT_INTERVAL:
-			fprintf(fp, "gnuplot interval %s , %s\n\n", stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
-			break;
-		case PLOT_OCTAGON:
-			fprintf(fp, "gnuplot octagon %s , %s\n\n", stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
-			break;
-		case PLOT_GRID:
-			fprintf(fp, "gnuplot grid %d %s , %s\n\n", numSections, stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
-			break;
-		}
-		break;
-	case PLOT_MATLAB:
-		switch(plotSetting)
-		{
-		case PLOT_INTERVAL:
-			fprintf(fp, "matlab interval %s , %s\n\n", stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
-			break;
-		case PLOT_OCTAGON:
-			fprintf(fp, "matlab octagon %s , %s\n\n", stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
-			break;
-		case PLOT_GRID:
-			fprintf(fp, "matlab grid %d %s , %s\n\n", numSections, stateVarNames[outputAxes[0]].c_str(), stateVarNames[outputAxes[1]].c_str());
-			break;
-		}
-		break;
+		// only a reference to the binary file is kept in the text
+		fprintf(fpDumping, "binary\n");
 	}
 
-	fprintf(fp, "output %s\n\n", outputFileName);
-
-	if(bSafetyChecking)
+	if(bChecking)
 	{
-		// dump the unsafe set
-		fprintf(fp, "unsafe set\n{\n");
-
-		for(int i=0; i<bVecUnderCheck.size(); ++i)
-		{
-			if(bVecUnderCheck[i])
-			{
-				fprintf(fp, "%s\n{\n", modeNames[i].c_str());
-
-				for(int j=0; j<unsafeSet[i].size(); ++j)
-				{
-					unsafeSet[i][j].dump(fp, stateVarNames);
-				}
-
-				fprintf(fp, "}\n\n");
-			}
-		}
-
-		fprintf(fp, "}\n\n");
+		fpCounterexamples = problem->open_counterexample_file();
 	}
 
-	int rangeDim = system.hfOdes.size();
-
-	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
-	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
-	list<int>::const_iterator modeIter = modeIDs.begin();
-
-	list<TaylorModelVec>::const_iterator tmvIter;
-	list<vector<Interval> >::const_iterator doIter;
+	return true;
+}
 
-	fprintf(fp, "hybrid flowpipes\n{\n");
+void HybridStreamingStage::close()
+{
+	problem->plot_2D_footer(fpPlotting);
+	fclose(fpPlotting);
 
-	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
+	if(fpBinary != NULL)
 	{
-		tmvIter = fpIter->begin();
-		doIter = fpdoIter->begin();
-		vector<string> newNames;
-
-		if(doIter->size() != tmVarNames.size())
-		{
-			string tVar("local_t");
-			newNames.push_back(tVar);
+		write_flowpipe_file_end(fpBinary);
+		fclose(fpBinary);
+	}
 
-			// rename the variables
-			for(int i=1; i<doIter->size(); ++i)
-			{
-				char name[NAME_SIZE];
-				sprintf(name, "%s%d", local_var_name, i);
-				string strName(name);
-				newNames.push_back(strName);
-			}
-		}
-		else
-		{
-			// do not change the name
-			newNames = tmVarNames;
-		}
+	problem->dump_footer(fpDumping);
+	fclose(fpDumping);
 
-		fprintf(fp, "%s\n{\n", modeNames[*modeIter].c_str());
+	if(fpCounterexamples != NULL)
+	{
+		fclose(fpCounterexamples);
+	}
+}
 
-		fprintf(fp, "tm var ");
-		for(int i=1; i<newNames.size()-1; ++i)
-		{
-			fprintf(fp, "%s,", newNames[i].c_str());
-		}
-		fprintf(fp, "%s\n\n", newNames[newNames.size()-1].c_str());
+void HybridStreamingStage::receive(const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, const int mode, TreeNode *node)
+{
+	problem->plot_2D_mode(fpPlotting, flowpipes, domains, mode);
 
-		for(; tmvIter!=fpIter->end(); ++tmvIter, ++doIter)
-		{
-			fprintf(fp, "{\n");
-			tmvIter->dump_interval(fp, stateVarNames, newNames);
+	if(fpBinary != NULL)
+	{
+		problem->dump_binary_mode(fpBinary, flowpipes, domains, mode);
+	}
+	else
+	{
+		problem->dump_mode(fpDumping, flowpipes, domains, mode);
+	}
 
-			for(int i=0; i<doIter->size(); ++i)
-			{
-				fprintf(fp, "%s in ", newNames[i].c_str());
-				(*doIter)[i].dump(fp);
-				fprintf(fp, "\n");
-			}
+	if(bChecking && result != UNSAFE)
+	{
+		int type = problem->check_mode(fpCounterexamples, flowpipes, domains, mode, node);
 
-			fprintf(fp, "}\n\n");
+		if(type != SAFE)
+		{
+			result = type;
 		}
-
-		fprintf(fp, "}\n\n");
 	}
 
-	fprintf(fp, "}\n");
+	numOfFlowpipes += flowpipes.size();
+	++numOfModes;
+}
+
+class HybridSplitTasks		// the reachability computations for the sub-boxes of the initial set
+{
+public:
+	const HybridReachability *problem;
+	vector<HybridSystem> systems;
+	vector<list<list<TaylorModelVec> > > flowpipes;
+	vector<list<list<vector<Interval> > > > domains;
+	vector<list<int> > modeIDs;
+	vector<list<TreeNode *> > nodes;
+	vector<TreeNode *> trees;
+};
+
+static void hybrid_split_task(void *arg, const int i)
+{
+	HybridSplitTasks *tasks = (HybridSplitTasks *)arg;
+	tasks->problem->reach(tasks->flowpipes[i], tasks->domains[i], tasks->modeIDs[i], tasks->nodes[i], tasks->trees[i], tasks->systems[i]);
 }
 
-void HybridReachability::run()
+bool HybridReachability::run()
 {
 	// normalize the candidate vectors
 	for(int i=0; i<aggregationTemplate_candidates.size(); ++i)
@@ -3050,15 +4539,119 @@ void HybridReachability::run()
 	compute_power_4(globalMaxOrder+1);
 	compute_double_factorial(2*globalMaxOrder);
 
+	HybridStreamingStage stage;
+	stage.problem = this;
+	stage.bChecking = bSafetyChecking;
 
-	system.reach_hybrid(flowpipesCompo, domains, modeIDs, traceNodes, traceTree, integrationSchemes, step, miniStep, time, orderType, orders, maxOrders, globalMaxOrder, bAdaptiveSteps, bAdaptiveOrders,
-			maxJumps, precondition, estimation, aggregationType, aggregationTemplate_candidates, default_aggregation_template, weightTab,
-			linear_auto, template_auto, bPrint, stateVarNames, modeNames, tmVarNames);
+	if(bStreaming)
+	{
+		// the output files are filled while the mode visits are computed
+		if(!stage.open())
+		{
+			return false;
+		}
+
+		if(bSafetyChecking)
+		{
+			select_modes_under_check();
+		}
+
+		system.consumer = &stage;
+	}
+
+	if(numSplits <= 1)
+	{
+		reach(flowpipesCompo, domains, modeIDs, traceNodes, traceTree, system);
+	}
+	else
+	{
+		reach_split();
+	}
+
+	if(bStreaming)
+	{
+		system.consumer = NULL;
+		stage.close();
+
+		checkingResult = stage.result;
+		numOfStreamedFlowpipes = stage.numOfFlowpipes;
+		numOfStreamedModes = stage.numOfModes;
+	}
+
+	return true;
+}
+
+void HybridReachability::reach_split()
+{
+	list<Flowpipe> initialSets;
+	system.initialSet.split(initialSets, numSplits);
+	numSplits = initialSets.size();		// a degenerate domain may have fewer pieces
+
+	HybridSplitTasks tasks;
+	tasks.problem = this;
+
+	list<Flowpipe>::const_iterator iter = initialSets.begin();
+	for(; iter != initialSets.end(); ++iter)
+	{
+		HybridSystem sys = system;
+		sys.initialSet = *iter;
+		tasks.systems.push_back(sys);
+	}
+
+	int num = tasks.systems.size();
+	tasks.flowpipes.resize(num);
+	tasks.domains.resize(num);
+	tasks.modeIDs.resize(num);
+	tasks.nodes.resize(num);
+	tasks.trees.resize(num, NULL);
+
+	// the sub-boxes share the output files when streaming, so they are handled one after another
+	runParallelTasks(hybrid_split_task, &tasks, num, bStreaming ? 1 : numThreads);
+
+	// the results are merged in the order of the sub-boxes, all of the computation paths start from the root of the first tree
+	flowpipesCompo.clear();
+	domains.clear();
+	modeIDs.clear();
+	traceNodes.clear();
+
+	traceTree = tasks.trees[0];
+
+	for(int i=0; i<num; ++i)
+	{
+		TreeNode *root = tasks.trees[i];
+
+		if(i > 0)
+		{
+			list<TreeNode *>::iterator iterChild = root->children.begin();
+			for(; iterChild != root->children.end(); ++iterChild)
+			{
+				(*iterChild)->parent = traceTree;
+			}
+
+			traceTree->children.splice(traceTree->children.end(), root->children);
+
+			list<TreeNode *>::iterator iterNode = tasks.nodes[i].begin();
+			for(; iterNode != tasks.nodes[i].end(); ++iterNode)
+			{
+				if(*iterNode == root)
+				{
+					*iterNode = traceTree;
+				}
+			}
+
+			delete root;
+		}
+
+		flowpipesCompo.splice(flowpipesCompo.end(), tasks.flowpipes[i]);
+		domains.splice(domains.end(), tasks.domains[i]);
+		modeIDs.splice(modeIDs.end(), tasks.modeIDs[i]);
+		traceNodes.splice(traceNodes.end(), tasks.nodes[i]);
+	}
 }
 
-void HybridReachability::plot_2D() const
+FILE *HybridReachability::open_plotting_file() const
 {
-	char filename[NAME_SIZE+10];
+	char filename[NAME_SIZE+30];
 
 	switch(plotFormat)
 	{
@@ -3070,50 +4663,50 @@ void HybridReachability::plot_2D() const
 		break;
 	}
 
-	FILE *fpPlotting = fopen(filename, "w");
+	return fopen(filename, "w");
+}
+
+bool HybridReachability::plot_2D() const
+{
+	FILE *fpPlotting = open_plotting_file();
 
 	if(fpPlotting == NULL)
 	{
-		printf("Can not create the plotting file.\n");
-		exit(1);
+		return false;
 	}
 
 	printf("Generating the plotting file...\n");
-	switch(plotFormat)
+
+	plot_2D_header(fpPlotting);
+
+	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
+	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
+	list<int>::const_iterator modeIter = modeIDs.begin();
+
+	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
 	{
-	case PLOT_GNUPLOT:
-		plot_2D_GNUPLOT(fpPlotting);
-		break;
-	case PLOT_MATLAB:
-		plot_2D_MATLAB(fpPlotting);
-		break;
+		plot_2D_mode(fpPlotting, *fpIter, *fpdoIter, *modeIter);
 	}
+
+	plot_2D_footer(fpPlotting);
+
 	printf("Done.\n");
 
 	fclose(fpPlotting);
+
+	return true;
 }
 
-void HybridReachability::plot_2D_GNUPLOT(FILE *fp) const
+void HybridReachability::plot_2D_header(FILE *fp) const
 {
-	switch(plotSetting)
+	if(plotFormat != PLOT_GNUPLOT)
 	{
-	case PLOT_INTERVAL:
-		plot_2D_interval_GNUPLOT(fp);
-		break;
-	case PLOT_OCTAGON:
-		plot_2D_octagon_GNUPLOT(fp);
-		break;
-	case PLOT_GRID:
-		plot_2D_grid_GNUPLOT(fp);
-		break;
+		return;
 	}
-}
 
-void HybridReachability::plot_2D_interval_GNUPLOT(FILE *fp) const
-{
 	fprintf(fp, "set terminal postscript\n");
 
-	char filename[NAME_SIZE+10];
+	char filename[NAME_SIZE+30];
 	sprintf(filename, "%s%s.eps", imageDir, outputFileName);
 	fprintf(fp, "set output '%s'\n", filename);
 
@@ -3125,53 +4718,81 @@ void HybridReachability::plot_2D_interval_GNUPLOT(FILE *fp) const
 	fprintf(fp, "set xlabel \"%s\"\n", stateVarNames[outputAxes[0]].c_str());
 	fprintf(fp, "set ylabel \"%s\"\n", stateVarNames[outputAxes[1]].c_str());
 	fprintf(fp, "plot '-' notitle with lines ls 1\n");
+}
 
-	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
-	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
-	list<int>::const_iterator modeIter = modeIDs.begin();
+void HybridReachability::plot_2D_mode(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
+{
+	switch(plotFormat)
+	{
+	case PLOT_GNUPLOT:
+		plot_2D_GNUPLOT(fp, flowpipes, fpDomains, mode);
+		break;
+	case PLOT_MATLAB:
+		plot_2D_MATLAB(fp, flowpipes, fpDomains, mode);
+		break;
+	}
+}
 
-	list<TaylorModelVec>::const_iterator tmvIter;
-	list<vector<Interval> >::const_iterator doIter;
+void HybridReachability::plot_2D_footer(FILE *fp) const
+{
+	if(plotFormat == PLOT_GNUPLOT)
+	{
+		fprintf(fp, "e\n");
+	}
+}
 
-	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
+void HybridReachability::plot_2D_GNUPLOT(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
+{
+	switch(plotSetting)
 	{
-		tmvIter = fpIter->begin();
-		doIter = fpdoIter->begin();
+	case PLOT_INTERVAL:
+		plot_2D_interval_GNUPLOT(fp, flowpipes, fpDomains, mode);
+		break;
+	case PLOT_OCTAGON:
+		plot_2D_octagon_GNUPLOT(fp, flowpipes, fpDomains, mode);
+		break;
+	case PLOT_GRID:
+		plot_2D_grid_GNUPLOT(fp, flowpipes, fpDomains, mode);
+		break;
+	}
+}
 
-		for(; tmvIter != fpIter->end(); ++tmvIter, ++doIter)
-		{
-			vector<Interval> box;
-			tmvIter->intEval(box, *doIter);
+void HybridReachability::plot_2D_interval_GNUPLOT(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
+{
+	list<TaylorModelVec>::const_iterator tmvIter = flowpipes.begin();
+	list<vector<Interval> >::const_iterator doIter = fpDomains.begin();
 
-			// contract the interval according to the invariant
-			vector<Interval> new_domain;
-			vector<bool> bVecTemp;
-			TaylorModelVec tmvInterval(box, new_domain);
-			int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[*modeIter], bVecTemp);
+	for(; tmvIter != flowpipes.end(); ++tmvIter, ++doIter)
+	{
+		vector<Interval> box;
+		tmvIter->intEval(box, *doIter);
 
-			if(type < 0)
-			{
-				continue;
-			}
+		// contract the interval according to the invariant
+		vector<Interval> new_domain;
+		vector<bool> bVecTemp;
+		TaylorModelVec tmvInterval(box, new_domain);
+		int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[mode], bVecTemp);
 
-			tmvInterval.intEval(box, new_domain);
+		if(type < 0)
+		{
+			continue;
+		}
 
-			Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
+		tmvInterval.intEval(box, new_domain);
 
-			// output the vertices
-			fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
-			fprintf(fp, "%lf %lf\n", X.sup(), Y.inf());
-			fprintf(fp, "%lf %lf\n", X.sup(), Y.sup());
-			fprintf(fp, "%lf %lf\n", X.inf(), Y.sup());
-			fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
-			fprintf(fp, "\n\n");
-		}
-	}
+		Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
 
-	fprintf(fp, "e\n");
+		// output the vertices
+		fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
+		fprintf(fp, "%lf %lf\n", X.sup(), Y.inf());
+		fprintf(fp, "%lf %lf\n", X.sup(), Y.sup());
+		fprintf(fp, "%lf %lf\n", X.inf(), Y.sup());
+		fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
+		fprintf(fp, "\n\n");
+	}
 }
 
-void HybridReachability::plot_2D_octagon_GNUPLOT(FILE *fp) const
+void HybridReachability::plot_2D_octagon_GNUPLOT(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
 {
 	int x = outputAxes[0];
 	int y = outputAxes[1];
@@ -3253,21 +4874,6 @@ void HybridReachability::plot_2D_octagon_GNUPLOT(FILE *fp) const
 
 	ColVector b(rows);
 
-	fprintf(fp, "set terminal postscript\n");
-
-	char filename[NAME_SIZE+10];
-	sprintf(filename, "%s%s.eps", imageDir, outputFileName);
-	fprintf(fp, "set output '%s'\n", filename);
-
-	fprintf(fp, "set style line 1 linecolor rgb \"blue\"\n");
-	fprintf(fp, "set autoscale\n");
-	fprintf(fp, "unset label\n");
-	fprintf(fp, "set xtic auto\n");
-	fprintf(fp, "set ytic auto\n");
-	fprintf(fp, "set xlabel \"%s\"\n", stateVarNames[outputAxes[0]].c_str());
-	fprintf(fp, "set ylabel \"%s\"\n", stateVarNames[outputAxes[1]].c_str());
-	fprintf(fp, "plot '-' notitle with lines ls 1\n");
-
 	vector<Interval> step_exp_table;
 	Interval I(1);
 	step_exp_table.push_back(I);
@@ -3279,155 +4885,121 @@ void HybridReachability::plot_2D_octagon_GNUPLOT(FILE *fp) const
 	gsl_vector *d = gsl_vector_alloc(2);
 	gsl_vector *vertex = gsl_vector_alloc(2);
 
-	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
-	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
-	list<int>::const_iterator modeIter = modeIDs.begin();
-
-	list<TaylorModelVec>::const_iterator tmvIter;
-	list<vector<Interval> >::const_iterator doIter;
+	list<TaylorModelVec>::const_iterator tmvIter = flowpipes.begin();
+	list<vector<Interval> >::const_iterator doIter = fpDomains.begin();
 
-	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
+	for(; tmvIter != flowpipes.end(); ++tmvIter, ++doIter)
 	{
-		tmvIter = fpIter->begin();
-		doIter = fpdoIter->begin();
-
-		for(; tmvIter != fpIter->end(); ++tmvIter, ++doIter)
-		{
-			int rangeDim = tmvIter->tms.size();
-			vector<Interval> box;
-			tmvIter->intEval(box, *doIter);
+		int rangeDim = tmvIter->tms.size();
+		vector<Interval> box;
+		tmvIter->intEval(box, *doIter);
 
-			vector<Interval> new_domain;
-			vector<bool> bVecTemp;
-			TaylorModelVec tmvInterval(box, new_domain);
-			int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[*modeIter], bVecTemp);
+		vector<Interval> new_domain;
+		vector<bool> bVecTemp;
+		TaylorModelVec tmvInterval(box, new_domain);
+		int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[mode], bVecTemp);
 
-			if(type < 0)
-			{
-				continue;
-			}
+		if(type < 0)
+		{
+			continue;
+		}
 
-			tmvInterval.intEval(box, new_domain);
+		tmvInterval.intEval(box, new_domain);
 
-			// the box template
-			b.set(box[x].sup(), 0);
-			b.set(box[y].sup(), 2);
-			b.set(-box[x].inf(), 4);
-			b.set(-box[y].inf(), 6);
+		// the box template
+		b.set(box[x].sup(), 0);
+		b.set(box[y].sup(), 2);
+		b.set(-box[x].inf(), 4);
+		b.set(-box[y].inf(), 6);
 
-			// consider the other vectors
-			Matrix other_vectors(rangeDim, rangeDim+1);
-			for(int i=0; i<rangeDim; ++i)
+		// consider the other vectors
+		Matrix other_vectors(rangeDim, rangeDim+1);
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if(i != x && i != y)
 			{
-				if(i != x && i != y)
-				{
-					other_vectors.set(1, i, i+1);
-				}
+				other_vectors.set(1, i, i+1);
 			}
+		}
 
-			other_vectors.set(1/sqrt(2), x, x+1);
-			other_vectors.set(1/sqrt(2), x, y+1);
-			other_vectors.set(1/sqrt(2), y, x+1);
-			other_vectors.set(-1/sqrt(2), y, y+1);
-
-			TaylorModelVec tmv_other_vectors(other_vectors);
-
-			for(int i=0; i<rangeDim; ++i)
-			{
-
-				RowVector rowVecTemp(rangeDim);
-
-				for(int j=0; j<rangeDim; ++j)
-				{
-					rowVecTemp.set(other_vectors.get(i,j+1), j);
-				}
-
-				Interval intTemp = rho(*tmvIter, rowVecTemp, *doIter);
-				new_domain[i+1].setSup(intTemp);
+		other_vectors.set(1/sqrt(2), x, x+1);
+		other_vectors.set(1/sqrt(2), x, y+1);
+		other_vectors.set(1/sqrt(2), y, x+1);
+		other_vectors.set(-1/sqrt(2), y, y+1);
 
-				rowVecTemp.neg_assign();
+		TaylorModelVec tmv_other_vectors(other_vectors);
 
-				intTemp = rho(*tmvIter, rowVecTemp, *doIter);
-				intTemp.inv_assign();
-				new_domain[i+1].setInf(intTemp);
-			}
+		for(int i=0; i<rangeDim; ++i)
+		{
 
-			type = contract_interval_arithmetic(tmv_other_vectors, new_domain, system.invariants[*modeIter], bVecTemp);
+			RowVector rowVecTemp(rangeDim);
 
-			if(type < 0)
+			for(int j=0; j<rangeDim; ++j)
 			{
-				continue;
+				rowVecTemp.set(other_vectors.get(i,j+1), j);
 			}
 
+			Interval intTemp = rho(*tmvIter, rowVecTemp, *doIter);
+			new_domain[i+1].setSup(intTemp);
 
-			RowVector template_vector_1(rangeDim);
-			template_vector_1.set(1/sqrt(2), x);
-			template_vector_1.set(1/sqrt(2), y);
+			rowVecTemp.neg_assign();
 
-			double sp = (rho(tmv_other_vectors, template_vector_1, new_domain)).sup();
-			double sp2 = (1/sqrt(2))*b.get(0) + (1/sqrt(2))*b.get(2);
-			b.set(sp, 1);
-
-
-			RowVector template_vector_3(rangeDim);
-			template_vector_3.set(-1/sqrt(2), x);
-			template_vector_3.set(1/sqrt(2), y);
+			intTemp = rho(*tmvIter, rowVecTemp, *doIter);
+			intTemp.inv_assign();
+			new_domain[i+1].setInf(intTemp);
+		}
 
-			sp = (rho(tmv_other_vectors, template_vector_3, new_domain)).sup();
-			b.set(sp, 3);
+		type = contract_interval_arithmetic(tmv_other_vectors, new_domain, system.invariants[mode], bVecTemp);
 
+		if(type < 0)
+		{
+			continue;
+		}
 
-			RowVector template_vector_5(rangeDim);
-			template_vector_5.set(-1/sqrt(2), x);
-			template_vector_5.set(-1/sqrt(2), y);
 
-			sp = (rho(tmv_other_vectors, template_vector_5, new_domain)).sup();
-			b.set(sp, 5);
+		RowVector template_vector_1(rangeDim);
+		template_vector_1.set(1/sqrt(2), x);
+		template_vector_1.set(1/sqrt(2), y);
 
+		double sp = (rho(tmv_other_vectors, template_vector_1, new_domain)).sup();
+		double sp2 = (1/sqrt(2))*b.get(0) + (1/sqrt(2))*b.get(2);
+		b.set(sp, 1);
 
-			RowVector template_vector_7(rangeDim);
-			template_vector_7.set(1/sqrt(2), x);
-			template_vector_7.set(-1/sqrt(2), y);
 
-			sp = (rho(tmv_other_vectors, template_vector_7, new_domain)).sup();
-			b.set(sp, 7);
+		RowVector template_vector_3(rangeDim);
+		template_vector_3.set(-1/sqrt(2), x);
+		template_vector_3.set(1/sqrt(2), y);
 
-			Polyhedron polyTemplate(sortedTemplate, b);
-			polyTemplate.tightenConstraints();
+		sp = (rho(tmv_other_vectors, template_vector_3, new_domain)).sup();
+		b.set(sp, 3);
 
-			double f1, f2;
 
-			list<LinearConstraint>::iterator iterp, iterq;
-			iterp = iterq = polyTemplate.constraints.begin();
-			++iterq;
+		RowVector template_vector_5(rangeDim);
+		template_vector_5.set(-1/sqrt(2), x);
+		template_vector_5.set(-1/sqrt(2), y);
 
-			for(; iterq != polyTemplate.constraints.end(); ++iterp, ++iterq)
-			{
-				gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
-				gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
-				gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
-				gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
+		sp = (rho(tmv_other_vectors, template_vector_5, new_domain)).sup();
+		b.set(sp, 5);
 
-				gsl_vector_set(d, 0, iterp->B.midpoint());
-				gsl_vector_set(d, 1, iterq->B.midpoint());
 
-				gsl_linalg_HH_solve(C, d, vertex);
+		RowVector template_vector_7(rangeDim);
+		template_vector_7.set(1/sqrt(2), x);
+		template_vector_7.set(-1/sqrt(2), y);
 
-				double v1 = gsl_vector_get(vertex, 0);
-				double v2 = gsl_vector_get(vertex, 1);
+		sp = (rho(tmv_other_vectors, template_vector_7, new_domain)).sup();
+		b.set(sp, 7);
 
-				if(iterp == polyTemplate.constraints.begin())
-				{
-					f1 = v1;
-					f2 = v2;
-				}
+		Polyhedron polyTemplate(sortedTemplate, b);
+		polyTemplate.tightenConstraints();
 
-				fprintf(fp, "%lf %lf\n", v1, v2);
-			}
+		double f1, f2;
 
-			iterp = polyTemplate.constraints.begin();
-			--iterq;
+		list<LinearConstraint>::iterator iterp, iterq;
+		iterp = iterq = polyTemplate.constraints.begin();
+		++iterq;
 
+		for(; iterq != polyTemplate.constraints.end(); ++iterp, ++iterq)
+		{
 			gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
 			gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
 			gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
@@ -3441,172 +5013,160 @@ void HybridReachability::plot_2D_octagon_GNUPLOT(FILE *fp) const
 			double v1 = gsl_vector_get(vertex, 0);
 			double v2 = gsl_vector_get(vertex, 1);
 
-			fprintf(fp, "%lf %lf\n", v1, v2);
+			if(iterp == polyTemplate.constraints.begin())
+			{
+				f1 = v1;
+				f2 = v2;
+			}
 
-			fprintf(fp, "%lf %lf\n", f1, f2);
-			fprintf(fp, "\n\n");
+			fprintf(fp, "%lf %lf\n", v1, v2);
 		}
-	}
 
-	fprintf(fp, "e\n");
-}
+		iterp = polyTemplate.constraints.begin();
+		--iterq;
 
-void HybridReachability::plot_2D_grid_GNUPLOT(FILE *fp) const
-{
-	fprintf(fp, "set terminal postscript\n");
+		gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
+		gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
+		gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
+		gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
 
-	char filename[NAME_SIZE+10];
-	sprintf(filename, "%s%s.eps", imageDir, outputFileName);
-	fprintf(fp, "set output '%s'\n", filename);
+		gsl_vector_set(d, 0, iterp->B.midpoint());
+		gsl_vector_set(d, 1, iterq->B.midpoint());
 
-	fprintf(fp, "set style line 1 linecolor rgb \"blue\"\n");
-	fprintf(fp, "set autoscale\n");
-	fprintf(fp, "unset label\n");
-	fprintf(fp, "set xtic auto\n");
-	fprintf(fp, "set ytic auto\n");
-	fprintf(fp, "set xlabel \"%s\"\n", stateVarNames[outputAxes[0]].c_str());
-	fprintf(fp, "set ylabel \"%s\"\n", stateVarNames[outputAxes[1]].c_str());
-	fprintf(fp, "plot '-' notitle with lines ls 1\n");
+		gsl_linalg_HH_solve(C, d, vertex);
 
-	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
-	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
-	list<int>::const_iterator modeIter = modeIDs.begin();
+		double v1 = gsl_vector_get(vertex, 0);
+		double v2 = gsl_vector_get(vertex, 1);
+
+		fprintf(fp, "%lf %lf\n", v1, v2);
+
+		fprintf(fp, "%lf %lf\n", f1, f2);
+		fprintf(fp, "\n\n");
+	}
+
+	gsl_matrix_free(C);
+	gsl_vector_free(d);
+	gsl_vector_free(vertex);
+}
 
-	list<TaylorModelVec>::const_iterator tmvIter;
-	list<vector<Interval> >::const_iterator doIter;
+void HybridReachability::plot_2D_grid_GNUPLOT(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
+{
+	list<TaylorModelVec>::const_iterator tmvIter = flowpipes.begin();
+	list<vector<Interval> >::const_iterator doIter = fpDomains.begin();
 
 	vector<Interval> step_exp_table;
 	Interval I(1);
 	step_exp_table.push_back(I);
 
-	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
+	for(; tmvIter != flowpipes.end(); ++tmvIter, ++doIter)
 	{
-		tmvIter = fpIter->begin();
-		doIter = fpdoIter->begin();
-		int domainDim = doIter->size();
+		// decompose the domain
+		list<vector<Interval> > grids;
 
-		for(; tmvIter != fpIter->end(); ++tmvIter, ++doIter)
-		{
-			// decompose the domain
-			list<vector<Interval> > grids;
+		gridBox(grids, *doIter, numSections);
 
-			gridBox(grids, *doIter, numSections);
+		// Transform the Taylor model into a Horner form
+		vector<HornerForm> tmvHF;
+		vector<Interval> remainders;
+		int rangeDim = tmvIter->tms.size();
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			HornerForm hfTemp;
+			Interval intTemp;
+			tmvIter->tms[i].toHornerForm(hfTemp, intTemp);
+			tmvHF.push_back(hfTemp);
+			remainders.push_back(intTemp);
+		}
 
-			// Transform the Taylor model into a Horner form
-			vector<HornerForm> tmvHF;
-			vector<Interval> remainders;
-			int rangeDim = tmvIter->tms.size();
+		// evaluate the images from all of the grids
+		list<vector<Interval> >::const_iterator gIter = grids.begin();
+		for(; gIter!=grids.end(); ++gIter)
+		{
+			vector<Interval> box;
 
 			for(int i=0; i<rangeDim; ++i)
 			{
-				HornerForm hfTemp;
 				Interval intTemp;
-				tmvIter->tms[i].toHornerForm(hfTemp, intTemp);
-				tmvHF.push_back(hfTemp);
-				remainders.push_back(intTemp);
+				tmvHF[i].intEval(intTemp, *gIter);
+				intTemp += remainders[i];
+				box.push_back(intTemp);
 			}
 
-			// evaluate the images from all of the grids
-			list<vector<Interval> >::const_iterator gIter = grids.begin();
-			for(; gIter!=grids.end(); ++gIter)
-			{
-				vector<Interval> box;
-
-				for(int i=0; i<rangeDim; ++i)
-				{
-					Interval intTemp;
-					tmvHF[i].intEval(intTemp, *gIter);
-					intTemp += remainders[i];
-					box.push_back(intTemp);
-				}
-
-				// contract the interval according to the invariant
-				vector<Interval> new_domain;
-				vector<bool> bVecTemp;
-				TaylorModelVec tmvInterval(box, new_domain);
-				int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[*modeIter], bVecTemp);
+			// contract the interval according to the invariant
+			vector<Interval> new_domain;
+			vector<bool> bVecTemp;
+			TaylorModelVec tmvInterval(box, new_domain);
+			int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[mode], bVecTemp);
 
-				if(type < 0)
-				{
-					continue;
-				}
+			if(type < 0)
+			{
+				continue;
+			}
 
-				tmvInterval.intEval(box, new_domain);
+			tmvInterval.intEval(box, new_domain);
 
-				Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
+			Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
 
-				// output the vertices
-				fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
-				fprintf(fp, "%lf %lf\n", X.sup(), Y.inf());
-				fprintf(fp, "%lf %lf\n", X.sup(), Y.sup());
-				fprintf(fp, "%lf %lf\n", X.inf(), Y.sup());
-				fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
-				fprintf(fp, "\n\n");
-			}
+			// output the vertices
+			fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
+			fprintf(fp, "%lf %lf\n", X.sup(), Y.inf());
+			fprintf(fp, "%lf %lf\n", X.sup(), Y.sup());
+			fprintf(fp, "%lf %lf\n", X.inf(), Y.sup());
+			fprintf(fp, "%lf %lf\n", X.inf(), Y.inf());
+			fprintf(fp, "\n\n");
 		}
 	}
-
-	fprintf(fp, "e\n");
 }
 
-void HybridReachability::plot_2D_MATLAB(FILE *fp) const
+void HybridReachability::plot_2D_MATLAB(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
 {
 	switch(plotSetting)
 	{
 	case PLOT_INTERVAL:
-		plot_2D_interval_MATLAB(fp);
+		plot_2D_interval_MATLAB(fp, flowpipes, fpDomains, mode);
 		break;
 	case PLOT_OCTAGON:
-		plot_2D_octagon_MATLAB(fp);
+		plot_2D_octagon_MATLAB(fp, flowpipes, fpDomains, mode);
 		break;
 	case PLOT_GRID:
-		plot_2D_grid_MATLAB(fp);
+		plot_2D_grid_MATLAB(fp, flowpipes, fpDomains, mode);
 		break;
 	}
 }
 
-void HybridReachability::plot_2D_interval_MATLAB(FILE *fp) const
+void HybridReachability::plot_2D_interval_MATLAB(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
 {
-	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
-	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
-	list<int>::const_iterator modeIter = modeIDs.begin();
+	list<TaylorModelVec>::const_iterator tmvIter = flowpipes.begin();
+	list<vector<Interval> >::const_iterator doIter = fpDomains.begin();
 
-	list<TaylorModelVec>::const_iterator tmvIter;
-	list<vector<Interval> >::const_iterator doIter;
-
-	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
+	for(; tmvIter != flowpipes.end(); ++tmvIter, ++doIter)
 	{
-		tmvIter = fpIter->begin();
-		doIter = fpdoIter->begin();
+		vector<Interval> box;
+		tmvIter->intEval(box, *doIter);
 
-		for(; tmvIter != fpIter->end(); ++tmvIter, ++doIter)
-		{
-			vector<Interval> box;
-			tmvIter->intEval(box, *doIter);
-
-			// contract the interval according to the invariant
-			vector<Interval> new_domain;
-			vector<bool> bVecTemp;
-			TaylorModelVec tmvInterval(box, new_domain);
-			int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[*modeIter], bVecTemp);
+		// contract the interval according to the invariant
+		vector<Interval> new_domain;
+		vector<bool> bVecTemp;
+		TaylorModelVec tmvInterval(box, new_domain);
+		int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[mode], bVecTemp);
 
-			if(type < 0)
-			{
-				continue;
-			}
+		if(type < 0)
+		{
+			continue;
+		}
 
-			tmvInterval.intEval(box, new_domain);
+		tmvInterval.intEval(box, new_domain);
 
-			Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
+		Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
 
-			// output the vertices
-			fprintf(fp,"plot( [%lf,%lf,%lf,%lf,%lf] , [%lf,%lf,%lf,%lf,%lf] , 'b');\nhold on;\nclear;\n",
-					X.inf(), X.sup(), X.sup(), X.inf(), X.inf(), Y.inf(), Y.inf(), Y.sup(), Y.sup(), Y.inf());
-		}
+		// output the vertices
+		fprintf(fp,"plot( [%lf,%lf,%lf,%lf,%lf] , [%lf,%lf,%lf,%lf,%lf] , 'b');\nhold on;\nclear;\n",
+				X.inf(), X.sup(), X.sup(), X.inf(), X.inf(), Y.inf(), Y.inf(), Y.sup(), Y.sup(), Y.inf());
 	}
 }
 
-void HybridReachability::plot_2D_octagon_MATLAB(FILE *fp) const
+void HybridReachability::plot_2D_octagon_MATLAB(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
 {
 	int x = outputAxes[0];
 	int y = outputAxes[1];
@@ -3699,159 +5259,123 @@ void HybridReachability::plot_2D_octagon_MATLAB(FILE *fp) const
 	gsl_vector *d = gsl_vector_alloc(2);
 	gsl_vector *vertex = gsl_vector_alloc(2);
 
-	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
-	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
-	list<int>::const_iterator modeIter = modeIDs.begin();
-
-	list<TaylorModelVec>::const_iterator tmvIter;
-	list<vector<Interval> >::const_iterator doIter;
+	list<TaylorModelVec>::const_iterator tmvIter = flowpipes.begin();
+	list<vector<Interval> >::const_iterator doIter = fpDomains.begin();
 
-	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
+	for(; tmvIter != flowpipes.end(); ++tmvIter, ++doIter)
 	{
-		tmvIter = fpIter->begin();
-		doIter = fpdoIter->begin();
-
-		for(; tmvIter != fpIter->end(); ++tmvIter, ++doIter)
-		{
-			int rangeDim = tmvIter->tms.size();
-			vector<Interval> box;
-			tmvIter->intEval(box, *doIter);
+		int rangeDim = tmvIter->tms.size();
+		vector<Interval> box;
+		tmvIter->intEval(box, *doIter);
 
-			vector<Interval> new_domain;
-			vector<bool> bVecTemp;
-			TaylorModelVec tmvInterval(box, new_domain);
-			int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[*modeIter], bVecTemp);
+		vector<Interval> new_domain;
+		vector<bool> bVecTemp;
+		TaylorModelVec tmvInterval(box, new_domain);
+		int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[mode], bVecTemp);
 
-			if(type < 0)
-			{
-				continue;
-			}
+		if(type < 0)
+		{
+			continue;
+		}
 
-			tmvInterval.intEval(box, new_domain);
+		tmvInterval.intEval(box, new_domain);
 
-			// the box template
-			b.set(box[x].sup(), 0);
-			b.set(box[y].sup(), 2);
-			b.set(-box[x].inf(), 4);
-			b.set(-box[y].inf(), 6);
+		// the box template
+		b.set(box[x].sup(), 0);
+		b.set(box[y].sup(), 2);
+		b.set(-box[x].inf(), 4);
+		b.set(-box[y].inf(), 6);
 
-			// consider the other vectors
-			Matrix other_vectors(rangeDim, rangeDim+1);
-			for(int i=0; i<rangeDim; ++i)
+		// consider the other vectors
+		Matrix other_vectors(rangeDim, rangeDim+1);
+		for(int i=0; i<rangeDim; ++i)
+		{
+			if(i != x && i != y)
 			{
-				if(i != x && i != y)
-				{
-					other_vectors.set(1, i, i+1);
-				}
+				other_vectors.set(1, i, i+1);
 			}
+		}
 
-			other_vectors.set(1/sqrt(2), x, x+1);
-			other_vectors.set(1/sqrt(2), x, y+1);
-			other_vectors.set(1/sqrt(2), y, x+1);
-			other_vectors.set(-1/sqrt(2), y, y+1);
-
-			TaylorModelVec tmv_other_vectors(other_vectors);
-
-			for(int i=0; i<rangeDim; ++i)
-			{
-
-				RowVector rowVecTemp(rangeDim);
-
-				for(int j=0; j<rangeDim; ++j)
-				{
-					rowVecTemp.set(other_vectors.get(i,j+1), j);
-				}
-
-				Interval intTemp = rho(*tmvIter, rowVecTemp, *doIter);
-				new_domain[i+1].setSup(intTemp);
+		other_vectors.set(1/sqrt(2), x, x+1);
+		other_vectors.set(1/sqrt(2), x, y+1);
+		other_vectors.set(1/sqrt(2), y, x+1);
+		other_vectors.set(-1/sqrt(2), y, y+1);
 
-				rowVecTemp.neg_assign();
+		TaylorModelVec tmv_other_vectors(other_vectors);
 
-				intTemp = rho(*tmvIter, rowVecTemp, *doIter);
-				intTemp.inv_assign();
-				new_domain[i+1].setInf(intTemp);
-			}
+		for(int i=0; i<rangeDim; ++i)
+		{
 
-			type = contract_interval_arithmetic(tmv_other_vectors, new_domain, system.invariants[*modeIter], bVecTemp);
+			RowVector rowVecTemp(rangeDim);
 
-			if(type < 0)
+			for(int j=0; j<rangeDim; ++j)
 			{
-				continue;
+				rowVecTemp.set(other_vectors.get(i,j+1), j);
 			}
 
+			Interval intTemp = rho(*tmvIter, rowVecTemp, *doIter);
+			new_domain[i+1].setSup(intTemp);
 
-			RowVector template_vector_1(rangeDim);
-			template_vector_1.set(1/sqrt(2), x);
-			template_vector_1.set(1/sqrt(2), y);
+			rowVecTemp.neg_assign();
 
-			double sp = (rho(tmv_other_vectors, template_vector_1, new_domain)).sup();
-			double sp2 = (1/sqrt(2))*b.get(0) + (1/sqrt(2))*b.get(2);
-			b.set(sp, 1);
-
-
-			RowVector template_vector_3(rangeDim);
-			template_vector_3.set(-1/sqrt(2), x);
-			template_vector_3.set(1/sqrt(2), y);
+			intTemp = rho(*tmvIter, rowVecTemp, *doIter);
+			intTemp.inv_assign();
+			new_domain[i+1].setInf(intTemp);
+		}
 
-			sp = (rho(tmv_other_vectors, template_vector_3, new_domain)).sup();
-			b.set(sp, 3);
+		type = contract_interval_arithmetic(tmv_other_vectors, new_domain, system.invariants[mode], bVecTemp);
 
+		if(type < 0)
+		{
+			continue;
+		}
 
-			RowVector template_vector_5(rangeDim);
-			template_vector_5.set(-1/sqrt(2), x);
-			template_vector_5.set(-1/sqrt(2), y);
 
-			sp = (rho(tmv_other_vectors, template_vector_5, new_domain)).sup();
-			b.set(sp, 5);
+		RowVector template_vector_1(rangeDim);
+		template_vector_1.set(1/sqrt(2), x);
+		template_vector_1.set(1/sqrt(2), y);
 
+		double sp = (rho(tmv_other_vectors, template_vector_1, new_domain)).sup();
+		double sp2 = (1/sqrt(2))*b.get(0) + (1/sqrt(2))*b.get(2);
+		b.set(sp, 1);
 
-			RowVector template_vector_7(rangeDim);
-			template_vector_7.set(1/sqrt(2), x);
-			template_vector_7.set(-1/sqrt(2), y);
 
-			sp = (rho(tmv_other_vectors, template_vector_7, new_domain)).sup();
-			b.set(sp, 7);
+		RowVector template_vector_3(rangeDim);
+		template_vector_3.set(-1/sqrt(2), x);
+		template_vector_3.set(1/sqrt(2), y);
 
-			Polyhedron polyTemplate(sortedTemplate, b);
-			polyTemplate.tightenConstraints();
+		sp = (rho(tmv_other_vectors, template_vector_3, new_domain)).sup();
+		b.set(sp, 3);
 
-			double f1, f2;
 
-			list<LinearConstraint>::iterator iterp, iterq;
-			iterp = iterq = polyTemplate.constraints.begin();
-			++iterq;
+		RowVector template_vector_5(rangeDim);
+		template_vector_5.set(-1/sqrt(2), x);
+		template_vector_5.set(-1/sqrt(2), y);
 
-			vector<double> vertices_x, vertices_y;
+		sp = (rho(tmv_other_vectors, template_vector_5, new_domain)).sup();
+		b.set(sp, 5);
 
-			for(; iterq != polyTemplate.constraints.end(); ++iterp, ++iterq)
-			{
-				gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
-				gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
-				gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
-				gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
 
-				gsl_vector_set(d, 0, iterp->B.midpoint());
-				gsl_vector_set(d, 1, iterq->B.midpoint());
+		RowVector template_vector_7(rangeDim);
+		template_vector_7.set(1/sqrt(2), x);
+		template_vector_7.set(-1/sqrt(2), y);
 
-				gsl_linalg_HH_solve(C, d, vertex);
+		sp = (rho(tmv_other_vectors, template_vector_7, new_domain)).sup();
+		b.set(sp, 7);
 
-				double v1 = gsl_vector_get(vertex, 0);
-				double v2 = gsl_vector_get(vertex, 1);
+		Polyhedron polyTemplate(sortedTemplate, b);
+		polyTemplate.tightenConstraints();
 
-				if(iterp == polyTemplate.constraints.begin())
-				{
-					f1 = v1;
-					f2 = v2;
-				}
+		double f1, f2;
 
-				vertices_x.push_back(v1);
-				vertices_y.push_back(v2);
-//				fprintf(fp, "%lf %lf\n", v1, v2);
-			}
+		list<LinearConstraint>::iterator iterp, iterq;
+		iterp = iterq = polyTemplate.constraints.begin();
+		++iterq;
 
-			iterp = polyTemplate.constraints.begin();
-			--iterq;
+		vector<double> vertices_x, vertices_y;
 
+		for(; iterq != polyTemplate.constraints.end(); ++iterp, ++iterq)
+		{
 			gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
 			gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
 			gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
@@ -3865,109 +5389,128 @@ void HybridReachability::plot_2D_octagon_MATLAB(FILE *fp) const
 			double v1 = gsl_vector_get(vertex, 0);
 			double v2 = gsl_vector_get(vertex, 1);
 
+			if(iterp == polyTemplate.constraints.begin())
+			{
+				f1 = v1;
+				f2 = v2;
+			}
+
 			vertices_x.push_back(v1);
 			vertices_y.push_back(v2);
-			vertices_x.push_back(f1);
-			vertices_y.push_back(f2);
+//				fprintf(fp, "%lf %lf\n", v1, v2);
+		}
 
-			fprintf(fp, "plot( ");
+		iterp = polyTemplate.constraints.begin();
+		--iterq;
 
-			fprintf(fp, "[ ");
-			for(int i=0; i<vertices_x.size()-1; ++i)
-			{
-				fprintf(fp, "%lf , ", vertices_x[i]);
-			}
-			fprintf(fp, "%lf ] , ", vertices_x.back());
+		gsl_matrix_set(C, 0, 0, iterp->A[x].midpoint());
+		gsl_matrix_set(C, 0, 1, iterp->A[y].midpoint());
+		gsl_matrix_set(C, 1, 0, iterq->A[x].midpoint());
+		gsl_matrix_set(C, 1, 1, iterq->A[y].midpoint());
 
-			fprintf(fp, "[ ");
-			for(int i=0; i<vertices_y.size()-1; ++i)
-			{
-				fprintf(fp, "%lf , ", vertices_y[i]);
-			}
-			fprintf(fp, "%lf ] , ", vertices_y.back());
+		gsl_vector_set(d, 0, iterp->B.midpoint());
+		gsl_vector_set(d, 1, iterq->B.midpoint());
+
+		gsl_linalg_HH_solve(C, d, vertex);
+
+		double v1 = gsl_vector_get(vertex, 0);
+		double v2 = gsl_vector_get(vertex, 1);
 
-			fprintf(fp, "'b');\nhold on;\nclear;\n");
+		vertices_x.push_back(v1);
+		vertices_y.push_back(v2);
+		vertices_x.push_back(f1);
+		vertices_y.push_back(f2);
+
+		fprintf(fp, "plot( ");
+
+		fprintf(fp, "[ ");
+		for(int i=0; i<vertices_x.size()-1; ++i)
+		{
+			fprintf(fp, "%lf , ", vertices_x[i]);
+		}
+		fprintf(fp, "%lf ] , ", vertices_x.back());
 
-//			fprintf(fp, "%lf %lf\n", v1, v2);
-//			fprintf(fp, "%lf %lf\n", f1, f2);
-//			fprintf(fp, "\n\n");
+		fprintf(fp, "[ ");
+		for(int i=0; i<vertices_y.size()-1; ++i)
+		{
+			fprintf(fp, "%lf , ", vertices_y[i]);
 		}
+		fprintf(fp, "%lf ] , ", vertices_y.back());
+
+		fprintf(fp, "'b');\nhold on;\nclear;\n");
+
+//		fprintf(fp, "%lf %lf\n", v1, v2);
+//		fprintf(fp, "%lf %lf\n", f1, f2);
+//		fprintf(fp, "\n\n");
 	}
+
+	gsl_matrix_free(C);
+	gsl_vector_free(d);
+	gsl_vector_free(vertex);
 }
 
-void HybridReachability::plot_2D_grid_MATLAB(FILE *fp) const
+void HybridReachability::plot_2D_grid_MATLAB(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const
 {
-	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
-	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
-	list<int>::const_iterator modeIter = modeIDs.begin();
-
-	list<TaylorModelVec>::const_iterator tmvIter;
-	list<vector<Interval> >::const_iterator doIter;
+	list<TaylorModelVec>::const_iterator tmvIter = flowpipes.begin();
+	list<vector<Interval> >::const_iterator doIter = fpDomains.begin();
 
 	vector<Interval> step_exp_table;
 	Interval I(1);
 	step_exp_table.push_back(I);
 
-	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter)
+	for(; tmvIter != flowpipes.end(); ++tmvIter, ++doIter)
 	{
-		tmvIter = fpIter->begin();
-		doIter = fpdoIter->begin();
-		int domainDim = doIter->size();
+		// decompose the domain
+		list<vector<Interval> > grids;
 
-		for(; tmvIter != fpIter->end(); ++tmvIter, ++doIter)
-		{
-			// decompose the domain
-			list<vector<Interval> > grids;
+		gridBox(grids, *doIter, numSections);
 
-			gridBox(grids, *doIter, numSections);
+		// Transform the Taylor model into a Horner form
+		vector<HornerForm> tmvHF;
+		vector<Interval> remainders;
+		int rangeDim = tmvIter->tms.size();
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			HornerForm hfTemp;
+			Interval intTemp;
+			tmvIter->tms[i].toHornerForm(hfTemp, intTemp);
+			tmvHF.push_back(hfTemp);
+			remainders.push_back(intTemp);
+		}
 
-			// Transform the Taylor model into a Horner form
-			vector<HornerForm> tmvHF;
-			vector<Interval> remainders;
-			int rangeDim = tmvIter->tms.size();
+		// evaluate the images from all of the grids
+		list<vector<Interval> >::const_iterator gIter = grids.begin();
+		for(; gIter!=grids.end(); ++gIter)
+		{
+			vector<Interval> box;
 
 			for(int i=0; i<rangeDim; ++i)
 			{
-				HornerForm hfTemp;
 				Interval intTemp;
-				tmvIter->tms[i].toHornerForm(hfTemp, intTemp);
-				tmvHF.push_back(hfTemp);
-				remainders.push_back(intTemp);
+				tmvHF[i].intEval(intTemp, *gIter);
+				intTemp += remainders[i];
+				box.push_back(intTemp);
 			}
 
-			// evaluate the images from all of the grids
-			list<vector<Interval> >::const_iterator gIter = grids.begin();
-			for(; gIter!=grids.end(); ++gIter)
-			{
-				vector<Interval> box;
-
-				for(int i=0; i<rangeDim; ++i)
-				{
-					Interval intTemp;
-					tmvHF[i].intEval(intTemp, *gIter);
-					intTemp += remainders[i];
-					box.push_back(intTemp);
-				}
-
-				// contract the interval according to the invariant
-				vector<Interval> new_domain;
-				vector<bool> bVecTemp;
-				TaylorModelVec tmvInterval(box, new_domain);
-				int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[*modeIter], bVecTemp);
+			// contract the interval according to the invariant
+			vector<Interval> new_domain;
+			vector<bool> bVecTemp;
+			TaylorModelVec tmvInterval(box, new_domain);
+			int type = contract_interval_arithmetic(tmvInterval, new_domain, system.invariants[mode], bVecTemp);
 
-				if(type < 0)
-				{
-					continue;
-				}
+			if(type < 0)
+			{
+				continue;
+			}
 
-				tmvInterval.intEval(box, new_domain);
+			tmvInterval.intEval(box, new_domain);
 
-				Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
+			Interval X(box[outputAxes[0]]), Y(box[outputAxes[1]]);
 
-				// output the vertices
-				fprintf(fp,"plot( [%lf,%lf,%lf,%lf,%lf] , [%lf,%lf,%lf,%lf,%lf] , 'b');\nhold on;\nclear;\n",
-						X.inf(), X.sup(), X.sup(), X.inf(), X.inf(), Y.inf(), Y.inf(), Y.sup(), Y.sup(), Y.inf());
-			}
+			// output the vertices
+			fprintf(fp,"plot( [%lf,%lf,%lf,%lf,%lf] , [%lf,%lf,%lf,%lf,%lf] , 'b');\nhold on;\nclear;\n",
+					X.inf(), X.sup(), X.sup(), X.inf(), X.inf(), Y.inf(), Y.inf(), Y.sup(), Y.sup(), Y.inf());
 		}
 	}
 }
@@ -4116,12 +5659,12 @@ bool HybridReachability::declareMode(const string & mName, const TaylorModelVec
 	}
 }
 
-bool HybridReachability::declareMode(const string & mName, const vector<string> & strOde, const vector<Interval> & uncertainties, const vector<PolynomialConstraint> & inv, const int integrationScheme)
+bool HybridReachability::declareMode(const string & mName, const vector<Expression> & exprOde, const vector<Interval> & uncertainties, const vector<PolynomialConstraint> & inv, const int integrationScheme)
 {
 	map<string,int>::const_iterator iter;
 	Interval intZero;
 
-	vector<string> odeEmpty;
+	vector<Expression> odeEmpty;
 
 	if((iter = modeTab.find(mName)) == modeTab.end())
 	{
@@ -4131,15 +5674,15 @@ bool HybridReachability::declareMode(const string & mName, const vector<string>
 
 		system.modes.push_back(modeID);
 
-		if(modeID > system.strOdes.size())
+		if(modeID > system.exprOdes.size())
 		{
-			for(int i=system.strOdes.size(); i<modeID; ++i)
+			for(int i=system.exprOdes.size(); i<modeID; ++i)
 			{
-				system.strOdes.push_back(odeEmpty);
+				system.exprOdes.push_back(odeEmpty);
 			}
 		}
 
-		system.strOdes.push_back(strOde);
+		system.exprOdes.push_back(exprOde);
 		system.invariants.push_back(inv);
 
 		vector<Interval> uncertainties_centered = uncertainties;
@@ -4280,6 +5823,11 @@ void HybridReachability::initialConfig(const int modeID, const Flowpipe & initia
 	system.initialSet = initialSet;
 }
 
+void HybridReachability::initialConfig(const Flowpipe & initialSet)
+{
+	system.initialSet = initialSet;
+}
+
 void HybridReachability::set_default_template()
 {
 	int rangeDim = system.initialSet.tmv.tms.size();
@@ -4604,27 +6152,47 @@ void HybridReachability::constructWeightTab()
 
 int HybridReachability::safetyChecking()
 {
-	int rangeDim = flowpipesCompo.front().front().tms.size();
-	Interval intZero;
+	FILE *fpDumpCounterexamples = open_counterexample_file();
 
-	bool bDumpCounterexamples = true;
+	select_modes_under_check();
 
-	int mkres = mkdir(counterexampleDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
+	// the main procedure of safety checking
+	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
+	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
+	list<int>::const_iterator modeIter = modeIDs.begin();
+	list<TreeNode *>::const_iterator nodeIter = traceNodes.begin();
+
+	int result = SAFE;
+
+	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter, ++nodeIter)
 	{
-		printf("Can not create the directory for counterexamples.\n");
-		bDumpCounterexamples = false;
-	}
+		int type = check_mode(fpDumpCounterexamples, *fpIter, *fpdoIter, *modeIter, *nodeIter);
 
-	char filename_counterexamples[NAME_SIZE+10];
-	FILE *fpDumpCounterexamples;
+		if(type == UNSAFE)
+		{
+			result = UNSAFE;
+			break;
+		}
+		else if(type == UNKNOWN)
+		{
+			result = UNKNOWN;
+		}
+	}
 
-	if(bDumpCounterexamples)
+	if(fpDumpCounterexamples != NULL)
 	{
-		sprintf(filename_counterexamples, "%s%s%s", counterexampleDir, outputFileName, str_counterexample_dumping_name_suffix);
-		fpDumpCounterexamples = fopen(filename_counterexamples, "w");
+		fclose(fpDumpCounterexamples);
 	}
 
+	return result;
+}
+
+// the modes in which the invariant does not intersect the unsafe set are not checked
+void HybridReachability::select_modes_under_check()
+{
+	int rangeDim = stateVarNames.size();
+	Interval intZero;
+
 	// we first check the intersection of the linear invariant constraints and linear unsafe constraints
 	for(int i=0; i<unsafeSet.size(); ++i)
 	{
@@ -4671,131 +6239,154 @@ int HybridReachability::safetyChecking()
 			bVecUnderCheck[i] = false;
 		}
 	}
+}
 
-	// the main procedure of safety checking
-	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
-	list<list<vector<Interval> > >::const_iterator fpdoIter = domains.begin();
-	list<int>::const_iterator modeIter = modeIDs.begin();
-	list<TreeNode *>::const_iterator nodeIter = traceNodes.begin();
+// the potential counterexamples are dumped to fp unless it is NULL
+int HybridReachability::check_mode(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode, TreeNode * const node) const
+{
+	if(!bVecUnderCheck[mode])
+	{
+		return SAFE;
+	}
 
-	vector<Interval> step_exp_table;
+	if(unsafeSet[mode].size() == 0)
+	{
+		return UNSAFE;
+	}
 
-	list<TaylorModelVec>::const_iterator tmvIter;
-	list<vector<Interval> >::const_iterator doIter;
+	list<TaylorModelVec>::const_iterator tmvIter = flowpipes.begin();
+	list<vector<Interval> >::const_iterator doIter = fpDomains.begin();
 
+	vector<Interval> step_exp_table;
 	int maxOrder = 0;
 	int result = SAFE;
 
-	for(; fpIter!=flowpipesCompo.end(); ++fpIter, ++fpdoIter, ++modeIter, ++nodeIter)
+	int domainDim = doIter->size();
+
+	list<TaylorModelVec> flowpipe_counterexamples;
+	list<vector<Interval> > counterexample_domains;
+	list<Interval> localTimes;
+	Interval localTime;
+
+	for(; tmvIter!=flowpipes.end(); ++tmvIter, ++doIter)
 	{
-		if(!bVecUnderCheck[*modeIter])
+
+		int tmp = maxOrder;
+		for(int i=0; i<tmvIter->tms.size(); ++i)
 		{
-			continue;
+			int order = tmvIter->tms[i].expansion.degree();
+			if(maxOrder < order)
+			{
+				maxOrder = order;
+			}
 		}
 
-		tmvIter = fpIter->begin();
-		doIter = fpdoIter->begin();
-
-		if(unsafeSet[*modeIter].size() == 0)
+		if(step_exp_table.size() == 0 || step_exp_table[1] != (*doIter)[0] || maxOrder > tmp)
 		{
-			return UNSAFE;
+			construct_step_exp_table(step_exp_table, (*doIter)[0], 2*maxOrder);
 		}
 
-		int domainDim = doIter->size();
+		bool bsafe = false;
 
-		list<TaylorModelVec> flowpipe_counterexamples;
-		list<vector<Interval> > counterexample_domains;
-		list<Interval> localTimes;
-		Interval localTime;
+		vector<Interval> tmvPolyRange;
+		tmvIter->polyRangeNormal(tmvPolyRange, step_exp_table);
 
-		for(; tmvIter!=fpIter->end(); ++tmvIter, ++doIter)
+		for(int i=0; i<unsafeSet[mode].size(); ++i)
 		{
+			TaylorModel tmTemp;
+
+			// interval evaluation on the constraint
+			unsafeSet[mode][i].hf.insert_normal(tmTemp, *tmvIter, tmvPolyRange, step_exp_table, domainDim);
 
-			int tmp = maxOrder;
-			for(int i=0; i<tmvIter->tms.size(); ++i)
+			Interval intTemp;
+			tmTemp.intEvalNormal(intTemp, step_exp_table);
+
+			if(intTemp > unsafeSet[mode][i].B)
 			{
-				int order = tmvIter->tms[i].expansion.degree();
-				if(maxOrder < order)
-				{
-					maxOrder = order;
-				}
+				// no intersection with the unsafe set
+				bsafe = true;
+				break;
 			}
-
-			if(step_exp_table.size() == 0 || step_exp_table[1] != (*doIter)[0] || maxOrder > tmp)
+			else
 			{
-				construct_step_exp_table(step_exp_table, (*doIter)[0], 2*maxOrder);
+				continue;
 			}
+		}
 
-			bool bsafe = false;
-
-			vector<Interval> tmvPolyRange;
-			tmvIter->polyRangeNormal(tmvPolyRange, step_exp_table);
+		if(!bsafe)
+		{
+			// collect the skeptical counterexamples
 
-			for(int i=0; i<unsafeSet[*modeIter].size(); ++i)
+			if(fp != NULL)
 			{
-				TaylorModel tmTemp;
-
-				// interval evaluation on the constraint
-				unsafeSet[*modeIter][i].hf.insert_normal(tmTemp, *tmvIter, tmvPolyRange, step_exp_table, domainDim);
-
-				Interval intTemp;
-				tmTemp.intEvalNormal(intTemp, step_exp_table);
-
-				if(intTemp > unsafeSet[*modeIter][i].B)
-				{
-					// no intersection with the unsafe set
-					bsafe = true;
-					break;
-				}
-				else
-				{
-					continue;
-				}
+				flowpipe_counterexamples.push_back(*tmvIter);
+				counterexample_domains.push_back(*doIter);
+				localTimes.push_back(localTime);
 			}
 
-			if(!bsafe)
-			{
-				// collect the skeptical counterexamples
+			result = UNKNOWN;
+		}
 
-				if(bDumpCounterexamples)
-				{
-					flowpipe_counterexamples.push_back(*tmvIter);
-					counterexample_domains.push_back(*doIter);
-					localTimes.push_back(localTime);
-				}
+		localTime += (*doIter)[0];
+	}
 
-				result = UNKNOWN;
-			}
+	if(fp != NULL && flowpipe_counterexamples.size() > 0)
+	{
+		// dump the skeptical counterexamples
+		dump_potential_counterexample(fp, flowpipe_counterexamples, counterexample_domains, node, localTimes);
+	}
 
-			localTime += (*doIter)[0];
-		}
+	return result;
+}
 
-		if(bDumpCounterexamples && flowpipe_counterexamples.size() > 0)
-		{
-			// dump the skeptical counterexamples
-			dump_potential_counterexample(fpDumpCounterexamples, flowpipe_counterexamples, counterexample_domains, *nodeIter, localTimes);
-		}
+FILE *HybridReachability::open_counterexample_file() const
+{
+	int mkres = mkdir(counterexampleDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+	if(mkres < 0 && errno != EEXIST)
+	{
+		printf("Can not create the directory for counterexamples.\n");
+		return NULL;
 	}
 
-	if(bDumpCounterexamples)
+	char filename_counterexamples[NAME_SIZE+40];
+	sprintf(filename_counterexamples, "%s%s%s", counterexampleDir, outputFileName, str_counterexample_dumping_name_suffix);
+	FILE *fpDumpCounterexamples = fopen(filename_counterexamples, "w");
+
+	if(fpDumpCounterexamples == NULL)
 	{
-		fclose(fpDumpCounterexamples);
+		printf("Can not create the file for counterexamples.\n");
 	}
 
-	return result;
+	return fpDumpCounterexamples;
 }
 
 unsigned long HybridReachability::numOfFlowpipes() const
 {
-	list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
 	unsigned long sum = 0;
 
-	for(; fpIter!=flowpipesCompo.end(); ++fpIter)
+	if(bStreaming)
+	{
+		sum = numOfStreamedFlowpipes;
+	}
+	else
 	{
-		sum += (unsigned long)(fpIter->size());
+		list<list<TaylorModelVec> >::const_iterator fpIter = flowpipesCompo.begin();
+		for(; fpIter!=flowpipesCompo.end(); ++fpIter)
+		{
+			sum += (unsigned long)(fpIter->size());
+		}
 	}
 
-	return (sum-1);
+	unsigned long numOfInitialSets = numSplits > 1 ? numSplits : 1;
+	return (sum-numOfInitialSets);
+}
+
+unsigned long HybridReachability::numOfJumpsExecuted() const
+{
+	// every mode visit except the ones of the initial sets is entered by a jump
+	unsigned long numOfInitialSets = numSplits > 1 ? numSplits : 1;
+	unsigned long numOfModes = bStreaming ? numOfStreamedModes : modeIDs.size();
+	return numOfModes > numOfInitialSets ? numOfModes - numOfInitialSets : 0;
 }
 
 void HybridReachability::dump_potential_counterexample(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, TreeNode * const node, const list<Interval> & localTimes) const
@@ -5004,6 +6595,8 @@ void generateNodeSeq(list<TreeNode *> & result, TreeNode *root)
 
 void aggregate_flowpipes_by_interval(TaylorModelVec & tmvAggregation, vector<Interval> & doAggregation, const vector<TaylorModelVec> & flowpipes, const vector<vector<Interval> > & domains)
 {
+	ProfileScope scope(PHASE_AGGREGATION);
+
 	vector<Interval> intVecAggregation;
 
 	flowpipes[0].intEval(intVecAggregation, domains[0]);
@@ -5171,6 +6764,8 @@ void aggregate_flowpipes_by_Parallelotope(TaylorModelVec & tmvAggregation, vecto
 		const vector<RowVector> & template_candidates, const vector<RowVector> & template_default, const vector<vector<Matrix> > & weightTab,
 		const vector<vector<vector<bool> > > & linear_auto, const vector<vector<vector<RowVector> > > & template_auto, const int globalMaxOrder, const int rangeDim)
 {
+	ProfileScope scope(PHASE_AGGREGATION);
+
 	int num_invariants = invariant.size();
 	int num_candidates = template_candidates.size();
 
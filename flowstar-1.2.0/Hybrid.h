@@ -12,9 +12,6 @@
 
 #include "Continuous.h"
 
-extern ParseSetting parseSetting;
-extern ParseResult parseResult;
-
 class ResetMap
 {
 public:
@@ -65,23 +62,117 @@ public:
 	TreeNode & operator = (const TreeNode & node);
 };
 
+class ModeFlowpipeConsumer		// receives the flowpipes of a mode visit once its jumps are computed
+{
+public:
+	virtual ~ModeFlowpipeConsumer() {}
+	virtual void receive(const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, const int mode, TreeNode *node) = 0;
+};
+
+// the Taylor expansion of a component of a mode's ODE in a fixed order
+class ModeExpansion
+{
+public:
+	HornerForm hf;
+	Polynomial mf;
+	Polynomial highest;		// the highest-order term, as computed by computeTaylorExpansion
+public:
+	ModeExpansion();
+	ModeExpansion(const ModeExpansion & expansion);
+	~ModeExpansion();
+
+	ModeExpansion & operator = (const ModeExpansion & expansion);
+};
+
+/*
+ * The Taylor expansions of the mode ODEs. They are computed lazily on the first visit of a mode and shared by all
+ * of the later visits, by the worker threads and by the copies of the hybrid system. An entry is never changed
+ * after it is inserted, so it can be read without holding the lock.
+ */
+class ExpansionCache
+{
+private:
+	map<vector<int>, ModeExpansion> entries;	// the key is (mode, component, order)
+	int numRefs;
+	pthread_mutex_t mutex;
+
+	const ModeExpansion *find(const int mode, const int component, const int order);
+	const ModeExpansion *insert(const int mode, const int component, const int order, const ModeExpansion & expansion);
+	const ModeExpansion *lookup(const int mode, const int component, const vector<Polynomial> & ode, const int order);
+public:
+	ExpansionCache();
+	~ExpansionCache();
+
+	void retain();
+	void release();		// the cache is deleted when the last holder releases it
+
+	void expansion(vector<HornerForm> & resultHF, const int mode, const vector<Polynomial> & ode, const int order);
+	void expansion(vector<HornerForm> & resultHF, const int mode, const vector<Polynomial> & ode, const vector<int> & orders);
+	void expansion(HornerForm & resultHF, const int mode, const int component, const vector<Polynomial> & ode, const int order);
+};
+
+// an enclosure {x : A*x in bounds} of an initial set, A is the identity for an interval enclosure
+class InitialSetEnclosure
+{
+public:
+	Matrix directions;			// the matrix A
+	Matrix generators;			// an approximation of the inverse of A
+	vector<Interval> bounds;
+	vector<Interval> box;		// an interval enclosure, also used as a quick check
+	bool bInterval;				// true if A is the identity
+	double timePassed;
+	int jumpsExecuted;
+public:
+	InitialSetEnclosure();
+	InitialSetEnclosure(const TaylorModelVec & tmv, const vector<Interval> & domain, const bool bParallelotope, const double widening,
+			const double time, const int jumps);
+	InitialSetEnclosure(const InitialSetEnclosure & enclosure);
+	~InitialSetEnclosure();
+
+	bool contains(const TaylorModelVec & tmv, const vector<Interval> & domain, const vector<Interval> & range) const;	// range is an interval enclosure of tmv
+	void toTaylorModel(TaylorModelVec & result) const;		// the domain is normalized to [-1,1]^n
+
+	InitialSetEnclosure & operator = (const InitialSetEnclosure & enclosure);
+};
+
+/*
+ * The enclosures of the initial sets which have been explored in each mode. A jump successor which is contained in
+ * one of them, and is reached no earlier and after no fewer jumps, can not lead to a new state and is dropped. An
+ * admitted successor is replaced by its enclosure, so that the stored sets are exactly the explored ones.
+ */
+class InitialSetStore
+{
+private:
+	vector<list<InitialSetEnclosure> > enclosures;
+	double widening;			// the relative amount by which an admitted enclosure is enlarged
+	pthread_mutex_t mutex;
+public:
+	InitialSetStore(const int numModes, const double widening_input);
+	~InitialSetStore();
+
+	// returns false if the set tmv over domain is subsumed, otherwise it is replaced by its stored enclosure
+	bool admit(TaylorModelVec & tmv, vector<Interval> & domain, const int mode, const bool bParallelotope, const double timePassed, const int jumpsExecuted);
+};
+
 class HybridSystem
 {
 private:
 	vector<int> modes;
 	vector<TaylorModelVec> odes;
 	vector<vector<HornerForm> > hfOdes;
-	vector<vector<string> > strOdes;
+	vector<vector<Expression> > exprOdes;
 	vector<vector<Interval> > uncertainties;
 	vector<vector<Interval> > uncertainty_centers;
 	vector<vector<PolynomialConstraint> > invariants;
 	vector<vector<DiscTrans> > transitions;
 	int initialMode;
 	Flowpipe initialSet;
+	ExpansionCache *expansionCache;		// shared by the copies which have the same ODEs
+	ModeFlowpipeConsumer *consumer;		// the flowpipes of the mode visits are handed to it and not kept in the results, may be NULL
 public:
 	HybridSystem();
 	HybridSystem(const vector<int> & modes_input, const vector<TaylorModelVec> & odes_input, const vector<vector<HornerForm> > & hfOdes_input,
-			const vector<vector<string> > & strOdes_input, const vector<vector<PolynomialConstraint> > & invariants_input, const vector<vector<DiscTrans> > & transitions_input,
+			const vector<vector<Expression> > & exprOdes_input, const vector<vector<PolynomialConstraint> > & invariants_input, const vector<vector<DiscTrans> > & transitions_input,
 			const int initMode,	const vector<vector<Interval> > & uncertainties_input, const vector<vector<Interval> > & uncertainty_centers_input, const Flowpipe & initSet);
 	HybridSystem(const HybridSystem & hybsys);
 	~HybridSystem();
@@ -176,6 +267,27 @@ public:
 			const int precondition, const vector<Interval> & estimation, const bool bPrint, const vector<string> & stateVarNames,
 			vector<bool> & invariant_boundary_intersected, const vector<string> & modeNames) const;
 
+	// for affine ODEs, the step size is only reduced down to miniStep if the flow can not be built for it
+	bool reach_continuous_linear(list<TaylorModelVec> & resultsCompo, list<vector<Interval> > & domains, const int mode, const Flowpipe & initFp,
+			const double step, const double miniStep, const double time, const int minOrder, const int maxOrder, const int precondition, const bool bPrint,
+			const vector<string> & stateVarNames, vector<bool> & invariant_boundary_intersected, const vector<string> & modeNames) const;
+
+	// the clocks of a mode are the state variables whose derivatives are constant, rates[i] bounds the derivative of the i-th clock
+	void clock_rates(vector<bool> & bClocks, vector<Interval> & rates, const int mode) const;
+
+	// the continuous reachability in a mode and the jump successors of the flowpipes, the tree nodes of the successors
+	// are not yet added to the children of node
+	// the successors subsumed by the sets in initialSets are dropped, unless it is NULL
+	bool reach_mode(list<TaylorModelVec> & mode_flowpipes, list<vector<Interval> > & mode_domains, list<int> & succModes, list<Flowpipe> & succFlowpipes,
+			list<double> & succTimes, list<TreeNode *> & succNodes, const int initMode, const Flowpipe & initFp, double timePassed, const int jumpsExecuted, TreeNode *node,
+			const vector<int> & integrationSchemes, const double step, const double miniStep,
+			const double time, const int orderType, const vector<int> & orders, const vector<int> & maxOrders, const int globalMaxOrder,
+			const bool bAdaptiveSteps, const bool bAdaptiveOrders, const int maxJmps, const int precondition, const vector<Interval> & estimation,
+			const vector<vector<int> > & aggregType, const vector<vector<vector<RowVector> > > & aggregationTemplate_candidates, const vector<RowVector> & default_aggregation_template,
+			const vector<vector<Matrix> > & weightTab, const vector<vector<vector<bool> > > & linear_auto, const vector<vector<vector<RowVector> > > & template_auto,
+			const bool bPrint, const vector<string> & stateVarNames, const vector<string> & modeNames, const vector<string> & tmVarNames,
+			InitialSetStore *initialSets) const;
+
 	// hybrid reachability
 	void reach_hybrid(list<list<TaylorModelVec> > & resultsCompo, list<list<vector<Interval> > > & domains, list<int> & modeIDs,
 			list<TreeNode *> & traceNodes, TreeNode * & traceTree, const vector<int> & integrationSchemes, const double step, const double miniStep,
@@ -183,7 +295,8 @@ public:
 			const bool bAdaptiveSteps, const bool bAdaptiveOrders, const int maxJmps, const int precondition, const vector<Interval> & estimation,
 			const vector<vector<int> > & aggregType, const vector<vector<vector<RowVector> > > aggregationTemplate_candidates, const vector<RowVector> default_aggregation_template,
 			const vector<vector<Matrix> > & weightTab, const vector<vector<vector<bool> > > & linear_auto, const vector<vector<vector<RowVector> > > & template_auto,
-			const bool bPrint, const vector<string> & stateVarNames, const vector<string> & modeNames, const vector<string> & tmVarNames) const;
+			const bool bPrint, const vector<string> & stateVarNames, const vector<string> & modeNames, const vector<string> & tmVarNames,
+			InitialSetStore *initialSets) const;
 
 	HybridSystem & operator = (const HybridSystem & hybsys);
 
@@ -220,6 +333,19 @@ public:
 
 	vector<int> integrationSchemes;
 
+	int numSplits;				// the number of the sub-boxes of the initial set
+	int numThreads;				// the number of the worker threads
+
+	bool bBinaryDumping;		// the flowpipes are dumped to a binary file next to the text dump
+
+	bool bStreaming;			// plot, dump and check the flowpipes of each mode visit once its jumps are computed and then free them
+	int checkingResult;			// the result of the safety checking on the streamed flowpipes
+	unsigned long numOfStreamedFlowpipes;
+	unsigned long numOfStreamedModes;
+
+	bool bPruning;				// the jump successors subsumed by an explored initial set are dropped
+	double widening;			// the relative enlargement of the explored initial sets
+
 	TreeNode *traceTree;
 
 	vector<bool> bVecUnderCheck;
@@ -257,21 +383,41 @@ public:
 	HybridReachability();
 	~HybridReachability();
 
-	void dump(FILE *fp) const;
+	bool dump(FILE *fp) const;		// returns false if the binary file can not be created
+	FILE *open_dumping_file() const;		// the file openers return NULL if the file can not be created
+
+	// the dumping file is written one mode visit at a time, the computation tree is written at the end
+	void dump_header(FILE *fp) const;
+	void dump_mode(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
+	void dump_footer(FILE *fp) const;
+
+	FILE *open_binary_dumping_file() const;
+	void dump_binary(FILE *fp) const;
+	void dump_binary_mode(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
+	bool load_binary();
+
+	void reach(list<list<TaylorModelVec> > & flowpipes, list<list<vector<Interval> > > & fpDomains, list<int> & fpModeIDs, list<TreeNode *> & nodes, TreeNode * & tree, const HybridSystem & sys) const;
+	void reach_parallel(list<list<TaylorModelVec> > & flowpipes, list<list<vector<Interval> > > & fpDomains, list<int> & fpModeIDs, list<TreeNode *> & nodes, TreeNode * & tree, const HybridSystem & sys) const;
+	bool run();		// returns false if the output files for streaming can not be created
+	void reach_split();		// the sub-boxes of the initial set are computed separately and their results are merged
 
-	void run();
+	bool plot_2D() const;		// returns false if the plotting file can not be created
+	FILE *open_plotting_file() const;
 
-	void plot_2D() const;
+	// the plotting file is written one mode visit at a time
+	void plot_2D_header(FILE *fp) const;
+	void plot_2D_mode(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
+	void plot_2D_footer(FILE *fp) const;
 
-	void plot_2D_GNUPLOT(FILE *fp) const;
-	void plot_2D_interval_GNUPLOT(FILE *fp) const;
-	void plot_2D_octagon_GNUPLOT(FILE *fp) const;
-	void plot_2D_grid_GNUPLOT(FILE *fp) const;
+	void plot_2D_GNUPLOT(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
+	void plot_2D_interval_GNUPLOT(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
+	void plot_2D_octagon_GNUPLOT(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
+	void plot_2D_grid_GNUPLOT(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
 
-	void plot_2D_MATLAB(FILE *fp) const;
-	void plot_2D_interval_MATLAB(FILE *fp) const;
-	void plot_2D_octagon_MATLAB(FILE *fp) const;
-	void plot_2D_grid_MATLAB(FILE *fp) const;
+	void plot_2D_MATLAB(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
+	void plot_2D_interval_MATLAB(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
+	void plot_2D_octagon_MATLAB(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
+	void plot_2D_grid_MATLAB(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode) const;
 
 	bool declareStateVar(const string & vName);
 	int getIDForStateVar(const string & vName) const;
@@ -282,7 +428,7 @@ public:
 	bool getTMVarName(string & vName, const int id) const;
 
 	bool declareMode(const string & mName, const TaylorModelVec & ode, const vector<Interval> & uncertainties, const vector<PolynomialConstraint> & inv, const int integrationScheme);
-	bool declareMode(const string & mName, const vector<string> & strOde, const vector<Interval> & uncertainties, const vector<PolynomialConstraint> & inv, const int integrationScheme);
+	bool declareMode(const string & mName, const vector<Expression> & exprOde, const vector<Interval> & uncertainties, const vector<PolynomialConstraint> & inv, const int integrationScheme);
 
 	int getIDForMode(const string & mName) const;
 	bool getModeName(string & mName, const int id) const;
@@ -291,11 +437,16 @@ public:
 	void declareTrans();
 
 	void initialConfig(const int modeID, const Flowpipe & initialSet);
+	void initialConfig(const Flowpipe & initialSet);		// the initial mode is kept
 	void set_default_template();
 	void constructWeightTab();
 
 	int safetyChecking();
+	void select_modes_under_check();
+	int check_mode(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & fpDomains, const int mode, TreeNode * const node) const;
+	FILE *open_counterexample_file() const;
 	unsigned long numOfFlowpipes() const;
+	unsigned long numOfJumpsExecuted() const;
 	void dump_potential_counterexample(FILE *fp, const list<TaylorModelVec> & flowpipes, const list<vector<Interval> > & domains, TreeNode * const node, const list<Interval> & globalTimes) const;
 
 	// parallelotopic aggregation
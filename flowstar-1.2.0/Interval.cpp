@@ -14,30 +14,227 @@
 
 #include "Interval.h"
 
-mpfr_prec_t intervalNumPrecision = normal_precision;
+__thread mpfr_prec_t intervalNumPrecision = normal_precision;
+
+/*
+ * Directed rounding for the double representation. The operations are done in the default rounding mode and the
+ * results are moved by one ulp if the error-free transformations show that they are on the wrong side. Below
+ * eft_min the error terms may underflow, then the results are always moved.
+ */
+
+const double eft_min = 1e-290;
+
+inline static bool mpfr_selected()
+{
+	return intervalNumPrecision > normal_precision;
+}
+
+inline static double add_down(const double a, const double b)
+{
+	double s = a + b;
+	double t = s - a;
+	double e = (a - (s - t)) + (b - t);
+
+	if(e < 0)
+		return nextafter(s, -INFINITY);
+	else if(e >= 0 || std::isinf(a) || std::isinf(b))
+		return s;
+	else
+		return s > 0 ? DBL_MAX : s;		// overflow
+}
+
+inline static double add_up(const double a, const double b)
+{
+	double s = a + b;
+	double t = s - a;
+	double e = (a - (s - t)) + (b - t);
+
+	if(e > 0)
+		return nextafter(s, INFINITY);
+	else if(e <= 0 || std::isinf(a) || std::isinf(b))
+		return s;
+	else
+		return s < 0 ? -DBL_MAX : s;	// overflow
+}
+
+inline static double sub_down(const double a, const double b)
+{
+	return add_down(a, -b);
+}
+
+inline static double sub_up(const double a, const double b)
+{
+	return add_up(a, -b);
+}
+
+inline static double mul_down(const double a, const double b)
+{
+	double p = a * b;
+
+	if(fabs(p) < eft_min)
+	{
+		if(a == 0 || b == 0)
+			return p;
+		else
+			return nextafter(p, -INFINITY);
+	}
+
+	return fma(a, b, -p) < 0 ? nextafter(p, -INFINITY) : p;
+}
+
+inline static double mul_up(const double a, const double b)
+{
+	double p = a * b;
+
+	if(fabs(p) < eft_min)
+	{
+		if(a == 0 || b == 0)
+			return p;
+		else
+			return nextafter(p, INFINITY);
+	}
+
+	return fma(a, b, -p) > 0 ? nextafter(p, INFINITY) : p;
+}
+
+inline static double div_down(const double a, const double b)
+{
+	double q = a / b;
+
+	if(fabs(q) < eft_min || fabs(a) < eft_min)
+	{
+		if(a == 0)
+			return q;
+		else
+			return nextafter(q, -INFINITY);
+	}
+
+	double r = fma(-q, b, a);		// the exact quotient is q + r/b
+
+	return (r < 0 && b > 0) || (r > 0 && b < 0) ? nextafter(q, -INFINITY) : q;
+}
+
+inline static double div_up(const double a, const double b)
+{
+	double q = a / b;
+
+	if(fabs(q) < eft_min || fabs(a) < eft_min)
+	{
+		if(a == 0)
+			return q;
+		else
+			return nextafter(q, INFINITY);
+	}
+
+	double r = fma(-q, b, a);
+
+	return (r > 0 && b > 0) || (r < 0 && b < 0) ? nextafter(q, INFINITY) : q;
+}
+
+inline static double sqrt_down(const double a)
+{
+	double s = std::sqrt(a);
+
+	if(a < eft_min)
+		return a == 0 ? s : nextafter(s, 0);
+
+	return fma(-s, s, a) < 0 ? nextafter(s, 0) : s;
+}
+
+inline static double sqrt_up(const double a)
+{
+	double s = std::sqrt(a);
+
+	if(a < eft_min)
+		return a == 0 ? s : nextafter(s, INFINITY);
+
+	return fma(-s, s, a) > 0 ? nextafter(s, INFINITY) : s;
+}
+
+inline static double pow_down(const double a, const unsigned int n)		// a >= 0
+{
+	double result = 1, base = a;
+
+	for(unsigned int m = n; m > 0; m >>= 1)
+	{
+		if(m & 1)
+			result = mul_down(result, base);
+
+		if(m > 1)
+			base = mul_down(base, base);
+	}
+
+	return result;
+}
+
+inline static double pow_up(const double a, const unsigned int n)		// a >= 0
+{
+	double result = 1, base = a;
+
+	for(unsigned int m = n; m > 0; m >>= 1)
+	{
+		if(m & 1)
+			result = mul_up(result, base);
+
+		if(m > 1)
+			base = mul_up(base, base);
+	}
+
+	return result;
+}
 
 Interval::Interval()
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	if(mpfr_selected())
+	{
+		mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
 
-	mpfr_set_d(lo, 0.0, MPFR_RNDD);
-	mpfr_set_d(up, 0.0, MPFR_RNDU);
+		mpfr_set_d(lo, 0.0, MPFR_RNDD);
+		mpfr_set_d(up, 0.0, MPFR_RNDU);
+		bMPFR = true;
+	}
+	else
+	{
+		dlo = 0.0;
+		dup = 0.0;
+		bMPFR = false;
+	}
 }
 
 Interval::Interval(const double c)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	if(mpfr_selected())
+	{
+		mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
 
-	mpfr_set_d(lo, c, MPFR_RNDD);
-	mpfr_set_d(up, c, MPFR_RNDU);
+		mpfr_set_d(lo, c, MPFR_RNDD);
+		mpfr_set_d(up, c, MPFR_RNDU);
+		bMPFR = true;
+	}
+	else
+	{
+		dlo = c;
+		dup = c;
+		bMPFR = false;
+	}
 }
 
 Interval::Interval(const double l, const double u)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	if(mpfr_selected())
+	{
+		mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
 
-	mpfr_set_d(lo, l, MPFR_RNDD);
-	mpfr_set_d(up, u, MPFR_RNDU);
+		mpfr_set_d(lo, l, MPFR_RNDD);
+		mpfr_set_d(up, u, MPFR_RNDU);
+		bMPFR = true;
+	}
+	else
+	{
+		dlo = l;
+		dup = u;
+		bMPFR = false;
+	}
 }
 
 Interval::Interval(const char *strLo, const char *strUp)
@@ -46,121 +243,343 @@ Interval::Interval(const char *strLo, const char *strUp)
 
 	mpfr_set_str(lo, strLo, 10, MPFR_RNDD);
 	mpfr_set_str(up, strUp, 10, MPFR_RNDU);
+	bMPFR = true;
+
+	if(!mpfr_selected())
+	{
+		toDouble();
+	}
 }
 
 Interval::Interval(const Interval & I)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	if(I.bMPFR)
+	{
+		mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
 
-	mpfr_set(lo, I.lo, MPFR_RNDD);
-	mpfr_set(up, I.up, MPFR_RNDU);
+		mpfr_set(lo, I.lo, MPFR_RNDD);
+		mpfr_set(up, I.up, MPFR_RNDU);
+		bMPFR = true;
+	}
+	else
+	{
+		dlo = I.dlo;
+		dup = I.dup;
+		bMPFR = false;
+	}
 }
 
 Interval::~Interval()
 {
-	mpfr_clear(lo);
-	mpfr_clear(up);
+	if(bMPFR)
+	{
+		mpfr_clear(lo);
+		mpfr_clear(up);
+	}
 }
 
+void Interval::toMPFR()
+{
+	if(!bMPFR)
+	{
+		mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+
+		mpfr_set_d(lo, dlo, MPFR_RNDD);
+		mpfr_set_d(up, dup, MPFR_RNDU);
+		bMPFR = true;
+	}
+}
+
+void Interval::toDouble()
+{
+	if(bMPFR)
+	{
+		dlo = mpfr_get_d(lo, MPFR_RNDD);
+		dup = mpfr_get_d(up, MPFR_RNDU);
+
+		mpfr_clear(lo);
+		mpfr_clear(up);
+		bMPFR = false;
+	}
+}
+
+// a read-only MPFR view of the bounds of an interval, the bounds in the double representation are copied exactly
+class MPFRView
+{
+private:
+	mpfr_t tlo, tup;
+	bool bCopied;
+
+public:
+	mpfr_srcptr lo, up;
+
+	MPFRView(const Interval & I)
+	{
+		if(I.bMPFR)
+		{
+			lo = I.lo;
+			up = I.up;
+			bCopied = false;
+		}
+		else
+		{
+			mpfr_inits2(intervalNumPrecision, tlo, tup, (mpfr_ptr) 0);
+			mpfr_set_d(tlo, I.dlo, MPFR_RNDD);
+			mpfr_set_d(tup, I.dup, MPFR_RNDU);
+			lo = tlo;
+			up = tup;
+			bCopied = true;
+		}
+	}
+
+	~MPFRView()
+	{
+		if(bCopied)
+		{
+			mpfr_clear(tlo);
+			mpfr_clear(tup);
+		}
+	}
+
+private:
+	MPFRView(const MPFRView &);
+	MPFRView & operator = (const MPFRView &);
+};
+
 void Interval::set(const double l, const double u)
 {
-	mpfr_set_d(lo, l, MPFR_RNDD);
-	mpfr_set_d(up, u, MPFR_RNDU);
+	if(bMPFR)
+	{
+		mpfr_set_d(lo, l, MPFR_RNDD);
+		mpfr_set_d(up, u, MPFR_RNDU);
+	}
+	else
+	{
+		dlo = l;
+		dup = u;
+	}
 }
 
 void Interval::set(const double c)
 {
-	mpfr_set_d(lo, c, MPFR_RNDD);
-	mpfr_set_d(up, c, MPFR_RNDU);
+	if(bMPFR)
+	{
+		mpfr_set_d(lo, c, MPFR_RNDD);
+		mpfr_set_d(up, c, MPFR_RNDU);
+	}
+	else
+	{
+		dlo = c;
+		dup = c;
+	}
 }
 
 void Interval::setInf(const double l)
 {
-	mpfr_set_d(lo, l, MPFR_RNDD);
+	if(bMPFR)
+	{
+		mpfr_set_d(lo, l, MPFR_RNDD);
+	}
+	else
+	{
+		dlo = l;
+	}
 }
 
 void Interval::setInf(const Interval & I)
 {
-	mpfr_set(lo, I.lo, MPFR_RNDD);
+	if(bMPFR || I.bMPFR)
+	{
+		toMPFR();
+		MPFRView J(I);
+
+		mpfr_set(lo, J.lo, MPFR_RNDD);
+	}
+	else
+	{
+		dlo = I.dlo;
+	}
 }
 
 void Interval::setSup(const double u)
 {
-	mpfr_set_d(up, u, MPFR_RNDU);
+	if(bMPFR)
+	{
+		mpfr_set_d(up, u, MPFR_RNDU);
+	}
+	else
+	{
+		dup = u;
+	}
 }
 
 void Interval::setSup(const Interval & S)
 {
-	mpfr_set(up, S.up, MPFR_RNDU);
+	if(bMPFR || S.bMPFR)
+	{
+		toMPFR();
+		MPFRView J(S);
+
+		mpfr_set(up, J.up, MPFR_RNDU);
+	}
+	else
+	{
+		dup = S.dup;
+	}
 }
 
 void Interval::split(Interval & left, Interval & right) const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	if(bMPFR)
+	{
+		left.toMPFR();
+		right.toMPFR();
 
-	mpfr_set(left.lo, lo, MPFR_RNDD);
-	mpfr_add(tmp, lo, up, MPFR_RNDU);
-	mpfr_div_d(left.up, tmp, 2.0, MPFR_RNDU);
+		mpfr_t tmp;
+		mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
 
-	mpfr_set(right.up, up, MPFR_RNDU);
-	mpfr_add(tmp, lo, up, MPFR_RNDD);
-	mpfr_div_d(right.lo, tmp, 2.0, MPFR_RNDD);
+		mpfr_set(left.lo, lo, MPFR_RNDD);
+		mpfr_add(tmp, lo, up, MPFR_RNDU);
+		mpfr_div_d(left.up, tmp, 2.0, MPFR_RNDU);
 
-	mpfr_clear(tmp);
+		mpfr_set(right.up, up, MPFR_RNDU);
+		mpfr_add(tmp, lo, up, MPFR_RNDD);
+		mpfr_div_d(right.lo, tmp, 2.0, MPFR_RNDD);
+
+		mpfr_clear(tmp);
+	}
+	else
+	{
+		left.toDouble();
+		right.toDouble();
+
+		left.dlo = dlo;
+		left.dup = mul_up(add_up(dlo, dup), 0.5);
+
+		right.dup = dup;
+		right.dlo = mul_down(add_down(dlo, dup), 0.5);
+	}
 }
 
 void Interval::split(list<Interval> & result, const int n) const
 {
-	mpfr_t inc, w, newup, newlo;
-	mpfr_inits2(intervalNumPrecision, inc, w, newup, newlo, (mpfr_ptr) 0);
+	if(bMPFR)
+	{
+		mpfr_t inc, w, newup, newlo;
+		mpfr_inits2(intervalNumPrecision, inc, w, newup, newlo, (mpfr_ptr) 0);
 
-	mpfr_sub(w, up, lo, MPFR_RNDU);
-	mpfr_div_si(inc, w, (long)n, MPFR_RNDU);
+		mpfr_sub(w, up, lo, MPFR_RNDU);
+		mpfr_div_si(inc, w, (long)n, MPFR_RNDU);
 
-	Interval grid;
-	mpfr_set(grid.lo, lo, MPFR_RNDD);
-	mpfr_add(grid.up, lo, inc, MPFR_RNDU);
-	result.push_back(grid);
+		Interval grid;
+		grid.toMPFR();
 
-	for(int i=1; i<n; ++i)
+		mpfr_set(grid.lo, lo, MPFR_RNDD);
+		mpfr_add(grid.up, lo, inc, MPFR_RNDU);
+		result.push_back(grid);
+
+		for(int i=1; i<n; ++i)
+		{
+			mpfr_add(grid.lo, grid.lo, inc, MPFR_RNDD);
+			mpfr_add(grid.up, grid.up, inc, MPFR_RNDU);
+			result.push_back(grid);
+		}
+
+		mpfr_clears(inc, w, newup, newlo, (mpfr_ptr) 0);
+	}
+	else
 	{
-		mpfr_add(grid.lo, grid.lo, inc, MPFR_RNDD);
-		mpfr_add(grid.up, grid.up, inc, MPFR_RNDU);
+		double inc = div_up(sub_up(dup, dlo), (double)n);
+
+		Interval grid;
+		grid.toDouble();
+
+		grid.dlo = dlo;
+		grid.dup = add_up(dlo, inc);
 		result.push_back(grid);
+
+		for(int i=1; i<n; ++i)
+		{
+			grid.dlo = add_down(grid.dlo, inc);
+			grid.dup = add_up(grid.dup, inc);
+			result.push_back(grid);
+		}
 	}
 }
 
 void Interval::set_inf()
 {
-	mpfr_set_inf(lo, -1);
-	mpfr_set_inf(up, 1);
+	if(bMPFR)
+	{
+		mpfr_set_inf(lo, -1);
+		mpfr_set_inf(up, 1);
+	}
+	else
+	{
+		dlo = -INFINITY;
+		dup = INFINITY;
+	}
 }
 
 double Interval::sup() const
 {
-	return mpfr_get_d(up, MPFR_RNDU);
+	if(bMPFR)
+		return mpfr_get_d(up, MPFR_RNDU);
+	else
+		return dup;
 }
 
 double Interval::inf() const
 {
-	return mpfr_get_d(lo, MPFR_RNDD);
+	if(bMPFR)
+		return mpfr_get_d(lo, MPFR_RNDD);
+	else
+		return dlo;
 }
 
 void Interval::sup(Interval & S) const
 {
-	mpfr_set(S.up, up, MPFR_RNDU);
-	mpfr_set(S.lo, up, MPFR_RNDD);
+	if(bMPFR)
+	{
+		S.toMPFR();
+
+		mpfr_set(S.up, up, MPFR_RNDU);
+		mpfr_set(S.lo, up, MPFR_RNDD);
+	}
+	else
+	{
+		S.toDouble();
+
+		S.dup = dup;
+		S.dlo = dup;
+	}
 }
 
 void Interval::inf(Interval & I) const
 {
-	mpfr_set(I.up, lo, MPFR_RNDU);
-	mpfr_set(I.lo, lo, MPFR_RNDD);
+	if(bMPFR)
+	{
+		I.toMPFR();
+
+		mpfr_set(I.up, lo, MPFR_RNDU);
+		mpfr_set(I.lo, lo, MPFR_RNDD);
+	}
+	else
+	{
+		I.toDouble();
+
+		I.dup = dlo;
+		I.dlo = dlo;
+	}
 }
 
 double Interval::midpoint() const
 {
+	if(!bMPFR)
+	{
+		return (dlo + dup) / 2.0;
+	}
+
 	mpfr_t tmp;
 	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
 
@@ -175,6 +594,17 @@ double Interval::midpoint() const
 
 void Interval::midpoint(Interval & M) const
 {
+	if(!bMPFR)
+	{
+		M.toDouble();
+
+		M.dup = mul_up(add_up(dlo, dup), 0.5);
+		M.dlo = mul_down(add_down(dlo, dup), 0.5);
+		return;
+	}
+
+	M.toMPFR();
+
 	mpfr_t tmp;
 	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
 
@@ -193,6 +623,20 @@ void Interval::midpoint(Interval & M) const
 
 void Interval::remove_midpoint(Interval & M)
 {
+	if(!bMPFR)
+	{
+		M.toDouble();
+
+		M.dup = mul_up(add_up(dlo, dup), 0.5);
+		M.dlo = mul_down(add_down(dlo, dup), 0.5);
+
+		dlo = sub_down(dlo, M.dup);
+		dup = sub_up(dup, M.dlo);
+		return;
+	}
+
+	M.toMPFR();
+
 	mpfr_t tmp;
 	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
 
@@ -214,22 +658,44 @@ void Interval::remove_midpoint(Interval & M)
 
 void Interval::bloat(const double e)
 {
-	mpfr_sub_d(lo, lo, e, MPFR_RNDD);
-	mpfr_add_d(up, up, e, MPFR_RNDU);
+	if(bMPFR)
+	{
+		mpfr_sub_d(lo, lo, e, MPFR_RNDD);
+		mpfr_add_d(up, up, e, MPFR_RNDU);
+	}
+	else
+	{
+		dlo = sub_down(dlo, e);
+		dup = add_up(dup, e);
+	}
 }
 
 bool Interval::within(const Interval & I, const double e) const
 {
+	if(!bMPFR && !I.bMPFR)
+	{
+		double d = dup >= I.dup ? sub_up(dup, I.dup) : sub_down(dup, I.dup);
+
+		if(fabs(d) > e)
+			return false;
+
+		d = dlo >= I.dlo ? sub_up(dlo, I.dlo) : sub_down(dlo, I.dlo);
+
+		return fabs(d) <= e;
+	}
+
+	MPFRView A(*this), J(I);
+
 	mpfr_t tmp;
 	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
 
-	if(mpfr_cmp(up, I.up) >= 0)
+	if(mpfr_cmp(A.up, J.up) >= 0)
 	{
-		mpfr_sub(tmp, up, I.up, MPFR_RNDU);
+		mpfr_sub(tmp, A.up, J.up, MPFR_RNDU);
 	}
 	else
 	{
-		mpfr_sub(tmp, up, I.up, MPFR_RNDD);
+		mpfr_sub(tmp, A.up, J.up, MPFR_RNDD);
 	}
 
 	mpfr_abs(tmp, tmp, MPFR_RNDU);
@@ -241,13 +707,13 @@ bool Interval::within(const Interval & I, const double e) const
 		return false;
 	}
 
-	if(mpfr_cmp(lo, I.lo) >= 0)
+	if(mpfr_cmp(A.lo, J.lo) >= 0)
 	{
-		mpfr_sub(tmp, lo, I.lo, MPFR_RNDU);
+		mpfr_sub(tmp, A.lo, J.lo, MPFR_RNDU);
 	}
 	else
 	{
-		mpfr_sub(tmp, lo, I.lo, MPFR_RNDD);
+		mpfr_sub(tmp, A.lo, J.lo, MPFR_RNDD);
 	}
 
 	mpfr_abs(tmp, tmp, MPFR_RNDU);
@@ -267,6 +733,11 @@ bool Interval::within(const Interval & I, const double e) const
 
 double Interval::width() const
 {
+	if(!bMPFR)
+	{
+		return sub_up(dup, dlo);
+	}
+
 	mpfr_t tmp;
 	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
 
@@ -280,6 +751,16 @@ double Interval::width() const
 
 void Interval::width(Interval & W) const
 {
+	if(!bMPFR)
+	{
+		W.toDouble();
+
+		W.dlo = W.dup = sub_up(dup, dlo);
+		return;
+	}
+
+	W.toMPFR();
+
 	mpfr_t tmp;
 	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
 
@@ -293,8 +774,8 @@ void Interval::width(Interval & W) const
 
 double Interval::mag() const
 {
-	double inf = mpfr_get_d(lo, MPFR_RNDD);
-	double sup = mpfr_get_d(up, MPFR_RNDU);
+	double inf = this->inf();
+	double sup = this->sup();
 
 	inf = fabs(inf);
 	sup = fabs(sup);
@@ -304,6 +785,16 @@ double Interval::mag() const
 
 void Interval::mag(Interval & M) const
 {
+	if(!bMPFR)
+	{
+		M.toDouble();
+
+		M.dlo = M.dup = mag();
+		return;
+	}
+
+	M.toMPFR();
+
 	mpfr_t tmp1, tmp2;
 	mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
 
@@ -327,6 +818,20 @@ void Interval::mag(Interval & M) const
 
 void Interval::abs(Interval & result) const
 {
+	if(!bMPFR)
+	{
+		result.toDouble();
+
+		double tmp1 = fabs(dlo);
+		double tmp2 = fabs(dup);
+
+		result.dlo = tmp1 > tmp2 ? tmp2 : tmp1;
+		result.dup = tmp1 > tmp2 ? tmp1 : tmp2;
+		return;
+	}
+
+	result.toMPFR();
+
 	mpfr_t tmp1, tmp2;
 	mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
 
@@ -360,6 +865,16 @@ void Interval::abs(Interval & result) const
 
 void Interval::abs_assign()
 {
+	if(!bMPFR)
+	{
+		double tmp1 = fabs(dlo);
+		double tmp2 = fabs(dup);
+
+		dlo = tmp1 > tmp2 ? tmp2 : tmp1;
+		dup = tmp1 > tmp2 ? tmp1 : tmp2;
+		return;
+	}
+
 	mpfr_t tmp1, tmp2, newLo, newUp;
 	mpfr_inits2(intervalNumPrecision, tmp1, tmp2, newLo, newUp, (mpfr_ptr) 0);
 
@@ -398,7 +913,14 @@ void Interval::abs_assign()
 
 bool Interval::subseteq(const Interval & I) const
 {
-	if( (mpfr_cmp(I.lo, lo) <= 0) && (mpfr_cmp(I.up, up) >= 0) )
+	if(!bMPFR && !I.bMPFR)
+	{
+		return (I.dlo <= dlo) && (I.dup >= dup);
+	}
+
+	MPFRView A(*this), J(I);
+
+	if( (mpfr_cmp(J.lo, A.lo) <= 0) && (mpfr_cmp(J.up, A.up) >= 0) )
 		return true;
 	else
 		return false;
@@ -406,7 +928,14 @@ bool Interval::subseteq(const Interval & I) const
 
 bool Interval::supseteq(const Interval & I) const
 {
-	if( (mpfr_cmp(lo, I.lo) <= 0) && (mpfr_cmp(up, I.up) >= 0) )
+	if(!bMPFR && !I.bMPFR)
+	{
+		return (dlo <= I.dlo) && (dup >= I.dup);
+	}
+
+	MPFRView A(*this), J(I);
+
+	if( (mpfr_cmp(A.lo, J.lo) <= 0) && (mpfr_cmp(A.up, J.up) >= 0) )
 		return true;
 	else
 		return false;
@@ -414,6 +943,11 @@ bool Interval::supseteq(const Interval & I) const
 
 bool Interval::valid() const
 {
+	if(!bMPFR)
+	{
+		return dup >= dlo;
+	}
+
 	if(mpfr_cmp(up, lo) >= 0)
 	{
 		return true;
@@ -424,39 +958,112 @@ bool Interval::valid() const
 	}
 }
 
+bool Interval::intersect_assign(const Interval & I)
+{
+	if(!bMPFR && !I.bMPFR)
+	{
+		if(I.dlo > dup || I.dup < dlo)
+			return false;
+
+		if(I.dlo > dlo)
+			dlo = I.dlo;
+
+		if(I.dup < dup)
+			dup = I.dup;
+
+		return true;
+	}
+
+	toMPFR();
+	MPFRView J(I);
+
+	if(mpfr_cmp(J.lo, up) > 0 || mpfr_cmp(J.up, lo) < 0)
+		return false;
+
+	if(mpfr_cmp(J.lo, lo) > 0)
+		mpfr_set(lo, J.lo, MPFR_RNDD);
+
+	if(mpfr_cmp(J.up, up) < 0)
+		mpfr_set(up, J.up, MPFR_RNDU);
+
+	return true;
+}
+
 bool Interval::operator == (const Interval & I) const
 {
-	return ( (mpfr_cmp(lo, I.lo) == 0) && (mpfr_cmp(up, I.up) == 0) );
+	if(!bMPFR && !I.bMPFR)
+	{
+		return (dlo == I.dlo) && (dup == I.dup);
+	}
+
+	MPFRView A(*this), J(I);
+
+	return ( (mpfr_cmp(A.lo, J.lo) == 0) && (mpfr_cmp(A.up, J.up) == 0) );
 }
 
 bool Interval::operator != (const Interval & I) const
 {
-	return ( (mpfr_cmp(lo, I.lo) != 0) || (mpfr_cmp(up, I.up) != 0) );
+	return !(*this == I);
 }
 
 bool Interval::operator > (const Interval & I) const
 {
-	return ( (mpfr_cmp(lo, I.up) > 0) );
+	if(!bMPFR && !I.bMPFR)
+	{
+		return dlo > I.dup;
+	}
+
+	MPFRView A(*this), J(I);
+
+	return ( (mpfr_cmp(A.lo, J.up) > 0) );
 }
 
 bool Interval::operator < (const Interval & I) const
 {
-	return ( (mpfr_cmp(up, I.lo) < 0) );
+	if(!bMPFR && !I.bMPFR)
+	{
+		return dup < I.dlo;
+	}
+
+	MPFRView A(*this), J(I);
+
+	return ( (mpfr_cmp(A.up, J.lo) < 0) );
 }
 
 bool Interval::operator <= (const Interval & I) const
 {
-	return ( (mpfr_cmp(lo, I.lo) < 0) );
+	if(!bMPFR && !I.bMPFR)
+	{
+		return dlo < I.dlo;
+	}
+
+	MPFRView A(*this), J(I);
+
+	return ( (mpfr_cmp(A.lo, J.lo) < 0) );
 }
 
 bool Interval::operator >= (const Interval & I) const
 {
-	return ( (mpfr_cmp(up, I.up) > 0) );
+	if(!bMPFR && !I.bMPFR)
+	{
+		return dup > I.dup;
+	}
+
+	MPFRView A(*this), J(I);
+
+	return ( (mpfr_cmp(A.up, J.up) > 0) );
 }
 
 bool Interval::smallereq(const Interval & I) const
 {
-	return ( (mpfr_cmp(up, I.lo) <= 0) );
+	if(!bMPFR && !I.bMPFR)
+	{
+		return dup <= I.dlo;
+	}
+
+	MPFRView A(*this), J(I);
+
+	return ( (mpfr_cmp(A.up, J.lo) <= 0) );
 }
 
 Interval & Interval::operator = (const Interval & I)
@@ -464,38 +1071,119 @@ Interval & Interval::operator = (const Interval & I)
 	if(this == &I)
 		return *this;	// check for self assignment
 
-	mpfr_set(lo, I.lo, MPFR_RNDD);
-	mpfr_set(up, I.up, MPFR_RNDU);
+	if(I.bMPFR)
+	{
+		toMPFR();
+
+		mpfr_set(lo, I.lo, MPFR_RNDD);
+		mpfr_set(up, I.up, MPFR_RNDU);
+	}
+	else
+	{
+		if(bMPFR)
+		{
+			mpfr_clear(lo);
+			mpfr_clear(up);
+			bMPFR = false;
+		}
+
+		dlo = I.dlo;
+		dup = I.dup;
+	}
 
 	return *this;
 }
 
 Interval & Interval::operator += (const Interval & I)
 {
-	mpfr_add(lo, lo, I.lo, MPFR_RNDD);
-	mpfr_add(up, up, I.up, MPFR_RNDU);
+	if(bMPFR || I.bMPFR)
+	{
+		toMPFR();
+		MPFRView J(I);
+
+		mpfr_add(lo, lo, J.lo, MPFR_RNDD);
+		mpfr_add(up, up, J.up, MPFR_RNDU);
+	}
+	else
+	{
+		dlo = add_down(dlo, I.dlo);
+		dup = add_up(dup, I.dup);
+	}
 
 	return *this;
 }
 
 Interval & Interval::operator -= (const Interval & I)
 {
-	mpfr_sub(lo, lo, I.up, MPFR_RNDD);
-	mpfr_sub(up, up, I.lo, MPFR_RNDU);
+	if(bMPFR || I.bMPFR)
+	{
+		toMPFR();
+		MPFRView J(I);
+
+		mpfr_sub(lo, lo, J.up, MPFR_RNDD);
+		mpfr_sub(up, up, J.lo, MPFR_RNDU);
+	}
+	else
+	{
+		double newLo = sub_down(dlo, I.dup);	// I may be the same as *this
+		dup = sub_up(dup, I.dlo);
+		dlo = newLo;
+	}
 
 	return *this;
 }
 
 Interval & Interval::operator *= (const Interval & I)
 {
+	if(!bMPFR && !I.bMPFR)
+	{
+		double min, max, tmp;
+
+		min = mul_down(dlo, I.dlo);
+
+		tmp = mul_down(dlo, I.dup);
+		if(min > tmp)
+			min = tmp;
+
+		tmp = mul_down(dup, I.dlo);
+		if(min > tmp)
+			min = tmp;
+
+		tmp = mul_down(dup, I.dup);
+		if(min > tmp)
+			min = tmp;
+
+		max = mul_up(dlo, I.dlo);
+
+		tmp = mul_up(dlo, I.dup);
+		if(max < tmp)
+			max = tmp;
+
+		tmp = mul_up(dup, I.dlo);
+		if(max < tmp)
+			max = tmp;
+
+		tmp = mul_up(dup, I.dup);
+		if(max < tmp)
+			max = tmp;
+
+		dlo = min;
+		dup = max;
+
+		return *this;
+	}
+
+	toMPFR();
+	MPFRView J(I);
+
 	mpfr_t lolo, loup, uplo, upup, min, max;
 	mpfr_inits2(intervalNumPrecision, lolo, loup, uplo, upup, min, max, (mpfr_ptr) 0);
 
 	// compute the lower bound
-	mpfr_mul(lolo, lo, I.lo, MPFR_RNDD);
-	mpfr_mul(loup, lo, I.up, MPFR_RNDD);
-	mpfr_mul(uplo, up, I.lo, MPFR_RNDD);
-	mpfr_mul(upup, up, I.up, MPFR_RNDD);
+	mpfr_mul(lolo, lo, J.lo, MPFR_RNDD);
+	mpfr_mul(loup, lo, J.up, MPFR_RNDD);
+	mpfr_mul(uplo, up, J.lo, MPFR_RNDD);
+	mpfr_mul(upup, up, J.up, MPFR_RNDD);
 
 	mpfr_set(min, lolo, MPFR_RNDD);
 
@@ -515,10 +1203,10 @@ Interval & Interval::operator *= (const Interval & I)
 	}
 
 	// compute the upper bound
-	mpfr_mul(lolo, lo, I.lo, MPFR_RNDU);
-	mpfr_mul(loup, lo, I.up, MPFR_RNDU);
-	mpfr_mul(uplo, up, I.lo, MPFR_RNDU);
-	mpfr_mul(upup, up, I.up, MPFR_RNDU);
+	mpfr_mul(lolo, lo, J.lo, MPFR_RNDU);
+	mpfr_mul(loup, lo, J.up, MPFR_RNDU);
+	mpfr_mul(uplo, up, J.lo, MPFR_RNDU);
+	mpfr_mul(upup, up, J.up, MPFR_RNDU);
 
 	mpfr_set(max, lolo, MPFR_RNDU);
 
@@ -557,16 +1245,32 @@ Interval & Interval::operator /= (const Interval & I)
 
 Interval & Interval::operator ++ ()
 {
-	mpfr_add_ui(lo, lo, 1L, MPFR_RNDD);
-	mpfr_add_ui(up, up, 1L, MPFR_RNDU);
+	if(bMPFR)
+	{
+		mpfr_add_ui(lo, lo, 1L, MPFR_RNDD);
+		mpfr_add_ui(up, up, 1L, MPFR_RNDU);
+	}
+	else
+	{
+		dlo = add_down(dlo, 1.0);
+		dup = add_up(dup, 1.0);
+	}
 
 	return *this;
 }
 
 Interval & Interval::operator -- ()
 {
-	mpfr_sub_ui(lo, lo, 1L, MPFR_RNDD);
-	mpfr_sub_ui(up, up, 1L, MPFR_RNDU);
+	if(bMPFR)
+	{
+		mpfr_sub_ui(lo, lo, 1L, MPFR_RNDD);
+		mpfr_sub_ui(up, up, 1L, MPFR_RNDU);
+	}
+	else
+	{
+		dlo = sub_down(dlo, 1.0);
+		dup = sub_up(dup, 1.0);
+	}
 
 	return *this;
 }
@@ -601,31 +1305,66 @@ const Interval Interval::operator / (const Interval & I) const
 
 void Interval::sqrt(Interval & result) const
 {
-	if(mpfr_sgn(lo) < 0)
+	if(inf() < 0)
 	{
 		printf("Exception: Square root of a negative number.\n");
 		exit(1);
 	}
 
-	mpfr_sqrt(result.lo, lo, MPFR_RNDD);
-	mpfr_sqrt(result.up, up, MPFR_RNDU);
+	if(bMPFR)
+	{
+		result.toMPFR();
+
+		mpfr_sqrt(result.lo, lo, MPFR_RNDD);
+		mpfr_sqrt(result.up, up, MPFR_RNDU);
+	}
+	else
+	{
+		result.toDouble();
+
+		result.dlo = sqrt_down(dlo);
+		result.dup = sqrt_up(dup);
+	}
 }
 
 void Interval::inv(Interval & result) const
 {
-	mpfr_mul_si(result.lo, up, -1L, MPFR_RNDD);
-	mpfr_mul_si(result.up, lo, -1L, MPFR_RNDU);
+	if(bMPFR)
+	{
+		result.toMPFR();
+
+		mpfr_mul_si(result.lo, up, -1L, MPFR_RNDD);
+		mpfr_mul_si(result.up, lo, -1L, MPFR_RNDU);
+	}
+	else
+	{
+		result.toDouble();
+
+		double tmp = -dup;		// result may be the same as *this
+		result.dup = -dlo;
+		result.dlo = tmp;
+	}
 }
 
 void Interval::rec(Interval & result) const
 {
-	if (mpfr_sgn(lo) <= 0 && mpfr_sgn(up) >= 0)
+	if (inf() <= 0 && sup() >= 0)
 	{
 		printf("Exception: Divided by 0.\n");
 		exit(1);
 	}
+	else if(!bMPFR)
+	{
+		result.toDouble();
+
+		double tmp = dlo;
+		result.dlo = div_down(1.0, dup);
+		result.dup = div_up(1.0, tmp);
+	}
 	else
 	{
+		result.toMPFR();
+
 		mpfr_t tmp;
 		mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
 		mpfr_set(tmp, lo, MPFR_RNDD);
@@ -639,18 +1378,19 @@ void Interval::rec(Interval & result) const
 
 void Interval::sqrt_assign()
 {
-	if(mpfr_sgn(lo) < 0)
-	{
-		printf("Exception: Square root of a negative number.\n");
-		exit(1);
-	}
-
-	mpfr_sqrt(lo, lo, MPFR_RNDD);
-	mpfr_sqrt(up, up, MPFR_RNDU);
+	sqrt(*this);
 }
 
 void Interval::inv_assign()
 {
+	if(!bMPFR)
+	{
+		double tmp = -dup;
+		dup = -dlo;
+		dlo = tmp;
+		return;
+	}
+
 	Interval result;
 	this->inv(result);
 	*this = result;
@@ -658,26 +1398,61 @@ void Interval::inv_assign()
 
 void Interval::rec_assign()
 {
-	Interval result;
-	this->rec(result);
-	*this = result;
+	rec(*this);
 }
 
 void Interval::add_assign(const double c)
 {
-	mpfr_add_d(lo, lo, c, MPFR_RNDD);
-	mpfr_add_d(up, up, c, MPFR_RNDU);
+	if(bMPFR)
+	{
+		mpfr_add_d(lo, lo, c, MPFR_RNDD);
+		mpfr_add_d(up, up, c, MPFR_RNDU);
+	}
+	else
+	{
+		dlo = add_down(dlo, c);
+		dup = add_up(dup, c);
+	}
 }
 
 void Interval::sub_assign(const double c)
 {
-	mpfr_sub_d(lo, lo, c, MPFR_RNDD);
-	mpfr_sub_d(up, up, c, MPFR_RNDU);
+	if(bMPFR)
+	{
+		mpfr_sub_d(lo, lo, c, MPFR_RNDD);
+		mpfr_sub_d(up, up, c, MPFR_RNDU);
+	}
+	else
+	{
+		dlo = sub_down(dlo, c);
+		dup = sub_up(dup, c);
+	}
 }
 
 void Interval::mul_assign(const double c)
 {
+	if(!bMPFR)
+	{
+		double newLo, newUp;
+
+		if(c > 0)
+		{
+			newLo = mul_down(dlo, c);
+			newUp = mul_up(dup, c);
+		}
+		else
+		{
+			newLo = mul_down(dup, c);
+			newUp = mul_up(dlo, c);
+		}
+
+		dlo = newLo;
+		dup = newUp;
+		return;
+	}
+
 	Interval result;
+	result.toMPFR();
 
 	if(c > 0)
 	{
@@ -695,7 +1470,28 @@ void Interval::mul_assign(const double c)
 
 void Interval::div_assign(const double c)
 {
+	if(!bMPFR)
+	{
+		double newLo, newUp;
+
+		if(c > 0)
+		{
+			newLo = div_down(dlo, c);
+			newUp = div_up(dup, c);
+		}
+		else
+		{
+			newLo = div_down(dup, c);
+			newUp = div_up(dlo, c);
+		}
+
+		dlo = newLo;
+		dup = newUp;
+		return;
+	}
+
 	Interval result;
+	result.toMPFR();
 
 	if(c > 0)
 	{
@@ -713,55 +1509,23 @@ void Interval::div_assign(const double c)
 
 Interval Interval::pow(const unsigned int n) const
 {
-	Interval result;
-
-	if(n % 2 == 1)		// n is odd
-	{
-		mpfr_pow_ui(result.lo, lo, n, MPFR_RNDD);		// a = lo^n
-		mpfr_pow_ui(result.up, up, n, MPFR_RNDU);		// b = up^n
-	}
-	else				// n is even
-	{
-		if(mpfr_cmp_si(lo, 0L) >= 0)			// 0 <= lo <= up
-		{
-			mpfr_pow_ui(result.lo, lo, n, MPFR_RNDD);		// a = lo^n
-			mpfr_pow_ui(result.up, up, n, MPFR_RNDU);		// b = up^n
-		}
-		else if(mpfr_cmp_si(up, 0L) <= 0)		// lo <= up <= 0
-		{
-			mpfr_pow_ui(result.lo, up, n, MPFR_RNDD);		// a = up^n
-			mpfr_pow_ui(result.up, lo, n, MPFR_RNDU);		// b = lo^n
-		}
-		else									// lo < 0 < up
-		{
-			mpfr_t tmp1, tmp2;
-			mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
-
-			mpfr_pow_ui(tmp1, lo, n, MPFR_RNDU);
-			mpfr_pow_ui(tmp2, up, n, MPFR_RNDU);
-
-			// set b = max ( lo^n , up^n )
-			if(mpfr_cmp(tmp1, tmp2) >= 0)
-			{
-				mpfr_set(result.up, tmp1, MPFR_RNDU);
-			}
-			else
-			{
-				mpfr_set(result.up, tmp2, MPFR_RNDU);
-			}
-
-			mpfr_clear(tmp1);
-			mpfr_clear(tmp2);
-		}
-	}
+	Interval result(*this);
+	result.pow_assign(n);
 
-	// return [a,b]
 	return result;
 }
 
 Interval Interval::exp() const
 {
+	if(!bMPFR)
+	{
+		Interval result(*this);		// evaluated by MPFR and rounded outward
+		result.exp_assign();
+		return result;
+	}
+
 	Interval result;
+	result.toMPFR();
 
 	mpfr_exp(result.lo, lo, MPFR_RNDD);
 	mpfr_exp(result.up, up, MPFR_RNDU);
@@ -771,6 +1535,13 @@ Interval Interval::exp() const
 
 Interval Interval::sin() const
 {
+	if(!bMPFR)
+	{
+		Interval result(*this);		// evaluated by MPFR and rounded outward
+		result.sin_assign();
+		return result;
+	}
+
 	mpfr_t pi_up, pi_lo, tmp_up, tmp_lo;
 	mpfr_inits2(intervalNumPrecision, pi_up, pi_lo, tmp_up, tmp_lo, (mpfr_ptr) 0);
 	mpfr_set_str(pi_up, str_pi_up, 10, MPFR_RNDU);
@@ -806,6 +1577,7 @@ Interval Interval::sin() const
 			modLo += 4;
 
 		Interval result;
+		result.toMPFR();
 		mpfr_t tmp1, tmp2;
 		mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
 
@@ -981,6 +1753,13 @@ Interval Interval::sin() const
 
 Interval Interval::cos() const
 {
+	if(!bMPFR)
+	{
+		Interval result(*this);		// evaluated by MPFR and rounded outward
+		result.cos_assign();
+		return result;
+	}
+
 	mpfr_t pi_up, pi_lo, tmp_up, tmp_lo;
 	mpfr_inits2(intervalNumPrecision, pi_up, pi_lo, tmp_up, tmp_lo, (mpfr_ptr) 0);
 	mpfr_set_str(pi_up, str_pi_up, 10, MPFR_RNDU);
@@ -1016,6 +1795,7 @@ Interval Interval::cos() const
 			modLo += 4;
 
 		Interval result;
+		result.toMPFR();
 		mpfr_t tmp1, tmp2;
 		mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
 
@@ -1191,6 +1971,13 @@ Interval Interval::cos() const
 
 Interval Interval::log() const
 {
+	if(!bMPFR)
+	{
+		Interval result(*this);		// evaluated by MPFR and rounded outward
+		result.log_assign();
+		return result;
+	}
+
 	if(mpfr_sgn(lo) <= 0)
 	{
 		printf("Exception: Logarithm of a non-positive number.\n");
@@ -1199,6 +1986,7 @@ Interval Interval::log() const
 	else
 	{
 		Interval result;
+		result.toMPFR();
 		mpfr_log(result.lo, lo, MPFR_RNDD);
 		mpfr_log(result.up, up, MPFR_RNDU);
 		return result;
@@ -1207,6 +1995,44 @@ Interval Interval::log() const
 
 void Interval::pow_assign(const unsigned int n)
 {
+	if(!bMPFR)
+	{
+		if(n % 2 == 1)		// n is odd
+		{
+			double newLo = dlo >= 0 ? pow_down(dlo, n) : -pow_up(-dlo, n);
+			double newUp = dup >= 0 ? pow_up(dup, n) : -pow_down(-dup, n);
+
+			dlo = newLo;
+			dup = newUp;
+		}
+		else				// n is even
+		{
+			if(dlo >= 0)					// 0 <= lo <= up
+			{
+				dlo = pow_down(dlo, n);
+				dup = pow_up(dup, n);
+			}
+			else if(dup <= 0)				// lo <= up <= 0
+			{
+				double newLo = pow_down(-dup, n);
+				double newUp = pow_up(-dlo, n);
+
+				dlo = newLo;
+				dup = newUp;
+			}
+			else							// lo < 0 < up
+			{
+				double tmp1 = pow_up(-dlo, n);
+				double tmp2 = pow_up(dup, n);
+
+				dup = tmp1 >= tmp2 ? tmp1 : tmp2;
+				dlo = 0;
+			}
+		}
+
+		return;
+	}
+
 	mpfr_t tmp1, tmp2;
 	mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
 
@@ -1255,12 +2081,28 @@ void Interval::pow_assign(const unsigned int n)
 
 void Interval::exp_assign()
 {
+	if(!bMPFR)
+	{
+		toMPFR();
+		exp_assign();
+		toDouble();
+		return;
+	}
+
 	mpfr_exp(lo, lo, MPFR_RNDD);
 	mpfr_exp(up, up, MPFR_RNDU);
 }
 
 void Interval::sin_assign()
 {
+	if(!bMPFR)
+	{
+		toMPFR();
+		sin_assign();
+		toDouble();
+		return;
+	}
+
 	mpfr_t pi_up, pi_lo, tmp_up, tmp_lo;
 	mpfr_inits2(intervalNumPrecision, pi_up, pi_lo, tmp_up, tmp_lo, (mpfr_ptr) 0);
 	mpfr_set_str(pi_up, str_pi_up, 10, MPFR_RNDU);
@@ -1296,6 +2138,7 @@ void Interval::sin_assign()
 			modLo += 4;
 
 		Interval result;
+		result.toMPFR();
 		mpfr_t tmp1, tmp2;
 		mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
 
@@ -1471,6 +2314,14 @@ void Interval::sin_assign()
 
 void Interval::cos_assign()
 {
+	if(!bMPFR)
+	{
+		toMPFR();
+		cos_assign();
+		toDouble();
+		return;
+	}
+
 	mpfr_t pi_up, pi_lo, tmp_up, tmp_lo;
 	mpfr_inits2(intervalNumPrecision, pi_up, pi_lo, tmp_up, tmp_lo, (mpfr_ptr) 0);
 	mpfr_set_str(pi_up, str_pi_up, 10, MPFR_RNDU);
@@ -1506,6 +2357,7 @@ void Interval::cos_assign()
 			modLo += 4;
 
 		Interval result;
+		result.toMPFR();
 		mpfr_t tmp1, tmp2;
 		mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
 
@@ -1681,6 +2533,14 @@ void Interval::cos_assign()
 
 void Interval::log_assign()
 {
+	if(!bMPFR)
+	{
+		toMPFR();
+		log_assign();
+		toDouble();
+		return;
+	}
+
 	if(mpfr_sgn(lo) <= 0)
 	{
 		printf("Exception: Logarithm of a non-positive number.\n");
@@ -1695,11 +2555,18 @@ void Interval::log_assign()
 
 double Interval::widthRatio(const Interval & I) const
 {
+	if(!bMPFR && !I.bMPFR)
+	{
+		return div_up(sub_up(I.dup, I.dlo), sub_up(dup, dlo));		// we assume that width1 >= width2
+	}
+
+	MPFRView A(*this), J(I);
+
 	mpfr_t width1, width2, ratio;
 	mpfr_inits2(intervalNumPrecision, width1, width2, ratio, (mpfr_ptr) 0);
 
-	mpfr_sub(width1, up, lo, MPFR_RNDU);
-	mpfr_sub(width2, I.up, I.lo, MPFR_RNDU);
+	mpfr_sub(width1, A.up, A.lo, MPFR_RNDU);
+	mpfr_sub(width2, J.up, J.lo, MPFR_RNDU);
 
 	mpfr_div(ratio, width2, width1, MPFR_RNDU);		// we assume that width1 >= width2
 
@@ -1714,6 +2581,14 @@ double Interval::widthRatio(const Interval & I) const
 
 void Interval::toString(string & result) const
 {
+	if(!bMPFR)
+	{
+		Interval I(*this);
+		I.toMPFR();
+		I.toString(result);
+		return;
+	}
+
 	char strTemp[30];
 
 	string strInt;
@@ -1737,6 +2612,14 @@ void Interval::toString(string & result) const
 
 void Interval::dump(FILE *fp) const
 {
+	if(!bMPFR)
+	{
+		Interval I(*this);
+		I.toMPFR();
+		I.dump(fp);
+		return;
+	}
+
 	fprintf (fp, "[");
 	mpfr_out_str(fp, 10, PN, lo, MPFR_RNDD);
 	fprintf(fp, " , ");
@@ -1746,6 +2629,14 @@ void Interval::dump(FILE *fp) const
 
 void Interval::output(FILE * fp, const char * msg, const char * msg2) const
 {
+	if(!bMPFR)
+	{
+		Interval I(*this);
+		I.toMPFR();
+		I.output(fp, msg, msg2);
+		return;
+	}
+
 	fprintf (fp, "%s [ ", msg);
 	mpfr_out_str(fp, 10, PN, lo, MPFR_RNDD);
 	fprintf(fp, " , ");
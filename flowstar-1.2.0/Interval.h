@@ -12,13 +12,28 @@
 
 #include "include.h"
 
-extern mpfr_prec_t intervalNumPrecision;
+extern __thread mpfr_prec_t intervalNumPrecision;		// kept per thread, the threads of an analysis share its setting
+
+/*
+ * An interval is represented by a pair of hardware doubles with outward rounding if intervalNumPrecision is not
+ * larger than 53, otherwise by a pair of MPFR numbers. The representation is selected when the interval is created.
+ * An operation involving an MPFR interval is done by MPFR, an operand in the double representation is read through an
+ * exact MPFR copy of its bounds and is never changed, so a shared interval can be read by several threads.
+ */
 
 class Interval
 {
 private:
 	mpfr_t lo;		// the lower bound
 	mpfr_t up;		// the upper bound
+	double dlo;		// the lower bound in the double representation
+	double dup;		// the upper bound in the double representation
+	bool bMPFR;		// true if the interval is represented by MPFR numbers
+
+	void toMPFR();		// switch to the MPFR representation
+	void toDouble();	// switch to the double representation, the bounds are rounded outward
+
+	friend class MPFRView;
 
 public:
 	Interval();
@@ -67,6 +82,7 @@ public:
 	bool subseteq(const Interval & I) const;	// returns true if the interval is a subset of I
 	bool supseteq(const Interval & I) const;	// returns true if the interval is a superset of I
 	bool valid() const;
+	bool intersect_assign(const Interval & I);		// returns false if the intersection is empty, the interval is then unchanged
 	bool operator == (const Interval & I) const;
 	bool operator != (const Interval & I) const;
 	bool operator > (const Interval & I) const;		// lo > up
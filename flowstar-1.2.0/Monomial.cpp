@@ -9,37 +9,91 @@
 
 #include "Monomial.h"
 
-double cutoff_threshold;
+__thread double cutoff_threshold;
 
-Monomial::Monomial()
+Monomial::Monomial():d(0), dim(0), bPacked(true)
 {
+	key[0] = key[1] = 0;
 }
 
-Monomial::Monomial(const Interval & I, const vector<int> & degs):coefficient(I), degrees(degs), d(0)
+Monomial::Monomial(const Interval & I, const vector<int> & degs):coefficient(I)
 {
-	for(int i=0; i<degs.size(); ++i)
+	pack(degs);
+}
+
+Monomial::Monomial(const Monomial & monomial): coefficient(monomial.coefficient), degrees(monomial.degrees), d(monomial.d), dim(monomial.dim), bPacked(monomial.bPacked)
+{
+	key[0] = monomial.key[0];
+	key[1] = monomial.key[1];
+}
+
+Monomial::Monomial(const Interval & I, const int numVars):coefficient(I), d(0), dim(numVars)
+{
+	key[0] = key[1] = 0;
+
+	if(numVars <= MONO_PACKED_VARS)
 	{
-		d += degs[i];
+		bPacked = true;
+	}
+	else
+	{
+		bPacked = false;
+		degrees.resize(numVars, 0);
 	}
 }
 
-Monomial::Monomial(const Monomial & monomial): coefficient(monomial.coefficient), degrees(monomial.degrees), d(monomial.d)
+Monomial::~Monomial()
 {
+	degrees.clear();
 }
 
-Monomial::Monomial(const Interval & I, const int numVars):d(0)
+void Monomial::pack(const vector<int> & degs)
 {
-	for(int i=0; i<numVars; ++i)
+	dim = degs.size();
+	d = 0;
+
+	for(int i=0; i<dim; ++i)
 	{
-		degrees.push_back(0);
+		d += degs[i];
 	}
 
-	coefficient = I;
+	key[0] = key[1] = 0;
+
+	if(dim <= MONO_PACKED_VARS && d <= MONO_FIELD_MAX)
+	{
+		key[0] = ((unsigned long long)d) << ((MONO_FIELDS_PER_KEY - 1) * MONO_FIELD_BITS);
+
+		for(int i=0; i<dim; ++i)
+		{
+			int field = i + 1;
+			key[field / MONO_FIELDS_PER_KEY] |= ((unsigned long long)degs[i]) << ((MONO_FIELDS_PER_KEY - 1 - field % MONO_FIELDS_PER_KEY) * MONO_FIELD_BITS);
+		}
+
+		bPacked = true;
+		degrees.clear();
+	}
+	else
+	{
+		bPacked = false;
+		degrees = degs;
+	}
 }
 
-Monomial::~Monomial()
+void Monomial::unpack()
 {
-	degrees.clear();
+	if(!bPacked)
+		return;
+
+	vector<int> degs(dim);
+
+	for(int i=0; i<dim; ++i)
+	{
+		degs[i] = getDegree(i);
+	}
+
+	degrees = degs;
+	bPacked = false;
+	key[0] = key[1] = 0;
 }
 
 int Monomial::degree() const
@@ -49,17 +103,57 @@ int Monomial::degree() const
 
 int Monomial::dimension() const
 {
-	return degrees.size();
+	return dim;
+}
+
+int Monomial::getDegree(const int varIndex) const
+{
+	if(bPacked)
+	{
+		int field = varIndex + 1;
+		return (int)((key[field / MONO_FIELDS_PER_KEY] >> ((MONO_FIELDS_PER_KEY - 1 - field % MONO_FIELDS_PER_KEY) * MONO_FIELD_BITS)) & MONO_FIELD_MAX);
+	}
+	else
+	{
+		return degrees[varIndex];
+	}
+}
+
+void Monomial::addDegree(const int varIndex, const int deg)
+{
+	if(bPacked && d + deg > MONO_FIELD_MAX)
+	{
+		unpack();
+	}
+
+	if(bPacked)
+	{
+		int field = varIndex + 1;
+
+		// the fields never become negative, so the carries of a negative deg cancel out
+		key[field / MONO_FIELDS_PER_KEY] += ((unsigned long long)(long long)deg) << ((MONO_FIELDS_PER_KEY - 1 - field % MONO_FIELDS_PER_KEY) * MONO_FIELD_BITS);
+		key[0] += ((unsigned long long)(long long)deg) << ((MONO_FIELDS_PER_KEY - 1) * MONO_FIELD_BITS);
+	}
+	else
+	{
+		degrees[varIndex] += deg;
+	}
+
+	d += deg;
 }
 
 void Monomial::intEval(Interval & result, const vector<Interval> & domain) const
 {
 	result = coefficient;
 
-	for(int i=0; i<degrees.size(); ++i)
+	for(int i=0; i<dim; ++i)
 	{
+		int deg = getDegree(i);
+		if(deg == 0)
+			continue;
+
 		Interval tmpI(1,1);
-		for(int j=0; j<degrees[i]; ++j)
+		for(int j=0; j<deg; ++j)
 		{
 			tmpI *= domain[i];
 		}
@@ -72,23 +166,25 @@ void Monomial::intEvalNormal(Interval & result, const vector<Interval> & step_ex
 	Interval intZero;
 	result = intZero;
 
-	if(degrees.size() == 0)
+	if(dim == 0)
 		return;
 
 	result = coefficient;
-	result *= step_exp_table[degrees[0]];
+	result *= step_exp_table[getDegree(0)];
 
 	Interval evenInt(0,1), oddInt(-1,1);
 	Interval intFactor(1);
 	bool bSet = false;
 
-	for(int i=1; i<degrees.size(); ++i)
+	for(int i=1; i<dim; ++i)
 	{
-		if(degrees[i] == 0)			// degree is zero
+		int deg = getDegree(i);
+
+		if(deg == 0)			// degree is zero
 		{
 			continue;
 		}
-		else if(degrees[i]%2 == 0)	// degree is an even number
+		else if(deg%2 == 0)	// degree is an even number
 		{
 			if(!bSet)
 			{
@@ -118,8 +214,12 @@ Monomial & Monomial::operator = (const Monomial & monomial)
 		return *this;
 
 	coefficient = monomial.coefficient;
+	key[0] = monomial.key[0];
+	key[1] = monomial.key[1];
 	degrees = monomial.degrees;
 	d = monomial.d;
+	dim = monomial.dim;
+	bPacked = monomial.bPacked;
 
 	return *this;
 }
@@ -134,9 +234,19 @@ Monomial & Monomial::operator *= (const Monomial & monomial)
 {
 	coefficient *= monomial.coefficient;
 
-	for(int i=0; i<degrees.size(); ++i)
+	if(bPacked && monomial.bPacked && d + monomial.d <= MONO_FIELD_MAX)
+	{
+		key[0] += monomial.key[0];
+		key[1] += monomial.key[1];
+	}
+	else
 	{
-		degrees[i] += monomial.degrees[i];
+		unpack();
+
+		for(int i=0; i<dim; ++i)
+		{
+			degrees[i] += monomial.getDegree(i);
+		}
 	}
 
 	d += monomial.d;
@@ -161,9 +271,9 @@ bool Monomial::isLinear(int & index) const
 {
 	if(d == 1)
 	{
-		for(int i=0; i<degrees.size(); ++i)
+		for(int i=0; i<dim; ++i)
 		{
-			if(degrees[i] == 1)
+			if(getDegree(i) == 1)
 			{
 				index = i;
 				return true;
@@ -178,24 +288,18 @@ void Monomial::dump_interval(FILE *fp, const vector<string> & varNames) const
 {
 	coefficient.dump(fp);
 
-	for(int i=0; i<degrees.size()-1; i++)
+	for(int i=0; i<dim; i++)
 	{
-		if(degrees[i] != 0)
+		int deg = getDegree(i);
+
+		if(deg != 0)
 		{
-			if(degrees[i] == 1)
+			if(deg == 1)
 				fprintf(fp, " * %s", varNames[i].c_str());
 			else
-				fprintf(fp, " * %s^%d", varNames[i].c_str(), degrees[i]);
+				fprintf(fp, " * %s^%d", varNames[i].c_str(), deg);
 		}
 	}
-
-	if(degrees[degrees.size()-1] != 0)
-	{
-		if(degrees[degrees.size()-1] == 1)
-			fprintf(fp, " * %s", varNames[degrees.size()-1].c_str());
-		else
-			fprintf(fp, " * %s^%d", varNames[degrees.size()-1].c_str(), degrees[degrees.size()-1]);
-	}
 }
 
 void Monomial::dump_constant(FILE *fp, const vector<string> & varNames) const
@@ -203,24 +307,18 @@ void Monomial::dump_constant(FILE *fp, const vector<string> & varNames) const
 	double c = coefficient.sup();
 	fprintf(fp, "(%lf)", c);
 
-	for(int i=0; i<degrees.size()-1; i++)
+	for(int i=0; i<dim; i++)
 	{
-		if(degrees[i] != 0)
+		int deg = getDegree(i);
+
+		if(deg != 0)
 		{
-			if(degrees[i] == 1)
+			if(deg == 1)
 				fprintf(fp, " * %s", varNames[i].c_str());
 			else
-				fprintf(fp, " * %s^%d", varNames[i].c_str(), degrees[i]);
+				fprintf(fp, " * %s^%d", varNames[i].c_str(), deg);
 		}
 	}
-
-	if(degrees[degrees.size()-1] != 0)
-	{
-		if(degrees[degrees.size()-1] == 1)
-			fprintf(fp, " * %s", varNames[degrees.size()-1].c_str());
-		else
-			fprintf(fp, " * %s^%d", varNames[degrees.size()-1].c_str(), degrees[degrees.size()-1]);
-	}
 }
 
 void Monomial::toString(string & result, const vector<string> & varNames) const
@@ -233,11 +331,13 @@ void Monomial::toString(string & result, const vector<string> & varNames) const
 	coefficient.toString(strInt);
 	strMono += strInt;
 
-	for(int i=0; i<degrees.size(); i++)
+	for(int i=0; i<dim; i++)
 	{
-		if(degrees[i] != 0)
+		int deg = getDegree(i);
+
+		if(deg != 0)
 		{
-			if(degrees[i] == 1)
+			if(deg == 1)
 			{
 				strMono += ' ';
 				strMono += '*';
@@ -253,7 +353,7 @@ void Monomial::toString(string & result, const vector<string> & varNames) const
 				strMono += '^';
 
 				char strNum[NUM_LENGTH];
-				sprintf(strNum, "%d", degrees[i]);
+				sprintf(strNum, "%d", deg);
 				string num(strNum);
 				strMono += num;
 			}
@@ -269,8 +369,8 @@ bool Monomial::classInvariantOK() const
 {
 	int sum = 0;
 
-	for(int i = 0; i<degrees.size(); ++i)
-		sum += degrees[i];
+	for(int i = 0; i<dim; ++i)
+		sum += getDegree(i);
 	return (sum == d);
 }
 
@@ -311,11 +411,15 @@ bool Monomial::cutoff()
 
 bool operator == (const Monomial & a, const Monomial & b)
 {
-	if (a.d == b.d)
+	if(a.bPacked && b.bPacked)
 	{
-		for(int i=0; i<a.degrees.size(); i++)
+		return a.key[0] == b.key[0] && a.key[1] == b.key[1];
+	}
+	else if (a.d == b.d)
+	{
+		for(int i=0; i<a.dim; i++)
 		{
-			if(a.degrees[i] != b.degrees[i])
+			if(a.getDegree(i) != b.getDegree(i))
 				return false;
 		}
 		return true;	// The two monomials are identical without considering the coefficients.
@@ -326,17 +430,24 @@ bool operator == (const Monomial & a, const Monomial & b)
 
 bool operator < (const Monomial & a, const Monomial & b)
 {
-	if(a.d < b.d)
+	if(a.bPacked && b.bPacked)
+	{
+		// the total degrees are in the most significant fields
+		return a.key[0] < b.key[0] || (a.key[0] == b.key[0] && a.key[1] < b.key[1]);
+	}
+	else if(a.d < b.d)
 		return true;
 	else if(a.d > b.d)
 		return false;
 	else	// a.d == b.d
 	{
-		for(int i=0; i<a.degrees.size(); ++i)
+		for(int i=0; i<a.dim; ++i)
 		{
-			if(a.degrees[i] < b.degrees[i])
+			int degA = a.getDegree(i), degB = b.getDegree(i);
+
+			if(degA < degB)
 				return true;
-			else if(a.degrees[i] > b.degrees[i])
+			else if(degA > degB)
 				return false;
 		}
 	}
@@ -12,14 +12,32 @@
 
 #include "Interval.h"
 
-extern double cutoff_threshold;
+extern __thread double cutoff_threshold;			// kept per thread like intervalNumPrecision
+
+/*
+ * The degrees of a monomial are packed into two 64-bit words of 8-bit fields. The first field holds the total degree
+ * and the i-th variable is in the (i+1)-th field, so that comparing the words as unsigned integers is the same as the
+ * graded order, and multiplying two monomials is adding their words. If there are more than MONO_PACKED_VARS
+ * variables or the total degree is larger than MONO_FIELD_MAX, the degrees are kept in a vector instead.
+ */
+
+#define MONO_FIELD_BITS		8
+#define MONO_FIELD_MAX		255
+#define MONO_FIELDS_PER_KEY	8
+#define MONO_PACKED_VARS	15
 
 class Monomial
 {
 private:
 	Interval coefficient;		// the coefficient of the monomial
-	vector<int> degrees;		// the degrees of the variables, e.g., [2,0,4] is the notation for x1^2 x3^4
-	int d;			        	// the degree of the monomial, it is the sum of the values in degrees.
+	unsigned long long key[2];	// the packed degrees
+	vector<int> degrees;		// the degrees of the variables if they are not packed, e.g., [2,0,4] is the notation for x1^2 x3^4
+	int d;			        	// the degree of the monomial, it is the sum of the degrees of the variables.
+	int dim;					// the number of the variables
+	bool bPacked;				// true if the degrees are packed
+
+	void pack(const vector<int> & degs);
+	void unpack();
 
 public:
 	Monomial();													// empty monomial.
@@ -31,6 +49,9 @@ public:
 	int degree() const;											// degree of the monomial
 	int dimension() const;										// dimension of the monomial
 
+	int getDegree(const int varIndex) const;					// degree of a variable
+	void addDegree(const int varIndex, const int deg);			// add deg to the degree of a variable, deg could be negative
+
 	void intEval(Interval & result, const vector<Interval> & domain) const;	// interval evaluation of the monomial
 
 	// interval evaluation of the monomial, we assume that the domain is normalized to [0,s] x [-1,1]^(d-1)
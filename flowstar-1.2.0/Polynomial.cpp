@@ -10,77 +10,8 @@
 #include "Polynomial.h"
 #include "TaylorModel.h"
 
-vector<Interval> factorial_rec;
-vector<Interval> power_4;
-vector<Interval> double_factorial;
-
-RangeTree::RangeTree()
-{
-}
-
-RangeTree::RangeTree(const list<Interval> & ranges_input, const list<RangeTree *> & children_input)
-{
-	ranges = ranges_input;
-	children = children_input;
-}
-
-RangeTree::RangeTree(const RangeTree & tree)
-{
-	ranges = tree.ranges;
-	children = tree.children;
-}
-
-RangeTree::~RangeTree()
-{
-	list<RangeTree *>::iterator iter = children.begin();
-
-	for(; iter!=children.end(); ++iter)
-	{
-		delete *iter;
-	}
-
-	ranges.clear();
-	children.clear();
-}
-
-RangeTree & RangeTree::operator = (const RangeTree & tree)
-{
-	if(this == &tree)
-		return *this;
-
-	ranges = tree.ranges;
-	children = tree.children;
-
-	return *this;
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+FactorialTables defaultFactorialTables;
+__thread FactorialTables *factorialTables = &defaultFactorialTables;
 
 // class HornerForm
 
@@ -124,6 +55,68 @@ void HornerForm::intEval(Interval & result, const vector<Interval> & domain) con
 	}
 }
 
+bool HornerForm::contract(vector<Interval> & domain, const Interval & range) const
+{
+	int n = hornerForms.size();
+
+	// forward: the ranges of the parts (...)*xi and of their partial sums
+	vector<Interval> factors(n);
+	vector<Interval> terms(n);
+	vector<Interval> prefix(n+1);
+
+	prefix[0] = constant;
+
+	for(int i=0; i<n; ++i)
+	{
+		hornerForms[i].intEval(factors[i], domain);
+		terms[i] = factors[i] * domain[i];
+		prefix[i+1] = prefix[i] + terms[i];
+	}
+
+	Interval target = prefix[n];
+
+	if(!target.intersect_assign(range))
+	{
+		return false;
+	}
+
+	// backward: a part lies in the target minus the other parts
+	Interval intZero;
+	Interval suffix;
+
+	for(int i=n-1; i>=0; --i)
+	{
+		if(!hornerForms[i].isZero())
+		{
+			Interval part = target - prefix[i] - suffix;
+
+			if(!intZero.subseteq(factors[i]))
+			{
+				Interval X = part / factors[i];
+
+				if(!domain[i].intersect_assign(X))
+				{
+					return false;
+				}
+			}
+
+			if(!intZero.subseteq(domain[i]))
+			{
+				Interval F = part / domain[i];
+
+				if(!hornerForms[i].contract(domain, F))
+				{
+					return false;
+				}
+			}
+		}
+
+		suffix += terms[i];
+	}
+
+	return true;
+}
+
 void HornerForm::insert(TaylorModel & result, const TaylorModelVec & vars, const vector<Interval> & varsPolyRange, const vector<Interval> & domain) const
 {
 	Interval intZero;
@@ -309,142 +302,375 @@ void HornerForm::insert_ctrunc_normal(TaylorModel & result, const TaylorModelVec
 	}
 }
 
-void HornerForm::insert_ctrunc_normal(TaylorModel & result, RangeTree * & tree, const TaylorModelVec & vars, const vector<Interval> & varsPolyRange, const vector<Interval> & step_exp_table, const int numVars, const int order) const
+void HornerForm::dump(FILE *fp, const vector<string> & varNames) const
 {
+	int numVars = hornerForms.size();
+
 	Interval intZero;
-	result.clear();
+	bool bPlus = false;
 
+	fprintf(fp, " ( ");
 	if(!constant.subseteq(intZero))
 	{
-		TaylorModel tmConstant(constant, numVars);
-		result = tmConstant;
+		bPlus = true;
+		constant.dump(fp);
 	}
 
-	RangeTree *pnode = new RangeTree;
+	if(numVars == 0)
+	{
+		fprintf(fp, " ) ");
+		return;
+	}
 
-	if(hornerForms.size() > 0)						// the first variable is t
+	for(int i=0; i<numVars; ++i)
 	{
-		TaylorModel tmTemp;
-		RangeTree *child;
+		if(hornerForms[i].hornerForms.size() != 0 || !hornerForms[i].constant.subseteq(intZero))
+		{
+			if(bPlus)		// only used to print the "+" symbol
+				fprintf(fp, " + ");
+			else
+				bPlus = true;
 
-		hornerForms[0].insert_ctrunc_normal(tmTemp, child, vars, varsPolyRange, step_exp_table, numVars, order);
+			hornerForms[i].dump(fp, varNames);
+			fprintf(fp, "* %s", varNames[i].c_str());
+		}
+	}
 
-		tmTemp.expansion.mul_assign(0,1);			// multiplied by t
-		tmTemp.remainder *= step_exp_table[1];
+	fprintf(fp, " ) ");
+}
 
-		Interval intTrunc;
-		tmTemp.expansion.ctrunc_normal(intTrunc, step_exp_table, order);
-		tmTemp.remainder += intTrunc;
+HornerForm & HornerForm::operator = (const HornerForm & hf)
+{
+	if(this == &hf)
+		return *this;
 
-		pnode->ranges.push_back(intTrunc);
-		pnode->children.push_back(child);
+	constant = hf.constant;
+	hornerForms = hf.hornerForms;
+	return *this;
+}
 
-		result.add_assign(tmTemp);
+bool HornerForm::isZero() const
+{
+	Interval intZero;
 
-		for(int i=1; i<hornerForms.size(); ++i)
-		{
-			TaylorModel tmTemp;
-			RangeTree *child;
+	if(!constant.subseteq(intZero))
+		return false;
 
-			hornerForms[i].insert_ctrunc_normal(tmTemp, child, vars, varsPolyRange, step_exp_table, numVars, order);	// recursive call
+	for(int i=0; i<hornerForms.size(); ++i)
+	{
+		if(!hornerForms[i].isZero())
+			return false;
+	}
 
-			Interval tm1, intTrunc2;
-			tmTemp.mul_insert_ctrunc_normal_assign(tm1, intTrunc2, vars.tms[i-1], varsPolyRange[i-1], step_exp_table, order); 	// here coefficient_range = tm1
+	return true;
+}
 
-			pnode->ranges.push_back(tm1);
-			pnode->ranges.push_back(varsPolyRange[i-1]);
-			pnode->ranges.push_back(intTrunc2);
-			pnode->children.push_back(child);
+void HornerForm::toTape(HornerTape & result) const
+{
+	result.clear();
+	compile(result, 0);
+}
 
-			result.add_assign(tmTemp);
+void HornerForm::compile(HornerTape & tape, const int reg) const
+{
+	Interval intZero;
+
+	if(constant.subseteq(intZero))
+	{
+		tape.code.push_back(HornerInstruction(HORNER_ZERO, reg, 0, 0, 0));
+	}
+	else
+	{
+		tape.code.push_back(HornerInstruction(HORNER_CONST, reg, 0, tape.constants.size(), 0));
+		tape.constants.push_back(constant);
+	}
+
+	if(tape.numRegisters < reg+1)
+		tape.numRegisters = reg+1;
+
+	for(int i=0; i<hornerForms.size(); ++i)
+	{
+		const HornerForm & child = hornerForms[i];
+
+		if(child.isZero())
+			continue;		// it adds nothing
+
+		bool bConstant = true;
+		for(int j=0; j<child.hornerForms.size(); ++j)
+		{
+			if(!child.hornerForms[j].isZero())
+			{
+				bConstant = false;
+				break;
+			}
+		}
+
+		if(bConstant)
+		{
+			tape.code.push_back(HornerInstruction(HORNER_CONST_MUL_ADD, reg, reg+1, tape.constants.size(), i));
+			tape.constants.push_back(child.constant);
 		}
+		else
+		{
+			child.compile(tape, reg+1);
+			tape.code.push_back(HornerInstruction(HORNER_MUL_ADD, reg, reg+1, 0, i));
+		}
+
+		if(tape.numRegisters < reg+2)
+			tape.numRegisters = reg+2;
 	}
+}
+
+
+
+
+
+
+
+
+
+
+
+// class HornerInstruction
 
-	tree = pnode;
+HornerInstruction::HornerInstruction():opcode(HORNER_ZERO), dst(0), src(0), constant(0), var(0)
+{
 }
 
-void HornerForm::insert_only_remainder(Interval & result, RangeTree *tree, const TaylorModelVec & vars, const Interval & timeStep) const
+HornerInstruction::HornerInstruction(const int opcode_input, const int dst_input, const int src_input, const int constant_input, const int var_input):
+	opcode(opcode_input), dst(dst_input), src(src_input), constant(constant_input), var(var_input)
 {
-	Interval intZero;
+}
 
-	result = intZero;
-	list<Interval>::const_iterator iter = tree->ranges.begin();
-	list<RangeTree *>::const_iterator child = tree->children.begin();
+HornerInstruction::HornerInstruction(const HornerInstruction & instruction):opcode(instruction.opcode), dst(instruction.dst),
+	src(instruction.src), constant(instruction.constant), var(instruction.var)
+{
+}
 
-	if(hornerForms.size() > 0)						// the first variable is t
-	{
-		Interval intTemp;
-		hornerForms[0].insert_only_remainder(intTemp, *child, vars, timeStep);
-		intTemp *= timeStep;
+HornerInstruction::~HornerInstruction()
+{
+}
 
-		intTemp += (*iter);
-		result += intTemp;
+HornerInstruction & HornerInstruction::operator = (const HornerInstruction & instruction)
+{
+	if(this == &instruction)
+		return *this;
 
-		++iter;
-		++child;
+	opcode = instruction.opcode;
+	dst = instruction.dst;
+	src = instruction.src;
+	constant = instruction.constant;
+	var = instruction.var;
+	return *this;
+}
 
-		for(int i=1; i<hornerForms.size(); ++i,++child)
-		{
-			Interval intTemp2;
-			hornerForms[i].insert_only_remainder(intTemp2, *child, vars, timeStep);
 
-			Interval newRemainder = (*iter) * vars.tms[i-1].remainder;
-			++iter;
-			newRemainder += (*iter) * intTemp2;
-			newRemainder += vars.tms[i-1].remainder * intTemp2;
-			++iter;
-			newRemainder += (*iter);
 
-			result += newRemainder;
-			++iter;
+
+
+
+
+
+
+
+// class HornerTape
+
+HornerTape::HornerTape():numRegisters(0)
+{
+}
+
+HornerTape::HornerTape(const HornerForm & hf):numRegisters(0)
+{
+	hf.toTape(*this);
+}
+
+HornerTape::HornerTape(const HornerTape & tape):code(tape.code), constants(tape.constants), numRegisters(tape.numRegisters)
+{
+}
+
+HornerTape::~HornerTape()
+{
+	code.clear();
+	constants.clear();
+}
+
+void HornerTape::clear()
+{
+	code.clear();
+	constants.clear();
+	numRegisters = 0;
+}
+
+void HornerTape::intEval(Interval & result, const vector<Interval> & domain) const
+{
+	vector<Interval> registers;
+	intEval(result, domain, registers);
+}
+
+void HornerTape::intEval(Interval & result, const vector<Interval> & domain, vector<Interval> & registers) const
+{
+	if(code.size() == 0)
+	{
+		result.set(0,0);
+		return;
+	}
+
+	if(registers.size() < numRegisters)
+	{
+		registers.resize(numRegisters);
+	}
+
+	for(int i=0; i<code.size(); ++i)
+	{
+		const HornerInstruction & ins = code[i];
+
+		switch(ins.opcode)
+		{
+		case HORNER_CONST:
+			registers[ins.dst] = constants[ins.constant];
+			break;
+		case HORNER_ZERO:
+			registers[ins.dst].set(0,0);
+			break;
+		case HORNER_MUL_ADD:
+			registers[ins.src] *= domain[ins.var];
+			registers[ins.dst] += registers[ins.src];
+			break;
+		case HORNER_CONST_MUL_ADD:
+			registers[ins.src] = constants[ins.constant];
+			registers[ins.src] *= domain[ins.var];
+			registers[ins.dst] += registers[ins.src];
+			break;
 		}
 	}
+
+	result = registers[0];
 }
 
-void HornerForm::dump(FILE *fp, const vector<string> & varNames) const
+void HornerTape::insert_ctrunc_normal(TaylorModel & result, vector<Interval> & ranges, const TaylorModelVec & vars, const vector<Interval> & varsPolyRange, const vector<Interval> & step_exp_table, const int numVars, const int order) const
 {
-	int numVars = hornerForms.size();
+	ranges.clear();
 
-	Interval intZero;
-	bool bPlus = false;
+	if(code.size() == 0)
+	{
+		result.clear();
+		return;
+	}
 
-	fprintf(fp, " ( ");
-	if(!constant.subseteq(intZero))
+	vector<TaylorModel> registers(numRegisters);
+
+	for(int i=0; i<code.size(); ++i)
 	{
-		bPlus = true;
-		constant.dump(fp);
+		const HornerInstruction & ins = code[i];
+
+		if(ins.opcode == HORNER_CONST)
+		{
+			registers[ins.dst] = TaylorModel(constants[ins.constant], numVars);
+			continue;
+		}
+		else if(ins.opcode == HORNER_ZERO)
+		{
+			registers[ins.dst].clear();
+			continue;
+		}
+		else if(ins.opcode == HORNER_CONST_MUL_ADD)
+		{
+			registers[ins.src] = TaylorModel(constants[ins.constant], numVars);
+		}
+
+		TaylorModel & tmTemp = registers[ins.src];
+
+		if(ins.var == 0)							// the first variable is t
+		{
+			tmTemp.expansion.mul_assign(0,1);		// multiplied by t
+			tmTemp.remainder *= step_exp_table[1];
+
+			Interval intTrunc;
+			tmTemp.expansion.ctrunc_normal(intTrunc, step_exp_table, order);
+			tmTemp.remainder += intTrunc;
+
+			ranges.push_back(intTrunc);
+		}
+		else
+		{
+			Interval tm1, intTrunc2;
+			tmTemp.mul_insert_ctrunc_normal_assign(tm1, intTrunc2, vars.tms[ins.var-1], varsPolyRange[ins.var-1], step_exp_table, order); 	// here coefficient_range = tm1
+
+			ranges.push_back(tm1);
+			ranges.push_back(varsPolyRange[ins.var-1]);
+			ranges.push_back(intTrunc2);
+		}
+
+		registers[ins.dst].add_assign(tmTemp);
 	}
 
-	if(numVars == 0)
+	result = registers[0];
+}
+
+void HornerTape::insert_only_remainder(Interval & result, const vector<Interval> & ranges, const TaylorModelVec & vars, const Interval & timeStep, vector<Interval> & registers) const
+{
+	if(code.size() == 0)
 	{
-		fprintf(fp, " ) ");
+		result.set(0,0);
 		return;
 	}
 
-	for(int i=0; i<numVars; ++i)
+	if(registers.size() < numRegisters)
 	{
-		if(hornerForms[i].hornerForms.size() != 0 || !hornerForms[i].constant.subseteq(intZero))
+		registers.resize(numRegisters);
+	}
+
+	int k = 0;
+
+	for(int i=0; i<code.size(); ++i)
+	{
+		const HornerInstruction & ins = code[i];
+
+		if(ins.opcode == HORNER_CONST || ins.opcode == HORNER_ZERO)
 		{
-			if(bPlus)		// only used to print the "+" symbol
-				fprintf(fp, " + ");
-			else
-				bPlus = true;
+			registers[ins.dst].set(0,0);		// a constant has no remainder
+			continue;
+		}
+		else if(ins.opcode == HORNER_CONST_MUL_ADD)
+		{
+			registers[ins.src].set(0,0);
+		}
 
-			hornerForms[i].dump(fp, varNames);
-			fprintf(fp, "* %s", varNames[i].c_str());
+		Interval & intTemp = registers[ins.src];
+
+		if(ins.var == 0)							// the first variable is t
+		{
+			intTemp *= timeStep;
+			intTemp += ranges[k];
+			++k;
+
+			registers[ins.dst] += intTemp;
+		}
+		else
+		{
+			const Interval & remainder = vars.tms[ins.var-1].remainder;
+
+			Interval newRemainder = ranges[k] * remainder;
+			newRemainder += ranges[k+1] * intTemp;
+			newRemainder += remainder * intTemp;
+			newRemainder += ranges[k+2];
+			k += 3;
+
+			registers[ins.dst] += newRemainder;
 		}
 	}
 
-	fprintf(fp, " ) ");
+	result = registers[0];
 }
 
-HornerForm & HornerForm::operator = (const HornerForm & hf)
+HornerTape & HornerTape::operator = (const HornerTape & tape)
 {
-	if(this == &hf)
+	if(this == &tape)
 		return *this;
 
-	constant = hf.constant;
-	hornerForms = hf.hornerForms;
+	code = tape.code;
+	constants = tape.constants;
+	numRegisters = tape.numRegisters;
 	return *this;
 }
 
@@ -511,8 +737,7 @@ Polynomial::Polynomial(const RowVector & coefficients)
 
 		Interval intTemp(dTemp);
 		Monomial monoTemp(intTemp, numVars);
-		monoTemp.degrees[i] = 1;
-		monoTemp.d = 1;
+		monoTemp.addDegree(i, 1);
 		monomials.push_back(monoTemp);
 	}
 
@@ -530,8 +755,7 @@ Polynomial::Polynomial(const vector<Interval> & coefficients)
 			continue;
 
 		Monomial monoTemp(coefficients[i], numVars);
-		monoTemp.degrees[i] = 1;
-		monoTemp.d = 1;
+		monoTemp.addDegree(i, 1);
 		monomials.push_back(monoTemp);
 	}
 
@@ -543,7 +767,12 @@ Polynomial::Polynomial(const Monomial & monomial)
 	monomials.push_back(monomial);
 }
 
-Polynomial::Polynomial(const list<Monomial> & monos):monomials(monos)
+Polynomial::Polynomial(const list<Monomial> & monos):monomials(monos.begin(), monos.end())
+{
+	reorder();
+}
+
+Polynomial::Polynomial(const vector<Monomial> & monos):monomials(monos)
 {
 	reorder();
 }
@@ -559,7 +788,7 @@ Polynomial::~Polynomial()
 
 void Polynomial::reorder()
 {
-	monomials.sort();
+	stable_sort(monomials.begin(), monomials.end());
 }
 
 void Polynomial::clear()
@@ -575,7 +804,7 @@ void Polynomial::dump_interval(FILE *fp, const vector<string> & varNames) const
 		return;
 	}
 
-	list<Monomial>::const_iterator iter, iter_last;
+	vector<Monomial>::const_iterator iter, iter_last;
 	iter_last = monomials.end();
 	--iter_last;
 
@@ -596,7 +825,7 @@ void Polynomial::dump_constant(FILE *fp, const vector<string> & varNames) const
 		return;
 	}
 
-	list<Monomial>::const_iterator iter, iter_last;
+	vector<Monomial>::const_iterator iter, iter_last;
 	iter_last = monomials.end();
 	--iter_last;
 
@@ -609,6 +838,151 @@ void Polynomial::dump_constant(FILE *fp, const vector<string> & varNames) const
 	monomials.back().dump_constant(fp, varNames);
 }
 
+void Polynomial::dump_binary(FILE *fp, const int numVars) const
+{
+	unsigned int numTerms = monomials.size();
+	unsigned int bPacked = 1;
+
+	for(int i=0; i<numTerms; ++i)
+	{
+		if(!monomials[i].bPacked)
+		{
+			bPacked = 0;
+			break;
+		}
+	}
+
+	fwrite(&numTerms, sizeof(unsigned int), 1, fp);
+	fwrite(&bPacked, sizeof(unsigned int), 1, fp);
+
+	if(numTerms == 0)
+	{
+		return;
+	}
+
+	if(bPacked)
+	{
+		vector<unsigned long long> keys(2*numTerms);
+
+		for(int i=0; i<numTerms; ++i)
+		{
+			keys[2*i] = monomials[i].key[0];
+			keys[2*i+1] = monomials[i].key[1];
+		}
+
+		fwrite(&keys[0], sizeof(unsigned long long), keys.size(), fp);
+	}
+	else
+	{
+		vector<int> degrees(numTerms*numVars);
+
+		for(int i=0; i<numTerms; ++i)
+		{
+			for(int j=0; j<numVars; ++j)
+			{
+				degrees[i*numVars + j] = monomials[i].getDegree(j);
+			}
+		}
+
+		fwrite(&degrees[0], sizeof(int), degrees.size(), fp);
+	}
+
+	vector<double> bounds(numTerms);
+
+	for(int i=0; i<numTerms; ++i)
+	{
+		bounds[i] = monomials[i].coefficient.inf();
+	}
+
+	fwrite(&bounds[0], sizeof(double), numTerms, fp);
+
+	for(int i=0; i<numTerms; ++i)
+	{
+		bounds[i] = monomials[i].coefficient.sup();
+	}
+
+	fwrite(&bounds[0], sizeof(double), numTerms, fp);
+}
+
+bool Polynomial::load_binary(const char * & p, const char *end, const int numVars)
+{
+	unsigned int numTerms, bPacked;
+
+	if(!read_binary(&numTerms, sizeof(unsigned int), p, end) || !read_binary(&bPacked, sizeof(unsigned int), p, end))
+	{
+		return false;
+	}
+
+	monomials.clear();
+
+	if(numTerms == 0)
+	{
+		return true;
+	}
+
+	if(numTerms > (end - p) / (2*sizeof(double)))
+	{
+		return false;
+	}
+
+	monomials.resize(numTerms);
+
+	if(bPacked)
+	{
+		if(numVars > MONO_PACKED_VARS)
+		{
+			return false;
+		}
+
+		vector<unsigned long long> keys(2*numTerms);
+
+		if(!read_binary(&keys[0], keys.size()*sizeof(unsigned long long), p, end))
+		{
+			return false;
+		}
+
+		for(int i=0; i<numTerms; ++i)
+		{
+			Monomial & monomial = monomials[i];
+			monomial.key[0] = keys[2*i];
+			monomial.key[1] = keys[2*i+1];
+			monomial.d = (int)(keys[2*i] >> ((MONO_FIELDS_PER_KEY - 1) * MONO_FIELD_BITS));
+			monomial.dim = numVars;
+			monomial.bPacked = true;
+			monomial.degrees.clear();
+		}
+	}
+	else
+	{
+		vector<int> degrees(numTerms*numVars);
+
+		if(degrees.size() > 0 && !read_binary(&degrees[0], degrees.size()*sizeof(int), p, end))
+		{
+			return false;
+		}
+
+		for(int i=0; i<numTerms; ++i)
+		{
+			vector<int> degs(degrees.begin() + i*numVars, degrees.begin() + (i+1)*numVars);
+			monomials[i].pack(degs);
+		}
+	}
+
+	vector<double> los(numTerms), ups(numTerms);
+
+	if(!read_binary(&los[0], numTerms*sizeof(double), p, end) || !read_binary(&ups[0], numTerms*sizeof(double), p, end))
+	{
+		return false;
+	}
+
+	for(int i=0; i<numTerms; ++i)
+	{
+		monomials[i].coefficient.set(los[i], ups[i]);
+	}
+
+	return true;
+}
+
 void Polynomial::constant(Interval & result) const
 {
 	Interval intZero;
@@ -635,7 +1009,7 @@ void Polynomial::intEvalNormal(Interval & result, const vector<Interval> & step_
 	Interval intZero;
 	result = intZero;
 
-	list<Monomial>::const_iterator iter;
+	vector<Monomial>::const_iterator iter;
 
 	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
 	{
@@ -654,7 +1028,7 @@ void Polynomial::inv(Polynomial & result) const
 
 void Polynomial::inv_assign()
 {
-	list<Monomial>::iterator iter;
+	vector<Monomial>::iterator iter;
 
 	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
 	{
@@ -664,10 +1038,6 @@ void Polynomial::inv_assign()
 
 void Polynomial::add_assign(const Monomial & monomial)
 {
-	bool bAdded = false;
-
-	list<Monomial>::iterator iter;
-
 	Interval intZero;
 
 	if(monomial.coefficient.subseteq(intZero))
@@ -675,31 +1045,16 @@ void Polynomial::add_assign(const Monomial & monomial)
 		return;
 	}
 
-	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
+	// binary search for the position of the monomial
+	vector<Monomial>::iterator iter = lower_bound(monomials.begin(), monomials.end(), monomial);
+
+	if(iter != monomials.end() && monomial == *iter)
 	{
-		if(monomial < *iter)
-		{
-			monomials.insert(iter, monomial);
-			bAdded = true;
-			break;
-		}
-		else if(monomial == *iter)
-		{
-			(*iter) += monomial;
-/*
-			if(iter->coefficient.subseteq(intZero))
-			{
-				monomials.erase(iter);
-			}
-*/
-			bAdded = true;
-			break;
-		}
+		(*iter) += monomial;
 	}
-
-	if(!bAdded)
+	else
 	{
-		monomials.push_back(monomial);
+		monomials.insert(iter, monomial);
 	}
 }
 
@@ -720,7 +1075,7 @@ void Polynomial::mul_assign(const Monomial & monomial)
 	}
 	else
 	{
-		list<Monomial>::iterator iter;
+		vector<Monomial>::iterator iter;
 		for(iter = monomials.begin(); iter != monomials.end(); )
 		{
 			(*iter) *= monomial;
@@ -748,19 +1103,19 @@ void Polynomial::mul_assign(const Interval & I)
 	}
 	else
 	{
-		list<Monomial>::iterator iter;
-		for(iter = monomials.begin(); iter != monomials.end(); )
+		int n = 0;
+		for(int i=0; i<monomials.size(); ++i)
 		{
-			iter->coefficient *= I;
-			if(iter->coefficient.subseteq(intZero))
-			{
-				iter = monomials.erase(iter);
-			}
-			else
+			monomials[i].coefficient *= I;
+			if(!monomials[i].coefficient.subseteq(intZero))
 			{
-				++iter;
+				if(n != i)
+					monomials[n] = monomials[i];
+				++n;
 			}
 		}
+
+		monomials.resize(n);
 	}
 }
 
@@ -768,7 +1123,7 @@ void Polynomial::div_assign(const Interval & I)
 {
 //	Interval intZero;
 
-	list<Monomial>::iterator iter;
+	vector<Monomial>::iterator iter;
 	for(iter = monomials.begin(); iter != monomials.end(); )
 	{
 		iter->coefficient /= I;
@@ -799,12 +1154,11 @@ void Polynomial::div(Polynomial & result, const Interval & I) const
 
 void Polynomial::mul_assign(const int varIndex, const int degree)
 {
-	list<Monomial>::iterator iter;
+	vector<Monomial>::iterator iter;
 
 	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
 	{
-		iter->degrees[varIndex] += degree;
-		iter->d += degree;
+		iter->addDegree(varIndex, degree);
 	}
 }
 
@@ -825,57 +1179,48 @@ Polynomial & Polynomial::operator = (const Polynomial & polynomial)
 
 Polynomial & Polynomial::operator += (const Polynomial & polynomial)
 {
-	Polynomial result;
+	if(polynomial.monomials.size() == 0)
+		return *this;
 
-//	Interval intZero;
+	if(monomials.size() == 0)
+	{
+		monomials = polynomial.monomials;
+		return *this;
+	}
 
-	list<Monomial>::const_iterator iterA;	// polynomial A
-	list<Monomial>::const_iterator iterB;	// polynomial B
+	// merge the two sorted sequences
+	vector<Monomial> result;
+	result.reserve(monomials.size() + polynomial.monomials.size());
 
-	for(iterA = monomials.begin(), iterB = polynomial.monomials.begin(); ; )
-	{
-		if(iterA == monomials.end() || iterB == polynomial.monomials.end())
-			break;
+	vector<Monomial>::const_iterator iterA = monomials.begin();				// polynomial A
+	vector<Monomial>::const_iterator iterB = polynomial.monomials.begin();	// polynomial B
 
+	for(; iterA != monomials.end() && iterB != polynomial.monomials.end(); )
+	{
 		if((*iterA) < (*iterB))
-	    {
-			result.monomials.push_back(*iterA);
+		{
+			result.push_back(*iterA);
 			++iterA;
-	    }
+		}
 		else if((*iterB) < (*iterA))
-	    {
-			result.monomials.push_back(*iterB);
+		{
+			result.push_back(*iterB);
 			++iterB;
-	    }
+		}
 		else
 		{
-			Interval intTemp;
-			intTemp = iterA->coefficient + iterB->coefficient;
-
-//			if(!intTemp.subseteq(intZero))
-//			{
-				Monomial monoTemp(*iterA);
-				monoTemp.coefficient = intTemp;
-				result.monomials.push_back(monoTemp);
-//			}
+			result.push_back(*iterA);
+			result.back().coefficient += iterB->coefficient;
 
 			++iterA;
 			++iterB;
 		}
 	}
 
-	if(iterA == monomials.end() && iterB != polynomial.monomials.end())
-	{
-		for(; iterB != polynomial.monomials.end(); ++iterB)
-			result.monomials.push_back(*iterB);
-	}
-	else if(iterA != monomials.end() && iterB == polynomial.monomials.end())
-	{
-		for(; iterA != monomials.end(); ++iterA)
-			result.monomials.push_back(*iterA);
-	}
+	result.insert(result.end(), iterA, (vector<Monomial>::const_iterator)monomials.end());
+	result.insert(result.end(), iterB, polynomial.monomials.end());
 
-	*this = result;
+	monomials.swap(result);
 	return *this;
 }
 
@@ -890,109 +1235,190 @@ Polynomial & Polynomial::operator -= (const Polynomial & polynomial)
 
 Polynomial & Polynomial::operator *= (const Polynomial & polynomial)
 {
-	Polynomial result;
+	Interval intZero;
+	mul_kernel(*this, intZero, polynomial, NULL, INT_MAX);
+
+	return *this;
+}
+
+const Polynomial Polynomial::operator + (const Polynomial & polynomial) const
+{
+	Polynomial result = *this;
+	result += polynomial;
+	return result;
+}
+
+const Polynomial Polynomial::operator - (const Polynomial & polynomial) const
+{
+	Polynomial result = *this;
+	result -= polynomial;
+	return result;
+}
+
+const Polynomial Polynomial::operator * (const Polynomial & polynomial) const
+{
+	Polynomial result = *this;
+	result *= polynomial;
+	return result;
+}
+
+// a product term in the heap of the multiplication kernel
+class MulTerm
+{
+public:
+	Monomial monomial;		// the product of the i-th and the j-th monomials
+	int i;
+	int j;
 
-	if((monomials.size() == 0) || (polynomial.monomials.size() == 0))
+	MulTerm(const Monomial & monomial_input, const int i_input, const int j_input):monomial(monomial_input), i(i_input), j(j_input)
 	{
-		this->clear();
-		return *this;
+	}
+};
+
+inline static bool mulTermGreater(const MulTerm & a, const MulTerm & b)
+{
+	return b.monomial < a.monomial;
+}
+
+/*
+ * Since the monomial order is compatible with the multiplication, the products of a monomial in the first polynomial
+ * with the monomials in the second one are generated in the ascending order. The streams of the first monomials are
+ * merged by a heap and the products of the same monomial are accumulated when they are popped. Moreover, the order
+ * is graded, so the products of degree > order in a stream form a suffix which is never pushed into the heap.
+ */
+void Polynomial::mul_kernel(Polynomial & result, Interval & remainder, const Polynomial & P, const vector<Interval> *pStepExpTable, const int order) const
+{
+	Interval intZero;
+	remainder = intZero;
+
+	int numA = monomials.size();
+	int numB = P.monomials.size();
+
+	if(numA == 0 || numB == 0)
+	{
+		result.clear();
+		return;
+	}
+
+	// the products of the i-th monomial with the first limits[i] monomials in P are of degree <= order
+	vector<int> limits(numA);
+	vector<MulTerm> heap;
+	heap.reserve(numA);
+
+	for(int i=0, j=numB; i<numA; ++i)
+	{
+		int maxDegree = order - monomials[i].d;
+		for(; j > 0 && P.monomials[j-1].d > maxDegree; --j);
+		limits[i] = j;
+
+		if(j > 0)
+		{
+			heap.push_back(MulTerm(monomials[i] * P.monomials[0], i, 0));
+		}
+	}
+
+	make_heap(heap.begin(), heap.end(), mulTermGreater);
+
+	vector<Monomial> monos;
+
+	for(; heap.size() > 0;)
+	{
+		pop_heap(heap.begin(), heap.end(), mulTermGreater);
+		MulTerm & term = heap.back();
+
+		if(monos.size() > 0 && monos.back() == term.monomial)
+		{
+			monos.back().coefficient += term.monomial.coefficient;
+		}
+		else
+		{
+			monos.push_back(term.monomial);
+		}
+
+		int i = term.i;
+		int j = term.j + 1;
+
+		if(j < limits[i])
+		{
+			term.monomial = monomials[i];
+			term.monomial *= P.monomials[j];
+			term.j = j;
+			push_heap(heap.begin(), heap.end(), mulTermGreater);
+		}
+		else
+		{
+			heap.pop_back();
+		}
 	}
 
-	list<Monomial>::const_iterator iterB;	// polynomial B
-
-	for(iterB = polynomial.monomials.begin(); iterB != polynomial.monomials.end(); ++iterB)
+	if(pStepExpTable != NULL)
 	{
-		Polynomial polyTemp = *this;
-		polyTemp.mul_assign(*iterB);
-		result += polyTemp;
+		for(int i=0; i<numA; ++i)
+		{
+			for(int j=limits[i]; j<numB; ++j)
+			{
+				Monomial monoTemp = monomials[i];
+				monoTemp *= P.monomials[j];
+
+				Interval intTemp;
+				monoTemp.intEvalNormal(intTemp, *pStepExpTable);
+				remainder += intTemp;
+			}
+		}
 	}
 
-	*this = result;
-	return *this;
+	result.monomials.swap(monos);
 }
 
-const Polynomial Polynomial::operator + (const Polynomial & polynomial) const
+void Polynomial::mul_nctrunc(Polynomial & result, const Polynomial & P, const int order) const
 {
-	Polynomial result = *this;
-	result += polynomial;
-	return result;
+	Interval intZero;
+	mul_kernel(result, intZero, P, NULL, order);
 }
 
-const Polynomial Polynomial::operator - (const Polynomial & polynomial) const
+void Polynomial::mul_nctrunc_assign(const Polynomial & P, const int order)
 {
-	Polynomial result = *this;
-	result -= polynomial;
-	return result;
+	Interval intZero;
+	mul_kernel(*this, intZero, P, NULL, order);
 }
 
-const Polynomial Polynomial::operator * (const Polynomial & polynomial) const
+void Polynomial::mul_ctrunc_normal(Polynomial & result, Interval & remainder, const Polynomial & P, const vector<Interval> & step_exp_table, const int order) const
 {
-	Polynomial result = *this;
-	result *= polynomial;
-	return result;
+	mul_kernel(result, remainder, P, &step_exp_table, order);
 }
 
 void Polynomial::ctrunc(Interval & remainder, const vector<Interval> & domain, const int order)
 {
 	Polynomial polyTemp;
-	Monomial monoTemp;
 
-	for(; monomials.size() > 0;)
-	{
-		monoTemp = monomials.back();
+	// the monomials of degree > order are at the end
+	int n = monomials.size();
+	for(; n > 0 && monomials[n-1].d > order; --n);
 
-		if(monoTemp.d > order)
-		{
-			polyTemp.monomials.insert(polyTemp.monomials.begin(), monoTemp);
-			monomials.pop_back();
-		}
-		else
-		{
-			break;
-		}
-	}
+	polyTemp.monomials.assign(monomials.begin() + n, monomials.end());
+	monomials.resize(n);
 
 	polyTemp.intEval(remainder, domain);
 }
 
 void Polynomial::nctrunc(const int order)
 {
-	Monomial monoTemp;
-
-	for(; monomials.size() > 0;)
+	for(; monomials.size() > 0 && monomials.back().d > order;)
 	{
-		monoTemp = monomials.back();
-
-		if(monoTemp.d > order)
-		{
-			monomials.pop_back();
-		}
-		else
-		{
-			break;
-		}
+		monomials.pop_back();
 	}
 }
 
 void Polynomial::ctrunc_normal(Interval & remainder, const vector<Interval> & step_exp_table, const int order)
 {
 	Polynomial polyTemp;
-	Monomial monoTemp;
 
-	for(; monomials.size() > 0;)
-	{
-		monoTemp = monomials.back();
+	// the monomials of degree > order are at the end
+	int n = monomials.size();
+	for(; n > 0 && monomials[n-1].d > order; --n);
 
-		if(monoTemp.d > order)
-		{
-			polyTemp.monomials.insert(polyTemp.monomials.begin(), monoTemp);
-			monomials.pop_back();
-		}
-		else
-		{
-			break;
-		}
-	}
+	polyTemp.monomials.assign(monomials.begin() + n, monomials.end());
+	monomials.resize(n);
 
 	polyTemp.intEvalNormal(remainder, step_exp_table);
 }
@@ -1001,7 +1427,7 @@ void Polynomial::linearCoefficients(vector<Interval> & result) const
 {
 	// initially, the result should be filled with 0
 
-	list<Monomial>::const_iterator iter;
+	vector<Monomial>::const_iterator iter;
 
 	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
 	{
@@ -1021,7 +1447,7 @@ void Polynomial::linearCoefficients(RowVector & result) const
 {
 	// initially, the result should be filled with 0
 
-	list<Monomial>::const_iterator iter;
+	vector<Monomial>::const_iterator iter;
 
 	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
 	{
@@ -1041,7 +1467,7 @@ void Polynomial::constraintCoefficients(RowVector & result) const
 {
 	// initially, the result should be filled with 0
 
-	list<Monomial>::const_iterator iter;
+	vector<Monomial>::const_iterator iter;
 
 	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
 	{
@@ -1064,7 +1490,7 @@ void Polynomial::constraintCoefficients(vector<Interval> & result) const
 {
 	// initially, the result should be filled with 0
 
-	list<Monomial>::const_iterator iter;
+	vector<Monomial>::const_iterator iter;
 
 	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
 	{
@@ -1090,50 +1516,54 @@ void Polynomial::toHornerForm(HornerForm & result) const
 	if(monomials.size() == 0)
 		return;
 
-	int numVars = (monomials.begin())->degrees.size();
+	int numVars = (monomials.begin())->dimension();
 
-	list<Monomial> lstMono = monomials;
-	list<Monomial>::iterator iter = lstMono.begin();
+	vector<Monomial> lstMono;
+	vector<Monomial>::const_iterator iter = monomials.begin();
 
 	if(iter->d == 0)
 	{
 		result.constant = iter->coefficient;
-		iter = lstMono.erase(iter);
+		++iter;
 
-		if(lstMono.size() == 0)
+		if(iter == monomials.end())
 			return;
 	}
 
-	vector<list<Monomial> > vlMono;
+	lstMono.assign(iter, monomials.end());
+
+	vector<vector<Monomial> > vlMono;
 
 	for(int i=0; i<numVars; ++i)
 	{
-		list<Monomial> lst_ith;
+		vector<Monomial> lst_ith;
 
-		for(iter = lstMono.begin(); iter != lstMono.end();)
+		int n = 0;
+		for(int j=0; j<lstMono.size(); ++j)
 		{
-			if(iter->degrees[i] > 0)
+			if(lstMono[j].getDegree(i) > 0)
 			{
-				iter->degrees[i] -= 1;
-				iter->d -= 1;
-				lst_ith.push_back(*iter);
-				iter = lstMono.erase(iter);
+				lstMono[j].addDegree(i, -1);
+				lst_ith.push_back(lstMono[j]);
 			}
 			else
 			{
-				++iter;
+				if(n != j)
+					lstMono[n] = lstMono[j];
+				++n;
 			}
 		}
 
+		lstMono.resize(n);
 		vlMono.push_back(lst_ith);
 	}
 
+	result.hornerForms.resize(numVars);
+
 	for(int i=0; i<numVars; ++i)
 	{
 		Polynomial polyTemp(vlMono[i]);
-		HornerForm hf;
-		polyTemp.toHornerForm(hf);
-		result.hornerForms.push_back(hf);
+		polyTemp.toHornerForm(result.hornerForms[i]);		// built in place, a nested Horner form is expensive to copy
 	}
 }
 
@@ -1149,9 +1579,7 @@ int Polynomial::degree() const
 {
 	if(monomials.size() > 0)
 	{
-		list<Monomial>::const_iterator iter = monomials.end();
-		--iter;
-		return iter->d;
+		return monomials.back().d;
 	}
 	else
 	{
@@ -1175,24 +1603,26 @@ void Polynomial::cutoff_normal(Interval & intRem, const vector<Interval> & step_
 {
 	Polynomial polyTemp;
 
-	list<Monomial>::iterator iter;
-	for(iter = monomials.begin(); iter != monomials.end(); )
+	polyTemp.monomials.reserve(monomials.size());
+
+	int n = 0;
+	for(int i=0; i<monomials.size(); ++i)
 	{
 		Monomial monoTemp;
-		bool bvalid = iter->cutoff(monoTemp);
+		bool bvalid = monomials[i].cutoff(monoTemp);
 
 		polyTemp.monomials.push_back(monoTemp);
 
-		if(!bvalid)
-		{
-			iter = monomials.erase(iter);
-		}
-		else
+		if(bvalid)
 		{
-			++iter;
+			if(n != i)
+				monomials[n] = monomials[i];
+			++n;
 		}
 	}
 
+	monomials.resize(n);
+
 	polyTemp.intEvalNormal(intRem, step_exp_table);
 }
 
@@ -1200,66 +1630,66 @@ void Polynomial::cutoff(Interval & intRem, const vector<Interval> & domain)
 {
 	Polynomial polyTemp;
 
-	list<Monomial>::iterator iter;
-	for(iter = monomials.begin(); iter != monomials.end(); )
+	polyTemp.monomials.reserve(monomials.size());
+
+	int n = 0;
+	for(int i=0; i<monomials.size(); ++i)
 	{
 		Monomial monoTemp;
-		bool bvalid = iter->cutoff(monoTemp);
+		bool bvalid = monomials[i].cutoff(monoTemp);
 
 		polyTemp.monomials.push_back(monoTemp);
 
-		if(!bvalid)
-		{
-			iter = monomials.erase(iter);
-		}
-		else
+		if(bvalid)
 		{
-			++iter;
+			if(n != i)
+				monomials[n] = monomials[i];
+			++n;
 		}
 	}
 
+	monomials.resize(n);
+
 	polyTemp.intEval(intRem, domain);
 }
 
 void Polynomial::cutoff()
 {
-	list<Monomial>::iterator iter;
-	for(iter = monomials.begin(); iter != monomials.end(); )
+	int n = 0;
+	for(int i=0; i<monomials.size(); ++i)
 	{
-		bool bvalid = iter->cutoff();
-
-		if(!bvalid)
-		{
-			iter = monomials.erase(iter);
-		}
-		else
+		if(monomials[i].cutoff())
 		{
-			++iter;
+			if(n != i)
+				monomials[n] = monomials[i];
+			++n;
 		}
 	}
+
+	monomials.resize(n);
 }
 
 void Polynomial::derivative(Polynomial & result, const int varIndex) const
 {
-	result = *this;
+	vector<Monomial> monos;		// the order of the monomials is kept by the derivation
+	vector<Monomial>::const_iterator iter;
 
-	list<Monomial>::iterator iter;
-
-	for(iter = result.monomials.begin(); iter != result.monomials.end(); )
+	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
 	{
-		if(iter->degrees[varIndex] > 0)
-		{
-			double tmp = iter->degrees[varIndex];
-			iter->degrees[varIndex] -= 1;
-			iter->d -= 1;
-			iter->coefficient.mul_assign(tmp);
-			++iter;
-		}
-		else
+		int deg = iter->getDegree(varIndex);
+
+		if(deg > 0)
 		{
-			iter = result.monomials.erase(iter);
+			monos.push_back(*iter);
+
+			Monomial & monoTemp = monos.back();
+			double tmp = deg;
+			monoTemp.addDegree(varIndex, -1);
+			monoTemp.coefficient.mul_assign(tmp);
 		}
 	}
+
+	result.monomials.swap(monos);
 }
 
 void Polynomial::LieDerivative(Polynomial & result, const vector<Polynomial> & f) const
@@ -1279,8 +1709,8 @@ void Polynomial::LieDerivative(Polynomial & result, const vector<Polynomial> & f
 
 void Polynomial::sub(Polynomial & result, const Polynomial & P, const int order) const
 {
-	list<Monomial> monomials1, monomials2;
-	list<Monomial>::const_iterator iter;
+	vector<Monomial> monomials1, monomials2;
+	vector<Monomial>::const_iterator iter;
 
 	for(iter = monomials.begin(); iter != monomials.end(); ++iter)
 	{
@@ -1336,8 +1766,7 @@ void Polynomial::exp_taylor(Polynomial & result, const int numVars, const int or
 
 		result.mul_assign(intFactor);
 
-		result *= F;
-		result.nctrunc(order);
+		result.mul_nctrunc_assign(F, order);
 		result.cutoff();
 
 		result += polyOne;
@@ -1379,8 +1808,7 @@ void Polynomial::rec_taylor(Polynomial & result, const int numVars, const int or
 	{
 		result.inv_assign();
 
-		result *= F_c;
-		result.nctrunc(order);
+		result.mul_nctrunc_assign(F_c, order);
 		result.cutoff();
 
 		result += polyOne;
@@ -1431,8 +1859,7 @@ void Polynomial::sin_taylor(Polynomial & result, const int numVars, const int or
 		{
 		case 0:
 		{
-			polyPowerF *= F;
-			polyPowerF.nctrunc(order);
+			polyPowerF.mul_nctrunc_assign(F, order);
 			polyPowerF.cutoff();
 
 			polyTemp = polyPowerF;
@@ -1445,8 +1872,7 @@ void Polynomial::sin_taylor(Polynomial & result, const int numVars, const int or
 		}
 		case 1:
 		{
-			polyPowerF *= F;
-			polyPowerF.nctrunc(order);
+			polyPowerF.mul_nctrunc_assign(F, order);
 			polyPowerF.cutoff();
 
 			polyTemp = polyPowerF;
@@ -1459,8 +1885,7 @@ void Polynomial::sin_taylor(Polynomial & result, const int numVars, const int or
 		}
 		case 2:
 		{
-			polyPowerF *= F;
-			polyPowerF.nctrunc(order);
+			polyPowerF.mul_nctrunc_assign(F, order);
 			polyPowerF.cutoff();
 
 			polyTemp = polyPowerF;
@@ -1473,8 +1898,7 @@ void Polynomial::sin_taylor(Polynomial & result, const int numVars, const int or
 		}
 		case 3:
 		{
-			polyPowerF *= F;
-			polyPowerF.nctrunc(order);
+			polyPowerF.mul_nctrunc_assign(F, order);
 			polyPowerF.cutoff();
 
 			polyTemp = polyPowerF;
@@ -1533,8 +1957,7 @@ void Polynomial::cos_taylor(Polynomial & result, const int numVars, const int or
 		{
 		case 0:
 		{
-			polyPowerF *= F;
-			polyPowerF.nctrunc(order);
+			polyPowerF.mul_nctrunc_assign(F, order);
 			polyPowerF.cutoff();
 
 			polyTemp = polyPowerF;
@@ -1547,8 +1970,7 @@ void Polynomial::cos_taylor(Polynomial & result, const int numVars, const int or
 		}
 		case 1:
 		{
-			polyPowerF *= F;
-			polyPowerF.nctrunc(order);
+			polyPowerF.mul_nctrunc_assign(F, order);
 			polyPowerF.cutoff();
 
 			polyTemp = polyPowerF;
@@ -1561,8 +1983,7 @@ void Polynomial::cos_taylor(Polynomial & result, const int numVars, const int or
 		}
 		case 2:
 		{
-			polyPowerF *= F;
-			polyPowerF.nctrunc(order);
+			polyPowerF.mul_nctrunc_assign(F, order);
 			polyPowerF.cutoff();
 
 			polyTemp = polyPowerF;
@@ -1575,8 +1996,7 @@ void Polynomial::cos_taylor(Polynomial & result, const int numVars, const int or
 		}
 		case 3:
 		{
-			polyPowerF *= F;
-			polyPowerF.nctrunc(order);
+			polyPowerF.mul_nctrunc_assign(F, order);
 			polyPowerF.cutoff();
 
 			polyTemp = polyPowerF;
@@ -1632,8 +2052,7 @@ void Polynomial::log_taylor(Polynomial & result, const int numVars, const int or
 		result -= polyJ;
 		result.inv_assign();
 
-		result *= F_c;
-		result.nctrunc(order);
+		result.mul_nctrunc_assign(F_c, order);
 		result.cutoff();
 	}
 
@@ -1687,8 +2106,7 @@ void Polynomial::sqrt_taylor(Polynomial & result, const int numVars, const int o
 		result.mul_assign( J / K );
 
 		result += polyOne;
-		result *= F_2c;
-		result.nctrunc(order);
+		result.mul_nctrunc_assign(F_2c, order);
 		result.cutoff();
 	}
 
@@ -1707,7 +2125,7 @@ void Polynomial::toString(string & result, const vector<string> & varNames) cons
 		return;
 	}
 
-	list<Monomial>::const_iterator iter, iter_last;
+	vector<Monomial>::const_iterator iter, iter_last;
 	iter_last = monomials.end();
 	--iter_last;
 
@@ -1772,288 +2190,446 @@ void Polynomial::toString(string & result, const vector<string> & varNames) cons
 
 
 
-void compute_factorial_rec(const int order)
+bool read_binary(void *data, const size_t size, const char * & p, const char *end)
 {
-	Interval I(1);
-
-	factorial_rec.push_back(I);
-
-	for(int i=1; i<=order; ++i)
+	if(end - p < size)
 	{
-		I.div_assign((double)i);
-		factorial_rec.push_back(I);
+		return false;
 	}
+
+	memcpy(data, p, size);
+	p += size;
+
+	return true;
 }
 
-void compute_power_4(const int order)
+// class FactorialTables
+
+FactorialTables::FactorialTables()
 {
-	Interval I(1);
+	precision = 0;
+}
+
+FactorialTables::FactorialTables(const FactorialTables & tables):factorial_rec(tables.factorial_rec), power_4(tables.power_4), double_factorial(tables.double_factorial), precision(tables.precision)
+{
+}
 
-	power_4.push_back(I);
+FactorialTables::~FactorialTables()
+{
+	factorial_rec.clear();
+	power_4.clear();
+	double_factorial.clear();
+}
+
+FactorialTables & FactorialTables::operator = (const FactorialTables & tables)
+{
+	if(this == &tables)
+		return *this;
+
+	factorial_rec = tables.factorial_rec;
+	power_4 = tables.power_4;
+	double_factorial = tables.double_factorial;
+	precision = tables.precision;
+
+	return *this;
+}
 
-	for(int i=1; i<=order; ++i)
+// the entries of a lower precision would not be accurate enough for the thread
+static void check_table_precision(FactorialTables & tables)
+{
+	if(tables.precision != intervalNumPrecision)
 	{
-		I.mul_assign(4.0);
-		power_4.push_back(I);
+		tables.factorial_rec.clear();
+		tables.power_4.clear();
+		tables.double_factorial.clear();
+		tables.precision = intervalNumPrecision;
 	}
 }
 
-void compute_double_factorial(const int order)
+void compute_factorial_rec(const int order)
 {
-	Interval odd(1), even(1);
+	FactorialTables & tables = *factorialTables;
+	check_table_precision(tables);
+
+	if(tables.factorial_rec.size() == 0)
+	{
+		tables.factorial_rec.push_back(Interval(1));
+	}
 
-	double_factorial.push_back(even);
-	double_factorial.push_back(odd);
+	Interval I = tables.factorial_rec.back();
 
-	for(int i=2; i<=order; ++i)
+	for(int i=tables.factorial_rec.size(); i<=order; ++i)
 	{
-		if(i%2 == 0)
-		{
-			even.mul_assign((double)i);
-			double_factorial.push_back(even);
-		}
-		else
-		{
-			odd.mul_assign((double)i);
-			double_factorial.push_back(odd);
-		}
+		I.div_assign((double)i);
+		tables.factorial_rec.push_back(I);
 	}
 }
 
-void computeTaylorExpansion(vector<HornerForm> & result, const vector<Polynomial> & ode, const int order)
+void compute_power_4(const int order)
 {
-	int rangeDim = ode.size();
-
-	vector<Polynomial> taylorExpansion;
-	vector<Polynomial> LieDeriv_n;
+	FactorialTables & tables = *factorialTables;
+	check_table_precision(tables);
 
-	for(int i=0; i<rangeDim; ++i)
+	if(tables.power_4.size() == 0)
 	{
-		RowVector row(rangeDim+1);
-		row.set(1,i+1);
-		Polynomial P(row);
-		taylorExpansion.push_back(P);
-		LieDeriv_n.push_back(P);
+		tables.power_4.push_back(Interval(1));
 	}
 
-	for(int i=0; i<rangeDim; ++i)
+	Interval I = tables.power_4.back();
+
+	for(int i=tables.power_4.size(); i<=order; ++i)
 	{
-		for(int j=1; j<=order; ++j)
-		{
-			Polynomial P1;
-			LieDeriv_n[i].LieDerivative(P1, ode);
-			LieDeriv_n[i] = P1;
+		I.mul_assign(4.0);
+		tables.power_4.push_back(I);
+	}
+}
 
-			P1.mul_assign(factorial_rec[j]);
-			P1.mul_assign(0,j);
+void compute_double_factorial(const int order)
+{
+	FactorialTables & tables = *factorialTables;
+	check_table_precision(tables);
 
-			taylorExpansion[i] += P1;
-		}
+	if(tables.double_factorial.size() == 0)
+	{
+		tables.double_factorial.push_back(Interval(1));
+		tables.double_factorial.push_back(Interval(1));
+	}
 
-		taylorExpansion[i].cutoff();
+	for(int i=tables.double_factorial.size(); i<=order; ++i)
+	{
+		Interval I = tables.double_factorial[i-2];
+		I.mul_assign((double)i);
+		tables.double_factorial.push_back(I);
 	}
+}
 
+void toHornerTapes(vector<HornerTape> & result, const vector<HornerForm> & hfs)
+{
 	result.clear();
 
-	for(int i=0; i<taylorExpansion.size(); ++i)
+	for(int i=0; i<hfs.size(); ++i)
 	{
-		HornerForm hf;
-		taylorExpansion[i].toHornerForm(hf);
-		result.push_back(hf);
+		result.push_back(HornerTape(hfs[i]));
 	}
 }
 
-void computeTaylorExpansion(vector<HornerForm> & result, const vector<Polynomial> & ode, const vector<int> & orders)
+// a product of variables in the right-hand side of an ODE, it is the product of its parent and the variable var
+class SeriesNode
 {
-	int rangeDim = ode.size();
-
-	vector<Polynomial> taylorExpansion;
-	vector<Polynomial> LieDeriv_n;
+public:
+	int parent;							// -1 if the node is the variable itself
+	int var;
+	vector<Polynomial> coefficients;	// the Taylor coefficients w.r.t. the time computed so far
 
-	for(int i=0; i<rangeDim; ++i)
+	SeriesNode(const int parent_input, const int var_input):parent(parent_input), var(var_input)
 	{
-		RowVector row(rangeDim+1);
-		row.set(1,i+1);
-		Polynomial P(row);
-		taylorExpansion.push_back(P);
-		LieDeriv_n.push_back(P);
 	}
+};
 
-	for(int i=0; i<rangeDim; ++i)
+static int seriesNode(vector<SeriesNode> & nodes, vector<vector<int> > & nodeDegrees, const vector<int> & degrees)
+{
+	for(int i=0; i<nodeDegrees.size(); ++i)
 	{
-		for(int j=1; j<=orders[i]; ++j)
-		{
-			Polynomial P1;
-			LieDeriv_n[i].LieDerivative(P1, ode);
-			LieDeriv_n[i] = P1;
+		if(nodeDegrees[i] == degrees)
+			return i;
+	}
 
-			P1.mul_assign(factorial_rec[j]);
-			P1.mul_assign(0,j);
+	int parent = -1;
+	int var = 0;
+	int total = 0;
 
-			taylorExpansion[i] += P1;
-		}
+	for(int i=degrees.size()-1; i>=0; --i)
+	{
+		if(degrees[i] > 0 && total == 0)
+			var = i;
 
-		taylorExpansion[i].cutoff();
+		total += degrees[i];
 	}
 
-	result.clear();
-
-	for(int i=0; i<taylorExpansion.size(); ++i)
+	if(total > 1)
 	{
-		HornerForm hf;
-		taylorExpansion[i].toHornerForm(hf);
-		result.push_back(hf);
+		vector<int> parentDegrees = degrees;
+		--parentDegrees[var];
+		parent = seriesNode(nodes, nodeDegrees, parentDegrees);
 	}
+
+	nodes.push_back(SeriesNode(parent, var));
+	nodeDegrees.push_back(degrees);
+
+	return nodes.size() - 1;
 }
 
-void computeTaylorExpansion(vector<HornerForm> & resultHF, vector<Polynomial> & resultMF, vector<Polynomial> & highest, const vector<Polynomial> & ode, const int order)
+/*
+ * Computes the Taylor coefficients x_i(t) = X[i][0] + X[i][1]*t + ... + X[i][orders[i]]*t^orders[i] of the flow
+ * of a polynomial ODE x' = f(t,x), such that X[i][k] = L^k(x_i)/k! where L is the Lie derivative. The first orders
+ * are computed by Taylor-mode automatic differentiation: the series of the products in f are propagated by the
+ * Cauchy product and X[i][k+1] = f_i(t,x)[k] / (k+1). The time is the series t + 1*t, i.e., the expansion point is
+ * kept symbolic as the Lie derivatives do. A Cauchy product of two dense coefficients eventually costs more than
+ * the Lie derivative of one, hence the remaining orders are computed by X[i][k+1] = L(X[i][k]) / (k+1).
+ */
+void computeTaylorCoefficients(vector<vector<Polynomial> > & result, const vector<Polynomial> & ode, const vector<int> & orders)
 {
 	int rangeDim = ode.size();
+	int numVars = rangeDim + 1;
 
-	vector<Polynomial> taylorExpansion;
-	vector<Polynomial> LieDeriv_n;
-
+	int maxOrder = 0;
 	for(int i=0; i<rangeDim; ++i)
 	{
-		RowVector row(rangeDim+1);
-		row.set(1,i+1);
-		Polynomial P(row);
-		taylorExpansion.push_back(P);
-		LieDeriv_n.push_back(P);
+		if(orders[i] > maxOrder)
+			maxOrder = orders[i];
 	}
 
-	highest.clear();
+	// the Taylor coefficients of the variables, the first one is the time
+	vector<vector<Polynomial> > X(numVars);
+
+	for(int i=0; i<numVars; ++i)
+	{
+		RowVector row(numVars);
+		row.set(1,i);
+		X[i].push_back(Polynomial(row));
+	}
+
+	X[0].push_back(Polynomial(Interval(1), numVars));
+
+	// decompose the monomials of the ODE into their coefficients and the products of variables
+	vector<SeriesNode> nodes;
+	vector<vector<int> > nodeDegrees;
+	vector<vector<int> > termNodes(rangeDim);
+	vector<vector<Monomial> > termCoefficients(rangeDim);
 
 	for(int i=0; i<rangeDim; ++i)
 	{
-		for(int j=1; j<=order; ++j)
+		for(int j=0; j<ode[i].monomials.size(); ++j)
 		{
-			Polynomial P;
-			LieDeriv_n[i].LieDerivative(P, ode);
-			LieDeriv_n[i] = P;
+			Monomial coefficient = ode[i].monomials[j];
+			vector<int> degrees(numVars);
 
-			if(j == order)
+			for(int k=0; k<numVars; ++k)
 			{
-				highest.push_back(P);
+				degrees[k] = coefficient.getDegree(k);
+				coefficient.addDegree(k, -degrees[k]);
 			}
 
-			P.mul_assign(factorial_rec[j]);
-			P.mul_assign(0,j);
+			termCoefficients[i].push_back(coefficient);
 
-			taylorExpansion[i] += P;
+			if(ode[i].monomials[j].degree() == 0)
+			{
+				termNodes[i].push_back(-1);
+			}
+			else
+			{
+				termNodes[i].push_back(seriesNode(nodes, nodeDegrees, degrees));
+			}
 		}
+	}
 
-		taylorExpansion[i].cutoff();
+	int sizeOde = 1;		// the derivative w.r.t. the time
+	for(int i=0; i<rangeDim; ++i)
+	{
+		sizeOde += ode[i].monomials.size();
 	}
 
-	resultMF = taylorExpansion;
+	int k = 0;
 
-	resultHF.clear();
-	for(int i=0; i<taylorExpansion.size(); ++i)
+	for(; k < maxOrder; ++k)
 	{
-		HornerForm hf;
-		taylorExpansion[i].toHornerForm(hf);
-		resultHF.push_back(hf);
-	}
-}
+		if(k > 0)
+		{
+			// estimate the numbers of the monomial products in both ways, the size of the coefficient k of a node is
+			// approximated by the one of the coefficient k-1
+			double costAD = 0, costLie = 0;
 
-void computeTaylorExpansion(vector<HornerForm> & resultHF, vector<Polynomial> & resultMF, vector<Polynomial> & highest, const vector<Polynomial> & ode, const vector<int> & orders)
-{
-	int rangeDim = ode.size();
+			for(int i=0; i<nodes.size(); ++i)
+			{
+				if(nodes[i].parent >= 0 && nodes[i].var > 0)
+				{
+					const vector<Polynomial> & P = nodes[nodes[i].parent].coefficients;
+					const vector<Polynomial> & V = X[nodes[i].var];
+
+					for(int m=0; m<=k; ++m)
+					{
+						costAD += (double)P[m < k ? m : k-1].monomials.size() * V[k-m].monomials.size();
+					}
+				}
+			}
 
-	vector<Polynomial> taylorExpansion;
-	vector<Polynomial> LieDeriv_n;
+			for(int i=0; i<rangeDim; ++i)
+			{
+				if(k < orders[i])
+					costLie += (double)X[i+1][k].monomials.size() * sizeOde;
+			}
 
-	for(int i=0; i<rangeDim; ++i)
-	{
-		RowVector row(rangeDim+1);
-		row.set(1,i+1);
-		Polynomial P(row);
-		taylorExpansion.push_back(P);
-		LieDeriv_n.push_back(P);
-	}
+			if(costAD > costLie)
+				break;
+		}
 
-	highest.clear();
+		for(int i=0; i<nodes.size(); ++i)
+		{
+			SeriesNode & node = nodes[i];
+			const vector<Polynomial> & V = X[node.var];
+			Polynomial coefficient;
 
-	for(int i=0; i<rangeDim; ++i)
-	{
-		for(int j=1; j<=orders[i]; ++j)
+			if(node.parent < 0)
+			{
+				if(k < V.size())
+					coefficient = V[k];
+			}
+			else if(node.var == 0)
+			{
+				// multiplied by the time series t + 1*t
+				const vector<Polynomial> & P = nodes[node.parent].coefficients;
+				coefficient = P[k];
+				coefficient.mul_assign(0,1);
+
+				if(k > 0)
+					coefficient += P[k-1];
+			}
+			else
+			{
+				const vector<Polynomial> & P = nodes[node.parent].coefficients;
+
+				for(int m=0; m<=k; ++m)
+				{
+					coefficient += P[m] * V[k-m];
+				}
+			}
+
+			node.coefficients.push_back(coefficient);
+		}
+
+		Interval intK(k+1);
+
+		for(int i=0; i<rangeDim; ++i)
 		{
-			Polynomial P;
-			LieDeriv_n[i].LieDerivative(P, ode);
-			LieDeriv_n[i] = P;
+			Polynomial F;
 
-			if(j == orders[i])
+			for(int j=0; j<termNodes[i].size(); ++j)
 			{
-				highest.push_back(P);
+				if(termNodes[i][j] < 0)
+				{
+					if(k == 0)
+						F += Polynomial(termCoefficients[i][j]);
+				}
+				else
+				{
+					Polynomial P = nodes[termNodes[i][j]].coefficients[k];
+					P.mul_assign(termCoefficients[i][j]);
+					F += P;
+				}
 			}
 
-			P.mul_assign(factorial_rec[j]);
-			P.mul_assign(0,j);
+			F.div_assign(intK);
+			X[i+1].push_back(F);
+		}
+	}
 
-			taylorExpansion[i] += P;
+	// the remaining orders are computed by the Lie derivatives
+	for(int i=0; i<rangeDim; ++i)
+	{
+		for(int j=k; j<orders[i]; ++j)
+		{
+			Polynomial P;
+			X[i+1][j].LieDerivative(P, ode);
+			P.div_assign(Interval(j+1));
+			X[i+1].push_back(P);
 		}
+	}
+
+	result.clear();
 
-		taylorExpansion[i].cutoff();
+	for(int i=0; i<rangeDim; ++i)
+	{
+		X[i+1].resize(orders[i]+1);
+		result.push_back(X[i+1]);
 	}
+}
 
-	resultMF = taylorExpansion;
+// the Taylor expansion sum_k X[k]*t^k
+static void sumTaylorCoefficients(Polynomial & result, const vector<Polynomial> & coefficients)
+{
+	result = coefficients[0];
 
-	resultHF.clear();
-	for(int i=0; i<taylorExpansion.size(); ++i)
+	for(int k=1; k<coefficients.size(); ++k)
 	{
-		HornerForm hf;
-		taylorExpansion[i].toHornerForm(hf);
-		resultHF.push_back(hf);
+		Polynomial P = coefficients[k];
+		P.mul_assign(0,k);
+		result += P;
 	}
+
+	result.cutoff();
 }
 
-void increaseExpansionOrder(vector<HornerForm> & resultHF, vector<Polynomial> & resultMF, vector<Polynomial> & highest, const vector<Polynomial> & taylorExpansion, const vector<Polynomial> & ode, const int order)
+void computeTaylorExpansion(vector<HornerForm> & result, const vector<Polynomial> & ode, const int order)
 {
-	int rangeDim = ode.size();
+	vector<int> orders(ode.size(), order);
+	computeTaylorExpansion(result, ode, orders);
+}
 
-	vector<Polynomial> expansion = taylorExpansion;
-	vector<Polynomial> LieDeriv_n = highest;
+void computeTaylorExpansion(vector<HornerForm> & result, const vector<Polynomial> & ode, const vector<int> & orders)
+{
+	vector<vector<Polynomial> > coefficients;
+	computeTaylorCoefficients(coefficients, ode, orders);
 
-	for(int i=0; i<rangeDim; ++i)
+	result.clear();
+	result.resize(coefficients.size());
+
+	for(int i=0; i<coefficients.size(); ++i)
 	{
-		Polynomial P1;
-		LieDeriv_n[i].LieDerivative(P1, ode);
+		Polynomial expansion;
+		sumTaylorCoefficients(expansion, coefficients[i]);
+		expansion.toHornerForm(result[i]);
+	}
+}
 
-		highest[i] = P1;
+void computeTaylorExpansion(vector<HornerForm> & resultHF, vector<Polynomial> & resultMF, vector<Polynomial> & highest, const vector<Polynomial> & ode, const int order)
+{
+	vector<int> orders(ode.size(), order);
+	computeTaylorExpansion(resultHF, resultMF, highest, ode, orders);
+}
 
-		P1.mul_assign(factorial_rec[order+1]);
-		P1.mul_assign(0, order+1);
+void computeTaylorExpansion(vector<HornerForm> & resultHF, vector<Polynomial> & resultMF, vector<Polynomial> & highest, const vector<Polynomial> & ode, const vector<int> & orders)
+{
+	vector<vector<Polynomial> > coefficients;
+	computeTaylorCoefficients(coefficients, ode, orders);
 
-		expansion[i] += P1;
+	resultMF.clear();
+	resultMF.resize(coefficients.size());
+	resultHF.clear();
+	resultHF.resize(coefficients.size());
+	highest.clear();
 
-		expansion[i].cutoff();
+	for(int i=0; i<coefficients.size(); ++i)
+	{
+		sumTaylorCoefficients(resultMF[i], coefficients[i]);
+		resultMF[i].toHornerForm(resultHF[i]);
+		highest.push_back(coefficients[i].back());
 	}
+}
 
-	resultMF = expansion;
+void increaseExpansionOrder(vector<HornerForm> & resultHF, vector<Polynomial> & resultMF, vector<Polynomial> & highest, const vector<Polynomial> & taylorExpansion, const vector<Polynomial> & ode, const int order)
+{
+	int rangeDim = ode.size();
 
 	resultHF.clear();
-	for(int i=0; i<expansion.size(); ++i)
+	resultHF.resize(rangeDim);
+	resultMF.resize(rangeDim);
+
+	for(int i=0; i<rangeDim; ++i)
 	{
-		HornerForm hf;
-		expansion[i].toHornerForm(hf);
-		resultHF.push_back(hf);
+		increaseExpansionOrder(resultHF[i], resultMF[i], highest[i], taylorExpansion[i], ode, order);
 	}
 }
 
 void increaseExpansionOrder(HornerForm & resultHF, Polynomial & resultMF, Polynomial & highest, const Polynomial & taylorExpansion, const vector<Polynomial> & ode, const int order)
 {
-	int rangeDim = ode.size();
-
 	Polynomial expansion = taylorExpansion;
-	Polynomial LieDeriv_n = highest;
 
 	Polynomial P1;
-	LieDeriv_n.LieDerivative(P1, ode);
+	highest.LieDerivative(P1, ode);
+	P1.div_assign(Interval(order+1));
 
 	highest = P1;
 
-	P1.mul_assign(factorial_rec[order+1]);
 	P1.mul_assign(0, order+1);
 
 	expansion += P1;
@@ -18,24 +18,28 @@ class TaylorModel;
 class TaylorModelVec;
 class Flowpipe;
 
-extern vector<Interval> factorial_rec;
-extern vector<Interval> power_4;
-extern vector<Interval> double_factorial;
-
-class RangeTree
+// The reciprocals of the factorials, the powers of 4 and the double factorials used by the remainder estimation. An
+// analysis owns its tables, they are filled in its precision before its workers start and only read by the workers.
+class FactorialTables
 {
 public:
-	list<Interval> ranges;
-	list<RangeTree *> children;
-
-	RangeTree();
-	RangeTree(const list<Interval> & ranges_input, const list<RangeTree *> & children_input);
-	RangeTree(const RangeTree & tree);
-	~RangeTree();
+	vector<Interval> factorial_rec;
+	vector<Interval> power_4;
+	vector<Interval> double_factorial;
+	mpfr_prec_t precision;				// the precision of the entries
+public:
+	FactorialTables();
+	FactorialTables(const FactorialTables & tables);
+	~FactorialTables();
 
-	RangeTree & operator = (const RangeTree & tree);
+	FactorialTables & operator = (const FactorialTables & tables);
 };
 
+extern __thread FactorialTables *factorialTables;		// the tables of the analysis run by the current thread
+extern FactorialTables defaultFactorialTables;			// used by a thread which runs no analysis
+
+class HornerTape;
+
 class HornerForm							// c + (...)*x1 + (...)*x2 + ... + (...)*xn
 {
 private:
@@ -51,6 +55,10 @@ public:
 	void clear();
 	void intEval(Interval & result, const vector<Interval> & domain) const;		// interval evaluation of the Horner form
 
+	// forward-backward propagation (HC4-revise), the domain is narrowed to the points at which the value may lie in the
+	// range, returns false if there are none
+	bool contract(vector<Interval> & domain, const Interval & range) const;
+
 	// substitute the variables by the given Taylor models
 	void insert(TaylorModel & result, const TaylorModelVec & vars, const vector<Interval> & varsPolyRange, const vector<Interval> & domain) const;
 	void insert_normal(TaylorModel & result, const TaylorModelVec & vars, const vector<Interval> & varsPolyRange, const vector<Interval> & step_exp_table, const int numVars) const;
@@ -63,20 +71,76 @@ public:
 
 	void insert_ctrunc_normal(TaylorModel & result, const TaylorModelVec & vars, const vector<Interval> & varsPolyRange, const vector<Interval> & step_exp_table, const int numVars, const int order) const;
 
-	void insert_ctrunc_normal(TaylorModel & result, RangeTree * & tree, const TaylorModelVec & vars, const vector<Interval> & varsPolyRange, const vector<Interval> & step_exp_table, const int numVars, const int order) const;	// the first time
-	void insert_only_remainder(Interval & result, RangeTree *tree, const TaylorModelVec & vars, const Interval & timeStep) const;	// after the first time
-
 	void dump(FILE *fp, const vector<string> & varNames) const;	// only for tests
 
+	bool isZero() const;
+	void toTape(HornerTape & result) const;		// compile the Horner form into a straight-line program
+
 	HornerForm & operator = (const HornerForm & hf);
 
+private:
+	void compile(HornerTape & tape, const int reg) const;	// the value of the Horner form is written into the register reg
+
+public:
 	friend class Polynomial;
 };
 
+class HornerInstruction
+{
+public:
+	int opcode;		// see HORNER_* in include.h
+	int dst;		// the register which is updated
+	int src;		// the register holding the value of the child
+	int constant;	// index of the constant
+	int var;		// index of the variable which multiplies the child
+
+	HornerInstruction();
+	HornerInstruction(const int opcode_input, const int dst_input, const int src_input, const int constant_input, const int var_input);
+	HornerInstruction(const HornerInstruction & instruction);
+	~HornerInstruction();
+
+	HornerInstruction & operator = (const HornerInstruction & instruction);
+};
+
+/*
+ * A Horner form flattened into a sequence of instructions over a register file. A node at depth d of the Horner
+ * form is evaluated in the register d, zero children are dropped and the constant children are folded into the
+ * multiplication by their variable. The evaluation performs the same interval operations as the recursive one.
+ *   HORNER_CONST:			R[dst] = C[constant]
+ *   HORNER_ZERO:			R[dst] = 0
+ *   HORNER_MUL_ADD:		R[dst] += R[src] * x[var]
+ *   HORNER_CONST_MUL_ADD:	R[src] = C[constant];  R[dst] += R[src] * x[var]
+ */
+class HornerTape
+{
+private:
+	vector<HornerInstruction> code;
+	vector<Interval> constants;
+	int numRegisters;
+public:
+	HornerTape();
+	HornerTape(const HornerForm & hf);
+	HornerTape(const HornerTape & tape);
+	~HornerTape();
+
+	void clear();
+
+	void intEval(Interval & result, const vector<Interval> & domain) const;
+	void intEval(Interval & result, const vector<Interval> & domain, vector<Interval> & registers) const;		// the registers are reused over the calls
+
+	// the ranges which are needed to recompute the remainder are recorded in the order of the instructions
+	void insert_ctrunc_normal(TaylorModel & result, vector<Interval> & ranges, const TaylorModelVec & vars, const vector<Interval> & varsPolyRange, const vector<Interval> & step_exp_table, const int numVars, const int order) const;	// the first time
+	void insert_only_remainder(Interval & result, const vector<Interval> & ranges, const TaylorModelVec & vars, const Interval & timeStep, vector<Interval> & registers) const;	// after the first time
+
+	HornerTape & operator = (const HornerTape & tape);
+
+	friend class HornerForm;
+};
+
 class Polynomial				// polynomials in monomial form
 {
 private:
-	list<Monomial> monomials;
+	vector<Monomial> monomials;		// sorted in the ascending order, see operator < of Monomial
 public:
 	Polynomial();														// empty polynomial
 	Polynomial(const Interval & constant, const int numVars);			// constant polynomial where dim is the number of the variables
@@ -84,6 +148,7 @@ public:
 	Polynomial(const vector<Interval> & coefficients);					// linear polynomial with the given coefficients, the input matrix is a row vector
 	Polynomial(const Monomial & monomial);								// polynomial with one monomial
 	Polynomial(const list<Monomial> & monos);
+	Polynomial(const vector<Monomial> & monos);
 	Polynomial(const Polynomial & polynomial);
 	~Polynomial();
 
@@ -93,6 +158,10 @@ public:
 	void dump_interval(FILE *fp, const vector<string> & varNames) const;
 	void dump_constant(FILE *fp, const vector<string> & varNames) const;
 
+	// the binary form stores the degrees and the coefficient bounds column-wise, the bounds are rounded outward to doubles
+	void dump_binary(FILE *fp, const int numVars) const;
+	bool load_binary(const char * & p, const char *end, const int numVars);
+
 	void constant(Interval & result) const;											// constant part of the polynomial
 	void intEval(Interval & result, const vector<Interval> & domain) const;			// interval evaluation of the polynomial
 	void intEvalNormal(Interval & result, const vector<Interval> & step_exp_table) const;	// fast evaluation over normalized domain
@@ -118,6 +187,12 @@ public:
 	const Polynomial operator - (const Polynomial & polynomial) const;
 	const Polynomial operator * (const Polynomial & polynomial) const;
 
+	// multiplication without generating the monomials of degree > order, they are either discarded or evaluated
+	// over the normalized domain and added to the remainder
+	void mul_nctrunc(Polynomial & result, const Polynomial & P, const int order) const;
+	void mul_nctrunc_assign(const Polynomial & P, const int order);
+	void mul_ctrunc_normal(Polynomial & result, Interval & remainder, const Polynomial & P, const vector<Interval> & step_exp_table, const int order) const;
+
 	void ctrunc(Interval & remainder, const vector<Interval> & domain, const int order);	// conservative truncation
 	void nctrunc(const int order);															// non-conservative truncation
 	void ctrunc_normal(Interval & remainder, const vector<Interval> & step_exp_table, const int order);
@@ -150,16 +225,31 @@ public:
 
 	void toString(string & result, const vector<string> & varNames) const;	// transform a polynomial to a string
 
+private:
+	void mul_kernel(Polynomial & result, Interval & remainder, const Polynomial & P, const vector<Interval> *pStepExpTable, const int order) const;
+
+public:
+
 	friend class TaylorModel;
 	friend class TaylorModelVec;
 	friend class Flowpipe;
 	friend class ContinuousSystem;
+	friend void computeTaylorCoefficients(vector<vector<Polynomial> > & result, const vector<Polynomial> & ode, const vector<int> & orders);
 };
 
+// copy size bytes from a memory-mapped buffer and advance the cursor, returns false if the buffer is exhausted
+bool read_binary(void *data, const size_t size, const char * & p, const char *end);
+
+// extend the tables of the current thread, they are refilled if the precision of the thread has changed
 void compute_factorial_rec(const int order);
 void compute_power_4(const int order);
 void compute_double_factorial(const int order);
 
+void toHornerTapes(vector<HornerTape> & result, const vector<HornerForm> & hfs);
+
+// the Taylor coefficients of the flow of a polynomial ODE, result[i][k] = L^k(x_i)/k!
+void computeTaylorCoefficients(vector<vector<Polynomial> > & result, const vector<Polynomial> & ode, const vector<int> & orders);
+
 void computeTaylorExpansion(vector<HornerForm> & result, const vector<Polynomial> & ode, const int order);
 void computeTaylorExpansion(vector<HornerForm> & result, const vector<Polynomial> & ode, const vector<int> & orders);
 
@@ -0,0 +1,287 @@
+/*---
+  Flow*: A Taylor Model Based Flowpipe analyzer.
+  Authors: Xin Chen, Erika Abraham and Sriram Sankaranarayanan.
+  Email: Xin Chen <xin.chen@cs.rwth-aachen.de> if you have questions or comments.
+  
+  The code is released as is under the GNU General Public License (GPL). Please consult the file LICENSE.txt for
+  further information.
+---*/
+
+#include "Profiler.h"
+#include "TaylorModel.h"
+
+Profiler disabledProfiler;
+StepLog disabledStepLog;
+
+__thread Profiler *profiler = &disabledProfiler;
+__thread StepLog *stepLog = &disabledStepLog;
+
+__thread int profile_depth[NUM_PHASES];
+
+// the state of the step log in the current thread
+static __thread const char *step_log_mode = NULL;		// NULL for a continuous system
+static __thread double step_log_time = 0;				// the global time at the beginning of the current step
+static __thread int step_log_picard = 0;				// the number of Picard iterations in the current attempt
+static __thread struct timespec step_log_begin;			// when the current attempt started
+
+static const char *phase_names[NUM_PHASES] = {"picard", "remainder", "precondition", "range_bounding", "composition", "contraction", "aggregation", "reset"};
+
+// class Profiler
+
+Profiler::Profiler()
+{
+	bEnabled = false;
+	reset();
+}
+
+Profiler::~Profiler()
+{
+}
+
+void Profiler::reset()
+{
+	for(int i=0; i<NUM_PHASES; ++i)
+	{
+		wallTime[i] = 0;
+		cpuTime[i] = 0;
+		calls[i] = 0;
+		retries[i] = 0;
+	}
+
+	totalWallTime = 0;
+	totalCPUTime = 0;
+}
+
+void Profiler::start()
+{
+	reset();
+	clock_gettime(CLOCK_MONOTONIC, &wallBegin);
+	cpuBegin = clock();
+}
+
+void Profiler::stop()
+{
+	struct timespec wallEnd;
+	clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+
+	totalWallTime = elapsed_nanoseconds(wallBegin, wallEnd) / 1e9;
+	totalCPUTime = (double)(clock() - cpuBegin) / CLOCKS_PER_SEC;
+}
+
+void Profiler::record(const int phase, const unsigned long long wall, const unsigned long long cpu)
+{
+	// the workers record concurrently
+	__sync_fetch_and_add(&wallTime[phase], wall);
+	__sync_fetch_and_add(&cpuTime[phase], cpu);
+	__sync_fetch_and_add(&calls[phase], 1ULL);
+}
+
+void Profiler::retry(const int phase)
+{
+	if(bEnabled)
+	{
+		__sync_fetch_and_add(&retries[phase], 1ULL);
+	}
+}
+
+void Profiler::dump_summary(FILE *fp) const
+{
+	fprintf(fp, "%-16s %12s %10s %12s %12s %8s\n", "phase", "calls", "retries", "wall (s)", "cpu (s)", "wall %");
+
+	for(int i=0; i<NUM_PHASES; ++i)
+	{
+		double wall = wallTime[i] / 1e9;
+		double ratio = totalWallTime > 0 ? 100 * wall / totalWallTime : 0;
+
+		fprintf(fp, "%-16s %12llu %10llu %12.6lf %12.6lf %7.2lf%%\n", phase_names[i], calls[i], retries[i], wall, cpuTime[i] / 1e9, ratio);
+	}
+
+	fprintf(fp, "%-16s %12s %10s %12.6lf %12.6lf\n", "total", "", "", totalWallTime, totalCPUTime);
+	fprintf(fp, "The time of a phase includes the time of the phases nested in it and is summed over the threads.\n");
+}
+
+void Profiler::dump_json(FILE *fp) const
+{
+	fprintf(fp, "{\n");
+	fprintf(fp, "  \"total\": {\"wall\": %.9lf, \"cpu\": %.9lf},\n", totalWallTime, totalCPUTime);
+	fprintf(fp, "  \"phases\": [\n");
+
+	for(int i=0; i<NUM_PHASES; ++i)
+	{
+		fprintf(fp, "    {\"name\": \"%s\", \"calls\": %llu, \"retries\": %llu, \"wall\": %.9lf, \"cpu\": %.9lf}%s\n",
+				phase_names[i], calls[i], retries[i], wallTime[i] / 1e9, cpuTime[i] / 1e9, i < NUM_PHASES-1 ? "," : "");
+	}
+
+	fprintf(fp, "  ]\n");
+	fprintf(fp, "}\n");
+}
+
+void Profiler::report(const char *fileName, FILE *fpLog) const
+{
+	fprintf(fpLog, "Profile:\n");
+	dump_summary(fpLog);
+
+	char filename[NAME_SIZE+30];
+	sprintf(filename, "%s%s%s", outputDir, fileName, str_profile_name_suffix);
+	FILE *fp = fopen(filename, "w");
+
+	if(fp == NULL)
+	{
+		fprintf(fpLog, "Can not create the profile file.\n");
+		return;
+	}
+
+	dump_json(fp);
+	fclose(fp);
+}
+
+
+// class StepLog
+
+StepLog::StepLog()
+{
+	fp = NULL;
+	bEnabled = false;
+	pthread_mutex_init(&mutex, NULL);
+}
+
+StepLog::~StepLog()
+{
+	close();
+	pthread_mutex_destroy(&mutex);
+}
+
+void StepLog::open(const char *fileName)
+{
+	if(!bEnabled)
+	{
+		return;
+	}
+
+	char filename[NAME_SIZE+30];
+	sprintf(filename, "%s%s%s", outputDir, fileName, str_step_log_name_suffix);
+	fp = fopen(filename, "w");
+
+	if(fp == NULL)
+	{
+		printf("Can not create the step log file.\n");
+		bEnabled = false;
+	}
+}
+
+void StepLog::close()
+{
+	if(fp != NULL)
+	{
+		fclose(fp);
+		fp = NULL;
+	}
+}
+
+void StepLog::enter(const char *mode, const double timePassed)
+{
+	step_log_mode = mode;
+	step_log_time = timePassed;
+}
+
+void StepLog::begin()
+{
+	if(bEnabled)
+	{
+		step_log_picard = 1;
+		clock_gettime(CLOCK_MONOTONIC, &step_log_begin);
+	}
+}
+
+void StepLog::refine()
+{
+	if(bEnabled)
+	{
+		++step_log_picard;
+	}
+}
+
+void StepLog::write(const double step, const int *orders, const int numOrders, const bool bAccepted, const TaylorModelVec & tmv)
+{
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	// the record is composed before locking the file since the workers write concurrently
+	string record;
+	char buffer[NUM_LENGTH+30];
+
+	if(step_log_mode == NULL)
+	{
+		record += "{\"mode\": null";
+	}
+	else
+	{
+		record += "{\"mode\": \"";
+		record += step_log_mode;
+		record += "\"";
+	}
+
+	sprintf(buffer, ", \"time\": %.12e, \"step\": %.12e, \"orders\": [", step_log_time, step);
+	record += buffer;
+
+	for(int i=0; i<numOrders; ++i)
+	{
+		sprintf(buffer, i == 0 ? "%d" : ", %d", orders[i]);
+		record += buffer;
+	}
+
+	record += bAccepted ? "], \"status\": \"accepted\", \"remainders\": [" : "], \"status\": \"rejected\", \"remainders\": [";
+
+	for(int i=0; i<tmv.tms.size(); ++i)
+	{
+		sprintf(buffer, i == 0 ? "%.6e" : ", %.6e", tmv.tms[i].getRemainder().width());
+		record += buffer;
+	}
+
+	sprintf(buffer, "], \"picard\": %d, \"elapsed_us\": %.3lf}\n", step_log_picard, elapsed_nanoseconds(step_log_begin, end) / 1e3);
+	record += buffer;
+
+	pthread_mutex_lock(&mutex);
+	fputs(record.c_str(), fp);
+	pthread_mutex_unlock(&mutex);
+
+	// the next attempt starts from here
+	step_log_picard = 1;
+	step_log_begin = end;
+}
+
+void StepLog::reject(const double step, const int order, const TaylorModelVec & tmv)
+{
+	if(bEnabled)
+	{
+		write(step, &order, 1, false, tmv);
+	}
+}
+
+void StepLog::reject(const double step, const vector<int> & orders, const TaylorModelVec & tmv)
+{
+	if(bEnabled)
+	{
+		write(step, &orders[0], orders.size(), false, tmv);
+	}
+}
+
+void StepLog::accept(const double step, const int order, const TaylorModelVec & tmv)
+{
+	if(bEnabled)
+	{
+		write(step, &order, 1, true, tmv);
+	}
+
+	step_log_time += step;
+}
+
+void StepLog::accept(const double step, const vector<int> & orders, const TaylorModelVec & tmv)
+{
+	if(bEnabled)
+	{
+		write(step, &orders[0], orders.size(), true, tmv);
+	}
+
+	step_log_time += step;
+}
@@ -0,0 +1,144 @@
+/*---
+  Flow*: A Taylor Model Based Flowpipe analyzer.
+  Authors: Xin Chen, Erika Abraham and Sriram Sankaranarayanan.
+  Email: Xin Chen <xin.chen@cs.rwth-aachen.de> if you have questions or comments.
+  
+  The code is released as is under the GNU General Public License (GPL). Please consult the file LICENSE.txt for
+  further information.
+---*/
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+#include "include.h"
+
+class TaylorModelVec;
+
+/*
+ * The profiler accumulates the wall time, the CPU time, the number of calls and the number of retries of each phase
+ * over all of the threads. The phases may be nested, e.g., range bounding is done within the Picard iteration, so the
+ * time of a phase includes the time of the phases it calls.
+ */
+class Profiler
+{
+private:
+	unsigned long long wallTime[NUM_PHASES];	// in nanoseconds, summed over the threads
+	unsigned long long cpuTime[NUM_PHASES];		// in nanoseconds, summed over the threads
+	unsigned long long calls[NUM_PHASES];
+	unsigned long long retries[NUM_PHASES];
+
+	struct timespec wallBegin;
+	clock_t cpuBegin;
+	double totalWallTime;		// of the whole computation, in seconds
+	double totalCPUTime;
+public:
+	bool bEnabled;
+public:
+	Profiler();
+	~Profiler();
+
+	void reset();
+	void start();		// start and stop measuring the whole computation
+	void stop();
+
+	void record(const int phase, const unsigned long long wall, const unsigned long long cpu);
+	void retry(const int phase);
+
+	void dump_summary(FILE *fp) const;
+	void dump_json(FILE *fp) const;
+	void report(const char *fileName, FILE *fpLog) const;		// print the summary to fpLog and write the JSON report to the output directory
+};
+
+
+/*
+ * The step log writes one JSON record per attempted integration step. The attempts are made by the advance functions
+ * of a flowpipe, the global time and the mode are kept per thread since a worker integrates one mode at a time.
+ */
+class StepLog
+{
+private:
+	FILE *fp;
+	pthread_mutex_t mutex;
+
+	void write(const double step, const int *orders, const int numOrders, const bool bAccepted, const TaylorModelVec & tmv);
+public:
+	bool bEnabled;
+public:
+	StepLog();
+	~StepLog();
+
+	void open(const char *fileName);		// the log is written to the output directory
+	void close();
+
+	void enter(const char *mode, const double timePassed);		// the following steps are in the given mode, starting at the global time
+	void begin();											// an advance function starts to attempt a step
+	void refine();											// one more Picard iteration to refine the remainder
+
+	void reject(const double step, const int order, const TaylorModelVec & tmv);
+	void reject(const double step, const vector<int> & orders, const TaylorModelVec & tmv);
+	void accept(const double step, const int order, const TaylorModelVec & tmv);
+	void accept(const double step, const vector<int> & orders, const TaylorModelVec & tmv);
+};
+
+// An analysis owns its profiler and step log. They are reached through these pointers, which are kept per thread like
+// the numerical settings, so the concurrent analyses do not share them. A thread which runs no analysis uses disabled ones.
+extern __thread Profiler *profiler;
+extern __thread StepLog *stepLog;
+
+extern Profiler disabledProfiler;
+extern StepLog disabledStepLog;
+
+extern __thread int profile_depth[NUM_PHASES];		// the number of the active scopes of each phase in the current thread
+
+class ProfileScope		// measures its lifetime as a call of a phase, the nested scopes of the same phase are not counted
+{
+private:
+	Profiler *target;		// the profiler of the analysis when the scope is entered
+	int phase;
+	bool bOutermost;
+	bool bCounted;
+	struct timespec wallBegin;
+	struct timespec cpuBegin;
+public:
+	ProfileScope(const int phase_input);
+	~ProfileScope();
+};
+
+inline unsigned long long elapsed_nanoseconds(const struct timespec & begin, const struct timespec & end)
+{
+	return (unsigned long long)(end.tv_sec - begin.tv_sec) * 1000000000ULL + end.tv_nsec - begin.tv_nsec;
+}
+
+inline ProfileScope::ProfileScope(const int phase_input)
+{
+	target = profiler;
+	phase = phase_input;
+	bCounted = target->bEnabled;
+	bOutermost = false;
+
+	if(bCounted && profile_depth[phase]++ == 0)
+	{
+		bOutermost = true;
+		clock_gettime(CLOCK_MONOTONIC, &wallBegin);
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuBegin);
+	}
+}
+
+inline ProfileScope::~ProfileScope()
+{
+	if(bCounted)
+	{
+		--profile_depth[phase];
+	}
+
+	if(bOutermost)
+	{
+		struct timespec wallEnd, cpuEnd;
+		clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuEnd);
+		clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+
+		target->record(phase, elapsed_nanoseconds(wallBegin, wallEnd), elapsed_nanoseconds(cpuBegin, cpuEnd));
+	}
+}
+
+#endif /* PROFILER_H_ */
@@ -9,9 +9,6 @@
 
 #include "TaylorModel.h"
 
-ParseSetting parseSetting;
-ParseResult parseResult;
-
 // class TaylorModel
 
 TaylorModel::TaylorModel()
@@ -92,6 +89,28 @@ void TaylorModel::dump_constant(FILE *fp, vector<string> const & varNames) const
 	fprintf(fp, "\n");
 }
 
+void TaylorModel::dump_binary(FILE *fp, const int numVars) const
+{
+	expansion.dump_binary(fp, numVars);
+
+	double bounds[2] = {remainder.inf(), remainder.sup()};
+	fwrite(bounds, sizeof(double), 2, fp);
+}
+
+bool TaylorModel::load_binary(const char * & p, const char *end, const int numVars)
+{
+	double bounds[2];
+
+	if(!expansion.load_binary(p, end, numVars) || !read_binary(bounds, sizeof(bounds), p, end))
+	{
+		return false;
+	}
+
+	remainder.set(bounds[0], bounds[1]);
+
+	return true;
+}
+
 void TaylorModel::constant(Interval & result) const
 {
 	expansion.constant(result);
@@ -200,10 +219,7 @@ void TaylorModel::mul_ctrunc(TaylorModel & result, const TaylorModel & tm, const
 void TaylorModel::mul_ctrunc_normal(TaylorModel & result, const TaylorModel & tm, const vector<Interval> & step_exp_table, const int order) const
 {
 	Interval intZero;
-	Polynomial P1xP2;
-	Interval P1xI2, P2xI1, I1xI2;
-
-	P1xP2 = expansion * tm.expansion;
+	Interval P1xI2, P2xI1, I1xI2, intTrunc;
 
 	if(!tm.remainder.subseteq(intZero))
 	{
@@ -219,29 +235,26 @@ void TaylorModel::mul_ctrunc_normal(TaylorModel & result, const TaylorModel & tm
 
 	I1xI2 = remainder * tm.remainder;
 
-	result.expansion = P1xP2;
+	expansion.mul_ctrunc_normal(result.expansion, intTrunc, tm.expansion, step_exp_table, order);
 
 	result.remainder = I1xI2;
 	result.remainder += P2xI1;
 	result.remainder += P1xI2;
-
-	result.ctrunc_normal(step_exp_table, order);
+	result.remainder += intTrunc;
 
 	result.cutoff_normal(step_exp_table);
 }
 
 void TaylorModel::mul_no_remainder(TaylorModel & result, const TaylorModel & tm, const int order) const
 {
-	result.expansion = expansion * tm.expansion;
-	result.expansion.nctrunc(order);
+	expansion.mul_nctrunc(result.expansion, tm.expansion, order);
 
 	result.expansion.cutoff();
 }
 
 void TaylorModel::mul_no_remainder_no_cutoff(TaylorModel & result, const TaylorModel & tm, const int order) const
 {
-	result.expansion = expansion * tm.expansion;
-	result.expansion.nctrunc(order);
+	expansion.mul_nctrunc(result.expansion, tm.expansion, order);
 }
 
 void TaylorModel::mul(TaylorModel & result, const Interval & I) const
@@ -380,10 +393,7 @@ void TaylorModel::mul_insert_ctrunc(TaylorModel & result, const TaylorModel & tm
 void TaylorModel::mul_insert_ctrunc_normal(TaylorModel & result, const TaylorModel & tm, const Interval & tmPolyRange, const vector<Interval> & step_exp_table, const int order) const
 {
 	Interval intZero;
-	Polynomial P1xP2;
-	Interval P1xI2, P2xI1, I1xI2;
-
-	P1xP2 = expansion * tm.expansion;
+	Interval P1xI2, P2xI1, I1xI2, intTrunc;
 
 	if(!tm.remainder.subseteq(intZero))
 	{
@@ -398,23 +408,20 @@ void TaylorModel::mul_insert_ctrunc_normal(TaylorModel & result, const TaylorMod
 
 	I1xI2 = remainder * tm.remainder;
 
-	result.expansion = P1xP2;
+	expansion.mul_ctrunc_normal(result.expansion, intTrunc, tm.expansion, step_exp_table, order);
 
 	result.remainder = I1xI2;
 	result.remainder += P2xI1;
 	result.remainder += P1xI2;
+	result.remainder += intTrunc;
 
-	result.ctrunc_normal(step_exp_table, order);
 	result.cutoff_normal(step_exp_table);
 }
 
 void TaylorModel::mul_insert_ctrunc_normal(TaylorModel & result, Interval & tm1, Interval & intTrunc, const TaylorModel & tm, const Interval & tmPolyRange, const vector<Interval> & step_exp_table, const int order) const
 {
-	Polynomial P1xP2;
 	Interval P1xI2, P2xI1, I1xI2;
 
-	P1xP2 = expansion * tm.expansion;
-
 	Interval intZero;
 	tm1 = intZero;
 	intTrunc = intZero;
@@ -433,14 +440,12 @@ void TaylorModel::mul_insert_ctrunc_normal(TaylorModel & result, Interval & tm1,
 
 	I1xI2 = remainder * tm.remainder;
 
-	result.expansion = P1xP2;
+	expansion.mul_ctrunc_normal(result.expansion, intTrunc, tm.expansion, step_exp_table, order);
 
 	result.remainder = I1xI2;
 	result.remainder += P2xI1;
 	result.remainder += P1xI2;
 
-	result.expansion.ctrunc_normal(intTrunc, step_exp_table, order);
-
 	Interval intRound;
 	result.expansion.cutoff_normal(intRound, step_exp_table);
 	intTrunc += intRound;
@@ -498,26 +503,7 @@ void TaylorModel::div_assign(const Interval & I)
 void TaylorModel::derivative(TaylorModel & result, const int varIndex) const
 {
 	Interval intZero;
-	result = *this;
-
-	list<Monomial>::iterator iter;
-
-	for(iter = result.expansion.monomials.begin(); iter != result.expansion.monomials.end();)
-	{
-		if(iter->degrees[varIndex] > 0)
-		{
-			double tmp = iter->degrees[varIndex];
-			iter->degrees[varIndex] -= 1;
-			iter->d -= 1;
-			iter->coefficient.mul_assign(tmp);
-			++iter;
-		}
-		else
-		{
-			iter = result.expansion.monomials.erase(iter);
-		}
-	}
-
+	expansion.derivative(result.expansion, varIndex);
 	result.remainder = intZero;
 }
 
@@ -540,21 +526,19 @@ void TaylorModel::integral(TaylorModel & result, const Interval & I) const
 {
 	result = *this;
 
-	list<Monomial>::iterator iter;
+	vector<Monomial>::iterator iter;
 
 	for(iter = result.expansion.monomials.begin(); iter != result.expansion.monomials.end(); ++iter)
 	{
-		if(iter->degrees[0] > 0)
+		if(iter->getDegree(0) > 0)
 		{
-			iter->degrees[0] += 1;
-			iter->d += 1;
-			double tmp = iter->degrees[0];
+			iter->addDegree(0, 1);
+			double tmp = iter->getDegree(0);
 			iter->coefficient.div_assign(tmp);
 		}
 		else
 		{
-			iter->degrees[0] += 1;
-			iter->d += 1;
+			iter->addDegree(0, 1);
 		}
 	}
 
@@ -565,21 +549,19 @@ void TaylorModel::integral_no_remainder(TaylorModel & result) const
 {
 	result = *this;
 
-	list<Monomial>::iterator iter;
+	vector<Monomial>::iterator iter;
 
 	for(iter = result.expansion.monomials.begin(); iter != result.expansion.monomials.end(); ++iter)
 	{
-		if(iter->degrees[0] > 0)
+		if(iter->getDegree(0) > 0)
 		{
-			iter->degrees[0] += 1;
-			iter->d += 1;
-			double tmp = iter->degrees[0];
+			iter->addDegree(0, 1);
+			double tmp = iter->getDegree(0);
 			iter->coefficient.div_assign(tmp);
 		}
 		else
 		{
-			iter->degrees[0] += 1;
-			iter->d += 1;
+			iter->addDegree(0, 1);
 		}
 	}
 }
@@ -601,11 +583,11 @@ void TaylorModel::insert(TaylorModel & result, const TaylorModelVec & vars, cons
 	{
 		result = *this;
 
-		list<Monomial>::iterator iter;
+		vector<Monomial>::iterator iter;
 
 		for(iter = result.expansion.monomials.begin(); iter != result.expansion.monomials.end(); )
 		{
-			if( ((iter->d) - (iter->degrees[0])) > 0 )
+			if( ((iter->d) - (iter->getDegree(0))) > 0 )
 			{
 				iter = result.expansion.monomials.erase(iter);
 			}
@@ -631,11 +613,11 @@ void TaylorModel::insert_ctrunc(TaylorModel & result, const TaylorModelVec & var
 	{
 		result = *this;
 
-		list<Monomial>::iterator iter;
+		vector<Monomial>::iterator iter;
 
 		for(iter = result.expansion.monomials.begin(); iter != result.expansion.monomials.end(); )
 		{
-			if( ((iter->d) - (iter->degrees[0])) > 0 )
+			if( ((iter->d) - (iter->getDegree(0))) > 0 )
 			{
 				iter = result.expansion.monomials.erase(iter);
 			}
@@ -661,11 +643,11 @@ void TaylorModel::insert_no_remainder(TaylorModel & result, const TaylorModelVec
 	{
 		result = *this;
 
-		list<Monomial>::iterator iter;
+		vector<Monomial>::iterator iter;
 
 		for(iter = result.expansion.monomials.begin(); iter != result.expansion.monomials.end();)
 		{
-			if( ((iter->d) - (iter->degrees[0])) > 0 )
+			if( ((iter->d) - (iter->getDegree(0))) > 0 )
 			{
 				iter = result.expansion.monomials.erase(iter);
 			}
@@ -690,11 +672,11 @@ void TaylorModel::insert_no_remainder_no_cutoff(TaylorModel & result, const Tayl
 	{
 		result = *this;
 
-		list<Monomial>::iterator iter;
+		vector<Monomial>::iterator iter;
 
 		for(iter = result.expansion.monomials.begin(); iter != result.expansion.monomials.end();)
 		{
-			if( ((iter->d) - (iter->degrees[0])) > 0 )
+			if( ((iter->d) - (iter->getDegree(0))) > 0 )
 			{
 				iter = result.expansion.monomials.erase(iter);
 			}
@@ -719,11 +701,11 @@ void TaylorModel::insert_ctrunc_normal(TaylorModel & result, const TaylorModelVe
 	{
 		result = *this;
 
-		list<Monomial>::iterator iter;
+		vector<Monomial>::iterator iter;
 
 		for(iter = result.expansion.monomials.begin(); iter != result.expansion.monomials.end(); )
 		{
-			if( ((iter->d) - (iter->degrees[0])) > 0 )
+			if( ((iter->d) - (iter->getDegree(0))) > 0 )
 			{
 				iter = result.expansion.monomials.erase(iter);
 			}
@@ -751,14 +733,14 @@ void TaylorModel::evaluate_t(TaylorModel & result, const vector<Interval> & step
 	if(expansion.monomials.size() == 0)
 		return;
 
-	list<Monomial>::const_iterator iter;
+	vector<Monomial>::const_iterator iter;
 	Interval intZero;
 
 	if(step_exp_table[1].subseteq(intZero))		// t = 0
 	{
 		for(iter = expansion.monomials.begin(); iter != expansion.monomials.end(); ++iter)
 		{
-			if(iter->degrees[0] == 0)
+			if(iter->getDegree(0) == 0)
 			{
 				result.expansion.add_assign(*iter);
 			}
@@ -769,13 +751,12 @@ void TaylorModel::evaluate_t(TaylorModel & result, const vector<Interval> & step
 		for(iter = expansion.monomials.begin(); iter != expansion.monomials.end(); ++iter)
 		{
 			Monomial monoTemp = *iter;
-			int tmp = monoTemp.degrees[0];
+			int tmp = monoTemp.getDegree(0);
 
 			if(tmp > 0)
 			{
 				monoTemp.coefficient *= step_exp_table[tmp];
-				monoTemp.d -= tmp;
-				monoTemp.degrees[0] = 0;
+				monoTemp.addDegree(0, -tmp);
 			}
 
 			result.expansion.add_assign(monoTemp);
@@ -904,6 +885,8 @@ void TaylorModel::polyRange(Interval & result, const vector<Interval> & domain)
 
 void TaylorModel::polyRangeNormal(Interval & result, const vector<Interval> & step_exp_table) const
 {
+	ProfileScope scope(PHASE_RANGE_BOUNDING);
+
 	expansion.intEvalNormal(result, step_exp_table);
 }
 
@@ -1690,6 +1673,29 @@ void TaylorModelVec::dump_constant(FILE *fp, const vector<string> & stateVarName
 	fprintf(fp, "\n");
 }
 
+void TaylorModelVec::dump_binary(FILE *fp, const int numVars) const
+{
+	for(int i=0; i<tms.size(); ++i)
+	{
+		tms[i].dump_binary(fp, numVars);
+	}
+}
+
+bool TaylorModelVec::load_binary(const char * & p, const char *end, const int rangeDim, const int numVars)
+{
+	tms.resize(rangeDim);
+
+	for(int i=0; i<rangeDim; ++i)
+	{
+		if(!tms[i].load_binary(p, end, numVars))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void TaylorModelVec::constant(vector<Interval> & result) const
 {
 	result.clear();
@@ -2094,6 +2100,8 @@ void TaylorModelVec::cutoff()
 
 void TaylorModelVec::Picard_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<HornerForm> & ode, const int numVars, const int order) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	TaylorModelVec tmvTemp;
 
 	if(order <= 1)
@@ -2130,6 +2138,8 @@ void TaylorModelVec::Picard_no_remainder_assign(const TaylorModelVec & x0, const
 
 void TaylorModelVec::Picard_ctrunc_normal(TaylorModelVec & result, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerForm> & ode, const vector<Interval> & step_exp_table, const int numVars, const int order) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	TaylorModelVec tmvTemp;
 
 	if(order <= 1)
@@ -2164,22 +2174,20 @@ void TaylorModelVec::Picard_ctrunc_normal_assign(const TaylorModelVec & x0, cons
 	*this = result;
 }
 
-void TaylorModelVec::Picard_ctrunc_normal(TaylorModelVec & result, vector<RangeTree *> & trees, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerForm> & ode, const vector<Interval> & step_exp_table, const int numVars, const int order) const
+void TaylorModelVec::Picard_ctrunc_normal(TaylorModelVec & result, vector<vector<Interval> > & ranges, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerTape> & ode, const vector<Interval> & step_exp_table, const int numVars, const int order) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	TaylorModelVec tmvTemp;
 
-	trees.clear();
-	for(int i=0; i<ode.size(); ++i)
-	{
-		trees.push_back(NULL);
-	}
+	ranges.resize(ode.size());
 
 	if(order <= 1)
 	{
 		for(int i=0; i<ode.size(); ++i)
 		{
 			TaylorModel tmTemp;
-			ode[i].insert_ctrunc_normal(tmTemp, trees[i], *this, polyRange, step_exp_table, numVars, 0);
+			ode[i].insert_ctrunc_normal(tmTemp, ranges[i], *this, polyRange, step_exp_table, numVars, 0);
 			tmvTemp.tms.push_back(tmTemp);
 		}
 	}
@@ -2188,7 +2196,7 @@ void TaylorModelVec::Picard_ctrunc_normal(TaylorModelVec & result, vector<RangeT
 		for(int i=0; i<ode.size(); ++i)
 		{
 			TaylorModel tmTemp;
-			ode[i].insert_ctrunc_normal(tmTemp, trees[i], *this, polyRange, step_exp_table, numVars, order-1);
+			ode[i].insert_ctrunc_normal(tmTemp, ranges[i], *this, polyRange, step_exp_table, numVars, order-1);
 			tmvTemp.tms.push_back(tmTemp);
 		}
 	}
@@ -2199,28 +2207,26 @@ void TaylorModelVec::Picard_ctrunc_normal(TaylorModelVec & result, vector<RangeT
 	x0.add(result, tmvTemp2);
 }
 
-void TaylorModelVec::Picard_ctrunc_normal(TaylorModelVec & result, vector<RangeTree *> & trees, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerForm> & ode, const vector<Interval> & step_exp_table, const int numVars, const vector<int> & orders) const
+void TaylorModelVec::Picard_ctrunc_normal(TaylorModelVec & result, vector<vector<Interval> > & ranges, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerTape> & ode, const vector<Interval> & step_exp_table, const int numVars, const vector<int> & orders) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	TaylorModelVec tmvTemp;
 
-	trees.clear();
-	for(int i=0; i<ode.size(); ++i)
-	{
-		trees.push_back(NULL);
-	}
+	ranges.resize(ode.size());
 
 	for(int i=0; i<ode.size(); ++i)
 	{
 		if(orders[i] <= 1)
 		{
 			TaylorModel tmTemp;
-			ode[i].insert_ctrunc_normal(tmTemp, trees[i], *this, polyRange, step_exp_table, numVars, 0);
+			ode[i].insert_ctrunc_normal(tmTemp, ranges[i], *this, polyRange, step_exp_table, numVars, 0);
 			tmvTemp.tms.push_back(tmTemp);
 		}
 		else
 		{
 			TaylorModel tmTemp;
-			ode[i].insert_ctrunc_normal(tmTemp, trees[i], *this, polyRange, step_exp_table, numVars, orders[i]-1);
+			ode[i].insert_ctrunc_normal(tmTemp, ranges[i], *this, polyRange, step_exp_table, numVars, orders[i]-1);
 			tmvTemp.tms.push_back(tmTemp);
 		}
 	}
@@ -2231,14 +2237,18 @@ void TaylorModelVec::Picard_ctrunc_normal(TaylorModelVec & result, vector<RangeT
 	x0.add(result, tmvTemp2);
 }
 
-void TaylorModelVec::Picard_only_remainder(vector<Interval> & result, vector<RangeTree *> & trees, const TaylorModelVec & x0, const vector<HornerForm> & ode, const Interval & timeStep) const
+void TaylorModelVec::Picard_only_remainder(vector<Interval> & result, const vector<vector<Interval> > & ranges, const TaylorModelVec & x0, const vector<HornerTape> & ode, const Interval & timeStep) const
 {
+	ProfileScope scope(PHASE_REMAINDER);
+	stepLog->refine();
+
+	vector<Interval> registers;
 	result.clear();
 
 	for(int i=0; i<ode.size(); ++i)
 	{
 		Interval intTemp;
-		ode[i].insert_only_remainder(intTemp, trees[i], *this, timeStep);
+		ode[i].insert_only_remainder(intTemp, ranges[i], *this, timeStep, registers);
 		intTemp *= timeStep;
 		result.push_back(intTemp);
 	}
@@ -2246,6 +2256,8 @@ void TaylorModelVec::Picard_only_remainder(vector<Interval> & result, vector<Ran
 
 void TaylorModelVec::Picard_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<HornerForm> & ode, const int numVars, const vector<int> & orders, const vector<bool> & bIncreased) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	result = *this;
 
 	for(int i=0; i<ode.size(); ++i)
@@ -2278,6 +2290,8 @@ void TaylorModelVec::Picard_no_remainder_assign(const TaylorModelVec & x0, const
 
 void TaylorModelVec::Picard_ctrunc_normal(TaylorModelVec & result, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerForm> & ode, const vector<Interval> & step_exp_table, const int numVars, const vector<int> & orders) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	TaylorModelVec tmvTemp;
 
 	for(int i=0; i<ode.size(); ++i)
@@ -2308,35 +2322,22 @@ void TaylorModelVec::Picard_ctrunc_normal_assign(const TaylorModelVec & x0, cons
 }
 
 // using Taylor approximation
-void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<string> & strOde, const int order, const vector<Interval> & uncertainty_centers) const
+void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<Expression> & exprOde, const int order, const vector<Interval> & uncertainty_centers) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	TaylorModelVec tmvTemp;
 	Interval intZero;
-	int rangeDim = strOde.size();
+	int rangeDim = exprOde.size();
 
-	string prefix(str_prefix_taylor_polynomial);
-	string suffix(str_suffix);
+	int exprOrder = order <= 1 ? 0 : order-1;
 
-	parseSetting.clear();
-
-	parseSetting.flowpipe = *this;
-
-	if(order <= 1)
-	{
-		parseSetting.order = 0;
-	}
-	else
+	for(int i=0; i<exprOde.size(); ++i)
 	{
-		parseSetting.order = order-1;
-	}
-
-	for(int i=0; i<strOde.size(); ++i)
-	{
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-
-		parseODE();		// call the parser
+		Polynomial polyTemp;
+		exprOde[i].taylor_polynomial(polyTemp, *this, rangeDim+1, exprOrder);
 
-		TaylorModel tmTemp(parseResult.expansion, intZero);
+		TaylorModel tmTemp(polyTemp, intZero);
 
 		if(!uncertainty_centers[i].subseteq(intZero))
 		{
@@ -2353,45 +2354,32 @@ void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder(TaylorModelVec &
 	x0.add(result, tmvTemp2);
 }
 
-void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder_assign(const TaylorModelVec & x0, const vector<string> & strOde, const int order, const vector<Interval> & uncertainty_centers)
+void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder_assign(const TaylorModelVec & x0, const vector<Expression> & exprOde, const int order, const vector<Interval> & uncertainty_centers)
 {
 	TaylorModelVec result;
-	Picard_non_polynomial_taylor_no_remainder(result, x0, strOde, order, uncertainty_centers);
+	Picard_non_polynomial_taylor_no_remainder(result, x0, exprOde, order, uncertainty_centers);
 	*this = result;
 }
 
-void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<string> & strOde, const vector<int> & orders, const vector<bool> & bIncreased, const vector<Interval> & uncertainty_centers) const
+void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<int> & orders, const vector<bool> & bIncreased, const vector<Interval> & uncertainty_centers) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	result = *this;
 
 	Interval intZero;
-	int rangeDim = strOde.size();
-
-	string prefix(str_prefix_taylor_polynomial);
-	string suffix(str_suffix);
-
-	parseSetting.clear();
+	int rangeDim = exprOde.size();
 
-	parseSetting.flowpipe = *this;
-
-	for(int i=0; i<strOde.size(); ++i)
+	for(int i=0; i<exprOde.size(); ++i)
 	{
 		if(bIncreased[i])
 		{
-			if(orders[i] <= 1)
-			{
-				parseSetting.order = 0;
-			}
-			else
-			{
-				parseSetting.order = orders[i]-1;
-			}
-
-			parseSetting.strODE = prefix + strOde[i] + suffix;
+			int exprOrder = orders[i] <= 1 ? 0 : orders[i]-1;
 
-			parseODE();		// call the parser
+			Polynomial polyTemp;
+			exprOde[i].taylor_polynomial(polyTemp, *this, rangeDim+1, exprOrder);
 
-			TaylorModel tmTemp(parseResult.expansion, intZero);
+			TaylorModel tmTemp(polyTemp, intZero);
 
 			if(!uncertainty_centers[i].subseteq(intZero))
 			{
@@ -2406,43 +2394,29 @@ void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder(TaylorModelVec &
 	}
 }
 
-void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder_assign(const TaylorModelVec & x0, const vector<string> & strOde, const vector<int> & orders, const vector<bool> & bIncreased, const vector<Interval> & uncertainty_centers)
+void TaylorModelVec::Picard_non_polynomial_taylor_no_remainder_assign(const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<int> & orders, const vector<bool> & bIncreased, const vector<Interval> & uncertainty_centers)
 {
 	TaylorModelVec result;
-	Picard_non_polynomial_taylor_no_remainder(result, x0, strOde, orders, bIncreased, uncertainty_centers);
+	Picard_non_polynomial_taylor_no_remainder(result, x0, exprOde, orders, bIncreased, uncertainty_centers);
 	*this = result;
 }
 
-void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec & result, const TaylorModelVec & x0, const vector<string> & strOde, const vector<Interval> & step_exp_table, const int order, const vector<Interval> & uncertainty_centers) const
+void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec & result, list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<Interval> & step_exp_table, const int order, const vector<Interval> & uncertainty_centers) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	TaylorModelVec tmvTemp;
 	Interval intZero;
-	int rangeDim = strOde.size();
+	int rangeDim = exprOde.size();
 
-	string prefix(str_prefix_taylor_picard);
-	string suffix(str_suffix);
-
-	parseSetting.clear();
+	ranges.clear();
 
-	parseSetting.flowpipe = *this;
-	parseSetting.step_exp_table = step_exp_table;
+	int exprOrder = order <= 1 ? 0 : order-1;
 
-	if(order <= 1)
+	for(int i=0; i<exprOde.size(); ++i)
 	{
-		parseSetting.order = 0;
-	}
-	else
-	{
-		parseSetting.order = order-1;
-	}
-
-	for(int i=0; i<strOde.size(); ++i)
-	{
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-
-		parseODE();		// call the parser
-
-		TaylorModel tmTemp(parseResult.expansion, parseResult.remainder);
+		TaylorModel tmTemp;
+		exprOde[i].taylor_picard(tmTemp, ranges, *this, step_exp_table, rangeDim+1, exprOrder);
 
 		if(!uncertainty_centers[i].subseteq(intZero))
 		{
@@ -2459,43 +2433,29 @@ void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec &
 	x0.add(result, tmvTemp2);
 }
 
-void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal_assign(const TaylorModelVec & x0, const vector<string> & strOde, const vector<Interval> & step_exp_table, const int order, const vector<Interval> & uncertainty_centers)
+void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal_assign(list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<Interval> & step_exp_table, const int order, const vector<Interval> & uncertainty_centers)
 {
 	TaylorModelVec result;
-	Picard_non_polynomial_taylor_ctrunc_normal(result, x0, strOde, step_exp_table, order, uncertainty_centers);
+	Picard_non_polynomial_taylor_ctrunc_normal(result, ranges, x0, exprOde, step_exp_table, order, uncertainty_centers);
 	*this = result;
 }
 
-void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec & result, const TaylorModelVec & x0, const vector<string> & strOde, const vector<Interval> & step_exp_table, const vector<int> & orders, const vector<Interval> & uncertainty_centers) const
+void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec & result, list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<Interval> & step_exp_table, const vector<int> & orders, const vector<Interval> & uncertainty_centers) const
 {
+	ProfileScope scope(PHASE_PICARD);
+
 	TaylorModelVec tmvTemp;
 	Interval intZero;
-	int rangeDim = strOde.size();
-
-	string prefix(str_prefix_taylor_picard);
-	string suffix(str_suffix);
+	int rangeDim = exprOde.size();
 
-	parseSetting.clear();
-
-	parseSetting.flowpipe = *this;
-	parseSetting.step_exp_table = step_exp_table;
+	ranges.clear();
 
-	for(int i=0; i<strOde.size(); ++i)
+	for(int i=0; i<exprOde.size(); ++i)
 	{
-		if(orders[i] <= 1)
-		{
-			parseSetting.order = 0;
-		}
-		else
-		{
-			parseSetting.order = orders[i]-1;
-		}
-
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-
-		parseODE();		// call the parser
+		int exprOrder = orders[i] <= 1 ? 0 : orders[i]-1;
 
-		TaylorModel tmTemp(parseResult.expansion, parseResult.remainder);
+		TaylorModel tmTemp;
+		exprOde[i].taylor_picard(tmTemp, ranges, *this, step_exp_table, rangeDim+1, exprOrder);
 
 		if(!uncertainty_centers[i].subseteq(intZero))
 		{
@@ -2512,73 +2472,51 @@ void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec &
 	x0.add(result, tmvTemp2);
 }
 
-void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal_assign(const TaylorModelVec & x0, const vector<string> & strOde, const vector<Interval> & step_exp_table, const vector<int> & orders, const vector<Interval> & uncertainty_centers)
+void TaylorModelVec::Picard_non_polynomial_taylor_ctrunc_normal_assign(list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<Interval> & step_exp_table, const vector<int> & orders, const vector<Interval> & uncertainty_centers)
 {
 	TaylorModelVec result;
-	Picard_non_polynomial_taylor_ctrunc_normal(result, x0, strOde, step_exp_table, orders, uncertainty_centers);
+	Picard_non_polynomial_taylor_ctrunc_normal(result, ranges, x0, exprOde, step_exp_table, orders, uncertainty_centers);
 	*this = result;
 }
 
-void TaylorModelVec::Picard_non_polynomial_taylor_only_remainder(vector<Interval> & result, const TaylorModelVec & x0, const vector<string> & strOde, const Interval & timeStep, const int order) const
+void TaylorModelVec::Picard_non_polynomial_taylor_only_remainder(vector<Interval> & result, list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const Interval & timeStep, const int order) const
 {
-	result.clear();
+	ProfileScope scope(PHASE_REMAINDER);
+	stepLog->refine();
 
-	string prefix(str_prefix_taylor_remainder);
-	string suffix(str_suffix);
+	result.clear();
 
-	parseSetting.flowpipe = *this;
-	parseSetting.iterRange = parseSetting.ranges.begin();
+	list<Interval>::iterator iterRange = ranges.begin();
 
-	if(order <= 1)
-	{
-		parseSetting.order = 0;
-	}
-	else
-	{
-		parseSetting.order = order-1;
-	}
+	int exprOrder = order <= 1 ? 0 : order-1;
 
-	for(int i=0; i<strOde.size(); ++i)
+	for(int i=0; i<exprOde.size(); ++i)
 	{
 		Interval intTemp;
+		exprOde[i].taylor_remainder(intTemp, iterRange, *this, exprOrder);
 
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-
-		parseODE();		// call the parser
-
-		intTemp = parseResult.remainder * timeStep;
+		intTemp *= timeStep;
 		result.push_back(intTemp);
 	}
 }
 
-void TaylorModelVec::Picard_non_polynomial_taylor_only_remainder(vector<Interval> & result, const TaylorModelVec & x0, const vector<string> & strOde, const Interval & timeStep, const vector<int> & orders) const
+void TaylorModelVec::Picard_non_polynomial_taylor_only_remainder(vector<Interval> & result, list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const Interval & timeStep, const vector<int> & orders) const
 {
-	result.clear();
+	ProfileScope scope(PHASE_REMAINDER);
+	stepLog->refine();
 
-	string prefix(str_prefix_taylor_remainder);
-	string suffix(str_suffix);
+	result.clear();
 
-	parseSetting.flowpipe = *this;
-	parseSetting.iterRange = parseSetting.ranges.begin();
+	list<Interval>::iterator iterRange = ranges.begin();
 
-	for(int i=0; i<strOde.size(); ++i)
+	for(int i=0; i<exprOde.size(); ++i)
 	{
-		if(orders[i] <= 1)
-		{
-			parseSetting.order = 0;
-		}
-		else
-		{
-			parseSetting.order = orders[i]-1;
-		}
+		int exprOrder = orders[i] <= 1 ? 0 : orders[i]-1;
 
 		Interval intTemp;
+		exprOde[i].taylor_remainder(intTemp, iterRange, *this, exprOrder);
 
-		parseSetting.strODE = prefix + strOde[i] + suffix;
-
-		parseODE();		// call the parser
-
-		intTemp = parseResult.remainder * timeStep;
+		intTemp *= timeStep;
 		result.push_back(intTemp);
 	}
 }
@@ -2654,6 +2592,8 @@ void TaylorModelVec::polyRange(vector<Interval> & result, const vector<Interval>
 
 void TaylorModelVec::polyRangeNormal(vector<Interval> & result, const vector<Interval> & step_exp_table) const
 {
+	ProfileScope scope(PHASE_RANGE_BOUNDING);
+
 	result.clear();
 
 	for(int i=0; i<tms.size(); ++i)
@@ -2695,33 +2635,23 @@ TaylorModelVec & TaylorModelVec::operator = (const TaylorModelVec & tmv)
 ParseSetting::ParseSetting()
 {
 	iterRange = ranges.begin();
-	order = 0;
 }
 
 ParseSetting::ParseSetting(const ParseSetting & setting)
 {
-	strODE = setting.strODE;
-
 	ranges = setting.ranges;
 	iterRange = setting.iterRange;
-
-	step_exp_table = setting.step_exp_table;
-	flowpipe = setting.flowpipe;
-	order = setting.order;
 }
 
 ParseSetting::~ParseSetting()
 {
 	ranges.clear();
-	step_exp_table.clear();
 }
 
 void ParseSetting::clear()
 {
 	ranges.clear();
 	iterRange = ranges.begin();
-
-	step_exp_table.clear();
 }
 
 ParseSetting & ParseSetting::operator = (const ParseSetting & setting)
@@ -2729,15 +2659,9 @@ ParseSetting & ParseSetting::operator = (const ParseSetting & setting)
 	if(this == &setting)
 		return *this;
 
-	strODE = setting.strODE;
-
 	ranges = setting.ranges;
 	iterRange = setting.iterRange;
 
-	step_exp_table = setting.step_exp_table;
-	flowpipe = setting.flowpipe;
-	order = setting.order;
-
 	return *this;
 }
 
@@ -2777,8 +2701,7 @@ ParseResult::ParseResult()
 
 ParseResult::ParseResult(const ParseResult & result)
 {
-	expansion = result.expansion;
-	remainder = result.remainder;
+	expression = result.expression;
 }
 
 ParseResult::~ParseResult()
@@ -2790,8 +2713,7 @@ ParseResult & ParseResult::operator = (const ParseResult & result)
 	if(this == &result)
 		return *this;
 
-	expansion = result.expansion;
-	remainder = result.remainder;
+	expression = result.expression;
 
 	return *this;
 }
@@ -2829,7 +2751,7 @@ void exp_taylor_remainder(Interval & result, const Interval & tmRange, const int
 	J *= tmRange;
 	J.exp_assign();
 
-	result = factorial_rec[order] * intProd * J;
+	result = factorialTables->factorial_rec[order] * intProd * J;
 }
 
 void rec_taylor_remainder(Interval & result, const Interval & tmRange, const int order)
@@ -2886,7 +2808,7 @@ void sin_taylor_remainder(Interval & result, const Interval & C, const Interval
 		break;
 	}
 
-	result = factorial_rec[order] * intProd * J;
+	result = factorialTables->factorial_rec[order] * intProd * J;
 }
 
 void cos_taylor_remainder(Interval & result, const Interval & C, const Interval & tmRange, const int order)
@@ -2922,7 +2844,7 @@ void cos_taylor_remainder(Interval & result, const Interval & C, const Interval
 		break;
 	}
 
-	result = factorial_rec[order] * intProd * J;
+	result = factorialTables->factorial_rec[order] * intProd * J;
 }
 
 void log_taylor_remainder(Interval & result, const Interval & tmRange, const int order)
@@ -2977,7 +2899,7 @@ void sqrt_taylor_remainder(Interval & result, const Interval & tmRange, const in
 
 	if(order > 1)
 	{
-		result = double_factorial[2*order-3] * factorial_rec[order] * intProd;
+		result = factorialTables->double_factorial[2*order-3] * factorialTables->factorial_rec[order] * intProd;
 	}
 	else
 	{
@@ -11,6 +11,8 @@
 #define TAYLORMODEL_H_
 
 #include "Polynomial.h"
+#include "Expression.h"
+#include "Profiler.h"
 
 class TaylorModel			// Taylor models: R^n -> R. We use t to denote the time variable and x to denote the state variable.
 {
@@ -31,6 +33,8 @@ public:
 	void clear();
 	void dump_interval(FILE *fp, const vector<string> & varNames) const;
 	void dump_constant(FILE *fp, const vector<string> & varNames) const;
+	void dump_binary(FILE *fp, const int numVars) const;
+	bool load_binary(const char * & p, const char *end, const int numVars);
 	void constant(Interval & result) const;									// Return the constant part of the expansion.
 
 	void intEval(Interval & result, const vector<Interval> & domain) const;
@@ -123,7 +127,9 @@ public:
 	TaylorModel & operator = (const TaylorModel & tm);
 
 	friend class HornerForm;
+	friend class HornerTape;
 	friend class Polynomial;
+	friend class Expression;
 	friend class TaylorModelVec;
 	friend class Flowpipe;
 	friend class ContinuousSystem;
@@ -151,6 +157,8 @@ public:
 	void clear();
 	void dump_interval(FILE *fp, const vector<string> & stateVarNames, const vector<string> & tmVarNames) const;
 	void dump_constant(FILE *fp, const vector<string> & stateVarNames, const vector<string> & tmVarNames) const;
+	void dump_binary(FILE *fp, const int numVars) const;
+	bool load_binary(const char * & p, const char *end, const int rangeDim, const int numVars);
 	void constant(vector<Interval> & result) const;
 
 	void intEval(vector<Interval> & result, const vector<Interval> & domain) const;
@@ -215,9 +223,9 @@ public:
 	void Picard_ctrunc_normal(TaylorModelVec & result, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerForm> & ode, const vector<Interval> & step_exp_table, const int numVars, const int order) const;
 	void Picard_ctrunc_normal_assign(const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerForm> & ode, const vector<Interval> & step_exp_table, const int numVars, const int order);
 
-	void Picard_ctrunc_normal(TaylorModelVec & result, vector<RangeTree *> & trees, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerForm> & ode, const vector<Interval> & step_exp_table, const int numVars, const int order) const;
-	void Picard_ctrunc_normal(TaylorModelVec & result, vector<RangeTree *> & trees, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerForm> & ode, const vector<Interval> & step_exp_table, const int numVars, const vector<int> & orders) const;
-	void Picard_only_remainder(vector<Interval> & result, vector<RangeTree *> & trees, const TaylorModelVec & x0, const vector<HornerForm> & ode, const Interval & timeStep) const;
+	void Picard_ctrunc_normal(TaylorModelVec & result, vector<vector<Interval> > & ranges, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerTape> & ode, const vector<Interval> & step_exp_table, const int numVars, const int order) const;
+	void Picard_ctrunc_normal(TaylorModelVec & result, vector<vector<Interval> > & ranges, const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerTape> & ode, const vector<Interval> & step_exp_table, const int numVars, const vector<int> & orders) const;
+	void Picard_only_remainder(vector<Interval> & result, const vector<vector<Interval> > & ranges, const TaylorModelVec & x0, const vector<HornerTape> & ode, const Interval & timeStep) const;
 
 	void Picard_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<HornerForm> & ode, const int numVars, const vector<int> & orders, const vector<bool> & bIncreased) const;
 	void Picard_no_remainder_assign(const TaylorModelVec & x0, const vector<HornerForm> & ode, const int numVars, const vector<int> & orders, const vector<bool> & bIncreased);
@@ -225,20 +233,20 @@ public:
 	void Picard_ctrunc_normal_assign(const TaylorModelVec & x0, const vector<Interval> & polyRange, const vector<HornerForm> & ode, const vector<Interval> & step_exp_table, const int numVars, const vector<int> & orders);
 
 	// using Taylor approximation
-	void Picard_non_polynomial_taylor_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<string> & strOde, const int order, const vector<Interval> & uncertainty_centers) const;
-	void Picard_non_polynomial_taylor_no_remainder_assign(const TaylorModelVec & x0, const vector<string> & strOde, const int order, const vector<Interval> & uncertainty_centers);
+	void Picard_non_polynomial_taylor_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<Expression> & exprOde, const int order, const vector<Interval> & uncertainty_centers) const;
+	void Picard_non_polynomial_taylor_no_remainder_assign(const TaylorModelVec & x0, const vector<Expression> & exprOde, const int order, const vector<Interval> & uncertainty_centers);
 
-	void Picard_non_polynomial_taylor_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<string> & strOde, const vector<int> & orders, const vector<bool> & bIncreased, const vector<Interval> & uncertainty_centers) const;
-	void Picard_non_polynomial_taylor_no_remainder_assign(const TaylorModelVec & x0, const vector<string> & strOde, const vector<int> & orders, const vector<bool> & bIncreased, const vector<Interval> & uncertainty_centers);
+	void Picard_non_polynomial_taylor_no_remainder(TaylorModelVec & result, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<int> & orders, const vector<bool> & bIncreased, const vector<Interval> & uncertainty_centers) const;
+	void Picard_non_polynomial_taylor_no_remainder_assign(const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<int> & orders, const vector<bool> & bIncreased, const vector<Interval> & uncertainty_centers);
 
-	void Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec & result, const TaylorModelVec & x0, const vector<string> & strOde, const vector<Interval> & step_exp_table, const int order, const vector<Interval> & uncertainty_centers) const;
-	void Picard_non_polynomial_taylor_ctrunc_normal_assign(const TaylorModelVec & x0, const vector<string> & strOde, const vector<Interval> & step_exp_table, const int order, const vector<Interval> & uncertainty_centers);
+	void Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec & result, list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<Interval> & step_exp_table, const int order, const vector<Interval> & uncertainty_centers) const;
+	void Picard_non_polynomial_taylor_ctrunc_normal_assign(list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<Interval> & step_exp_table, const int order, const vector<Interval> & uncertainty_centers);
 
-	void Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec & result, const TaylorModelVec & x0, const vector<string> & strOde, const vector<Interval> & step_exp_table, const vector<int> & orders, const vector<Interval> & uncertainty_centers) const;
-	void Picard_non_polynomial_taylor_ctrunc_normal_assign(const TaylorModelVec & x0, const vector<string> & strOde, const vector<Interval> & step_exp_table, const vector<int> & orders, const vector<Interval> & uncertainty_centers);
+	void Picard_non_polynomial_taylor_ctrunc_normal(TaylorModelVec & result, list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<Interval> & step_exp_table, const vector<int> & orders, const vector<Interval> & uncertainty_centers) const;
+	void Picard_non_polynomial_taylor_ctrunc_normal_assign(list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const vector<Interval> & step_exp_table, const vector<int> & orders, const vector<Interval> & uncertainty_centers);
 
-	void Picard_non_polynomial_taylor_only_remainder(vector<Interval> & result, const TaylorModelVec & x0, const vector<string> & strOde, const Interval & timeStep, const int order) const;
-	void Picard_non_polynomial_taylor_only_remainder(vector<Interval> & result, const TaylorModelVec & x0, const vector<string> & strOde, const Interval & timeStep, const vector<int> & orders) const;
+	void Picard_non_polynomial_taylor_only_remainder(vector<Interval> & result, list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const Interval & timeStep, const int order) const;
+	void Picard_non_polynomial_taylor_only_remainder(vector<Interval> & result, list<Interval> & ranges, const TaylorModelVec & x0, const vector<Expression> & exprOde, const Interval & timeStep, const vector<int> & orders) const;
 
 	void normalize(vector<Interval> & domain);		// we assume that the original domain is full-dimensional
 
@@ -248,18 +256,12 @@ public:
 	TaylorModelVec & operator = (const TaylorModelVec & tmv);
 };
 
-class ParseSetting
+class ParseSetting					// the intermediate ranges shared by the Picard and the remainder evaluations of a non-polynomial ODE
 {
 public:
-	string strODE;
-
 	list<Interval> ranges;
 	list<Interval>::iterator iterRange;
 
-	vector<Interval> step_exp_table;
-	TaylorModelVec flowpipe;
-	int order;
-
 	ParseSetting();
 	ParseSetting(const ParseSetting & setting);
 	~ParseSetting();
@@ -269,11 +271,10 @@ public:
 	ParseSetting & operator = (const ParseSetting & setting);
 };
 
-class ParseResult					// the data structure of a parsed non-polynomial ODE with its remainder
+class ParseResult					// the data structure of a parsed non-polynomial ODE
 {
 public:
-	Polynomial expansion;
-	Interval remainder;
+	Expression expression;
 
 	ParseResult();
 	ParseResult(const ParseResult & result);
@@ -296,7 +297,4 @@ void cos_taylor_only_remainder(Interval & result, const Interval & remainder, li
 void log_taylor_only_remainder(Interval & result, const Interval & remainder, list<Interval>::iterator & iterRange, const int order);
 void sqrt_taylor_only_remainder(Interval & result, const Interval & remainder, list<Interval>::iterator & iterRange, const int order);
 
-extern ParseSetting parseSetting;
-extern ParseResult parseResult;
-
 #endif /* TAYLORMODEL_H_ */
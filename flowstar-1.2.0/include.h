@@ -15,8 +15,15 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 
 #include <cmath>
+#include <cfloat>
+#include <climits>
 #include <mpfr.h>
 #include <vector>
 #include <string>
@@ -45,6 +52,7 @@ const int high_precision	=	256;
 
 #define DC_THRESHOLD_SEARCH 	1e-5
 #define DC_THRESHOLD_IMPROV		0.9
+#define DC_CONTRACTOR_ROUNDS	8			// the maximum number of rounds of the HC4 and Newton contractors
 
 #define ID_PRE			0
 #define QR_PRE			1
@@ -72,12 +80,36 @@ const int high_precision	=	256;
 #define PARA_AGGREG		1
 #define PCA_AGGREG		2
 
+#define TASK_NONE					0
+#define TASK_CONTINUOUS				1		// compute the flowpipes of a continuous system
+#define TASK_HYBRID					2
+#define TASK_CONTINUOUS_FLOWPIPES	3		// plot and check the flowpipes given in the model file
+#define TASK_HYBRID_FLOWPIPES		4
+
 #define MSG_SIZE		100
 #define NUM_LENGTH		50
 
 #define LOW_DEGREE				1
 #define HIGH_DEGREE				2
 #define NONPOLY_TAYLOR			3
+#define LINEAR_ODE				4
+
+// instructions of a HornerTape
+#define HORNER_CONST			0
+#define HORNER_ZERO				1
+#define HORNER_MUL_ADD			2
+#define HORNER_CONST_MUL_ADD	3
+
+// the profiled phases
+#define PHASE_PICARD			0
+#define PHASE_REMAINDER			1
+#define PHASE_PRECONDITION		2
+#define PHASE_RANGE_BOUNDING	3
+#define PHASE_COMPOSITION		4
+#define PHASE_CONTRACTION		5
+#define PHASE_AGGREGATION		6
+#define PHASE_RESET				7
+#define NUM_PHASES				8
 
 const char str_pi_up[]	=	"3.14159265358979323846264338327950288419716939937511";
 const char str_pi_lo[]	=	"3.14159265358979323846264338327950288419716939937510";
@@ -87,10 +119,6 @@ const char imageDir[] = "./images/";
 const char counterexampleDir[] = "./counterexamples/";
 const char local_var_name[] = "local_var_";
 
-const char str_prefix_taylor_picard[] = "taylor picard { ";
-const char str_prefix_taylor_remainder[] = "taylor remainder { ";
-const char str_prefix_taylor_polynomial[] = "taylor polynomial { ";
-
 const char str_prefix_combination_picard[] = "combination picard { ";
 const char str_prefix_combination_remainder[] = "combination remainder { ";
 const char str_prefix_combination_polynomial[] = "combination polynomial { ";
@@ -98,11 +126,23 @@ const char str_prefix_combination_polynomial[] = "combination polynomial { ";
 const char str_suffix[] = " }";
 
 const char str_counterexample_dumping_name_suffix[] = ".counterexample";
+const char str_binary_dumping_name_suffix[] = ".flowb";
+const char str_profile_name_suffix[] = ".profile.json";
+const char str_step_log_name_suffix[] = ".steps.jsonl";
+const char str_batch_log_name_suffix[] = ".log";
 
-extern int lineNum;
+// the binary flowpipe file consists of a header and a sequence of records, the numbers are in the byte order of the writer
+const char str_flowpipe_file_magic[] = "FLOW*BIN";
 
-using namespace std;
+#define FLOWPIPE_FILE_VERSION		1
+#define FLOWPIPE_FILE_BOM			0x01020304
+#define FLOWPIPE_FILE_CONTINUOUS	0
+#define FLOWPIPE_FILE_HYBRID		1
 
-extern void parseODE();
+#define FLOWPIPE_RECORD_END			0
+#define FLOWPIPE_RECORD_FLOWPIPE	1
+#define FLOWPIPE_RECORD_MODE		2
+
+using namespace std;
 
 #endif /* INCLUDE_H_ */
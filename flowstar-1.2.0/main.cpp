@@ -0,0 +1,77 @@
+/*---
+  Flow*: A Taylor Model Based Flowpipe analyzer.
+  Authors: Xin Chen, Erika Abraham and Sriram Sankaranarayanan.
+  Email: Xin Chen <xin.chen@cs.rwth-aachen.de> if you have questions or comments.
+
+  The code is released as is under the GNU General Public License (GPL). Please consult the file LICENSE.txt for
+  further information.
+---*/
+
+#include "Batch.h"
+
+// usage: flowstar < model
+//        flowstar -b manifest [-t threads] [-r report.csv]
+int main(int argc, char *argv[])
+{
+	const char *manifest = NULL;
+	const char *report = NULL;
+	int numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+	int opt;
+
+	while((opt = getopt(argc, argv, "b:t:r:")) != -1)
+	{
+		switch(opt)
+		{
+		case 'b':
+			manifest = optarg;
+			break;
+		case 't':
+			numThreads = atoi(optarg);
+			break;
+		case 'r':
+			report = optarg;
+			break;
+		default:
+			return 2;
+		}
+	}
+
+	if(manifest == NULL)
+	{
+		Analysis analysis;
+
+		if(!analysis.parse(stdin))
+		{
+			return 1;
+		}
+
+		return analysis.run() ? 0 : 1;
+	}
+
+	Batch batch;
+	batch.numThreads = numThreads > 0 ? numThreads : 1;
+
+	if(!batch.load(manifest))
+	{
+		return 1;
+	}
+
+	bool bSucceeded = batch.run();
+	batch.dump_summary(stdout);
+
+	if(report != NULL)
+	{
+		FILE *fp = fopen(report, "w");
+
+		if(fp == NULL)
+		{
+			printf("Can not create the report %s.\n", report);
+			return 1;
+		}
+
+		batch.dump_csv(fp);
+		fclose(fp);
+	}
+
+	return bSucceeded ? 0 : 1;
+}
@@ -0,0 +1,525 @@
+/*---
+  Flow*: A Taylor Model Based Flowpipe analyzer.
+  Authors: Xin Chen, Erika Abraham and Sriram Sankaranarayanan.
+  Email: Xin Chen <xin.chen@cs.rwth-aachen.de> if you have questions or comments.
+
+  The code is released as is under the GNU General Public License (GPL). Please consult the file LICENSE.txt for
+  further information.
+---*/
+
+/*
+ * Microbenchmarks of the interval, polynomial and Taylor model kernels. The inputs are either taken from the first
+ * mode of a model, i.e., the Taylor models are the flowpipe of one step computed by Picard iteration, or generated
+ * randomly with the given dimension, order and term density.
+ *
+ * usage: microbench [-m thermostat|airplane] [-d dimension] [-o order] [-p density] [-s step] [-t seconds]
+ *                   [-n iterations] [-k kernel,...]
+ *
+ * The allocations are the calls of the C++ operator new, the allocations made by the C libraries are not counted.
+ */
+
+#include "Continuous.h"
+
+#if __cplusplus >= 201103L
+#define NEW_SPECIFIER
+#define DELETE_SPECIFIER	noexcept
+#else
+#define NEW_SPECIFIER		throw(std::bad_alloc)
+#define DELETE_SPECIFIER	throw()
+#endif
+
+#define NUM_SAMPLES		16			// the number of the inputs a kernel cycles through
+
+static unsigned long long numAllocations = 0;
+
+void *operator new(size_t size) NEW_SPECIFIER
+{
+	++numAllocations;
+	void *p = malloc(size > 0 ? size : 1);
+
+	if(p == NULL)
+	{
+		throw std::bad_alloc();
+	}
+
+	return p;
+}
+
+void *operator new[](size_t size) NEW_SPECIFIER
+{
+	++numAllocations;
+	void *p = malloc(size > 0 ? size : 1);
+
+	if(p == NULL)
+	{
+		throw std::bad_alloc();
+	}
+
+	return p;
+}
+
+void operator delete(void *p) DELETE_SPECIFIER
+{
+	free(p);
+}
+
+void operator delete[](void *p) DELETE_SPECIFIER
+{
+	free(p);
+}
+
+// the inputs of the kernels
+static int dimension = 3;
+static int order = 4;
+static double density = 0.5;
+static double step = 0.01;
+
+static vector<Interval> step_exp_table, step_end_exp_table;
+static vector<HornerForm> ode;
+static TaylorModelVec flowpipe;				// the Taylor models over the domain [0,step] x [-1,1]^dimension
+static vector<Interval> flowpipePolyRange;
+static vector<Interval> domain;
+static vector<PolynomialConstraint> constraints;
+
+static vector<Interval> intervalsA, intervalsB;
+static vector<Polynomial> polynomialsA, polynomialsB;
+static vector<TaylorModel> tmsA, tmsB;
+
+// the states changed by the kernels
+static Interval intervalResult;
+static Polynomial polynomialResult;
+static TaylorModel tmResult;
+static Matrix matrixResult;
+static Matrix matrixInverse;
+static TaylorModelVec contractedFlowpipe;
+static vector<Interval> contractedDomain;
+static vector<bool> boundary_intersected;
+
+static unsigned long long randomState = 20150501ULL;
+
+static double random_uniform(const double lo, const double up)
+{
+	randomState = randomState * 6364136223846793005ULL + 1442695040888963407ULL;
+	return lo + (up - lo) * (double)(randomState >> 11) / 9007199254740992.0;
+}
+
+// a polynomial over t and the state variables of degree at most maxDegree, a monomial is kept with the given probability
+static void random_polynomial(Polynomial & result, const int numVars, const int maxDegree, const double prob, const bool bTime)
+{
+	list<Monomial> monomials;
+	vector<int> degrees(numVars, 0);
+
+	for(;;)
+	{
+		int d = 0;
+		for(int i=0; i<numVars; ++i)
+		{
+			d += degrees[i];
+		}
+
+		if(d <= maxDegree && (bTime || degrees[0] == 0) && random_uniform(0, 1) < prob)
+		{
+			double c = random_uniform(-1, 1);
+			monomials.push_back(Monomial(Interval(c - 1e-12, c + 1e-12), degrees));
+		}
+
+		// the next degree vector in the lexicographic order
+		int k = numVars - 1;
+		for(; k >= 0 && degrees[k] == maxDegree; --k)
+		{
+			degrees[k] = 0;
+		}
+
+		if(k < 0)
+		{
+			break;
+		}
+
+		++degrees[k];
+	}
+
+	if(monomials.size() == 0)
+	{
+		monomials.push_back(Monomial(Interval(1.0, 1.0), numVars));
+	}
+
+	result = Polynomial(monomials);
+}
+
+static void linear_polynomial(Polynomial & result, const double constant, const vector<double> & coefficients)
+{
+	vector<Interval> intCoefficients;
+	intCoefficients.push_back(Interval(0.0));
+
+	for(int i=0; i<coefficients.size(); ++i)
+	{
+		intCoefficients.push_back(Interval(coefficients[i]));
+	}
+
+	result = Polynomial(intCoefficients);
+	result += Polynomial(Interval(constant), coefficients.size() + 1);
+}
+
+// the ODE of the first mode and the initial set of a model
+static bool model_ode(vector<Polynomial> & rhs, vector<Interval> & box, const string & model)
+{
+	if(model == "thermostat")
+	{
+		// models/thermostat/thermostat_double_sat.model, mode1
+		double x1[] = {-0.015 * 0.99, -0.015 * 0.01, 0};
+		double x2[] = {-0.045 * 0.01, -0.045 * 0.99, 0};
+		double tau[] = {0, 0, 0};
+
+		rhs.resize(3);
+		linear_polynomial(rhs[0], 1.5, vector<double>(x1, x1+3));
+		linear_polynomial(rhs[1], 9.0, vector<double>(x2, x2+3));
+		linear_polynomial(rhs[2], 1.0, vector<double>(tau, tau+3));
+
+		box.push_back(Interval(19.0, 21.0));
+		box.push_back(Interval(19.0, 21.0));
+		box.push_back(Interval(0.0, 0.0));
+	}
+	else if(model == "airplane")
+	{
+		// models/airplane/airplane_single_sat.model, mode1
+		double g = 9.80555 / 92.827721;
+		double rows[10][10] = {
+			{-0.099593, 0, -1, g, 0, 0, 0.740361, 0, 0, 0},
+			{-1.700982, -1.184647, 0.223908, 0, 0, 0.531304, 0.049766, 0, 0, 0},
+			{0.407420, -0.056276, -0.188010, 0, 0, 0.005685, -0.106592, 0, 0, 0},
+			{0, 1, 0, 0, 0, 0, 0, 0, 0, 0},
+			{0, 0, 0, g, 0, 0, 0, 0, 0, 0}};
+		double constants[10] = {0, 0, 0, 0, 0, 0.25, 0.5, 0, 0, 1};
+
+		rhs.resize(10);
+		for(int i=0; i<10; ++i)
+		{
+			linear_polynomial(rhs[i], constants[i], vector<double>(rows[i], rows[i]+10));
+			box.push_back(Interval(0.0, 0.0));
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	// a point initial set is widened such that the Taylor models depend on the state variables
+	for(int i=0; i<box.size(); ++i)
+	{
+		if(box[i].width() < 1e-3)
+		{
+			box[i] = Interval(box[i].inf() - 5e-4, box[i].sup() + 5e-4);
+		}
+	}
+
+	return true;
+}
+
+static void prepare_inputs(const string & model)
+{
+	compute_factorial_rec(2*order+2);
+	compute_power_4(2*order+2);
+	compute_double_factorial(4*order+4);
+
+	construct_step_exp_table(step_exp_table, step_end_exp_table, step, 2*order);
+
+	vector<Polynomial> rhs;
+	vector<Interval> box;
+
+	if(!model_ode(rhs, box, model))
+	{
+		// a random polynomial ODE of degree 2 whose initial set is centered at 1
+		for(int i=0; i<dimension; ++i)
+		{
+			Polynomial p;
+			random_polynomial(p, dimension+1, 2, density, false);
+			rhs.push_back(p);
+			box.push_back(Interval(0.9, 1.1));
+		}
+	}
+
+	dimension = rhs.size();
+	int numVars = dimension + 1;
+
+	ode.clear();
+	for(int i=0; i<dimension; ++i)
+	{
+		HornerForm hf;
+		rhs[i].toHornerForm(hf);
+		ode.push_back(hf);
+	}
+
+	// the flowpipe of one step, the state variables are normalized by x = c + r*x'
+	vector<TaylorModel> tms;
+	for(int i=0; i<dimension; ++i)
+	{
+		vector<Interval> coefficients(numVars);
+		coefficients[i+1] = Interval(box[i].width() / 2);
+
+		Polynomial p(coefficients);
+		p += Polynomial(Interval(box[i].midpoint()), numVars);
+		tms.push_back(TaylorModel(p, Interval()));
+	}
+
+	TaylorModelVec x0(tms);
+	flowpipe = x0;
+
+	for(int i=1; i<=order; ++i)
+	{
+		flowpipe.Picard_no_remainder_assign(x0, ode, numVars, i);
+	}
+
+	domain.clear();
+	domain.push_back(Interval(0.0, step));
+	for(int i=0; i<dimension; ++i)
+	{
+		domain.push_back(Interval(-1.0, 1.0));
+	}
+
+	flowpipe.cutoff(domain);
+
+	for(int i=0; i<dimension; ++i)
+	{
+		Polynomial p;
+		flowpipe.tms[i].getExpansion(p);
+		flowpipe.tms[i] = TaylorModel(p, Interval(-1e-8, 1e-8));
+	}
+
+	flowpipe.polyRangeNormal(flowpipePolyRange, step_exp_table);
+
+	// the constraint cuts the range of the last variable, which is the clock in the models, in the middle
+	vector<Interval> range;
+	flowpipe.intEval(range, domain);
+
+	vector<Interval> coefficients(numVars);
+	coefficients[dimension] = Interval(1.0);
+	constraints.clear();
+	constraints.push_back(PolynomialConstraint(Polynomial(coefficients), Interval(range[dimension-1].midpoint())));
+
+	// the operands of the binary kernels
+	for(int i=0; i<NUM_SAMPLES; ++i)
+	{
+		Polynomial p, q;
+
+		if(model.size() > 0)
+		{
+			flowpipe.tms[i % dimension].getExpansion(p);
+			flowpipe.tms[(i+1) % dimension].getExpansion(q);
+		}
+		else
+		{
+			random_polynomial(p, numVars, order, density, true);
+			random_polynomial(q, numVars, order, density, true);
+		}
+
+		polynomialsA.push_back(p);
+		polynomialsB.push_back(q);
+		tmsA.push_back(TaylorModel(p, Interval(-1e-8, 1e-8)));
+		tmsB.push_back(TaylorModel(q, Interval(-1e-8, 1e-8)));
+
+		Interval I, J;
+		p.intEvalNormal(I, step_exp_table);
+		q.intEvalNormal(J, step_exp_table);
+		intervalsA.push_back(I);
+		intervalsB.push_back(J);
+	}
+}
+
+// the kernels, the second function of a kernel restores its input and is timed separately
+
+static void kernel_interval_mul(const int i)
+{
+	intervalResult *= intervalsB[i];
+}
+
+static void reset_interval_mul(const int i)
+{
+	intervalResult = intervalsA[i];
+}
+
+static void kernel_interval_sin(const int i)
+{
+	intervalResult = intervalsA[i].sin();
+}
+
+static void kernel_polynomial_mul(const int i)
+{
+	polynomialResult *= polynomialsB[i];
+}
+
+static void reset_polynomial_mul(const int i)
+{
+	polynomialResult = polynomialsA[i];
+}
+
+static void kernel_tm_mul_ctrunc_normal(const int i)
+{
+	tmsA[i].mul_ctrunc_normal(tmResult, tmsB[i], step_exp_table, order);
+}
+
+static void kernel_horner_insert_ctrunc_normal(const int i)
+{
+	ode[i % dimension].insert_ctrunc_normal(tmResult, flowpipe, flowpipePolyRange, step_exp_table, dimension+1, order);
+}
+
+static void kernel_preconditionQR(const int i)
+{
+	preconditionQR(matrixResult, matrixInverse, flowpipe, dimension, dimension+1);
+}
+
+static void kernel_contract_interval_arithmetic(const int i)
+{
+	contract_interval_arithmetic(contractedFlowpipe, contractedDomain, constraints, boundary_intersected);
+}
+
+static void reset_contract_interval_arithmetic(const int i)
+{
+	contractedFlowpipe = flowpipe;
+	contractedDomain = domain;
+	boundary_intersected.clear();
+}
+
+typedef void (*KernelFunction)(const int i);
+
+class Kernel
+{
+public:
+	const char *name;
+	KernelFunction run;
+	KernelFunction reset;		// NULL if the kernel does not change its input
+};
+
+static const Kernel kernels[] = {
+	{"interval_mul", kernel_interval_mul, reset_interval_mul},
+	{"interval_sin", kernel_interval_sin, NULL},
+	{"polynomial_mul", kernel_polynomial_mul, reset_polynomial_mul},
+	{"tm_mul_ctrunc_normal", kernel_tm_mul_ctrunc_normal, NULL},
+	{"horner_insert_ctrunc_normal", kernel_horner_insert_ctrunc_normal, NULL},
+	{"preconditionQR", kernel_preconditionQR, NULL},
+	{"contract_interval_arithmetic", kernel_contract_interval_arithmetic, reset_contract_interval_arithmetic}
+};
+
+static const int numKernels = sizeof(kernels) / sizeof(Kernel);
+
+// runs n iterations and returns the time in nanoseconds, the allocations are added to numAllocs
+static double measure(const Kernel & kernel, const long n, const bool bReset, unsigned long long & numAllocs)
+{
+	struct timespec begin, end;
+	unsigned long long allocBegin = numAllocations;
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+
+	for(long i=0; i<n; ++i)
+	{
+		if(kernel.reset != NULL)
+		{
+			kernel.reset(i % NUM_SAMPLES);
+		}
+
+		if(!bReset)
+		{
+			kernel.run(i % NUM_SAMPLES);
+		}
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	numAllocs = numAllocations - allocBegin;
+
+	return (double)elapsed_nanoseconds(begin, end);
+}
+
+static void benchmark(const Kernel & kernel, const double minTime, const long fixedIterations)
+{
+	unsigned long long numAllocs, numResetAllocs;
+	long n = fixedIterations > 0 ? fixedIterations : 1;
+	double time = measure(kernel, n, false, numAllocs);
+
+	// double the iterations until the minimum time is reached
+	for(; fixedIterations <= 0 && time < minTime * 1e9;)
+	{
+		n *= 2;
+		time = measure(kernel, n, false, numAllocs);
+	}
+
+	// the time to restore the inputs is not counted
+	if(kernel.reset != NULL)
+	{
+		double resetTime = measure(kernel, n, true, numResetAllocs);
+		time = time > resetTime ? time - resetTime : 0;
+		numAllocs = numAllocs > numResetAllocs ? numAllocs - numResetAllocs : 0;
+	}
+
+	printf("%-30s %12ld %14.1lf %12.2lf\n", kernel.name, n, time / n, (double)numAllocs / n);
+}
+
+int main(int argc, char *argv[])
+{
+	string model;
+	string selected;
+	double minTime = 0.2;
+	long fixedIterations = 0;
+
+	int c;
+	while((c = getopt(argc, argv, "m:d:o:p:s:t:n:k:")) != -1)
+	{
+		switch(c)
+		{
+		case 'm':
+			model = optarg;
+			break;
+		case 'd':
+			dimension = atoi(optarg);
+			break;
+		case 'o':
+			order = atoi(optarg);
+			break;
+		case 'p':
+			density = atof(optarg);
+			break;
+		case 's':
+			step = atof(optarg);
+			break;
+		case 't':
+			minTime = atof(optarg);
+			break;
+		case 'n':
+			fixedIterations = atol(optarg);
+			break;
+		case 'k':
+			selected = string(",") + optarg + ",";
+			break;
+		default:
+			printf("usage: %s [-m thermostat|airplane] [-d dimension] [-o order] [-p density] [-s step] [-t seconds] [-n iterations] [-k kernel,...]\n", argv[0]);
+			exit(1);
+		}
+	}
+
+	if(model.size() > 0 && model != "thermostat" && model != "airplane")
+	{
+		printf("Unknown model %s.\n", model.c_str());
+		exit(1);
+	}
+
+	if(dimension <= 0 || order <= 0 || density <= 0 || step <= 0)
+	{
+		printf("The dimension, order, density and step should be positive.\n");
+		exit(1);
+	}
+
+	intervalNumPrecision = normal_precision;
+	cutoff_threshold = 1e-12;
+
+	prepare_inputs(model);
+
+	printf("inputs: %s, dimension %d, order %d, density %.2lf, step %g\n", model.size() > 0 ? model.c_str() : "random", dimension, order, density, step);
+	printf("%-30s %12s %14s %12s\n", "kernel", "iterations", "ns/op", "allocs/op");
+
+	for(int i=0; i<numKernels; ++i)
+	{
+		if(selected.size() == 0 || selected.find(string(",") + kernels[i].name + ",") != string::npos)
+		{
+			benchmark(kernels[i], minTime, fixedIterations);
+		}
+	}
+
+	return 0;
+}
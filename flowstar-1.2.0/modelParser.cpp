@@ -2,32 +2,424 @@
   Flow*: A Taylor Model Based Flowpipe analyzer.
   Authors: Xin Chen, Erika Abraham and Sriram Sankaranarayanan.
   Email: Xin Chen <xin.chen@cs.rwth-aachen.de> if you have questions or comments.
-  
+
   The code is released as is under the GNU General Public License (GPL). Please consult the file LICENSE.txt for
   further information.
 ---*/
 
 #include "modelParser.h"
 
-int lineNum = 1;
+void parseError(const char *str, int lnum)
+{
+	cerr << "Error @line " << lnum << ":" << string(str) << endl;
+}
+
+bool make_output_directories()
+{
+	int mkres = mkdir(outputDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+	if(mkres < 0 && errno != EEXIST)
+	{
+		printf("Can not create the directory for output files.\n");
+		return false;
+	}
+
+	mkres = mkdir(imageDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+	if(mkres < 0 && errno != EEXIST)
+	{
+		printf("Can not create the directory for images.\n");
+		return false;
+	}
 
-ContinuousReachability continuousProblem;
-HybridReachability hybridProblem;
+	return true;
+}
 
-vector<Interval> gUncertainties;
+static void print_peak_memory(FILE *fp)
+{
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	fprintf(fp, "peak memory: %ld KB\n", usage.ru_maxrss);
+}
 
-extern int yyparse();
+static void print_result(FILE *fp, const int checkingResult)
+{
+	fprintf(fp, "Result: ");
 
-void parseError(const char *str, int lnum)
+	switch(checkingResult)
+	{
+	case UNSAFE:
+		fprintf(fp, "UNSAFE\n");
+		break;
+	case SAFE:
+		fprintf(fp, "SAFE\n");
+		break;
+	case UNKNOWN:
+		fprintf(fp, "UNKNOWN\n");
+		break;
+	}
+}
+
+// class Analysis
+
+Analysis::Analysis()
+{
+	task = TASK_NONE;
+	bSafetyChecking = false;
+	result = UNKNOWN;
+
+	precision = normal_precision;
+	cutoff = 0;
+
+	lineNum = 1;
+	bError = false;
+
+	fpLog = stdout;
+}
+
+Analysis::~Analysis()
+{
+	// the thread should not keep using the profiler and the step log of a destroyed analysis
+	if(::profiler == &profiler)
+	{
+		::profiler = &disabledProfiler;
+	}
+
+	if(::stepLog == &stepLog)
+	{
+		::stepLog = &disabledStepLog;
+	}
+
+	if(::factorialTables == &factorialTables)
+	{
+		::factorialTables = &defaultFactorialTables;
+	}
+}
+
+bool Analysis::parse(FILE *fp)
+{
+	apply_settings();
+	return parse_model(this, fp, NULL);
+}
+
+bool Analysis::parse_file(const char *fileName)
+{
+	FILE *fp = fopen(fileName, "r");
+
+	if(fp == NULL)
+	{
+		fprintf(fpLog, "Can not open the model file %s.\n", fileName);
+		return false;
+	}
+
+	bool bParsed = parse(fp);
+	fclose(fp);
+
+	return bParsed;
+}
+
+bool Analysis::parse_string(const string & model)
+{
+	apply_settings();
+	return parse_model(this, NULL, model.c_str());
+}
+
+void Analysis::copy_model(const Analysis & analysis)
+{
+	continuousProblem = analysis.continuousProblem;
+	hybridProblem = analysis.hybridProblem;
+	task = analysis.task;
+	bSafetyChecking = analysis.bSafetyChecking;
+	precision = analysis.precision;
+	cutoff = analysis.cutoff;
+
+	profiler.bEnabled = analysis.profiler.bEnabled;
+	stepLog.bEnabled = analysis.stepLog.bEnabled;
+}
+
+void Analysis::apply_settings()
+{
+	intervalNumPrecision = precision;
+	cutoff_threshold = cutoff;
+	::profiler = &profiler;
+	::stepLog = &stepLog;
+	::factorialTables = &factorialTables;
+}
+
+bool Analysis::run()
+{
+	apply_settings();
+
+	switch(task)
+	{
+	case TASK_CONTINUOUS:
+		return run_continuous();
+	case TASK_HYBRID:
+		return run_hybrid();
+	case TASK_CONTINUOUS_FLOWPIPES:
+		return check_continuous_flowpipes();
+	case TASK_HYBRID_FLOWPIPES:
+		return check_hybrid_flowpipes();
+	}
+
+	fprintf(fpLog, "No model has been parsed.\n");
+	return false;
+}
+
+bool Analysis::run_continuous()
+{
+	if(!make_output_directories())
+	{
+		return false;
+	}
+
+	continuousProblem.bSafetyChecking = bSafetyChecking;
+
+	clock_t begin, end;
+	stepLog.open(continuousProblem.outputFileName);
+	if(profiler.bEnabled)
+	{
+		profiler.start();
+	}
+
+	begin = clock();
+	bool bStarted = continuousProblem.run();
+	end = clock();
+	stepLog.close();
+
+	if(!bStarted)
+	{
+		fprintf(fpLog, "Can not create the output files.\n");
+		return false;
+	}
+
+	fprintf(fpLog, "%ld flowpipes computed.\n", continuousProblem.numOfFlowpipes());
+	fprintf(fpLog, "time cost: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
+
+	print_peak_memory(fpLog);
+
+	if(bSafetyChecking && continuousProblem.bOnlineChecking && continuousProblem.checkingResult == UNSAFE)
+	{
+		// the flowpipes computed so far are not worth plotting
+		fprintf(fpLog, "The unsafe set is reached within the time interval [%lf, %lf].\n", continuousProblem.violationTime.inf(), continuousProblem.violationTime.sup());
+		fprintf(fpLog, "Result: UNSAFE\n");
+		result = UNSAFE;
+	}
+	else
+	{
+		if(!continuousProblem.bStreaming)
+		{
+			if(!bSafetyChecking || !continuousProblem.bOnlineChecking)
+			{
+				fprintf(fpLog, "Preparing for plotting and dumping...\n");
+				continuousProblem.composition();
+				fprintf(fpLog, "Done.\n");
+			}
+
+			if(!continuousProblem.plot_2D())
+			{
+				fprintf(fpLog, "Can not create the plotting file.\n");
+				return false;
+			}
+
+			FILE *fpDumping = continuousProblem.open_dumping_file();
+
+			if(fpDumping == NULL)
+			{
+				fprintf(fpLog, "Can not create the dumping file.\n");
+				return false;
+			}
+
+			fprintf(fpLog, "Dumping the Taylor model flowpipes...\n");
+			bool bDumped = continuousProblem.dump(fpDumping);
+			fclose(fpDumping);
+
+			if(!bDumped)
+			{
+				fprintf(fpLog, "Can not create the binary dumping file.\n");
+				return false;
+			}
+
+			fprintf(fpLog, "Done.\n");
+		}
+
+		if(bSafetyChecking)
+		{
+			if(continuousProblem.bOnlineChecking || continuousProblem.bStreaming)
+			{
+				result = continuousProblem.checkingResult;
+			}
+			else
+			{
+				fprintf(fpLog, "Safety checking ...\n");
+				begin = clock();
+				result = continuousProblem.safetyChecking();
+				end = clock();
+				fprintf(fpLog, "Done.\n");
+				fprintf(fpLog, "time cost for safety checking: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
+			}
+
+			print_result(fpLog, result);
+		}
+	}
+
+	if(profiler.bEnabled)
+	{
+		profiler.stop();
+		profiler.report(continuousProblem.outputFileName, fpLog);
+	}
+
+	return true;
+}
+
+bool Analysis::run_hybrid()
 {
-	cerr << "Error @line " << lineNum << ":" << string(str) << endl;
-	exit(1);
+	if(!make_output_directories())
+	{
+		return false;
+	}
+
+	clock_t begin, end;
+	stepLog.open(hybridProblem.outputFileName);
+	if(profiler.bEnabled)
+	{
+		profiler.start();
+	}
+
+	// the unsafe set is also written to the header of a streamed dumping file
+	hybridProblem.bSafetyChecking = bSafetyChecking;
+
+	begin = clock();
+	bool bStarted = hybridProblem.run();
+	end = clock();
+	stepLog.close();
+
+	if(!bStarted)
+	{
+		fprintf(fpLog, "Can not create the output files.\n");
+		return false;
+	}
+
+	fprintf(fpLog, "%ld flowpipes computed.\n", hybridProblem.numOfFlowpipes());
+	fprintf(fpLog, "%lu jumps executed.\n", hybridProblem.numOfJumpsExecuted());
+	fprintf(fpLog, "time cost: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
+
+	print_peak_memory(fpLog);
+
+	if(!hybridProblem.bStreaming)
+	{
+		fprintf(fpLog, "Preparing for plotting and dumping...\n");
+		fprintf(fpLog, "Done.\n");
+
+		if(!hybridProblem.plot_2D())
+		{
+			fprintf(fpLog, "Can not create the plotting file.\n");
+			return false;
+		}
+
+		FILE *fpDumping = hybridProblem.open_dumping_file();
+
+		if(fpDumping == NULL)
+		{
+			fprintf(fpLog, "Can not create the dumping file.\n");
+			return false;
+		}
+
+		fprintf(fpLog, "Dumping the Taylor model flowpipes...\n");
+		bool bDumped = hybridProblem.dump(fpDumping);
+		fclose(fpDumping);
+
+		if(!bDumped)
+		{
+			fprintf(fpLog, "Can not create the binary dumping file.\n");
+			return false;
+		}
+
+		fprintf(fpLog, "Done.\n");
+	}
+
+	if(bSafetyChecking)
+	{
+		if(hybridProblem.bStreaming)
+		{
+			result = hybridProblem.checkingResult;
+		}
+		else
+		{
+			fprintf(fpLog, "Safety checking ...\n");
+			begin = clock();
+			result = hybridProblem.safetyChecking();
+			end = clock();
+			fprintf(fpLog, "Done.\n");
+			fprintf(fpLog, "time cost for safety checking: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
+		}
+
+		print_result(fpLog, result);
+	}
+
+	if(profiler.bEnabled)
+	{
+		profiler.stop();
+		profiler.report(hybridProblem.outputFileName, fpLog);
+	}
+
+	return true;
 }
 
-int main(int argc, const char *argv[])
+bool Analysis::check_continuous_flowpipes()
 {
-	yyparse();
+	if(continuousProblem.bBinaryDumping && !continuousProblem.load_binary())
+	{
+		parseError("Can not load the binary flowpipe file.", lineNum);
+		return false;
+	}
+
+	if(!continuousProblem.plot_2D())
+	{
+		fprintf(fpLog, "Can not create the plotting file.\n");
+		return false;
+	}
+
+	if(bSafetyChecking)
+	{
+		clock_t begin, end;
+		fprintf(fpLog, "Safety checking ...\n");
+		begin = clock();
+		result = continuousProblem.safetyChecking();
+		end = clock();
+		fprintf(fpLog, "Done.\n");
+		fprintf(fpLog, "time cost for safety checking: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
+
+		print_result(fpLog, result);
+	}
 
-	return 0;
+	return true;
 }
 
+bool Analysis::check_hybrid_flowpipes()
+{
+	if(hybridProblem.bBinaryDumping && !hybridProblem.load_binary())
+	{
+		parseError("Can not load the binary flowpipe file.", lineNum);
+		return false;
+	}
+
+	if(!hybridProblem.plot_2D())
+	{
+		fprintf(fpLog, "Can not create the plotting file.\n");
+		return false;
+	}
+
+	if(bSafetyChecking)
+	{
+		clock_t begin, end;
+		fprintf(fpLog, "Safety checking ...\n");
+		begin = clock();
+		result = hybridProblem.safetyChecking();
+		end = clock();
+		fprintf(fpLog, "Done.\n");
+		fprintf(fpLog, "time cost for safety checking: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
+
+		print_result(fpLog, result);
+	}
+
+	return true;
+}
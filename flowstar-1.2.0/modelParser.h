@@ -12,20 +12,61 @@
 
 #include "Hybrid.h"
 
-extern int lineNum;
+/*
+ * An analysis keeps all of the state of a model file: the parsed problem, its numerical settings and the state of the
+ * parser. The analyses are independent of each other, so different models can be parsed and run concurrently in
+ * different threads.
+ */
+class Analysis
+{
+public:
+	ContinuousReachability continuousProblem;
+	HybridReachability hybridProblem;
 
-extern mpfr_prec_t intervalNumPrecision;
+	vector<Interval> uncertainties;		// the uncertainties of the continuous system being parsed
+	ParseResult parseResult;			// the non-polynomial ODE being parsed
 
-extern ContinuousReachability continuousProblem;
-extern HybridReachability hybridProblem;
+	int task;							// what the model file asks for
+	bool bSafetyChecking;				// whether the model file has an unsafe set
+	int result;							// the result of the safety checking
 
-extern ParseSetting parseSetting;
-extern ParseResult parseResult;
+	mpfr_prec_t precision;				// the numerical settings, they are applied to the thread which parses or runs the analysis
+	double cutoff;
 
-extern int yyparse();
+	Profiler profiler;					// applied to the thread like the numerical settings
+	StepLog stepLog;
+	FactorialTables factorialTables;
 
-extern vector<Interval> gUncertainties;
+	int lineNum;
+	bool bError;
+
+	FILE *fpLog;						// receives the messages of run, stdout by default
+public:
+	Analysis();
+	~Analysis();
+
+	bool parse(FILE *fp);
+	bool parse_file(const char *fileName);
+	bool parse_string(const string & model);
+
+	void copy_model(const Analysis & analysis);		// takes over a parsed model, its settings can then be overridden by parsing an override block
+
+	void apply_settings();
+	bool run();
+
+private:
+	Analysis(const Analysis & analysis);		// not copyable
+	Analysis & operator = (const Analysis & analysis);
+
+	bool run_continuous();
+	bool run_hybrid();
+	bool check_continuous_flowpipes();
+	bool check_hybrid_flowpipes();
+};
+
+bool parse_model(Analysis *analysis, FILE *fp, const char *str);		// parses the file if str is NULL
 
 void parseError(const char *str, int lnum);
+bool make_output_directories();
 
 #endif /* MODELPARSER_H_ */
@@ -10,14 +10,12 @@
 
 
 	#include "modelParser.h"
-
-	extern int yyerror(const char *);
-	extern int yyerror(string);
-	extern int yylex();
-	extern int yyparse();
-	bool err;
 %}
 
+%define api.pure full
+%parse-param {Analysis *analysis} {void *scanner}
+%lex-param {void *scanner}
+
 %union
 {
 	double dblVal;
@@ -39,9 +37,17 @@
 	Interval *pint;
 	vector<string> *strVec;
 	TreeNode *pNode;
+	int nodeID;
+	vector<Expression> *exprVec;
 }
 
 
+%code
+{
+	int yylex(YYSTYPE *lvalp, void *scanner);
+	void yyerror(Analysis *analysis, void *scanner, const char *what);
+}
+
 %token<dblVal> NUM
 %token<identifier> IDENT
 %token STATEVAR TMVAR TM EQ GEQ LEQ ASSIGN END
@@ -59,8 +65,13 @@
 %token TIME
 %token MODES JUMPS INV GUARD RESET START MAXJMPS
 %token PRINTON PRINTOFF UNSAFESET
+%token SPLITINIT THREADS ONLINE STREAM
+%token BINARYDUMP BINARY
+%token PRUNE WIDENING
+%token PROFILE
+%token LOGSTEPS
+%token OVERRIDE
 %token CONTINUOUSFLOW HYBRIDFLOW
-%token TAYLOR_PICARD TAYLOR_REMAINDER TAYLOR_POLYNOMIAL
 %token EXP SIN COS LOG SQRT
 %token NPODE_TAYLOR CUTOFF PRECISION
 %token GNUPLOT MATLAB COMPUTATIONPATHS
@@ -82,11 +93,8 @@
 %type <intVec> taylor_model_domain
 %type <intVec> intervals
 %type <intVec> remainders
-%type <ptm> non_polynomial_rhs_picard
-%type <pint> non_polynomial_rhs_remainder
-%type <poly> non_polynomial_rhs_no_remainder
-%type <identifier> non_polynomial_rhs_string
-%type <strVec> npode
+%type <nodeID> non_polynomial_rhs_expression
+%type <exprVec> npode
 %type <pNode> computation_path
 
 
@@ -102,340 +110,205 @@
 
 model: CONTINUOUS '{' continuous '}'
 {
-	int mkres = mkdir(outputDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
-	{
-		printf("Can not create the directory for output files.\n");
-		exit(1);
-	}
-
-	mkres = mkdir(imageDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
-	{
-		printf("Can not create the directory for images.\n");
-		exit(1);
-	}
-
-	clock_t begin, end;
-	begin = clock();
-	continuousProblem.run();
-	end = clock();
-	printf("%ld flowpipes computed.\n", continuousProblem.numOfFlowpipes());
-	printf("time cost: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
-	
-	continuousProblem.bSafetyChecking = false;
-
-	printf("Preparing for plotting and dumping...\n");
-	continuousProblem.composition();
-	printf("Done.\n");
-
-	continuousProblem.plot_2D();
-
-	char filename[NAME_SIZE+10];
-	sprintf(filename, "%s%s.flow", outputDir, continuousProblem.outputFileName);
-	FILE *fpDumping = fopen(filename, "w");
-
-	if(fpDumping == NULL)
-	{
-		printf("Can not create the dumping file.\n");
-		exit(1);
-	}
-	
-	printf("Dumping the Taylor model flowpipes...\n");
-	continuousProblem.dump(fpDumping);
-	printf("Done.\n");
-
-	fclose(fpDumping);
+	analysis->task = TASK_CONTINUOUS;
+	analysis->bSafetyChecking = false;
 }
 |
 CONTINUOUS '{' continuous '}' unsafe_continuous
 {
-	int mkres = mkdir(outputDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
-	{
-		printf("Can not create the directory for output files.\n");
-		exit(1);
-	}
-
-	mkres = mkdir(imageDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
-	{
-		printf("Can not create the directory for images.\n");
-		exit(1);
-	}
+	analysis->task = TASK_CONTINUOUS;
+	analysis->bSafetyChecking = true;
+}
+|
+HYBRID '{' hybrid '}'
+{
+	analysis->task = TASK_HYBRID;
+	analysis->bSafetyChecking = false;
+}
+|
+HYBRID '{' hybrid '}' unsafe_hybrid
+{
+	analysis->task = TASK_HYBRID;
+	analysis->bSafetyChecking = true;
+}
+|
+stateVarDecls plotting OUTPUT IDENT unsafe_continuous CONTINUOUSFLOW '{' tmVarDecls continuous_flowpipes '}'
+{
+	strcpy(analysis->continuousProblem.outputFileName, $4->c_str());
+	analysis->task = TASK_CONTINUOUS_FLOWPIPES;
+	analysis->bSafetyChecking = true;
 
-	clock_t begin, end;
-	begin = clock();
-	continuousProblem.run();
-	end = clock();
-	printf("%ld flowpipes computed.\n", continuousProblem.numOfFlowpipes());
-	printf("time cost: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
+	delete $4;
+}
+|
+stateVarDecls plotting OUTPUT IDENT CONTINUOUSFLOW '{' tmVarDecls continuous_flowpipes '}'
+{
+	strcpy(analysis->continuousProblem.outputFileName, $4->c_str());
+	analysis->task = TASK_CONTINUOUS_FLOWPIPES;
+	analysis->bSafetyChecking = false;
 
-	continuousProblem.bSafetyChecking = true;
+	delete $4;
+}
+|
+stateVarDecls modeDecls COMPUTATIONPATHS '{' computation_paths '}' plotting OUTPUT IDENT unsafe_hybrid HYBRIDFLOW '{' hybrid_flowpipes '}'
+{
+	strcpy(analysis->hybridProblem.outputFileName, $9->c_str());
+	generateNodeSeq(analysis->hybridProblem.traceNodes, analysis->hybridProblem.traceTree);
+	analysis->task = TASK_HYBRID_FLOWPIPES;
+	analysis->bSafetyChecking = true;
 
-	printf("Preparing for plotting and dumping...\n");
-	continuousProblem.composition();
-	printf("Done.\n");
+	delete $9;
+}
+|
+stateVarDecls modeDecls COMPUTATIONPATHS '{' computation_paths '}' plotting OUTPUT IDENT HYBRIDFLOW '{' hybrid_flowpipes '}'
+{
+	strcpy(analysis->hybridProblem.outputFileName, $9->c_str());
+	generateNodeSeq(analysis->hybridProblem.traceNodes, analysis->hybridProblem.traceTree);
+	analysis->task = TASK_HYBRID_FLOWPIPES;
+	analysis->bSafetyChecking = false;
 
-	continuousProblem.plot_2D();
+	delete $9;
+}
+|
+stateVarDecls modeDecls plotting OUTPUT IDENT unsafe_hybrid HYBRIDFLOW '{' hybrid_flowpipes '}' COMPUTATIONPATHS '{' computation_paths '}'
+{
+	strcpy(analysis->hybridProblem.outputFileName, $5->c_str());
+	generateNodeSeq(analysis->hybridProblem.traceNodes, analysis->hybridProblem.traceTree);
+	analysis->task = TASK_HYBRID_FLOWPIPES;
+	analysis->bSafetyChecking = true;
 
-	char filename[NAME_SIZE+10];
-	sprintf(filename, "%s%s.flow", outputDir, continuousProblem.outputFileName);
-	FILE *fpDumping = fopen(filename, "w");
+	delete $5;
+}
+|
+stateVarDecls modeDecls plotting OUTPUT IDENT HYBRIDFLOW '{' hybrid_flowpipes '}' COMPUTATIONPATHS '{' computation_paths '}'
+{
+	strcpy(analysis->hybridProblem.outputFileName, $5->c_str());
+	generateNodeSeq(analysis->hybridProblem.traceNodes, analysis->hybridProblem.traceTree);
+	analysis->task = TASK_HYBRID_FLOWPIPES;
+	analysis->bSafetyChecking = false;
 
-	if(fpDumping == NULL)
+	delete $5;
+}
+|
+OVERRIDE '{' overrides '}'
+{
+	// the overrides only change the settings of a model which has already been parsed
+	if(analysis->task == TASK_NONE)
 	{
-		printf("Can not create the dumping file.\n");
-		exit(1);
+		parseError("There is no model to override.", analysis->lineNum);
+		YYABORT;
 	}
-	
-	printf("Dumping the Taylor model flowpipes...\n");
-	continuousProblem.dump(fpDumping);
-	printf("Done.\n");
-
-	fclose(fpDumping);
-
-	int checkingResult;
-	printf("Safety checking ...\n");
-	begin = clock();
-	checkingResult = continuousProblem.safetyChecking();
-	end = clock();
-	printf("Done.\n");
-	printf("time cost for safety checking: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
-	printf("Result: ");
+}
+;
 
-	switch(checkingResult)
-	{
-	case UNSAFE:
-		printf("UNSAFE\n");
-		break;
-	case SAFE:
-		printf("SAFE\n");
-		break;
-	case UNKNOWN:
-		printf("UNKNOWN\n");
-		break;
-	}
+overrides: overrides override
+{
 }
 |
-HYBRID '{' hybrid '}'
 {
-	int mkres = mkdir(outputDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
-	{
-		printf("Can not create the directory for output files.\n");
-		exit(1);
-	}
+}
+;
 
-	mkres = mkdir(imageDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
+override: TIME NUM
+{
+	if($2 <= 0)
 	{
-		printf("Can not create the directory for images.\n");
-		exit(1);
+		parseError("The time horizon should be a positive number.", analysis->lineNum);
+		YYABORT;
 	}
 
-	clock_t begin, end;
-	begin = clock();
-	hybridProblem.run();
-	end = clock();
-	printf("%ld flowpipes computed.\n", hybridProblem.numOfFlowpipes());
-	printf("time cost: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
-
-	hybridProblem.bSafetyChecking = false;
-
-	printf("Preparing for plotting and dumping...\n");
-	printf("Done.\n");
-
-	hybridProblem.plot_2D();
-
-	char filename[NAME_SIZE+10];
-	sprintf(filename, "%s%s.flow", outputDir, hybridProblem.outputFileName);
-	FILE *fpDumping = fopen(filename, "w");
-
-	if(fpDumping == NULL)
+	analysis->continuousProblem.time = $2;
+	analysis->hybridProblem.time = $2;
+}
+|
+FIXEDST NUM
+{
+	if($2 <= 0)
 	{
-		printf("Can not create the dumping file.\n");
-		exit(1);
+		parseError("The step size should be a positive number.", analysis->lineNum);
+		YYABORT;
 	}
 
-	printf("Dumping the Taylor model flowpipes...\n");
-	hybridProblem.dump(fpDumping);
-	printf("Done.\n");
+	analysis->continuousProblem.bAdaptiveSteps = false;
+	analysis->continuousProblem.step = $2;
 
-	fclose(fpDumping);
+	analysis->hybridProblem.bAdaptiveSteps = false;
+	analysis->hybridProblem.step = $2;
 }
 |
-HYBRID '{' hybrid '}' unsafe_hybrid
+FIXEDORD NUM
 {
-	int mkres = mkdir(outputDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
-	{
-		printf("Can not create the directory for output files.\n");
-		exit(1);
-	}
+	int order = (int)$2;
 
-	mkres = mkdir(imageDir, S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
-	if(mkres < 0 && errno != EEXIST)
+	if(order <= 0)
 	{
-		printf("Can not create the directory for images.\n");
-		exit(1);
+		parseError("Orders should be larger than zero.", analysis->lineNum);
+		YYABORT;
 	}
 
-	clock_t begin, end;
-	begin = clock();
-	hybridProblem.run();
-	end = clock();
-	printf("%ld flowpipes computed.\n", hybridProblem.numOfFlowpipes());
-	printf("time cost: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
-
-	hybridProblem.bSafetyChecking = true;
-
-	printf("Preparing for plotting and dumping...\n");
-	printf("Done.\n");
-
-	hybridProblem.plot_2D();
-
-	char filename[NAME_SIZE+10];
-	sprintf(filename, "%s%s.flow", outputDir, hybridProblem.outputFileName);
-	FILE *fpDumping = fopen(filename, "w");
+	analysis->continuousProblem.bAdaptiveOrders = false;
+	analysis->continuousProblem.orderType = UNIFORM;
+	analysis->continuousProblem.orders.assign(1, order);
+	analysis->continuousProblem.maxOrders.clear();
+	analysis->continuousProblem.globalMaxOrder = order;
 
-	if(fpDumping == NULL)
+	analysis->hybridProblem.bAdaptiveOrders = false;
+	analysis->hybridProblem.orderType = UNIFORM;
+	analysis->hybridProblem.orders.assign(1, order);
+	analysis->hybridProblem.maxOrders.clear();
+	analysis->hybridProblem.globalMaxOrder = order;
+}
+|
+OUTPUT IDENT
+{
+	if($2->size() >= NAME_SIZE)
 	{
-		printf("Can not create the dumping file.\n");
-		exit(1);
+		parseError("The output name is too long.", analysis->lineNum);
+		YYABORT;
 	}
-	
-	printf("Dumping the Taylor model flowpipes...\n");
-	hybridProblem.dump(fpDumping);
-	printf("Done.\n");
 
-	fclose(fpDumping);
+	strcpy(analysis->continuousProblem.outputFileName, $2->c_str());
+	strcpy(analysis->hybridProblem.outputFileName, $2->c_str());
 
-	int checkingResult;
-	printf("Safety checking ...\n");
-	begin = clock();
-	checkingResult = hybridProblem.safetyChecking();
-	end = clock();
-	printf("Done.\n");
-	printf("time cost for safety checking: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
-	printf("Result: ");
-
-	switch(checkingResult)
-	{
-	case UNSAFE:
-		printf("UNSAFE\n");
-		break;
-	case SAFE:
-		printf("SAFE\n");
-		break;
-	case UNKNOWN:
-		printf("UNKNOWN\n");
-		break;
-	}
+	delete $2;
 }
 |
-stateVarDecls plotting OUTPUT IDENT unsafe_continuous CONTINUOUSFLOW '{' tmVarDecls continuous_flowpipes '}'
+INIT '{' intervals '}'
 {
-	clock_t begin, end;
-	strcpy(continuousProblem.outputFileName, $4->c_str());
-
-	continuousProblem.plot_2D();
-
-	int checkingResult;
-	printf("Safety checking ...\n");
-	begin = clock();
-	checkingResult = continuousProblem.safetyChecking();
-	end = clock();
-	printf("Done.\n");
-	printf("time cost for safety checking: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
-	printf("Result: ");
+	// a hybrid system keeps its initial mode
+	Interval intZero;
+	Flowpipe initialSet(*$3, intZero);
 
-	switch(checkingResult)
+	if(analysis->task == TASK_HYBRID)
 	{
-	case UNSAFE:
-		printf("UNSAFE\n");
-		break;
-	case SAFE:
-		printf("SAFE\n");
-		break;
-	case UNKNOWN:
-		printf("UNKNOWN\n");
-		break;
+		analysis->hybridProblem.initialConfig(initialSet);
 	}
-}
-|
-stateVarDecls plotting OUTPUT IDENT CONTINUOUSFLOW '{' tmVarDecls continuous_flowpipes '}'
-{
-	strcpy(continuousProblem.outputFileName, $4->c_str());
-	continuousProblem.plot_2D();
-}
-|
-stateVarDecls modeDecls COMPUTATIONPATHS '{' computation_paths '}' plotting OUTPUT IDENT unsafe_hybrid HYBRIDFLOW '{' hybrid_flowpipes '}'
-{
-	clock_t begin, end;
-	strcpy(hybridProblem.outputFileName, $9->c_str());
-	generateNodeSeq(hybridProblem.traceNodes, hybridProblem.traceTree);
-
-	hybridProblem.plot_2D();
-
-	int checkingResult;
-	printf("Safety checking ...\n");
-	begin = clock();
-	checkingResult = hybridProblem.safetyChecking();
-	end = clock();
-	printf("Done.\n");
-	printf("time cost for safety checking: %lf\n", (double)(end - begin) / CLOCKS_PER_SEC);
-	printf("Result: ");
-
-	switch(checkingResult)
+	else
 	{
-	case UNSAFE:
-		printf("UNSAFE\n");
-		break;
-	case SAFE:
-		printf("SAFE\n");
-		break;
-	case UNKNOWN:
-		printf("UNKNOWN\n");
-		break;
+		analysis->continuousProblem.initialConfig(initialSet);
 	}
 
-	delete $9;
-}
-|
-stateVarDecls modeDecls COMPUTATIONPATHS '{' computation_paths '}' plotting OUTPUT IDENT HYBRIDFLOW '{' hybrid_flowpipes '}'
-{
-	strcpy(hybridProblem.outputFileName, $9->c_str());
-	generateNodeSeq(hybridProblem.traceNodes, hybridProblem.traceTree);
-	hybridProblem.plot_2D();
-
-	delete $9;
-}
-|
-TAYLOR_PICARD '{' non_polynomial_rhs_picard '}'
-{
-	$3->getExpansion(parseResult.expansion);
-	parseResult.remainder = $3->getRemainder();
-	delete $3;
-}
-|
-TAYLOR_REMAINDER '{' non_polynomial_rhs_remainder '}'
-{
-	parseResult.remainder = (*$3);
 	delete $3;
 }
 |
-TAYLOR_POLYNOMIAL '{' non_polynomial_rhs_no_remainder '}'
+UNSAFESET '{' polynomial_constraints '}'
 {
-	parseResult.expansion = (*$3);
+	// the unsafe set of a hybrid system is the same in all of the modes
+	int numModes = analysis->hybridProblem.modeNames.size();
+
+	analysis->continuousProblem.unsafeSet = *$3;
+	analysis->hybridProblem.unsafeSet.assign(numModes, *$3);
+	analysis->hybridProblem.bVecUnderCheck.assign(numModes, true);
+	analysis->bSafetyChecking = true;
+
 	delete $3;
 }
 ;
 
 continuous_flowpipes: continuous_flowpipes '{' interval_taylor_model taylor_model_domain '}'
 {
-	continuousProblem.flowpipesCompo.push_back(*$3);
-	continuousProblem.domains.push_back(*$4);
+	analysis->continuousProblem.flowpipesCompo.push_back(*$3);
+	analysis->continuousProblem.domains.push_back(*$4);
 
 	delete $3;
 	delete $4;
@@ -443,19 +316,25 @@ continuous_flowpipes: continuous_flowpipes '{' interval_taylor_model taylor_mode
 |
 '{' interval_taylor_model taylor_model_domain '}'
 {
-	continuousProblem.flowpipesCompo.push_back(*$2);
-	continuousProblem.domains.push_back(*$3);
+	analysis->continuousProblem.flowpipesCompo.push_back(*$2);
+	analysis->continuousProblem.domains.push_back(*$3);
 
 	delete $2;
 	delete $3;
 }
+|
+BINARY
+{
+	// the flowpipes are loaded from the binary file once the output name is known
+	analysis->continuousProblem.bBinaryDumping = true;
+}
 ;
 
 modeDecls: modeDecls IDENT '{' polynomial_constraints '}'
 {
 	TaylorModelVec tmvDummy;
 	vector<Interval> intVecDummy;
-	hybridProblem.declareMode(*$2, tmvDummy, intVecDummy, *$4, 0);
+	analysis->hybridProblem.declareMode(*$2, tmvDummy, intVecDummy, *$4, 0);
 
 	delete $2;
 	delete $4;
@@ -465,7 +344,7 @@ IDENT '{' polynomial_constraints '}'
 {
 	TaylorModelVec tmvDummy;
 	vector<Interval> intVecDummy;
-	hybridProblem.declareMode(*$1, tmvDummy, intVecDummy, *$3, 0);
+	analysis->hybridProblem.declareMode(*$1, tmvDummy, intVecDummy, *$3, 0);
 
 	delete $1;
 	delete $3;
@@ -474,44 +353,49 @@ IDENT '{' polynomial_constraints '}'
 
 hybrid_flowpipes: hybrid_flowpipes IDENT '{' tmVarDecls continuous_flowpipes '}'
 {
-	int id = hybridProblem.getIDForMode(*$2);
+	int id = analysis->hybridProblem.getIDForMode(*$2);
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	hybridProblem.modeIDs.push_back(id);
-	hybridProblem.flowpipesCompo.push_back(continuousProblem.flowpipesCompo);
-	hybridProblem.domains.push_back(continuousProblem.domains);
+	analysis->hybridProblem.modeIDs.push_back(id);
+	analysis->hybridProblem.flowpipesCompo.push_back(analysis->continuousProblem.flowpipesCompo);
+	analysis->hybridProblem.domains.push_back(analysis->continuousProblem.domains);
 
-	continuousProblem.flowpipesCompo.clear();
-	continuousProblem.domains.clear();
-	continuousProblem.tmVarTab.clear();
-	continuousProblem.tmVarNames.clear();
+	analysis->continuousProblem.flowpipesCompo.clear();
+	analysis->continuousProblem.domains.clear();
+	analysis->continuousProblem.tmVarTab.clear();
+	analysis->continuousProblem.tmVarNames.clear();
 }
 |
 IDENT '{' tmVarDecls continuous_flowpipes '}'
 {
-	int id = hybridProblem.getIDForMode(*$1);
+	int id = analysis->hybridProblem.getIDForMode(*$1);
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	hybridProblem.modeIDs.push_back(id);
-	hybridProblem.flowpipesCompo.push_back(continuousProblem.flowpipesCompo);
-	hybridProblem.domains.push_back(continuousProblem.domains);
+	analysis->hybridProblem.modeIDs.push_back(id);
+	analysis->hybridProblem.flowpipesCompo.push_back(analysis->continuousProblem.flowpipesCompo);
+	analysis->hybridProblem.domains.push_back(analysis->continuousProblem.domains);
 
-	continuousProblem.flowpipesCompo.clear();
-	continuousProblem.domains.clear();
-	continuousProblem.tmVarTab.clear();
-	continuousProblem.tmVarNames.clear();
+	analysis->continuousProblem.flowpipesCompo.clear();
+	analysis->continuousProblem.domains.clear();
+	analysis->continuousProblem.tmVarTab.clear();
+	analysis->continuousProblem.tmVarNames.clear();
+}
+|
+BINARY
+{
+	analysis->hybridProblem.bBinaryDumping = true;
 }
 ;
 
@@ -526,13 +410,13 @@ computation_path ';'
 
 computation_path: computation_path '(' NUM ',' '[' NUM ',' NUM ']' ')' '-' '>' IDENT
 {
-	int id = hybridProblem.getIDForMode(*$13);
+	int id = analysis->hybridProblem.getIDForMode(*$13);
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$13).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	list<TreeNode *>::iterator iter = $$->children.begin();
@@ -561,31 +445,31 @@ computation_path: computation_path '(' NUM ',' '[' NUM ',' NUM ']' ')' '-' '>' I
 |
 IDENT
 {
-	int id = hybridProblem.getIDForMode(*$1);
+	int id = analysis->hybridProblem.getIDForMode(*$1);
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	if(hybridProblem.traceTree == NULL)
+	if(analysis->hybridProblem.traceTree == NULL)
 	{
 		Interval intZero;
-		hybridProblem.traceTree = new TreeNode(0, id, intZero);
-		$$ = hybridProblem.traceTree;
+		analysis->hybridProblem.traceTree = new TreeNode(0, id, intZero);
+		$$ = analysis->hybridProblem.traceTree;
 	}
 	else
 	{
-		if(hybridProblem.traceTree->modeID == id)
+		if(analysis->hybridProblem.traceTree->modeID == id)
 		{
-			$$ = hybridProblem.traceTree;
+			$$ = analysis->hybridProblem.traceTree;
 		}
 		else
 		{
-			parseError("Invalid computation path.", lineNum);
-			exit(1);
+			parseError("Invalid computation path.", analysis->lineNum);
+			YYABORT;
 		}
 	}
 
@@ -595,22 +479,153 @@ IDENT
 
 print: PRINTON
 {
-	continuousProblem.bPrint = true;
-	hybridProblem.bPrint = true;
+	analysis->continuousProblem.bPrint = true;
+	analysis->hybridProblem.bPrint = true;
 }
 |
 PRINTOFF
 {
-	continuousProblem.bPrint = false;
-	hybridProblem.bPrint = false;
+	analysis->continuousProblem.bPrint = false;
+	analysis->hybridProblem.bPrint = false;
+}
+;
+
+parallel: SPLITINIT NUM THREADS NUM
+{
+	int numSplits = (int)$2;
+	int numThreads = (int)$4;
+
+	if(numSplits <= 0 || numThreads <= 0)
+	{
+		parseError("The numbers of the sub-boxes and the threads should be larger than zero.", analysis->lineNum);
+		YYABORT;
+	}
+
+	analysis->continuousProblem.numSplits = numSplits;
+	analysis->continuousProblem.numThreads = numThreads;
+	analysis->hybridProblem.numSplits = numSplits;
+	analysis->hybridProblem.numThreads = numThreads;
+}
+|
+SPLITINIT NUM
+{
+	int numSplits = (int)$2;
+
+	if(numSplits <= 0)
+	{
+		parseError("The number of the sub-boxes should be larger than zero.", analysis->lineNum);
+		YYABORT;
+	}
+
+	int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);	// use all of the online processors by default
+	if(numThreads <= 0)
+	{
+		numThreads = 1;
+	}
+
+	analysis->continuousProblem.numSplits = numSplits;
+	analysis->continuousProblem.numThreads = numThreads;
+	analysis->hybridProblem.numSplits = numSplits;
+	analysis->hybridProblem.numThreads = numThreads;
+}
+|
+THREADS NUM
+{
+	int numThreads = (int)$2;
+
+	if(numThreads <= 0)
+	{
+		parseError("The number of the threads should be larger than zero.", analysis->lineNum);
+		YYABORT;
+	}
+
+	analysis->continuousProblem.numThreads = numThreads;
+	analysis->hybridProblem.numThreads = numThreads;
+}
+|
+{
+}
+;
+
+streaming: STREAM
+{
+	analysis->continuousProblem.bStreaming = true;
+	analysis->hybridProblem.bStreaming = true;
+}
+|
+{
+	analysis->continuousProblem.bStreaming = false;
+	analysis->hybridProblem.bStreaming = false;
+}
+;
+
+dumping: BINARYDUMP
+{
+	analysis->continuousProblem.bBinaryDumping = true;
+	analysis->hybridProblem.bBinaryDumping = true;
+}
+|
+{
+	analysis->continuousProblem.bBinaryDumping = false;
+	analysis->hybridProblem.bBinaryDumping = false;
+}
+;
+
+profiling: PROFILE
+{
+	analysis->profiler.bEnabled = true;
+}
+|
+{
+	analysis->profiler.bEnabled = false;
+}
+;
+
+step_logging: LOGSTEPS
+{
+	analysis->stepLog.bEnabled = true;
+}
+|
+{
+	analysis->stepLog.bEnabled = false;
+}
+;
+
+pruning: PRUNE
+{
+	analysis->hybridProblem.bPruning = true;
+	analysis->hybridProblem.widening = 0;
+}
+|
+PRUNE WIDENING NUM
+{
+	if($3 < 0)
+	{
+		parseError("The widening should be nonnegative.", analysis->lineNum);
+		YYABORT;
+	}
+
+	analysis->hybridProblem.bPruning = true;
+	analysis->hybridProblem.widening = $3;
+}
+|
+{
+	analysis->hybridProblem.bPruning = false;
 }
 ;
 
 unsafe_continuous: UNSAFESET '{' polynomial_constraints '}'
 {
-	continuousProblem.unsafeSet = *$3;
+	analysis->continuousProblem.unsafeSet = *$3;
 	delete $3;
 }
+|
+UNSAFESET ONLINE '{' polynomial_constraints '}'
+{
+	analysis->continuousProblem.unsafeSet = *$4;
+	analysis->continuousProblem.bOnlineChecking = true;
+	delete $4;
+}
 ;
 
 unsafe_hybrid: UNSAFESET '{' hybrid_constraints '}'
@@ -620,26 +635,26 @@ unsafe_hybrid: UNSAFESET '{' hybrid_constraints '}'
 
 hybrid_constraints: hybrid_constraints IDENT '{' polynomial_constraints '}'
 {
-	int id = hybridProblem.getIDForMode(*$2);
+	int id = analysis->hybridProblem.getIDForMode(*$2);
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	hybridProblem.unsafeSet[id] = *$4;
-	hybridProblem.bVecUnderCheck[id] = true;
+	analysis->hybridProblem.unsafeSet[id] = *$4;
+	analysis->hybridProblem.bVecUnderCheck[id] = true;
 	delete $4;
 }
 |
 {
 	vector<PolynomialConstraint> vecEmpty;
-	for(int i=0; i<hybridProblem.modeNames.size(); ++i)
+	for(int i=0; i<analysis->hybridProblem.modeNames.size(); ++i)
 	{
-		hybridProblem.unsafeSet.push_back(vecEmpty);
-		hybridProblem.bVecUnderCheck.push_back(false);
+		analysis->hybridProblem.unsafeSet.push_back(vecEmpty);
+		analysis->hybridProblem.bVecUnderCheck.push_back(false);
 	}
 }
 ;
@@ -648,8 +663,8 @@ polynomial_constraints: polynomial_constraints ODEpolynomial LEQ NUM
 {
 	if($2->degree() < 1)
 	{
-		parseError("Invalid constraint.", lineNum);
-		exit(1);
+		parseError("Invalid constraint.", analysis->lineNum);
+		YYABORT;
 	}
 
 	$$ = $1;
@@ -664,8 +679,8 @@ polynomial_constraints ODEpolynomial GEQ NUM
 {
 	if($2->degree() < 1)
 	{
-		parseError("Invalid constraint.", lineNum);
-		exit(1);
+		parseError("Invalid constraint.", analysis->lineNum);
+		YYABORT;
 	}
 
 	$$ = $1;
@@ -683,8 +698,8 @@ polynomial_constraints ODEpolynomial EQ NUM
 {
 	if($2->degree() < 1)
 	{
-		parseError("Invalid constraint.", lineNum);
-		exit(1);
+		parseError("Invalid constraint.", analysis->lineNum);
+		YYABORT;
 	}
 
 	$$ = $1;
@@ -705,8 +720,8 @@ polynomial_constraints ODEpolynomial BELONGSTO '[' NUM ',' NUM ']'
 {
 	if($2->degree() < 1)
 	{
-		parseError("Invalid constraint.", lineNum);
-		exit(1);
+		parseError("Invalid constraint.", analysis->lineNum);
+		YYABORT;
 	}
 
 	PolynomialConstraint pc1(*$2, $7);
@@ -725,69 +740,85 @@ polynomial_constraints ODEpolynomial BELONGSTO '[' NUM ',' NUM ']'
 }
 ;
 
-continuous: stateVarDecls SETTING '{' settings print '}' POLYODE1 '{' ode '}' INIT '{' init '}'
+continuous: stateVarDecls SETTING '{' settings print parallel streaming dumping profiling step_logging '}' POLYODE1 '{' ode '}' INIT '{' init '}'
 {
-	ContinuousSystem system(*$9, gUncertainties, *$13);
-	continuousProblem.system = system;
-	continuousProblem.integrationScheme = LOW_DEGREE;
+	ContinuousSystem system(*$14, analysis->uncertainties, *$18);
+	analysis->continuousProblem.system = system;
 
-	delete $9;
-	delete $13;
+	if(isAffineODE(*$14))
+	{
+		analysis->continuousProblem.integrationScheme = LINEAR_ODE;
+	}
+	else
+	{
+		analysis->continuousProblem.integrationScheme = LOW_DEGREE;
+	}
+
+	delete $14;
+	delete $18;
 }
 |
-stateVarDecls SETTING '{' settings print '}' POLYODE2 '{' ode '}' INIT '{' init '}'
+stateVarDecls SETTING '{' settings print parallel streaming dumping profiling step_logging '}' POLYODE2 '{' ode '}' INIT '{' init '}'
 {
-	ContinuousSystem system(*$9, gUncertainties, *$13);
-	continuousProblem.system = system;
-	continuousProblem.integrationScheme = HIGH_DEGREE;
+	ContinuousSystem system(*$14, analysis->uncertainties, *$18);
+	analysis->continuousProblem.system = system;
 
-	delete $9;
-	delete $13;
+	if(isAffineODE(*$14))
+	{
+		analysis->continuousProblem.integrationScheme = LINEAR_ODE;
+	}
+	else
+	{
+		analysis->continuousProblem.integrationScheme = HIGH_DEGREE;
+	}
+
+	delete $14;
+	delete $18;
 }
 |
-stateVarDecls SETTING '{' settings print '}' NPODE_TAYLOR '{' npode '}' INIT '{' init '}'
+stateVarDecls SETTING '{' settings print parallel streaming dumping profiling step_logging '}' NPODE_TAYLOR '{' npode '}' INIT '{' init '}'
 {
-	ContinuousSystem system(*$9, gUncertainties, *$13);
-	continuousProblem.system = system;
-	continuousProblem.integrationScheme = NONPOLY_TAYLOR;
+	ContinuousSystem system(*$14, analysis->uncertainties, *$18);
+	analysis->continuousProblem.system = system;
+	analysis->continuousProblem.integrationScheme = NONPOLY_TAYLOR;
 
-	delete $9;
-	delete $13;
+	delete $14;
+	delete $18;
 }
 ;
 
-hybrid: stateVarDecls SETTING '{' settings MAXJMPS NUM print '}' MODES '{' modes '}' JUMPS '{' jumps '}' INIT '{' hybrid_init '}'
+hybrid: stateVarDecls SETTING '{' settings MAXJMPS NUM print parallel streaming dumping pruning profiling step_logging '}' MODES '{' modes '}' JUMPS '{' jumps '}' INIT '{' hybrid_init '}'
 {
 	if($6 < 0)
 	{
-		parseError("The maximum jump depth should be a nonnegative integer.", lineNum);
-		exit(1);
+		parseError("The maximum jump depth should be a nonnegative integer.", analysis->lineNum);
+		YYABORT;
 	}
 
-	hybridProblem.maxJumps = (int)$6;
+	analysis->hybridProblem.maxJumps = (int)$6;
 }
 ;
 
 hybrid_init: IDENT '{' intervals '}'
 {
-	int id = hybridProblem.getIDForMode(*$1);
+	int id = analysis->hybridProblem.getIDForMode(*$1);
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval intZero;
 	Flowpipe initialSet(*$3, intZero);
-	hybridProblem.initialConfig(id, initialSet);
+	analysis->hybridProblem.initialConfig(id, initialSet);
 
-	int numVars = hybridProblem.stateVarNames.size();
+	int numVars = analysis->hybridProblem.stateVarNames.size();
 
 	string tVar("local_t");
-	hybridProblem.declareTMVar(tVar);
-	continuousProblem.declareTMVar(tVar);
+	analysis->hybridProblem.declareTMVar(tVar);
+	analysis->continuousProblem.declareTMVar(tVar);
 
 	char name[NAME_SIZE];
 
@@ -795,8 +826,8 @@ hybrid_init: IDENT '{' intervals '}'
 	{
 		sprintf(name, "%s%d", local_var_name, i+1);
 		string tmVarName(name);
-		hybridProblem.declareTMVar(tmVarName);
-		continuousProblem.declareTMVar(tmVarName);
+		analysis->hybridProblem.declareTMVar(tmVarName);
+		analysis->continuousProblem.declareTMVar(tmVarName);
 	}
 
 	delete $1;
@@ -805,17 +836,17 @@ hybrid_init: IDENT '{' intervals '}'
 |
 IDENT '{' tmVarDecls taylor_model taylor_model_domain '}'
 {
-	int id = hybridProblem.getIDForMode(*$1);
+	int id = analysis->hybridProblem.getIDForMode(*$1);
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	Flowpipe initialSet(*$4, *$5);
-	hybridProblem.initialConfig(id, initialSet);
+	analysis->hybridProblem.initialConfig(id, initialSet);
 
 	delete $4;
 	delete $5;
@@ -824,7 +855,14 @@ IDENT '{' tmVarDecls taylor_model taylor_model_domain '}'
 
 modes: modes IDENT '{' POLYODE1 '{' ode '}' INV '{' polynomial_constraints '}' '}'
 {
-	hybridProblem.declareMode(*$2, *$6, gUncertainties, *$10, LOW_DEGREE);
+	if(isAffineODE(*$6))
+	{
+		analysis->hybridProblem.declareMode(*$2, *$6, analysis->uncertainties, *$10, LINEAR_ODE);
+	}
+	else
+	{
+		analysis->hybridProblem.declareMode(*$2, *$6, analysis->uncertainties, *$10, LOW_DEGREE);
+	}
 
 	delete $2;
 	delete $6;
@@ -833,7 +871,14 @@ modes: modes IDENT '{' POLYODE1 '{' ode '}' INV '{' polynomial_constraints '}' '
 |
 IDENT '{' POLYODE1 '{' ode '}' INV '{' polynomial_constraints '}' '}'
 {
-	hybridProblem.declareMode(*$1, *$5, gUncertainties, *$9, LOW_DEGREE);
+	if(isAffineODE(*$5))
+	{
+		analysis->hybridProblem.declareMode(*$1, *$5, analysis->uncertainties, *$9, LINEAR_ODE);
+	}
+	else
+	{
+		analysis->hybridProblem.declareMode(*$1, *$5, analysis->uncertainties, *$9, LOW_DEGREE);
+	}
 
 	delete $1;
 	delete $5;
@@ -842,7 +887,14 @@ IDENT '{' POLYODE1 '{' ode '}' INV '{' polynomial_constraints '}' '}'
 |
 modes IDENT '{' POLYODE2 '{' ode '}' INV '{' polynomial_constraints '}' '}'
 {
-	hybridProblem.declareMode(*$2, *$6, gUncertainties, *$10, HIGH_DEGREE);
+	if(isAffineODE(*$6))
+	{
+		analysis->hybridProblem.declareMode(*$2, *$6, analysis->uncertainties, *$10, LINEAR_ODE);
+	}
+	else
+	{
+		analysis->hybridProblem.declareMode(*$2, *$6, analysis->uncertainties, *$10, HIGH_DEGREE);
+	}
 
 	delete $2;
 	delete $6;
@@ -851,7 +903,14 @@ modes IDENT '{' POLYODE2 '{' ode '}' INV '{' polynomial_constraints '}' '}'
 |
 IDENT '{' POLYODE2 '{' ode '}' INV '{' polynomial_constraints '}' '}'
 {
-	hybridProblem.declareMode(*$1, *$5, gUncertainties, *$9, HIGH_DEGREE);
+	if(isAffineODE(*$5))
+	{
+		analysis->hybridProblem.declareMode(*$1, *$5, analysis->uncertainties, *$9, LINEAR_ODE);
+	}
+	else
+	{
+		analysis->hybridProblem.declareMode(*$1, *$5, analysis->uncertainties, *$9, HIGH_DEGREE);
+	}
 
 	delete $1;
 	delete $5;
@@ -860,7 +919,7 @@ IDENT '{' POLYODE2 '{' ode '}' INV '{' polynomial_constraints '}' '}'
 |
 modes IDENT '{' NPODE_TAYLOR '{' npode '}' INV '{' polynomial_constraints '}' '}'
 {
-	hybridProblem.declareMode(*$2, *$6, gUncertainties, *$10, NONPOLY_TAYLOR);
+	analysis->hybridProblem.declareMode(*$2, *$6, analysis->uncertainties, *$10, NONPOLY_TAYLOR);
 
 	delete $2;
 	delete $6;
@@ -869,7 +928,7 @@ modes IDENT '{' NPODE_TAYLOR '{' npode '}' INV '{' polynomial_constraints '}' '}
 |
 IDENT '{' NPODE_TAYLOR '{' npode '}' INV '{' polynomial_constraints '}' '}'
 {
-	hybridProblem.declareMode(*$1, *$5, gUncertainties, *$9, NONPOLY_TAYLOR);
+	analysis->hybridProblem.declareMode(*$1, *$5, analysis->uncertainties, *$9, NONPOLY_TAYLOR);
 
 	delete $1;
 	delete $5;
@@ -879,61 +938,61 @@ IDENT '{' NPODE_TAYLOR '{' npode '}' INV '{' polynomial_constraints '}' '}'
 
 jumps: jumps IDENT '-' '>' IDENT GUARD '{' polynomial_constraints '}' RESET '{' reset '}' PARAAGGREG '{' real_valued_vectors '}'
 {
-	int startID = hybridProblem.getIDForMode(*$2);
+	int startID = analysis->hybridProblem.getIDForMode(*$2);
 	if(startID < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	int endID = hybridProblem.getIDForMode(*$5);
+	int endID = analysis->hybridProblem.getIDForMode(*$5);
 	if(endID < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$5).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($16->size() > 0)
 	{
-		hybridProblem.declareTrans(startID, endID, *$8, *$12, PARA_AGGREG, *$16);
+		analysis->hybridProblem.declareTrans(startID, endID, *$8, *$12, PARA_AGGREG, *$16);
 	}
 	else
 	{
 		vector<vector<double> > emptyVec;
-		hybridProblem.declareTrans(startID, endID, *$8, *$12, PARA_AGGREG, emptyVec);
+		analysis->hybridProblem.declareTrans(startID, endID, *$8, *$12, PARA_AGGREG, emptyVec);
 	}
 }
 |
 jumps IDENT '-' '>' IDENT GUARD '{' polynomial_constraints '}' RESET '{' reset '}' INTAGGREG
 {
-	int startID = hybridProblem.getIDForMode(*$2);
+	int startID = analysis->hybridProblem.getIDForMode(*$2);
 	if(startID < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	int endID = hybridProblem.getIDForMode(*$5);
+	int endID = analysis->hybridProblem.getIDForMode(*$5);
 	if(endID < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "Mode %s has not been declared.", (*$5).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	vector<vector<double> > empty;
-	hybridProblem.declareTrans(startID, endID, *$8, *$12, INTERVAL_AGGREG, empty);
+	analysis->hybridProblem.declareTrans(startID, endID, *$8, *$12, INTERVAL_AGGREG, empty);
 }
 |
 {
-	hybridProblem.declareTrans();
+	analysis->hybridProblem.declareTrans();
 }
 ;
 
@@ -941,20 +1000,20 @@ reset: reset IDENT '\'' ASSIGN ODEpolynomial '+' '[' NUM ',' NUM ']'
 {
 	$$ = $1;
 
-	int id = hybridProblem.getIDForStateVar(*$2);
+	int id = analysis->hybridProblem.getIDForStateVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($8 > $10)
 	{
-		parseError("Invalid remainder interval.", lineNum);
-		exit(1);
+		parseError("Invalid remainder interval.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I($8, $10);
@@ -968,14 +1027,14 @@ reset IDENT '\'' ASSIGN ODEpolynomial
 {
 	$$ = $1;
 
-	int id = hybridProblem.getIDForStateVar(*$2);
+	int id = analysis->hybridProblem.getIDForStateVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval intZero;
@@ -986,7 +1045,7 @@ reset IDENT '\'' ASSIGN ODEpolynomial
 }
 |
 {
-	int numVars = hybridProblem.stateVarNames.size();
+	int numVars = analysis->hybridProblem.stateVarNames.size();
 
 	Matrix coefficients_identity_reset(numVars, numVars+1);
 
@@ -1016,10 +1075,10 @@ real_valued_vector: '[' vector_components ']'
 {
 	int rangeDim = $2->size();
 
-	if(rangeDim != hybridProblem.stateVarNames.size())
+	if(rangeDim != analysis->hybridProblem.stateVarNames.size())
 	{
-		parseError("The vector dimension should be equivalent to the system dimension.", lineNum);
-		exit(1);
+		parseError("The vector dimension should be equivalent to the system dimension.", analysis->lineNum);
+		YYABORT;
 	}
 
 	$$ = new vector<double>(0);
@@ -1045,8 +1104,8 @@ real_valued_vector: '[' vector_components ']'
 
 	if(bZero)
 	{
-		parseError("A template vector should not be zero.", lineNum);
-		exit(1);
+		parseError("A template vector should not be zero.", analysis->lineNum);
+		YYABORT;
 	}
 
 	delete $2;
@@ -1055,14 +1114,14 @@ real_valued_vector: '[' vector_components ']'
 
 vector_components: vector_components ',' IDENT ':' NUM
 {
-	int id = hybridProblem.getIDForStateVar(*$3);
+	int id = analysis->hybridProblem.getIDForStateVar(*$3);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$3).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	$$ = $1;
@@ -1072,17 +1131,17 @@ vector_components: vector_components ',' IDENT ':' NUM
 |
 IDENT ':' NUM
 {
-	int num = hybridProblem.stateVarNames.size();
+	int num = analysis->hybridProblem.stateVarNames.size();
 	$$ = new vector<double>(num);
 
-	int id = hybridProblem.getIDForStateVar(*$1);
+	int id = analysis->hybridProblem.getIDForStateVar(*$1);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	(*$$)[id] = $3;
@@ -1097,29 +1156,29 @@ stateVarDecls: STATEVAR stateIdDeclList
 
 stateIdDeclList: stateIdDeclList ',' IDENT
 {
-	if(!continuousProblem.declareStateVar(*$3))
+	if(!analysis->continuousProblem.declareStateVar(*$3))
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s has already been declared.", (*$3).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	hybridProblem.declareStateVar(*$3);
+	analysis->hybridProblem.declareStateVar(*$3);
 	delete $3;
 }
 |
 IDENT
 {
-	if(!continuousProblem.declareStateVar(*$1))
+	if(!analysis->continuousProblem.declareStateVar(*$1))
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s has already been declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	hybridProblem.declareStateVar(*$1);
+	analysis->hybridProblem.declareStateVar(*$1);
 	delete $1;
 }
 ;
@@ -1130,37 +1189,38 @@ settings: FIXEDST NUM TIME NUM remainder_estimation precondition plotting FIXEDO
 
 	if(order <= 0)
 	{
-		parseError("Orders should be larger than zero.", lineNum);
-		exit(1);
+		parseError("Orders should be larger than zero.", analysis->lineNum);
+		YYABORT;
 	}
 
-	continuousProblem.bAdaptiveSteps = false;
-	continuousProblem.step = $2;
-	continuousProblem.time = $4;
-	continuousProblem.bAdaptiveOrders = false;
-	continuousProblem.orderType = UNIFORM;
-	continuousProblem.orders.push_back(order);
-	continuousProblem.globalMaxOrder = order;
+	analysis->continuousProblem.bAdaptiveSteps = false;
+	analysis->continuousProblem.step = $2;
+	analysis->continuousProblem.time = $4;
+	analysis->continuousProblem.bAdaptiveOrders = false;
+	analysis->continuousProblem.orderType = UNIFORM;
+	analysis->continuousProblem.orders.push_back(order);
+	analysis->continuousProblem.globalMaxOrder = order;
 
-	hybridProblem.bAdaptiveSteps = false;
-	hybridProblem.step = $2;
-	hybridProblem.time = $4;
-	hybridProblem.bAdaptiveOrders = false;
-	hybridProblem.orderType = UNIFORM;
-	hybridProblem.orders.push_back(order);
-	hybridProblem.globalMaxOrder = order;
+	analysis->hybridProblem.bAdaptiveSteps = false;
+	analysis->hybridProblem.step = $2;
+	analysis->hybridProblem.time = $4;
+	analysis->hybridProblem.bAdaptiveOrders = false;
+	analysis->hybridProblem.orderType = UNIFORM;
+	analysis->hybridProblem.orders.push_back(order);
+	analysis->hybridProblem.globalMaxOrder = order;
 
 	if($11 <= 0)
 	{
-		parseError("The cutoff threshold should be a positive number.", lineNum);
-		exit(1);
+		parseError("The cutoff threshold should be a positive number.", analysis->lineNum);
+		YYABORT;
 	}
 
-	cutoff_threshold = $11;
-	intervalNumPrecision = (int)$13;
+	analysis->cutoff = $11;
+	analysis->precision = (int)$13;
+	analysis->apply_settings();
 
-	strcpy(continuousProblem.outputFileName, (*$15).c_str());
-	strcpy(hybridProblem.outputFileName, (*$15).c_str());
+	strcpy(analysis->continuousProblem.outputFileName, (*$15).c_str());
+	strcpy(analysis->hybridProblem.outputFileName, (*$15).c_str());
 
 	delete $15;
 }
@@ -1172,71 +1232,72 @@ FIXEDST NUM TIME NUM remainder_estimation precondition plotting ADAPTIVEORD '{'
 
 	if(minOrder <= 0 || maxOrder <= 0)
 	{
-		parseError("Orders should be larger than zero.", lineNum);
-		exit(1);
+		parseError("Orders should be larger than zero.", analysis->lineNum);
+		YYABORT;
 	}
 
 	if(minOrder > maxOrder)
 	{
-		parseError("MAX order should be no smaller than MIN order.", lineNum);
-		exit(1);
+		parseError("MAX order should be no smaller than MIN order.", analysis->lineNum);
+		YYABORT;
 	}
 
-	continuousProblem.bAdaptiveSteps = false;
-	continuousProblem.step = $2;
-	continuousProblem.time = $4;
-	continuousProblem.bAdaptiveOrders = true;
-	continuousProblem.orderType = UNIFORM;
-	continuousProblem.orders.push_back(minOrder);
-	continuousProblem.maxOrders.push_back(maxOrder);
-	continuousProblem.globalMaxOrder = maxOrder;
+	analysis->continuousProblem.bAdaptiveSteps = false;
+	analysis->continuousProblem.step = $2;
+	analysis->continuousProblem.time = $4;
+	analysis->continuousProblem.bAdaptiveOrders = true;
+	analysis->continuousProblem.orderType = UNIFORM;
+	analysis->continuousProblem.orders.push_back(minOrder);
+	analysis->continuousProblem.maxOrders.push_back(maxOrder);
+	analysis->continuousProblem.globalMaxOrder = maxOrder;
 
-	hybridProblem.bAdaptiveSteps = false;
-	hybridProblem.step = $2;
-	hybridProblem.time = $4;
-	hybridProblem.bAdaptiveOrders = true;
-	hybridProblem.orderType = UNIFORM;
-	hybridProblem.orders.push_back(minOrder);
-	hybridProblem.maxOrders.push_back(maxOrder);
-	hybridProblem.globalMaxOrder = maxOrder;
+	analysis->hybridProblem.bAdaptiveSteps = false;
+	analysis->hybridProblem.step = $2;
+	analysis->hybridProblem.time = $4;
+	analysis->hybridProblem.bAdaptiveOrders = true;
+	analysis->hybridProblem.orderType = UNIFORM;
+	analysis->hybridProblem.orders.push_back(minOrder);
+	analysis->hybridProblem.maxOrders.push_back(maxOrder);
+	analysis->hybridProblem.globalMaxOrder = maxOrder;
 
 	if($17 <= 0)
 	{
-		parseError("The cutoff threshold should be a positive number.", lineNum);
-		exit(1);
+		parseError("The cutoff threshold should be a positive number.", analysis->lineNum);
+		YYABORT;
 	}
 
-	cutoff_threshold = $17;
-	intervalNumPrecision = (int)$19;
+	analysis->cutoff = $17;
+	analysis->precision = (int)$19;
+	analysis->apply_settings();
 
-	strcpy(continuousProblem.outputFileName, (*$21).c_str());
-	strcpy(hybridProblem.outputFileName, (*$21).c_str());
+	strcpy(analysis->continuousProblem.outputFileName, (*$21).c_str());
+	strcpy(analysis->hybridProblem.outputFileName, (*$21).c_str());
 
 	delete $21;
 }
 |
 FIXEDST NUM TIME NUM remainder_estimation precondition plotting FIXEDORD '{' orders '}' CUTOFF NUM PRECISION NUM OUTPUT IDENT
 {
-	continuousProblem.bAdaptiveSteps = false;
-	continuousProblem.step = $2;
-	continuousProblem.time = $4;
-	continuousProblem.bAdaptiveOrders = false;
-	continuousProblem.orderType = MULTI;
-	continuousProblem.orders = *$10;
+	analysis->continuousProblem.bAdaptiveSteps = false;
+	analysis->continuousProblem.step = $2;
+	analysis->continuousProblem.time = $4;
+	analysis->continuousProblem.bAdaptiveOrders = false;
+	analysis->continuousProblem.orderType = MULTI;
+	analysis->continuousProblem.orders = *$10;
 
-	hybridProblem.bAdaptiveSteps = false;
-	hybridProblem.step = $2;
-	hybridProblem.time = $4;
-	hybridProblem.bAdaptiveOrders = false;
-	hybridProblem.orderType = MULTI;
-	hybridProblem.orders = *$10;
+	analysis->hybridProblem.bAdaptiveSteps = false;
+	analysis->hybridProblem.step = $2;
+	analysis->hybridProblem.time = $4;
+	analysis->hybridProblem.bAdaptiveOrders = false;
+	analysis->hybridProblem.orderType = MULTI;
+	analysis->hybridProblem.orders = *$10;
 
 	for(int i=0; i<$10->size(); ++i)
 	{
 		if((*$10)[i] <= 0)
 		{
-			parseError("Orders should be larger than zero.", lineNum);
-			exit(1);
+			parseError("Orders should be larger than zero.", analysis->lineNum);
+			YYABORT;
 		}
 	}
 
@@ -1249,20 +1310,21 @@ FIXEDST NUM TIME NUM remainder_estimation precondition plotting FIXEDORD '{' ord
 		}
 	}
 
-	continuousProblem.globalMaxOrder = maxOrder;
-	hybridProblem.globalMaxOrder = maxOrder;
+	analysis->continuousProblem.globalMaxOrder = maxOrder;
+	analysis->hybridProblem.globalMaxOrder = maxOrder;
 
 	if($13 <= 0)
 	{
-		parseError("The cutoff threshold should be a positive number.", lineNum);
-		exit(1);
+		parseError("The cutoff threshold should be a positive number.", analysis->lineNum);
+		YYABORT;
 	}
 
-	cutoff_threshold = $13;
-	intervalNumPrecision = (int)$15;
+	analysis->cutoff = $13;
+	analysis->precision = (int)$15;
+	analysis->apply_settings();
 
-	strcpy(continuousProblem.outputFileName, (*$17).c_str());
-	strcpy(hybridProblem.outputFileName, (*$17).c_str());
+	strcpy(analysis->continuousProblem.outputFileName, (*$17).c_str());
+	strcpy(analysis->hybridProblem.outputFileName, (*$17).c_str());
 
 	delete $10;
 	delete $17;
@@ -1270,40 +1332,40 @@ FIXEDST NUM TIME NUM remainder_estimation precondition plotting FIXEDORD '{' ord
 |
 FIXEDST NUM TIME NUM remainder_estimation precondition plotting ADAPTIVEORD '{' MIN '{' orders '}' ',' MAX '{' orders '}' '}' CUTOFF NUM PRECISION NUM OUTPUT IDENT
 {
-	continuousProblem.bAdaptiveSteps = false;
-	continuousProblem.step = $2;
-	continuousProblem.time = $4;
-	continuousProblem.bAdaptiveOrders = true;
-	continuousProblem.orderType = MULTI;
-	continuousProblem.orders = *$12;
-	continuousProblem.maxOrders = *$17;
-
-	hybridProblem.bAdaptiveSteps = false;
-	hybridProblem.step = $2;
-	hybridProblem.time = $4;
-	hybridProblem.bAdaptiveOrders = true;
-	hybridProblem.orderType = MULTI;
-	hybridProblem.orders = *$12;
-	hybridProblem.maxOrders = *$17;
+	analysis->continuousProblem.bAdaptiveSteps = false;
+	analysis->continuousProblem.step = $2;
+	analysis->continuousProblem.time = $4;
+	analysis->continuousProblem.bAdaptiveOrders = true;
+	analysis->continuousProblem.orderType = MULTI;
+	analysis->continuousProblem.orders = *$12;
+	analysis->continuousProblem.maxOrders = *$17;
+
+	analysis->hybridProblem.bAdaptiveSteps = false;
+	analysis->hybridProblem.step = $2;
+	analysis->hybridProblem.time = $4;
+	analysis->hybridProblem.bAdaptiveOrders = true;
+	analysis->hybridProblem.orderType = MULTI;
+	analysis->hybridProblem.orders = *$12;
+	analysis->hybridProblem.maxOrders = *$17;
 
 	if($12->size() != $17->size())
 	{
-		parseError("Orders are not properly specified.", lineNum);
-		exit(1);
+		parseError("Orders are not properly specified.", analysis->lineNum);
+		YYABORT;
 	}
 
 	for(int i=0; i<$17->size(); ++i)
 	{
 		if((*$12)[i] <= 0 || (*$17)[i] <= 0)
 		{
-			parseError("Orders should be larger than zero.", lineNum);
-			exit(1);
+			parseError("Orders should be larger than zero.", analysis->lineNum);
+			YYABORT;
 		}
 
 		if((*$12)[i] > (*$17)[i])
 		{
-			parseError("MAX order should be no smaller than MIN order.", lineNum);
-			exit(1);
+			parseError("MAX order should be no smaller than MIN order.", analysis->lineNum);
+			YYABORT;
 		}
 	}
 
@@ -1316,20 +1378,21 @@ FIXEDST NUM TIME NUM remainder_estimation precondition plotting ADAPTIVEORD '{'
 		}
 	}
 
-	continuousProblem.globalMaxOrder = maxOrder;
-	hybridProblem.globalMaxOrder = maxOrder;
+	analysis->continuousProblem.globalMaxOrder = maxOrder;
+	analysis->hybridProblem.globalMaxOrder = maxOrder;
 
 	if($21 <= 0)
 	{
-		parseError("The cutoff threshold should be a positive number.", lineNum);
-		exit(1);
+		parseError("The cutoff threshold should be a positive number.", analysis->lineNum);
+		YYABORT;
 	}
 
-	cutoff_threshold = $21;
-	intervalNumPrecision = (int)$23;
+	analysis->cutoff = $21;
+	analysis->precision = (int)$23;
+	analysis->apply_settings();
 
-	strcpy(continuousProblem.outputFileName, (*$25).c_str());
-	strcpy(hybridProblem.outputFileName, (*$25).c_str());
+	strcpy(analysis->continuousProblem.outputFileName, (*$25).c_str());
+	strcpy(analysis->hybridProblem.outputFileName, (*$25).c_str());
 
 	delete $12;
 	delete $17;
@@ -1340,47 +1403,48 @@ ADAPTIVEST '{' MIN NUM ',' MAX NUM '}' TIME NUM remainder_estimation preconditio
 {
 	if($4 > $7)
 	{
-		parseError("MIN step should be no larger than MAX step.", lineNum);
-		exit(1);
+		parseError("MIN step should be no larger than MAX step.", analysis->lineNum);
+		YYABORT;
 	}
 
 	int order = (int)$15;
 
 	if(order <= 0)
 	{
-		parseError("Orders should be larger than zero.", lineNum);
-		exit(1);
+		parseError("Orders should be larger than zero.", analysis->lineNum);
+		YYABORT;
 	}
 
-	continuousProblem.bAdaptiveSteps = true;
-	continuousProblem.step = $7;
-	continuousProblem.miniStep = $4;
-	continuousProblem.time = $10;
-	continuousProblem.bAdaptiveOrders = false;
-	continuousProblem.orderType = UNIFORM;
-	continuousProblem.orders.push_back(order);
-	continuousProblem.globalMaxOrder = order;
+	analysis->continuousProblem.bAdaptiveSteps = true;
+	analysis->continuousProblem.step = $7;
+	analysis->continuousProblem.miniStep = $4;
+	analysis->continuousProblem.time = $10;
+	analysis->continuousProblem.bAdaptiveOrders = false;
+	analysis->continuousProblem.orderType = UNIFORM;
+	analysis->continuousProblem.orders.push_back(order);
+	analysis->continuousProblem.globalMaxOrder = order;
 
-	hybridProblem.bAdaptiveSteps = true;
-	hybridProblem.step = $7;
-	hybridProblem.miniStep = $4;
-	hybridProblem.time = $10;
-	hybridProblem.bAdaptiveOrders = false;
-	hybridProblem.orderType = UNIFORM;
-	hybridProblem.orders.push_back(order);
-	hybridProblem.globalMaxOrder = order;
+	analysis->hybridProblem.bAdaptiveSteps = true;
+	analysis->hybridProblem.step = $7;
+	analysis->hybridProblem.miniStep = $4;
+	analysis->hybridProblem.time = $10;
+	analysis->hybridProblem.bAdaptiveOrders = false;
+	analysis->hybridProblem.orderType = UNIFORM;
+	analysis->hybridProblem.orders.push_back(order);
+	analysis->hybridProblem.globalMaxOrder = order;
 
 	if($17 <= 0)
 	{
-		parseError("The cutoff threshold should be a positive number.", lineNum);
-		exit(1);
+		parseError("The cutoff threshold should be a positive number.", analysis->lineNum);
+		YYABORT;
 	}
 
-	cutoff_threshold = $17;
-	intervalNumPrecision = (int)$19;
+	analysis->cutoff = $17;
+	analysis->precision = (int)$19;
+	analysis->apply_settings();
 
-	strcpy(continuousProblem.outputFileName, (*$21).c_str());
-	strcpy(hybridProblem.outputFileName, (*$21).c_str());
+	strcpy(analysis->continuousProblem.outputFileName, (*$21).c_str());
+	strcpy(analysis->hybridProblem.outputFileName, (*$21).c_str());
 
 	delete $21;
 }
@@ -1389,34 +1453,34 @@ ADAPTIVEST '{' MIN NUM ',' MAX NUM '}' TIME NUM remainder_estimation preconditio
 {
 	if($4 > $7)
 	{
-		parseError("MIN step should be no larger than MAX step.", lineNum);
-		exit(1);
+		parseError("MIN step should be no larger than MAX step.", analysis->lineNum);
+		YYABORT;
 	}
 
 	for(int i=0; i<$16->size(); ++i)
 	{
 		if((*$16)[i] <= 0)
 		{
-			parseError("Orders should be larger than zero.", lineNum);
-			exit(1);
+			parseError("Orders should be larger than zero.", analysis->lineNum);
+			YYABORT;
 		}
 	}
 
-	continuousProblem.bAdaptiveSteps = true;
-	continuousProblem.step = $7;
-	continuousProblem.miniStep = $4;
-	continuousProblem.time = $10;
-	continuousProblem.bAdaptiveOrders = false;
-	continuousProblem.orderType = MULTI;
-	continuousProblem.orders = *$16;
+	analysis->continuousProblem.bAdaptiveSteps = true;
+	analysis->continuousProblem.step = $7;
+	analysis->continuousProblem.miniStep = $4;
+	analysis->continuousProblem.time = $10;
+	analysis->continuousProblem.bAdaptiveOrders = false;
+	analysis->continuousProblem.orderType = MULTI;
+	analysis->continuousProblem.orders = *$16;
 
-	hybridProblem.bAdaptiveSteps = true;
-	hybridProblem.step = $7;
-	hybridProblem.miniStep = $4;
-	hybridProblem.time = $10;
-	hybridProblem.bAdaptiveOrders = false;
-	hybridProblem.orderType = MULTI;
-	hybridProblem.orders = *$16;
+	analysis->hybridProblem.bAdaptiveSteps = true;
+	analysis->hybridProblem.step = $7;
+	analysis->hybridProblem.miniStep = $4;
+	analysis->hybridProblem.time = $10;
+	analysis->hybridProblem.bAdaptiveOrders = false;
+	analysis->hybridProblem.orderType = MULTI;
+	analysis->hybridProblem.orders = *$16;
 
 	int maxOrder = (*$16)[0];
 	for(int i=1; i<$16->size(); ++i)
@@ -1427,20 +1491,21 @@ ADAPTIVEST '{' MIN NUM ',' MAX NUM '}' TIME NUM remainder_estimation preconditio
 		}
 	}
 	
-	continuousProblem.globalMaxOrder = maxOrder;
-	hybridProblem.globalMaxOrder = maxOrder;
+	analysis->continuousProblem.globalMaxOrder = maxOrder;
+	analysis->hybridProblem.globalMaxOrder = maxOrder;
 
 	if($19 <= 0)
 	{
-		parseError("The cutoff threshold should be a positive number.", lineNum);
-		exit(1);
+		parseError("The cutoff threshold should be a positive number.", analysis->lineNum);
+		YYABORT;
 	}
 
-	cutoff_threshold = $19;
-	intervalNumPrecision = (int)$21;
+	analysis->cutoff = $19;
+	analysis->precision = (int)$21;
+	analysis->apply_settings();
 
-	strcpy(continuousProblem.outputFileName, (*$23).c_str());
-	strcpy(hybridProblem.outputFileName, (*$23).c_str());
+	strcpy(analysis->continuousProblem.outputFileName, (*$23).c_str());
+	strcpy(analysis->hybridProblem.outputFileName, (*$23).c_str());
 
 	delete $16;
 	delete $23;
@@ -1451,16 +1516,16 @@ remainder_estimation: REMEST NUM
 {
 	if($2 <= 0)
 	{
-		parseError("Remainder estimation should be a positive number.", lineNum);
-		exit(1);
+		parseError("Remainder estimation should be a positive number.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I(-$2, $2);
 
-	for(int i=0; i<continuousProblem.stateVarNames.size(); ++i)
+	for(int i=0; i<analysis->continuousProblem.stateVarNames.size(); ++i)
 	{
-		continuousProblem.estimation.push_back(I);
-		hybridProblem.estimation.push_back(I);
+		analysis->continuousProblem.estimation.push_back(I);
+		analysis->hybridProblem.estimation.push_back(I);
 	}
 }
 |
@@ -1470,13 +1535,13 @@ REMEST '{' remainders '}'
 	{
 		if((*$3)[i].inf() >= (*$3)[i].sup() - THRESHOLD_LOW)
 		{
-			parseError("Invalid remainder estimation.", lineNum);
-			exit(1);
+			parseError("Invalid remainder estimation.", analysis->lineNum);
+			YYABORT;
 		}
 	}
 
-	continuousProblem.estimation = *$3;
-	hybridProblem.estimation = *$3;
+	analysis->continuousProblem.estimation = *$3;
+	analysis->hybridProblem.estimation = *$3;
 	delete $3;
 }
 ;
@@ -1484,20 +1549,20 @@ REMEST '{' remainders '}'
 remainders: remainders ',' IDENT ':' '[' NUM ',' NUM ']'
 {
 	$$ = $1;
-	int id = continuousProblem.getIDForStateVar(*$3);
+	int id = analysis->continuousProblem.getIDForStateVar(*$3);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$3).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($6 >= $8)
 	{
-		parseError("Invalid remainder estimation.", lineNum);
-		exit(1);
+		parseError("Invalid remainder estimation.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I($6,$8);
@@ -1507,23 +1572,23 @@ remainders: remainders ',' IDENT ':' '[' NUM ',' NUM ']'
 |
 IDENT ':' '[' NUM ',' NUM ']'
 {
-	int numVars = continuousProblem.stateVarNames.size();
+	int numVars = analysis->continuousProblem.stateVarNames.size();
 	$$ = new vector<Interval>(numVars);
 
-	int id = continuousProblem.getIDForStateVar(*$1);
+	int id = analysis->continuousProblem.getIDForStateVar(*$1);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($4 >= $6)
 	{
-		parseError("Invalid remainder estimation.", lineNum);
-		exit(1);
+		parseError("Invalid remainder estimation.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I($4,$6);
@@ -1535,14 +1600,14 @@ IDENT ':' '[' NUM ',' NUM ']'
 orders: orders ',' IDENT ':' NUM
 {
 	$$ = $1;
-	int id = continuousProblem.getIDForStateVar(*$3);
+	int id = analysis->continuousProblem.getIDForStateVar(*$3);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$3).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	(*$$)[id] = (int)$5;
@@ -1551,21 +1616,21 @@ orders: orders ',' IDENT ':' NUM
 |
 IDENT ':' NUM
 {
-	int numVars = continuousProblem.stateVarNames.size();
+	int numVars = analysis->continuousProblem.stateVarNames.size();
 	$$ = new vector<int>(numVars);
 	for(int i=0; i<numVars; ++i)
 	{
 		(*$$)[i] = 0;
 	}
 
-	int id = continuousProblem.getIDForStateVar(*$1);
+	int id = analysis->continuousProblem.getIDForStateVar(*$1);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	(*$$)[id] = (int)$3;
@@ -1575,47 +1640,47 @@ IDENT ':' NUM
 
 precondition: QRPRECOND
 {
-	continuousProblem.precondition = QR_PRE;
-	hybridProblem.precondition = QR_PRE;
+	analysis->continuousProblem.precondition = QR_PRE;
+	analysis->hybridProblem.precondition = QR_PRE;
 }
 |
 IDPRECOND
 {
-	continuousProblem.precondition = ID_PRE;
-	hybridProblem.precondition = ID_PRE;
+	analysis->continuousProblem.precondition = ID_PRE;
+	analysis->hybridProblem.precondition = ID_PRE;
 }
 ;
 
 plotting: GNUPLOT INTERVAL IDENT ',' IDENT
 {
-	int x = continuousProblem.getIDForStateVar(*$3);
-	int y = continuousProblem.getIDForStateVar(*$5);
+	int x = analysis->continuousProblem.getIDForStateVar(*$3);
+	int y = analysis->continuousProblem.getIDForStateVar(*$5);
 
 	if(x < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$3).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if(y < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$5).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	continuousProblem.outputAxes.push_back(x);
-	continuousProblem.outputAxes.push_back(y);
-	continuousProblem.plotSetting = PLOT_INTERVAL;
-	continuousProblem.plotFormat = PLOT_GNUPLOT;
+	analysis->continuousProblem.outputAxes.push_back(x);
+	analysis->continuousProblem.outputAxes.push_back(y);
+	analysis->continuousProblem.plotSetting = PLOT_INTERVAL;
+	analysis->continuousProblem.plotFormat = PLOT_GNUPLOT;
 
-	hybridProblem.outputAxes.push_back(x);
-	hybridProblem.outputAxes.push_back(y);
-	hybridProblem.plotSetting = PLOT_INTERVAL;
-	hybridProblem.plotFormat = PLOT_GNUPLOT;
+	analysis->hybridProblem.outputAxes.push_back(x);
+	analysis->hybridProblem.outputAxes.push_back(y);
+	analysis->hybridProblem.plotSetting = PLOT_INTERVAL;
+	analysis->hybridProblem.plotFormat = PLOT_GNUPLOT;
 
 	delete $3;
 	delete $5;
@@ -1623,34 +1688,34 @@ plotting: GNUPLOT INTERVAL IDENT ',' IDENT
 |
 GNUPLOT OCTAGON IDENT ',' IDENT
 {
-	int x = continuousProblem.getIDForStateVar(*$3);
-	int y = continuousProblem.getIDForStateVar(*$5);
+	int x = analysis->continuousProblem.getIDForStateVar(*$3);
+	int y = analysis->continuousProblem.getIDForStateVar(*$5);
 
 	if(x < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State Variable %s is not declared.", (*$3).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if(y < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$5).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	continuousProblem.outputAxes.push_back(x);
-	continuousProblem.outputAxes.push_back(y);
-	continuousProblem.plotSetting = PLOT_OCTAGON;
-	continuousProblem.plotFormat = PLOT_GNUPLOT;
+	analysis->continuousProblem.outputAxes.push_back(x);
+	analysis->continuousProblem.outputAxes.push_back(y);
+	analysis->continuousProblem.plotSetting = PLOT_OCTAGON;
+	analysis->continuousProblem.plotFormat = PLOT_GNUPLOT;
 
-	hybridProblem.outputAxes.push_back(x);
-	hybridProblem.outputAxes.push_back(y);
-	hybridProblem.plotSetting = PLOT_OCTAGON;
-	hybridProblem.plotFormat = PLOT_GNUPLOT;
+	analysis->hybridProblem.outputAxes.push_back(x);
+	analysis->hybridProblem.outputAxes.push_back(y);
+	analysis->hybridProblem.plotSetting = PLOT_OCTAGON;
+	analysis->hybridProblem.plotFormat = PLOT_GNUPLOT;
 
 	delete $3;
 	delete $5;
@@ -1658,36 +1723,36 @@ GNUPLOT OCTAGON IDENT ',' IDENT
 |
 GNUPLOT GRID NUM IDENT ',' IDENT
 {
-	int x = continuousProblem.getIDForStateVar(*$4);
-	int y = continuousProblem.getIDForStateVar(*$6);
+	int x = analysis->continuousProblem.getIDForStateVar(*$4);
+	int y = analysis->continuousProblem.getIDForStateVar(*$6);
 
 	if(x < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$4).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if(y < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$6).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	continuousProblem.outputAxes.push_back(x);
-	continuousProblem.outputAxes.push_back(y);
-	continuousProblem.plotSetting = PLOT_GRID;
-	continuousProblem.numSections = (int)$3;
-	continuousProblem.plotFormat = PLOT_GNUPLOT;
+	analysis->continuousProblem.outputAxes.push_back(x);
+	analysis->continuousProblem.outputAxes.push_back(y);
+	analysis->continuousProblem.plotSetting = PLOT_GRID;
+	analysis->continuousProblem.numSections = (int)$3;
+	analysis->continuousProblem.plotFormat = PLOT_GNUPLOT;
 
-	hybridProblem.outputAxes.push_back(x);
-	hybridProblem.outputAxes.push_back(y);
-	hybridProblem.plotSetting = PLOT_GRID;
-	hybridProblem.numSections = (int)$3;
-	hybridProblem.plotFormat = PLOT_GNUPLOT;
+	analysis->hybridProblem.outputAxes.push_back(x);
+	analysis->hybridProblem.outputAxes.push_back(y);
+	analysis->hybridProblem.plotSetting = PLOT_GRID;
+	analysis->hybridProblem.numSections = (int)$3;
+	analysis->hybridProblem.plotFormat = PLOT_GNUPLOT;
 
 	delete $4;
 	delete $6;
@@ -1695,34 +1760,34 @@ GNUPLOT GRID NUM IDENT ',' IDENT
 |
 MATLAB INTERVAL IDENT ',' IDENT
 {
-	int x = continuousProblem.getIDForStateVar(*$3);
-	int y = continuousProblem.getIDForStateVar(*$5);
+	int x = analysis->continuousProblem.getIDForStateVar(*$3);
+	int y = analysis->continuousProblem.getIDForStateVar(*$5);
 
 	if(x < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$3).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if(y < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$5).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	continuousProblem.outputAxes.push_back(x);
-	continuousProblem.outputAxes.push_back(y);
-	continuousProblem.plotSetting = PLOT_INTERVAL;
-	continuousProblem.plotFormat = PLOT_MATLAB;
+	analysis->continuousProblem.outputAxes.push_back(x);
+	analysis->continuousProblem.outputAxes.push_back(y);
+	analysis->continuousProblem.plotSetting = PLOT_INTERVAL;
+	analysis->continuousProblem.plotFormat = PLOT_MATLAB;
 
-	hybridProblem.outputAxes.push_back(x);
-	hybridProblem.outputAxes.push_back(y);
-	hybridProblem.plotSetting = PLOT_INTERVAL;
-	hybridProblem.plotFormat = PLOT_MATLAB;
+	analysis->hybridProblem.outputAxes.push_back(x);
+	analysis->hybridProblem.outputAxes.push_back(y);
+	analysis->hybridProblem.plotSetting = PLOT_INTERVAL;
+	analysis->hybridProblem.plotFormat = PLOT_MATLAB;
 
 	delete $3;
 	delete $5;
@@ -1730,34 +1795,34 @@ MATLAB INTERVAL IDENT ',' IDENT
 |
 MATLAB OCTAGON IDENT ',' IDENT
 {
-	int x = continuousProblem.getIDForStateVar(*$3);
-	int y = continuousProblem.getIDForStateVar(*$5);
+	int x = analysis->continuousProblem.getIDForStateVar(*$3);
+	int y = analysis->continuousProblem.getIDForStateVar(*$5);
 
 	if(x < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State Variable %s is not declared.", (*$3).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if(y < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$5).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	continuousProblem.outputAxes.push_back(x);
-	continuousProblem.outputAxes.push_back(y);
-	continuousProblem.plotSetting = PLOT_OCTAGON;
-	continuousProblem.plotFormat = PLOT_MATLAB;
+	analysis->continuousProblem.outputAxes.push_back(x);
+	analysis->continuousProblem.outputAxes.push_back(y);
+	analysis->continuousProblem.plotSetting = PLOT_OCTAGON;
+	analysis->continuousProblem.plotFormat = PLOT_MATLAB;
 
-	hybridProblem.outputAxes.push_back(x);
-	hybridProblem.outputAxes.push_back(y);
-	hybridProblem.plotSetting = PLOT_OCTAGON;
-	hybridProblem.plotFormat = PLOT_MATLAB;
+	analysis->hybridProblem.outputAxes.push_back(x);
+	analysis->hybridProblem.outputAxes.push_back(y);
+	analysis->hybridProblem.plotSetting = PLOT_OCTAGON;
+	analysis->hybridProblem.plotFormat = PLOT_MATLAB;
 
 	delete $3;
 	delete $5;
@@ -1765,36 +1830,36 @@ MATLAB OCTAGON IDENT ',' IDENT
 |
 MATLAB GRID NUM IDENT ',' IDENT
 {
-	int x = continuousProblem.getIDForStateVar(*$4);
-	int y = continuousProblem.getIDForStateVar(*$6);
+	int x = analysis->continuousProblem.getIDForStateVar(*$4);
+	int y = analysis->continuousProblem.getIDForStateVar(*$6);
 
 	if(x < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$4).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if(y < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$6).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	continuousProblem.outputAxes.push_back(x);
-	continuousProblem.outputAxes.push_back(y);
-	continuousProblem.plotSetting = PLOT_GRID;
-	continuousProblem.numSections = (int)$3;
-	continuousProblem.plotFormat = PLOT_MATLAB;
+	analysis->continuousProblem.outputAxes.push_back(x);
+	analysis->continuousProblem.outputAxes.push_back(y);
+	analysis->continuousProblem.plotSetting = PLOT_GRID;
+	analysis->continuousProblem.numSections = (int)$3;
+	analysis->continuousProblem.plotFormat = PLOT_MATLAB;
 
-	hybridProblem.outputAxes.push_back(x);
-	hybridProblem.outputAxes.push_back(y);
-	hybridProblem.plotSetting = PLOT_GRID;
-	hybridProblem.numSections = (int)$3;
-	hybridProblem.plotFormat = PLOT_MATLAB;
+	analysis->hybridProblem.outputAxes.push_back(x);
+	analysis->hybridProblem.outputAxes.push_back(y);
+	analysis->hybridProblem.plotSetting = PLOT_GRID;
+	analysis->hybridProblem.numSections = (int)$3;
+	analysis->hybridProblem.plotFormat = PLOT_MATLAB;
 
 	delete $4;
 	delete $6;
@@ -1824,53 +1889,53 @@ tmVarDecls: TMVAR tmIdDeclList
 
 tmIdDeclList: tmIdDeclList ',' IDENT
 {
-	if(!continuousProblem.declareTMVar(*$3))
+	if(!analysis->continuousProblem.declareTMVar(*$3))
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "TM variable %s has already been declared.", (*$3).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	hybridProblem.declareTMVar(*$3);
+	analysis->hybridProblem.declareTMVar(*$3);
 	delete $3;
 }
 |
 IDENT
 {
 	string tVar("local_t");
-	continuousProblem.declareTMVar(tVar);
-	hybridProblem.declareTMVar(tVar);
+	analysis->continuousProblem.declareTMVar(tVar);
+	analysis->hybridProblem.declareTMVar(tVar);
 
-	if(!continuousProblem.declareTMVar(*$1))
+	if(!analysis->continuousProblem.declareTMVar(*$1))
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "TM variable %s has already been declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	hybridProblem.declareTMVar(*$1);
+	analysis->hybridProblem.declareTMVar(*$1);
 	delete $1;
 }
 ;
 
 taylor_model: taylor_model IDENT EQ polynomial '+' '[' NUM ',' NUM ']'
 {
-	int id = continuousProblem.getIDForStateVar(*$2);
+	int id = analysis->continuousProblem.getIDForStateVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($7 > $9)
 	{
-		parseError("Invalid interval remainder.", lineNum);
-		exit(1);
+		parseError("Invalid interval remainder.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I($7,$9);
@@ -1886,7 +1951,7 @@ taylor_model: taylor_model IDENT EQ polynomial '+' '[' NUM ',' NUM ']'
 	TaylorModel tmEmpty;
 	$$ = new TaylorModelVec;
 
-	for(int i=0; i<continuousProblem.stateVarNames.size(); ++i)
+	for(int i=0; i<analysis->continuousProblem.stateVarNames.size(); ++i)
 	{
 		$$->tms.push_back(tmEmpty);
 	}
@@ -1895,20 +1960,20 @@ taylor_model: taylor_model IDENT EQ polynomial '+' '[' NUM ',' NUM ']'
 
 taylor_model_domain: taylor_model_domain IDENT BELONGSTO '[' NUM ',' NUM ']'
 {
-	int id = continuousProblem.getIDForTMVar(*$2);
+	int id = analysis->continuousProblem.getIDForTMVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "TM variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($5 > $7)
 	{
-		parseError("Invalid interval.", lineNum);
-		exit(1);
+		parseError("Invalid interval.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I($5,$7);
@@ -1920,25 +1985,25 @@ taylor_model_domain: taylor_model_domain IDENT BELONGSTO '[' NUM ',' NUM ']'
 |
 IDENT BELONGSTO '[' NUM ',' NUM ']'
 {
-	$$ = new vector<Interval>( continuousProblem.tmVarNames.size() );
+	$$ = new vector<Interval>( analysis->continuousProblem.tmVarNames.size() );
 
 	Interval intZero;
 	(*$$)[0] = intZero;
 
-	int id = continuousProblem.getIDForTMVar(*$1);
+	int id = analysis->continuousProblem.getIDForTMVar(*$1);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "TM variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($4 > $6)
 	{
-		parseError("Invalid interval.", lineNum);
-		exit(1);
+		parseError("Invalid interval.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I($4,$6);
@@ -1950,20 +2015,20 @@ IDENT BELONGSTO '[' NUM ',' NUM ']'
 
 intervals: intervals IDENT BELONGSTO '[' NUM ',' NUM ']'
 {
-	int id = continuousProblem.getIDForStateVar(*$2);
+	int id = analysis->continuousProblem.getIDForStateVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($5 > $7)
 	{
-		parseError("Invalid interval.", lineNum);
-		exit(1);
+		parseError("Invalid interval.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I($5,$7);
@@ -1974,11 +2039,11 @@ intervals: intervals IDENT BELONGSTO '[' NUM ',' NUM ']'
 }
 |
 {
-	int numVars = continuousProblem.stateVarNames.size();
+	int numVars = analysis->continuousProblem.stateVarNames.size();
 	$$ = new vector<Interval>(numVars);
 
 	string tVar("local_t");
-	continuousProblem.declareTMVar(tVar);
+	analysis->continuousProblem.declareTMVar(tVar);
 
 	char name[NAME_SIZE];
 
@@ -1986,7 +2051,7 @@ intervals: intervals IDENT BELONGSTO '[' NUM ',' NUM ']'
 	{
 		sprintf(name, "%s%d", local_var_name, i+1);
 		string tmVarName(name);
-		continuousProblem.declareTMVar(tmVarName);
+		analysis->continuousProblem.declareTMVar(tmVarName);
 	}
 }
 ;
@@ -1995,14 +2060,14 @@ ode: ode IDENT '\'' EQ ODEpolynomial
 {
 	$$ = $1;
 
-	int id = continuousProblem.getIDForStateVar(*$2);
+	int id = analysis->continuousProblem.getIDForStateVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval intZero;
@@ -2017,24 +2082,24 @@ ode IDENT '\'' EQ ODEpolynomial '+' '[' NUM ',' NUM ']'
 {
 	$$ = $1;
 
-	int id = continuousProblem.getIDForStateVar(*$2);
+	int id = analysis->continuousProblem.getIDForStateVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($8 > $10)
 	{
-		parseError("Invalid interval", lineNum);
-		exit(1);
+		parseError("Invalid interval", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval uncertainty($8, $10);
-	gUncertainties[id] = uncertainty;
+	analysis->uncertainties[id] = uncertainty;
 
 	Interval intZero;
 	TaylorModel tmTemp(*$5, intZero);
@@ -2045,84 +2110,87 @@ ode IDENT '\'' EQ ODEpolynomial '+' '[' NUM ',' NUM ']'
 }
 |
 {
-	int numVars = continuousProblem.stateVarNames.size();
+	int numVars = analysis->continuousProblem.stateVarNames.size();
 
 	$$ = new TaylorModelVec;
 	TaylorModel tmTemp;
 	Interval intZero;
 
-	gUncertainties.clear();
+	analysis->uncertainties.clear();
 
 	for(int i=0; i<numVars; ++i)
 	{
 		$$->tms.push_back(tmTemp);
-		gUncertainties.push_back(intZero);
+		analysis->uncertainties.push_back(intZero);
 	}
 }
 ;
 
-npode: npode IDENT '\'' EQ non_polynomial_rhs_string
+npode: npode IDENT '\'' EQ non_polynomial_rhs_expression
 {
 	$$ = $1;
 
-	int id = continuousProblem.getIDForStateVar(*$2);
+	int id = analysis->continuousProblem.getIDForStateVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	(*$$)[id] = (*$5);
+	analysis->parseResult.expression.setRoot($5);
+	(*$$)[id] = analysis->parseResult.expression;
+	analysis->parseResult.expression.clear();
 
 	delete $2;
-	delete $5;
 }
 |
-npode IDENT '\'' EQ non_polynomial_rhs_string '+' '[' NUM ',' NUM ']'
+npode IDENT '\'' EQ non_polynomial_rhs_expression '+' '[' NUM ',' NUM ']'
 {
 	$$ = $1;
 
-	int id = continuousProblem.getIDForStateVar(*$2);
+	int id = analysis->continuousProblem.getIDForStateVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	(*$$)[id] = (*$5);
+	analysis->parseResult.expression.setRoot($5);
+	(*$$)[id] = analysis->parseResult.expression;
+	analysis->parseResult.expression.clear();
 
 	if($8 > $10)
 	{
-		parseError("Invalid interval", lineNum);
-		exit(1);
+		parseError("Invalid interval", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval uncertainty($8, $10);
-	gUncertainties[id] = uncertainty;
+	analysis->uncertainties[id] = uncertainty;
 
 	delete $2;
-	delete $5;
 }
 |
 {
-	int numVars = continuousProblem.stateVarNames.size();
-	$$ = new vector<string>;
+	int numVars = analysis->continuousProblem.stateVarNames.size();
+	$$ = new vector<Expression>;
 
-	string empty;
+	Expression empty;
 	Interval intZero;
 
-	gUncertainties.clear();
+	analysis->uncertainties.clear();
+	analysis->parseResult.expression.clear();
 
 	for(int i=0; i<numVars; ++i)
 	{
 		$$->push_back(empty);
-		gUncertainties.push_back(intZero);
+		analysis->uncertainties.push_back(intZero);
 	}
 }
 ;
@@ -2163,7 +2231,7 @@ polynomial '^' NUM
 	if(exp == 0)
 	{
 		Interval I(1);
-		$$ = new Polynomial(I, continuousProblem.tmVarNames.size());
+		$$ = new Polynomial(I, analysis->continuousProblem.tmVarNames.size());
 	}
 	else
 	{
@@ -2187,17 +2255,17 @@ polynomial '^' NUM
 |
 IDENT
 {
-	int id = continuousProblem.getIDForTMVar(*$1);
+	int id = analysis->continuousProblem.getIDForTMVar(*$1);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "TM variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	int numVars = continuousProblem.tmVarNames.size();
+	int numVars = analysis->continuousProblem.tmVarNames.size();
 	Interval I(1);
 
 	vector<int> degrees;
@@ -2215,7 +2283,7 @@ IDENT
 |
 NUM
 {
-	int numVars = continuousProblem.tmVarNames.size();
+	int numVars = analysis->continuousProblem.tmVarNames.size();
 	Interval I($1);
 	$$ = new Polynomial(I, numVars);
 }
@@ -2257,7 +2325,7 @@ ODEpolynomial '^' NUM
 	if(exp == 0)
 	{
 		Interval I(1);
-		$$ = new Polynomial(I, continuousProblem.stateVarNames.size()+1);
+		$$ = new Polynomial(I, analysis->continuousProblem.stateVarNames.size()+1);
 	}
 	else
 	{
@@ -2281,17 +2349,17 @@ ODEpolynomial '^' NUM
 |
 IDENT
 {
-	int id = continuousProblem.getIDForStateVar(*$1);
+	int id = analysis->continuousProblem.getIDForStateVar(*$1);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	int numVars = continuousProblem.stateVarNames.size()+1;
+	int numVars = analysis->continuousProblem.stateVarNames.size()+1;
 	Interval I(1);
 
 	vector<int> degrees;
@@ -2309,7 +2377,7 @@ IDENT
 |
 NUM
 {
-	int numVars = continuousProblem.stateVarNames.size()+1;
+	int numVars = analysis->continuousProblem.stateVarNames.size()+1;
 	Interval I($1);
 	$$ = new Polynomial(I, numVars);
 }
@@ -2317,20 +2385,20 @@ NUM
 
 interval_taylor_model: interval_taylor_model IDENT EQ interval_polynomial '+' '[' NUM ',' NUM ']'
 {
-	int id = continuousProblem.getIDForStateVar(*$2);
+	int id = analysis->continuousProblem.getIDForStateVar(*$2);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$2).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($7 > $9)
 	{
-		parseError("Invalid interval remainder.", lineNum);
-		exit(1);
+		parseError("Invalid interval remainder.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I($7,$9);
@@ -2347,25 +2415,25 @@ IDENT EQ interval_polynomial '+' '[' NUM ',' NUM ']'
 	TaylorModel tmEmpty;
 	$$ = new TaylorModelVec;
 
-	for(int i=0; i<continuousProblem.stateVarNames.size(); ++i)
+	for(int i=0; i<analysis->continuousProblem.stateVarNames.size(); ++i)
 	{
 		$$->tms.push_back(tmEmpty);
 	}
 
-	int id = continuousProblem.getIDForStateVar(*$1);
+	int id = analysis->continuousProblem.getIDForStateVar(*$1);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
 	if($6 > $8)
 	{
-		parseError("Invalid interval remainder.", lineNum);
-		exit(1);
+		parseError("Invalid interval remainder.", analysis->lineNum);
+		YYABORT;
 	}
 
 	Interval I($6,$8);
@@ -2414,7 +2482,7 @@ interval_polynomial '^' NUM
 	if(exp == 0)
 	{
 		Interval I(1);
-		$$ = new Polynomial(I, continuousProblem.tmVarNames.size());
+		$$ = new Polynomial(I, analysis->continuousProblem.tmVarNames.size());
 	}
 	else
 	{
@@ -2438,17 +2506,17 @@ interval_polynomial '^' NUM
 |
 IDENT
 {
-	int id = continuousProblem.getIDForTMVar(*$1);
+	int id = analysis->continuousProblem.getIDForTMVar(*$1);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "TM variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	int numVars = continuousProblem.tmVarNames.size();
+	int numVars = analysis->continuousProblem.tmVarNames.size();
 	Interval I(1);
 
 	vector<int> degrees;
@@ -2466,7 +2534,7 @@ IDENT
 |
 '[' NUM ',' NUM ']'
 {
-	int numVars = continuousProblem.tmVarNames.size();
+	int numVars = analysis->continuousProblem.tmVarNames.size();
 	Interval I($2, $4);
 	$$ = new Polynomial(I, numVars);
 }
@@ -2491,668 +2559,87 @@ IDENT
 
 
 
-non_polynomial_rhs_picard: non_polynomial_rhs_picard '+' non_polynomial_rhs_picard
+non_polynomial_rhs_expression: non_polynomial_rhs_expression '+' non_polynomial_rhs_expression
 {
-	$$ = $1;
-	$1->add_assign(*$3);
-	delete $3;
-}
-|
-non_polynomial_rhs_picard '-' non_polynomial_rhs_picard
-{
-	$$ = $1;
-	$1->sub_assign(*$3);
-	delete $3;
-}
-|
-non_polynomial_rhs_picard '*' non_polynomial_rhs_picard
-{
-	$$ = $1;
-
-	Interval intPoly1, intPoly2, intTrunc;
-
-	$3->polyRangeNormal(intPoly2, parseSetting.step_exp_table);
-	$1->mul_insert_ctrunc_normal_assign(intPoly1, intTrunc, *$3, intPoly2, parseSetting.step_exp_table, parseSetting.order);
-
-	parseSetting.ranges.push_back(intPoly1);
-	parseSetting.ranges.push_back(intPoly2);
-	parseSetting.ranges.push_back(intTrunc);
-
-	delete $3;
-}
-|
-'(' non_polynomial_rhs_picard ')'
-{
-	$$ = $2;
-}
-|
-non_polynomial_rhs_picard '/' non_polynomial_rhs_picard
-{
-	TaylorModel tmTemp;
-	$3->rec_taylor(tmTemp, parseSetting.ranges, parseSetting.step_exp_table, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	$$ = $1;
-
-	Interval intPoly1, intPoly2, intTrunc;
-
-	tmTemp.polyRangeNormal(intPoly2, parseSetting.step_exp_table);
-	$1->mul_insert_ctrunc_normal_assign(intPoly1, intTrunc, tmTemp, intPoly2, parseSetting.step_exp_table, parseSetting.order);
-
-	parseSetting.ranges.push_back(intPoly1);
-	parseSetting.ranges.push_back(intPoly2);
-	parseSetting.ranges.push_back(intTrunc);
-
-	delete $3;
-}
-|
-EXP '(' non_polynomial_rhs_picard ')'
-{
-	TaylorModel tmTemp;
-	$3->exp_taylor(tmTemp, parseSetting.ranges, parseSetting.step_exp_table, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	*$3 = tmTemp;
-	$$ = $3;
-}
-|
-SIN '(' non_polynomial_rhs_picard ')'
-{
-	TaylorModel tmTemp;
-	$3->sin_taylor(tmTemp, parseSetting.ranges, parseSetting.step_exp_table, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	*$3 = tmTemp;
-	$$ = $3;
-}
-|
-COS '(' non_polynomial_rhs_picard ')'
-{
-	TaylorModel tmTemp;
-	$3->cos_taylor(tmTemp, parseSetting.ranges, parseSetting.step_exp_table, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	*$3 = tmTemp;
-	$$ = $3;
-}
-|
-LOG '(' non_polynomial_rhs_picard ')'
-{
-	TaylorModel tmTemp;
-	$3->log_taylor(tmTemp, parseSetting.ranges, parseSetting.step_exp_table, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	*$3 = tmTemp;
-	$$ = $3;
-}
-|
-SQRT '(' non_polynomial_rhs_picard ')'
-{
-	TaylorModel tmTemp;
-	$3->sqrt_taylor(tmTemp, parseSetting.ranges, parseSetting.step_exp_table, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	*$3 = tmTemp;
-	$$ = $3;
-}
-|
-non_polynomial_rhs_picard '^' NUM
-{
-	int exp = (int)$3;
-
-	if(exp == 0)
-	{
-		Interval I(1);
-		$$ = new TaylorModel(I, continuousProblem.stateVarNames.size()+1);
-	}
-	else
-	{
-		$$ = new TaylorModel(*$1);
-
-		Interval intPoly1, intPoly2, intTrunc;
-		$1->polyRangeNormal(intPoly2, parseSetting.step_exp_table);
-
-		for(int i=2; i<=exp; ++i)
-		{
-			$$->mul_insert_ctrunc_normal_assign(intPoly1, intTrunc, *$1, intPoly2, parseSetting.step_exp_table, parseSetting.order);
-
-			parseSetting.ranges.push_back(intPoly1);
-			parseSetting.ranges.push_back(intPoly2);
-			parseSetting.ranges.push_back(intTrunc);
-		}
-	}
-
-	delete $1;
-}
-|
-'-' non_polynomial_rhs_picard %prec uminus
-{
-	Interval I(-1);
-	$$ = $2;
-	$$->mul_assign(I);
-}
-|
-IDENT
-{
-	int id = continuousProblem.getIDForStateVar(*$1);
-
-	if(id < 0)
-	{
-		char errMsg[MSG_SIZE];
-		sprintf(errMsg, "State variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
-	}
-
-	$$ = new TaylorModel;
-	(*$$) = parseSetting.flowpipe.tms[id];
-
-	delete $1;
+	$$ = analysis->parseResult.expression.binary(EXPR_ADD, $1, $3);
 }
 |
-'[' NUM ',' NUM ']'
+non_polynomial_rhs_expression '-' non_polynomial_rhs_expression
 {
-	int numVars = continuousProblem.stateVarNames.size()+1;
-	Interval I($2, $4);
-	$$ = new TaylorModel(I, numVars);
-}
-;
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-non_polynomial_rhs_remainder: non_polynomial_rhs_remainder '+' non_polynomial_rhs_remainder
-{
-	$$ = $1;
-	(*$$) += (*$3);
-	delete $3;
+	$$ = analysis->parseResult.expression.binary(EXPR_SUB, $1, $3);
 }
 |
-non_polynomial_rhs_remainder '-' non_polynomial_rhs_remainder
+non_polynomial_rhs_expression '*' non_polynomial_rhs_expression
 {
-	$$ = $1;
-	(*$$) -= (*$3);
-	delete $3;
-}
-|
-non_polynomial_rhs_remainder '*' non_polynomial_rhs_remainder
-{
-	$$ = new Interval;
-
-	(*$$) = (*parseSetting.iterRange) * (*$3);
-	++parseSetting.iterRange;
-	(*$$) += (*parseSetting.iterRange) * (*$1);
-	(*$$) += (*$1) * (*$3);
-	++parseSetting.iterRange;
-	(*$$) += (*parseSetting.iterRange);
-	++parseSetting.iterRange;
-
-	delete $1;
-	delete $3;
+	$$ = analysis->parseResult.expression.binary(EXPR_MUL, $1, $3);
 }
 |
-'(' non_polynomial_rhs_remainder ')'
+'(' non_polynomial_rhs_expression ')'
 {
 	$$ = $2;
 }
 |
-non_polynomial_rhs_remainder '/' non_polynomial_rhs_remainder
+non_polynomial_rhs_expression '/' non_polynomial_rhs_expression
 {
-	Interval intTemp;
-	rec_taylor_only_remainder(intTemp, *$3, parseSetting.iterRange, parseSetting.order);
-
-	$$ = new Interval;
-
-	(*$$) = (*parseSetting.iterRange) * intTemp;
-	++parseSetting.iterRange;
-	(*$$) += (*parseSetting.iterRange) * (*$1);
-	(*$$) += (*$1) * intTemp;
-	++parseSetting.iterRange;
-	(*$$) += (*parseSetting.iterRange);
-	++parseSetting.iterRange;
-
-	delete $1;
-	delete $3;
+	$$ = analysis->parseResult.expression.binary(EXPR_DIV, $1, $3);
 }
 |
-EXP '(' non_polynomial_rhs_remainder ')'
+EXP '(' non_polynomial_rhs_expression ')'
 {
-	Interval intTemp;
-	exp_taylor_only_remainder(intTemp, *$3, parseSetting.iterRange, parseSetting.order);
-
-	(*$3) = intTemp;
-	$$ = $3;
+	$$ = analysis->parseResult.expression.unary(EXPR_EXP, $3);
 }
 |
-SIN '(' non_polynomial_rhs_remainder ')'
+SIN '(' non_polynomial_rhs_expression ')'
 {
-	Interval intTemp;
-	sin_taylor_only_remainder(intTemp, *$3, parseSetting.iterRange, parseSetting.order);
-
-	(*$3) = intTemp;
-	$$ = $3;
+	$$ = analysis->parseResult.expression.unary(EXPR_SIN, $3);
 }
 |
-COS '(' non_polynomial_rhs_remainder ')'
+COS '(' non_polynomial_rhs_expression ')'
 {
-	Interval intTemp;
-	cos_taylor_only_remainder(intTemp, *$3, parseSetting.iterRange, parseSetting.order);
-
-	(*$3) = intTemp;
-	$$ = $3;
+	$$ = analysis->parseResult.expression.unary(EXPR_COS, $3);
 }
 |
-LOG '(' non_polynomial_rhs_remainder ')'
+LOG '(' non_polynomial_rhs_expression ')'
 {
-	Interval intTemp;
-	log_taylor_only_remainder(intTemp, *$3, parseSetting.iterRange, parseSetting.order);
-
-	(*$3) = intTemp;
-	$$ = $3;
+	$$ = analysis->parseResult.expression.unary(EXPR_LOG, $3);
 }
 |
-SQRT '(' non_polynomial_rhs_remainder ')'
+SQRT '(' non_polynomial_rhs_expression ')'
 {
-	Interval intTemp;
-	sqrt_taylor_only_remainder(intTemp, *$3, parseSetting.iterRange, parseSetting.order);
-
-	(*$3) = intTemp;
-	$$ = $3;
+	$$ = analysis->parseResult.expression.unary(EXPR_SQRT, $3);
 }
 |
-non_polynomial_rhs_remainder '^' NUM
+non_polynomial_rhs_expression '^' NUM
 {
-	int exp = (int)$3;
-
-	if(exp == 0)
-	{
-		Interval intZero;
-		(*$1) = intZero;
-		$$ = $1;
-	}
-	else
-	{
-		$$ = new Interval(*$1);
-
-		for(int i=2; i<=exp; ++i)
-		{
-			Interval intTemp;
-			intTemp = (*parseSetting.iterRange) * (*$1);
-			++parseSetting.iterRange;
-			intTemp += (*parseSetting.iterRange) * (*$$);
-			intTemp += (*$1) * (*$$);
-			++parseSetting.iterRange;
-			intTemp += (*parseSetting.iterRange);
-			++parseSetting.iterRange;
-			
-			(*$$) = intTemp;
-		}
-	}
-
-	delete $1;
+	$$ = analysis->parseResult.expression.power($1, (int)$3);
 }
 |
-'-' non_polynomial_rhs_remainder %prec uminus
+'-' non_polynomial_rhs_expression %prec uminus
 {
-	$$ = $2;
-	$$->inv_assign();
+	$$ = analysis->parseResult.expression.unary(EXPR_NEG, $2);
 }
 |
 IDENT
 {
-	int id = continuousProblem.getIDForStateVar(*$1);
+	int id = analysis->continuousProblem.getIDForStateVar(*$1);
 
 	if(id < 0)
 	{
 		char errMsg[MSG_SIZE];
 		sprintf(errMsg, "State variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
+		parseError(errMsg, analysis->lineNum);
+		YYABORT;
 	}
 
-	$$ = new Interval;
-	(*$$) = parseSetting.flowpipe.tms[id].getRemainder();
+	$$ = analysis->parseResult.expression.variable(id);
 
 	delete $1;
 }
 |
-'[' NUM ',' NUM ']'
-{
-	$$ = new Interval;
-}
-;
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-non_polynomial_rhs_no_remainder: non_polynomial_rhs_no_remainder '+' non_polynomial_rhs_no_remainder
-{
-	$$ = $1;
-	(*$$) += (*$3);
-
-	delete $3;
-}
-|
-non_polynomial_rhs_no_remainder '-' non_polynomial_rhs_no_remainder
-{
-	$$ = $1;
-	(*$$) -= (*$3);
-
-	delete $3;
-}
-|
-non_polynomial_rhs_no_remainder '*' non_polynomial_rhs_no_remainder
-{
-	$$ = $1;
-	(*$$) *= (*$3);
-	$$->nctrunc(parseSetting.order);
-	$$->cutoff();
-
-	delete $3;
-}
-|
-'(' non_polynomial_rhs_no_remainder ')'
-{
-	$$ = $2;
-}
-|
-non_polynomial_rhs_no_remainder '/' non_polynomial_rhs_no_remainder
-{
-	Polynomial polyTemp;
-	$3->rec_taylor(polyTemp, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	(*$1) *= polyTemp;
-	$1->nctrunc(parseSetting.order);
-	$$ = $1;
-	$$->cutoff();
-
-	delete $3;
-}
-|
-EXP '(' non_polynomial_rhs_no_remainder ')'
-{
-	Polynomial polyTemp;
-	$3->exp_taylor(polyTemp, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	(*$3) = polyTemp;
-	$$ = $3;
-}
-|
-SIN '(' non_polynomial_rhs_no_remainder ')'
-{
-	Polynomial polyTemp;
-	$3->sin_taylor(polyTemp, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	(*$3) = polyTemp;
-	$$ = $3;
-}
-|
-COS '(' non_polynomial_rhs_no_remainder ')'
-{
-	Polynomial polyTemp;
-	$3->cos_taylor(polyTemp, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	(*$3) = polyTemp;
-	$$ = $3;
-}
-|
-LOG '(' non_polynomial_rhs_no_remainder ')'
-{
-	Polynomial polyTemp;
-	$3->log_taylor(polyTemp, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	(*$3) = polyTemp;
-	$$ = $3;
-}
-|
-SQRT '(' non_polynomial_rhs_no_remainder ')'
-{
-	Polynomial polyTemp;
-	$3->sqrt_taylor(polyTemp, continuousProblem.stateVarNames.size()+1, parseSetting.order);
-
-	(*$3) = polyTemp;
-	$$ = $3;
-}
-|
-non_polynomial_rhs_no_remainder '^' NUM
-{
-	Interval I(1);
-	Polynomial polyTemp(I, continuousProblem.stateVarNames.size()+1);
-
-	int degree = (int)$3;
-	for(int i=0; i<degree; ++i)
-	{
-		polyTemp *= *$1;
-		polyTemp.nctrunc(parseSetting.order);
-	}
-
-	$$ = $1;
-	(*$$) = polyTemp;
-	$$->cutoff();
-}
-|
-'-' non_polynomial_rhs_no_remainder %prec uminus
-{
-	$$ = $2;
-	$$->inv_assign();
-}
-|
-IDENT
-{
-	int id = continuousProblem.getIDForStateVar(*$1);
-
-	if(id < 0)
-	{
-		char errMsg[MSG_SIZE];
-		sprintf(errMsg, "State variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
-	}
-
-	$$ = new Polynomial;
-	parseSetting.flowpipe.tms[id].getExpansion(*$$);
-}
-|
-'[' NUM ',' NUM ']'
-{
-	Interval I($2, $4);
-	$$ = new Polynomial(I, continuousProblem.stateVarNames.size()+1);
-}
-;
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-non_polynomial_rhs_string: non_polynomial_rhs_string '+' non_polynomial_rhs_string
-{
-	(*$1) += ' ';
-	(*$1) += '+';
-	(*$1) += ' ';
-	(*$1) += (*$3);
-
-	$$ = $1;
-	delete $3;
-}
-|
-non_polynomial_rhs_string '-' non_polynomial_rhs_string
-{
-	(*$1) += ' ';
-	(*$1) += '-';
-	(*$1) += ' ';
-	(*$1) += (*$3);
-
-	$$ = $1;
-	delete $3;
-}
-|
-non_polynomial_rhs_string '*' non_polynomial_rhs_string
-{
-	(*$1) += ' ';
-	(*$1) += '*';
-	(*$1) += ' ';
-	(*$1) += (*$3);
-
-	$$ = $1;
-	delete $3;
-}
-|
-'(' non_polynomial_rhs_string ')'
-{
-	string str;
-	str += '(';
-	str += (*$2);
-	str += ')';
-	(*$2) = str;
-
-	$$ = $2;
-}
-|
-non_polynomial_rhs_string '/' non_polynomial_rhs_string
-{
-	(*$1) += ' ';
-	(*$1) += '/';
-	(*$1) += ' ';
-	(*$1) += (*$3);
-
-	$$ = $1;
-	delete $3;
-}
-|
-EXP '(' non_polynomial_rhs_string ')'
-{
-	string str("exp");
-	str += '(';
-	str += (*$3);
-	str += ')';
-	(*$3) = str;
-
-	$$ = $3;
-}
-|
-SIN '(' non_polynomial_rhs_string ')'
-{
-	string str("sin");
-	str += '(';
-	str += (*$3);
-	str += ')';
-	(*$3) = str;
-
-	$$ = $3;
-}
-|
-COS '(' non_polynomial_rhs_string ')'
-{
-	string str("cos");
-	str += '(';
-	str += (*$3);
-	str += ')';
-	(*$3) = str;
-
-	$$ = $3;
-}
-|
-LOG '(' non_polynomial_rhs_string ')'
-{
-	string str("log");
-	str += '(';
-	str += (*$3);
-	str += ')';
-	(*$3) = str;
-
-	$$ = $3;
-}
-|
-SQRT '(' non_polynomial_rhs_string ')'
-{
-	string str("sqrt");
-	str += '(';
-	str += (*$3);
-	str += ')';
-	(*$3) = str;
-
-	$$ = $3;
-}
-|
-non_polynomial_rhs_string '^' NUM
-{
-	(*$1) += '^';
-
-	char strNum[NUM_LENGTH];
-	sprintf(strNum, "%d", (int)$3);
-	string num(strNum);
-	(*$1) += num;
-
-	$$ = $1;
-}
-|
-'-' non_polynomial_rhs_string %prec uminus
-{
-	string str;
-	str += '-';
-	str += (*$2);
-	(*$2) = str;
-
-	$$ = $2;
-}
-|
-IDENT
-{
-	int id = continuousProblem.getIDForStateVar(*$1);
-
-	if(id < 0)
-	{
-		char errMsg[MSG_SIZE];
-		sprintf(errMsg, "State variable %s is not declared.", (*$1).c_str());
-		parseError(errMsg, lineNum);
-		exit(1);
-	}
-
-	$$ = $1;
-}
-|
 NUM
 {
-	$$ = new string;
-	char strNum[NUM_LENGTH];
-	sprintf(strNum, "%.20e", $1);
-	string num(strNum);
-
-	(*$$) += '[';
-	(*$$) += num;
-	(*$$) += ' ';
-	(*$$) += ',';
-	(*$$) += ' ';
-	(*$$) += num;
-	(*$$) += ']';
+	Interval I($1);
+	$$ = analysis->parseResult.expression.constant(I);
 }
 ;
 
@@ -3173,16 +2660,8 @@ NUM
 
 %%
 
-int yyerror(const char * what)
-{
-	fprintf(stderr, "Error line %d: %s\n", lineNum,what);
-	err=true;
-	return 1;
-}
-
-int yyerror(string what)
+void yyerror(Analysis *analysis, void *scanner, const char *what)
 {
-	cerr << "Error line "<<lineNum<<" "<<what<<endl;
-	err=true;
-	return 1;
+	fprintf(stderr, "Error line %d: %s\n", analysis->lineNum, what);
+	analysis->bError = true;
 }
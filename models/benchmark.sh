@@ -0,0 +1,186 @@
+#!/bin/bash
+#
+# Runs every model in the subdirectories a number of times, writes the CSV and JSON reports and compares the report
+# with a stored baseline.
+#
+# usage: benchmark.sh [-b flowstar] [-n runs] [-t threshold] [-r report] [-c baseline] [model directories]
+#
+# The wall time of a model is the median over the runs, the peak memory is the maximum. A model regresses if its
+# wall time exceeds the baseline by more than the threshold (a ratio, 0.1 by default) or its result changes. The
+# exit status is 1 if a model regresses or fails.
+
+FLOWSTAR_BIN=
+RUNS=3
+THRESHOLD=0.1
+REPORT=benchmark
+BASELINE=
+
+while getopts "b:n:t:r:c:" opt
+do
+	case $opt in
+	b) FLOWSTAR_BIN=$OPTARG ;;
+	n) RUNS=$OPTARG ;;
+	t) THRESHOLD=$OPTARG ;;
+	r) REPORT=$OPTARG ;;
+	c) BASELINE=$OPTARG ;;
+	*) exit 2 ;;
+	esac
+done
+shift $((OPTIND-1))
+
+# the paths in the arguments are relative to the working directory of the caller
+case $FLOWSTAR_BIN in
+"") FLOWSTAR_BIN=$(dirname "$0")/../flowstar-1.2.0/flowstar ;;
+esac
+case $FLOWSTAR_BIN in
+/*) ;;
+*) FLOWSTAR_BIN=$PWD/$FLOWSTAR_BIN ;;
+esac
+case $BASELINE in
+""|/*) ;;
+*) BASELINE=$PWD/$BASELINE ;;
+esac
+
+ROOT=$(cd "$(dirname "$0")" && pwd)
+cd "$ROOT" || exit 2
+
+if [ ! -x "$FLOWSTAR_BIN" ]
+then
+	echo "Can not find the flowstar binary $FLOWSTAR_BIN."
+	exit 2
+fi
+
+if [ $# -eq 0 ]
+then
+	set -- */
+fi
+
+case $REPORT in
+/*) ;;
+*) REPORT=$ROOT/$REPORT ;;
+esac
+
+CSV=$REPORT.csv
+JSON=$REPORT.json
+LOG=$(mktemp)
+trap 'rm -f "$LOG"' EXIT
+
+echo "model,runs,wall_median,wall_min,wall_max,peak_memory_kb,flowpipes,jumps,result" > "$CSV"
+
+status=0
+
+for dir in "$@"
+do
+	dir=${dir%/}
+
+	for model in "$dir"/*.model
+	do
+		[ -e "$model" ] || continue
+
+		name=${model%.model}
+		times=
+		memory=0
+		flowpipes=
+		jumps=0
+		result=NONE
+
+		for ((i=0; i<RUNS; ++i))
+		do
+			begin=$(date +%s%N)
+			(cd "$dir" && "$FLOWSTAR_BIN" < "$(basename "$model")") > "$LOG" 2>&1
+			code=$?
+			end=$(date +%s%N)
+
+			if [ $code -ne 0 ]
+			then
+				result=ERROR
+				break
+			fi
+
+			times="$times $(awk -v b="$begin" -v e="$end" 'BEGIN { printf "%.6f", (e - b) / 1e9 }')"
+
+			m=$(sed -n 's/^peak memory: \([0-9]*\) KB$/\1/p' "$LOG")
+			if [ -n "$m" ] && [ "$m" -gt "$memory" ]
+			then
+				memory=$m
+			fi
+
+			flowpipes=$(sed -n 's/^\([0-9]*\) flowpipes computed\.$/\1/p' "$LOG")
+			j=$(sed -n 's/^\([0-9]*\) jumps executed\.$/\1/p' "$LOG")
+			[ -n "$j" ] && jumps=$j
+
+			r=$(sed -n 's/^Result: *\([A-Z]*\)$/\1/p' "$LOG" | tail -n 1)
+			[ -n "$r" ] && result=$r
+		done
+
+		if [ "$result" = ERROR ]
+		then
+			echo "$name: failed"
+			echo "$name,$RUNS,,,,,,,ERROR" >> "$CSV"
+			status=1
+			continue
+		fi
+
+		stats=$(echo $times | tr ' ' '\n' | sort -g | awk '{ t[NR] = $1 } END { m = NR % 2 ? t[(NR+1)/2] : (t[NR/2] + t[NR/2+1]) / 2; printf "%.6f,%.6f,%.6f", m, t[1], t[NR] }')
+
+		echo "$name: $stats s, $memory KB, $flowpipes flowpipes, $jumps jumps, $result"
+		echo "$name,$RUNS,$stats,$memory,$flowpipes,$jumps,$result" >> "$CSV"
+	done
+done
+
+# the JSON report has the same records as the CSV one
+awk -F, 'NR == 1 { for(i=1; i<=NF; ++i) key[i] = $i; next }
+{
+	printf "%s  {", (NR > 2 ? ",\n" : "[\n")
+	for(i=1; i<=NF; ++i)
+	{
+		if(i == 1 || i == NF)
+			value = "\"" $i "\""
+		else
+			value = ($i == "" ? "null" : $i)
+		printf "%s\"%s\": %s", (i > 1 ? ", " : ""), key[i], value
+	}
+	printf "}"
+}
+END { printf "%s]\n", (NR > 1 ? "\n" : "[") }' "$CSV" > "$JSON"
+
+echo "Report written to $CSV and $JSON."
+
+if [ -n "$BASELINE" ]
+then
+	if [ ! -e "$BASELINE" ]
+	then
+		echo "Can not find the baseline $BASELINE."
+		exit 2
+	fi
+
+	# the fields are 3: wall_median, 6: peak_memory_kb, 7: flowpipes, 8: jumps, 9: result
+	awk -F, -v threshold="$THRESHOLD" '
+	FNR == 1 { next }
+	NR == FNR { wall[$1] = $3; flowpipes[$1] = $7; jumps[$1] = $8; result[$1] = $9; next }
+	!($1 in wall) { printf "%-48s new\n", $1; next }
+	{
+		verdict = "ok"
+		if($9 != result[$1])
+			verdict = "REGRESSION (result " result[$1] " -> " $9 ")"
+		else if(wall[$1] > 0 && $3 > wall[$1] * (1 + threshold))
+			verdict = "REGRESSION"
+		else if(wall[$1] > 0 && $3 < wall[$1] * (1 - threshold))
+			verdict = "improved"
+
+		if(verdict ~ /^REGRESSION/)
+			regressions++
+
+		note = ""
+		if($7 != flowpipes[$1] || $8 != jumps[$1])
+			note = sprintf(", flowpipes %s -> %s, jumps %s -> %s", flowpipes[$1], $7, jumps[$1], $8)
+
+		printf "%-48s %10.3fs -> %10.3fs %+7.1f%%  %s%s\n", $1, wall[$1], $3, (wall[$1] > 0 ? 100 * ($3 / wall[$1] - 1) : 0), verdict, note
+	}
+	END {
+		printf "%d regression(s) beyond %.1f%%.\n", regressions, 100 * threshold
+		exit (regressions > 0)
+	}' "$BASELINE" "$CSV" || status=1
+fi
+
+exit $status